@@ -85,6 +85,12 @@
 //
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 150
 
+// Host builds include bridges and controllers, which batch commands in their invoke requests.
+#define CHIP_CONFIG_MAX_PATHS_PER_INVOKE 16
+
+// Host builds include controllers, which resume sessions with many nodes.
+#define CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY 1
+
 // Safe to enable this flag since standalone is associated with host and not a device.
 #define CONFIG_BUILD_FOR_HOST_UNIT_TEST 1
 
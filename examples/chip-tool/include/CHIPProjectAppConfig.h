@@ -60,6 +60,9 @@
 
 #define CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY 1
 
+// Keep the index of resumable sessions in memory, as a controller resumes sessions with many nodes.
+#define CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY 1
+
 // Enable some test-only interaction model APIs.
 #define CONFIG_BUILD_FOR_HOST_UNIT_TEST 1
 
@@ -23,6 +23,7 @@
 #include <app/EventManagement.h>
 #include <app/GlobalAttributes.h>
 #include <app/att-storage.h>
+#include <app/util/af-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
@@ -34,20 +35,16 @@ using namespace chip;
 // TODO: Need to make it so that declarations of things that don't depend on generated files are not intermixed in af.h with
 // dependencies on generated files, so we don't have to re-declare things here.
 // Note: Some of the generated files that depended by af.h are gen_config.h and gen_tokens.h
-typedef uint8_t EmberAfClusterMask;
-
 extern uint16_t emberAfEndpointCount();
 extern uint16_t emberAfIndexFromEndpoint(EndpointId endpoint);
-extern uint8_t emberAfClusterCount(EndpointId endpoint, bool server);
-extern uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
+extern uint8_t emberAfClusterCountByIndex(uint16_t endpointIndex, bool server);
 extern uint16_t emberAfGetServerAttributeIndexByAttributeId(chip::EndpointId endpoint, chip::ClusterId cluster,
                                                             chip::AttributeId attributeId);
 extern chip::EndpointId emberAfEndpointFromIndex(uint16_t index);
-extern Optional<ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint, uint8_t n, bool server);
-extern Optional<AttributeId> emberAfGetServerAttributeIdByIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
-                                                                uint16_t attributeIndex);
+extern const EmberAfCluster * emberAfGetNthClusterFromIndex(uint16_t endpointIndex, uint8_t n, bool server);
 extern uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask);
 extern bool emberAfEndpointIndexIsEnabled(uint16_t index);
+extern uint32_t emberAfMetadataStructureGeneration();
 
 namespace chip {
 namespace app {
@@ -92,7 +89,7 @@ void AttributePathExpandIterator::PrepareClusterIndexRange(const AttributePathPa
     if (aAttributePath.HasWildcardClusterId())
     {
         mClusterIndex    = 0;
-        mEndClusterIndex = emberAfClusterCount(aEndpointId, true /* server */);
+        mEndClusterIndex = emberAfClusterCountByIndex(mEndpointIndex, true /* server */);
     }
     else
     {
@@ -109,7 +106,7 @@ void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePath
     if (aAttributePath.HasWildcardAttributeId())
     {
         mAttributeIndex          = 0;
-        mEndAttributeIndex       = emberAfGetServerAttributeCount(aEndpointId, aClusterId);
+        mEndAttributeIndex       = mCluster->attributeCount;
         mGlobalAttributeIndex    = 0;
         mGlobalAttributeEndIndex = ArraySize(GlobalAttributesNotInMetadata);
     }
@@ -165,6 +162,21 @@ void AttributePathExpandIterator::ResetCurrentCluster()
     Next();
 }
 
+bool AttributePathExpandIterator::IsCurrentClusterUnchanged() const
+{
+    if (mClusterIndex == UINT8_MAX || mEndpointIndex >= mEndEndpointIndex)
+    {
+        // Nothing has been resolved yet.
+        return true;
+    }
+    if (!emberAfEndpointIndexIsEnabled(mEndpointIndex) || emberAfEndpointFromIndex(mEndpointIndex) != mOutputPath.mEndpointId)
+    {
+        return false;
+    }
+    // The cluster metadata belongs to the endpoint type, so the same pointer means the endpoint has the same clusters.
+    return mClusterIndex >= mEndClusterIndex || emberAfGetNthClusterFromIndex(mEndpointIndex, mClusterIndex, true) == mCluster;
+}
+
 bool AttributePathExpandIterator::Next()
 {
     for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
@@ -186,7 +198,23 @@ bool AttributePathExpandIterator::Next()
             }
 
             PrepareEndpointIndexRange(mpAttributePath->mValue);
-            mClusterIndex = UINT8_MAX;
+            mClusterIndex       = UINT8_MAX;
+            mMetadataGeneration = emberAfMetadataStructureGeneration();
+        }
+        else if (mpAttributePath->mValue.IsWildcardPath() && mMetadataGeneration != emberAfMetadataStructureGeneration())
+        {
+            // Dynamic endpoints have been set or cleared since the iterator resolved where it is, e.g. between two chunks of a
+            // report. If the endpoint at mEndpointIndex was replaced, start over on it rather than read through stale metadata.
+            mMetadataGeneration = emberAfMetadataStructureGeneration();
+            if (!IsCurrentClusterUnchanged())
+            {
+                if (!mpAttributePath->mValue.HasWildcardEndpointId())
+                {
+                    // The endpoint may have been set again at another index.
+                    PrepareEndpointIndexRange(mpAttributePath->mValue);
+                }
+                mClusterIndex = UINT8_MAX;
+            }
         }
 
         for (; mEndpointIndex < mEndEndpointIndex;
@@ -198,11 +226,13 @@ bool AttributePathExpandIterator::Next()
                 continue;
             }
 
-            EndpointId endpointId = emberAfEndpointFromIndex(mEndpointIndex);
-
+            // The endpoint and cluster ids are resolved once, when the iterator enters the endpoint or the cluster, and kept in
+            // mOutputPath. Resuming in the middle of a cluster (e.g. for the next chunk of a report) then only needs the index of
+            // the next attribute.
             if (mClusterIndex == UINT8_MAX)
             {
-                PrepareClusterIndexRange(mpAttributePath->mValue, endpointId);
+                mOutputPath.mEndpointId = emberAfEndpointFromIndex(mEndpointIndex);
+                PrepareClusterIndexRange(mpAttributePath->mValue, mOutputPath.mEndpointId);
                 mAttributeIndex       = UINT16_MAX;
                 mGlobalAttributeIndex = UINT8_MAX;
             }
@@ -210,21 +240,20 @@ bool AttributePathExpandIterator::Next()
             for (; mClusterIndex < mEndClusterIndex;
                  (mClusterIndex++, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
             {
-                // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does
-                // not exceed the mEndClusterIndex.
-                ClusterId clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
                 if (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX)
                 {
-                    PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId);
+                    // emberAfGetNthClusterFromIndex must return a valid cluster here since we have verified the mClusterIndex
+                    // does not exceed the mEndClusterIndex.
+                    mCluster               = emberAfGetNthClusterFromIndex(mEndpointIndex, mClusterIndex, true /* server */);
+                    mOutputPath.mClusterId = mCluster->clusterId;
+                    PrepareAttributeIndexRange(mpAttributePath->mValue, mOutputPath.mEndpointId, mOutputPath.mClusterId);
                 }
 
                 if (mAttributeIndex < mEndAttributeIndex)
                 {
-                    // GetServerAttributeIdByIdex must return a valid attribute here since we have verified the mAttributeIndex does
-                    // not exceed the mEndAttributeIndex.
-                    mOutputPath.mAttributeId = emberAfGetServerAttributeIdByIndex(endpointId, clusterId, mAttributeIndex).Value();
-                    mOutputPath.mClusterId   = clusterId;
-                    mOutputPath.mEndpointId  = endpointId;
+                    // The cluster has this attribute since we have verified the mAttributeIndex does not exceed the
+                    // mEndAttributeIndex.
+                    mOutputPath.mAttributeId = mCluster->attributes[mAttributeIndex].attributeId;
                     mAttributeIndex++;
                     // We found a valid attribute path, now return and increase the attribute index for next iteration.
                     // Return true will skip the increment of mClusterIndex, mEndpointIndex and mpAttributePath.
@@ -234,8 +263,6 @@ bool AttributePathExpandIterator::Next()
                 {
                     // Return a path pointing to the next global attribute.
                     mOutputPath.mAttributeId = GlobalAttributesNotInMetadata[mGlobalAttributeIndex];
-                    mOutputPath.mClusterId   = clusterId;
-                    mOutputPath.mEndpointId  = endpointId;
                     mGlobalAttributeIndex++;
                     return true;
                 }
@@ -38,6 +38,9 @@
 #include <protocols/Protocols.h>
 #include <system/SystemPacketBuffer.h>
 
+// Defined in app/util/af-types.h.
+struct EmberAfCluster;
+
 namespace chip {
 namespace app {
 
@@ -63,6 +66,10 @@ namespace app {
  * - Chunk full, return
  * - In a new chunk, Get()
  *
+ * The iterator keeps the indices of the endpoint, cluster and attribute it points to, along with the endpoint id and the
+ * metadata of the cluster they resolve to, so resuming in a new chunk picks up the next attribute without looking up the
+ * endpoint or the cluster again.
+ *
  * TODO: The AttributePathParams may support a group id, the iterator should be able to call group data provider to expand the group
  * id.
  */
@@ -118,6 +125,11 @@ private:
     // metadata.
     uint8_t mGlobalAttributeIndex, mGlobalAttributeEndIndex;
 
+    // The cluster at mClusterIndex on the endpoint at mEndpointIndex, while the iterator is in it.
+    const EmberAfCluster * mCluster = nullptr;
+    // The emberAfMetadataStructureGeneration() the endpoint and cluster above were resolved at.
+    uint32_t mMetadataGeneration = 0;
+
     /**
      * Prepare*IndexRange will update mBegin*Index and mEnd*Index variables.
      * If AttributePathParams contains a wildcard field, it will set mBegin*Index to 0 and mEnd*Index to count.
@@ -125,11 +137,20 @@ private:
      *
      * If the Endpoint/Cluster/Attribute does not exist, mBegin*Index will be UINT*_MAX, and mEnd*Inde will be 0.
      *
-     * The index can be used with emberAfEndpointFromIndex, emberAfGetNthClusterId and emberAfGetServerAttributeIdByIndex.
+     * The index can be used with emberAfEndpointFromIndex and emberAfGetNthClusterFromIndex, and with the attributes of
+     * the cluster.
+     *
+     * PrepareClusterIndexRange expects mEndpointIndex to point to the endpoint, and PrepareAttributeIndexRange expects
+     * mCluster to point to the cluster.
      */
     void PrepareEndpointIndexRange(const AttributePathParams & aAttributePath);
     void PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId);
     void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId, ClusterId aClusterId);
+
+    /**
+     * Whether the endpoint and cluster the iterator is in are still at mEndpointIndex and mClusterIndex, with the same metadata.
+     */
+    bool IsCurrentClusterUnchanged() const;
 };
 } // namespace app
 } // namespace chip
@@ -67,6 +67,47 @@ public:
      */
     virtual CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                                  MutableByteSpan & aValue) = 0;
+
+    /**
+     * Receives the attribute values enumerated by ReadEndpointValues.
+     */
+    class AttributeValueVisitor
+    {
+    public:
+        virtual ~AttributeValueVisitor() = default;
+
+        /**
+         * Called once for each persisted attribute value.  `aValue` is only
+         * valid for the duration of the call, and is in the representation
+         * described in the WriteValue documentation.  It has not been checked
+         * against the attribute metadata.
+         *
+         * @return CHIP_NO_ERROR to continue the enumeration.  Any other value
+         *         stops it and is returned by ReadEndpointValues.
+         */
+        virtual CHIP_ERROR OnAttributeValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) = 0;
+    };
+
+    /**
+     * Read all the attribute values persisted for an endpoint, in a single
+     * pass over non-volatile memory.  This is used to restore the attribute
+     * store at startup without a separate read per attribute.
+     *
+     * The values may include attributes that no longer exist in the data
+     * model, which the visitor is expected to ignore.
+     *
+     * @param [in] aEndpointId the endpoint whose attribute values to read.
+     * @param [in] aVisitor called for each persisted value, in no particular
+     *             order.
+     *
+     * @return CHIP_ERROR_NOT_IMPLEMENTED if the provider cannot enumerate the
+     *         values of an endpoint, in which case ReadValue must be used for
+     *         each attribute instead.
+     */
+    virtual CHIP_ERROR ReadEndpointValues(EndpointId aEndpointId, AttributeValueVisitor & aVisitor)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
 };
 
 /**
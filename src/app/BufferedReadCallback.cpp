@@ -42,6 +42,7 @@ void BufferedReadCallback::OnReportEnd()
         mCallback.OnError(err);
     }
 
+    mReportPayload = nullptr;
     mCallback.OnReportEnd();
 }
 
@@ -65,9 +66,9 @@ CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aR
     // To avoid that, a single contiguous buffer is the best likely approach for now.
     //
     uint32_t totalBufSize = 0;
-    for (const auto & packetBuffer : mBufferedList)
+    for (const auto & item : mBufferedList)
     {
-        totalBufSize += packetBuffer->TotalLength();
+        totalBufSize += item.mEncodedLength;
     }
 
     //
@@ -81,14 +82,9 @@ CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aR
     TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
     ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
 
-    for (auto & bufHandle : mBufferedList)
+    for (auto & item : mBufferedList)
     {
-        System::PacketBufferTLVReader reader;
-
-        reader.Init(std::move(bufHandle));
-
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), item.mReader));
     }
 
     ReturnErrorOnFailure(writer.EndContainer(outerType));
@@ -104,6 +100,35 @@ CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
 {
     System::PacketBufferTLVWriter writer;
     System::PacketBufferHandle handle;
+    TLV::TLVReader endReader;
+    uint8_t headLength;
+
+    //
+    // The reader has just been positioned on the list item, so the head of the item ends at the reader's read point,
+    // and the item ends where skipping over it leaves a copy of the reader.
+    //
+    ReturnErrorOnFailure(reader.GetElementHeadLength(headLength));
+    endReader.Init(reader);
+    ReturnErrorOnFailure(endReader.Skip());
+
+    const uint8_t * itemStart = reader.GetReadPoint() - headLength;
+    const uint8_t * itemEnd   = endReader.GetReadPoint();
+
+    //
+    // A reader without a backing store only ever reads from the buffer it was initialized with, so a reader
+    // positioned on an item within the report data message can be kept for as long as that message is retained.
+    //
+    if (reader.GetBackingStore() == nullptr && !mReportPayload.IsNull() && itemStart >= mReportPayload->Start() &&
+        itemEnd <= mReportPayload->Start() + mReportPayload->DataLength())
+    {
+        if (mBufferedPayloads.empty() || mBufferedPayloads.back()->Start() != mReportPayload->Start())
+        {
+            mBufferedPayloads.push_back(mReportPayload.Retain());
+        }
+
+        mBufferedList.push_back({ reader, static_cast<uint32_t>(itemEnd - itemStart) });
+        return CHIP_NO_ERROR;
+    }
 
     //
     // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
@@ -129,7 +154,12 @@ CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
     //
     handle.RightSize();
 
-    mBufferedList.push_back(std::move(handle));
+    TLV::TLVReader itemReader;
+    itemReader.Init(handle->Start(), handle->DataLength());
+    ReturnErrorOnFailure(itemReader.Next());
+
+    mBufferedList.push_back({ itemReader, handle->DataLength() });
+    mBufferedPayloads.push_back(std::move(handle));
 
     return CHIP_NO_ERROR;
 }
@@ -142,7 +172,7 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
         TLV::TLVType outerContainer;
 
         VerifyOrReturnError(apData->GetType() == TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
-        mBufferedList.clear();
+        ClearBufferedList();
 
         ReturnErrorOnFailure(apData->EnterContainer(outerContainer));
 
@@ -219,9 +249,9 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     mCallback.OnAttributeData(mBufferedPath, &reader, statusIB);
 
     //
-    // Clear out our buffered contents to free up allocated buffers, and reset the buffered path.
+    // Clear out our buffered contents to free up allocated and retained buffers, and reset the buffered path.
     //
-    mBufferedList.clear();
+    ClearBufferedList();
     mBufferedPath = ConcreteDataAttributePath();
     return CHIP_NO_ERROR;
 }
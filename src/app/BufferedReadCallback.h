@@ -34,6 +34,9 @@ namespace app {
  * upon completion of delivery of all chunks. This is then delivered to a compliant ReadClient::Callback
  * without any awareness on their part that chunking happened.
  *
+ * List chunks are not copied out of the report data messages they arrive in: those messages are retained
+ * until the list is delivered, and the list items are read in place when the array is reconstituted.
+ *
  */
 class BufferedReadCallback : public ReadClient::Callback
 {
@@ -68,10 +71,14 @@ private:
     //
     void OnReportBegin() override;
     void OnReportEnd() override;
+
+    // Not passed on: the lists delivered to mCallback are not read from the report data message.
+    void OnReportPayload(const System::PacketBufferHandle & aPayload) override { mReportPayload = aPayload.Retain(); }
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
     void OnError(CHIP_ERROR aError) override
     {
-        mBufferedList.clear();
+        ClearBufferedList();
+        mReportPayload = nullptr;
         return mCallback.OnError(aError);
     }
 
@@ -114,15 +121,35 @@ private:
     }
 
     /*
-     * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
-     * the reader is positioned into that buffer and add it to our buffered list for tracking.
+     * Given a reader positioned at a list element, add the list item where the reader is positioned
+     * to our buffered list for tracking. If the item lies within the report data message being processed,
+     * that message is retained and the item is read from it in place. Otherwise, a packet buffer is
+     * allocated and the item is copied into it.
      *
      * This should be called in list index order starting from the lowest index that needs to be buffered.
      *
      */
     CHIP_ERROR BufferListItem(TLV::TLVReader & reader);
+
+    void ClearBufferedList()
+    {
+        mBufferedList.clear();
+        mBufferedPayloads.clear();
+    }
+
+    struct BufferedListItem
+    {
+        // Positioned on the list item, within one of mBufferedPayloads.
+        TLV::TLVReader mReader;
+        uint32_t mEncodedLength;
+    };
+
     ConcreteDataAttributePath mBufferedPath;
-    std::vector<System::PacketBufferHandle> mBufferedList;
+    std::vector<BufferedListItem> mBufferedList;
+    // The packet buffers the buffered list items are read from.
+    std::vector<System::PacketBufferHandle> mBufferedPayloads;
+    // The report data message being processed.
+    System::PacketBufferHandle mReportPayload;
     Callback & mCallback;
 };
 
@@ -24,6 +24,10 @@
 
 namespace chip {
 
+namespace AddressResolve {
+class Resolver;
+} // namespace AddressResolve
+
 class CASEClient;
 
 struct CASEClientInitParams
@@ -35,6 +39,8 @@ struct CASEClientInitParams
     FabricTable * fabricTable                                          = nullptr;
     Credentials::GroupDataProvider * groupDataProvider                 = nullptr;
     Optional<ReliableMessageProtocolConfig> mrpLocalConfig             = Optional<ReliableMessageProtocolConfig>::Missing();
+    // Looks up the addresses of peers for OperationalSessionSetup. AddressResolve::Resolver::Instance() is used if null.
+    AddressResolve::Resolver * addressResolver                         = nullptr;
 
     CHIP_ERROR Validate() const
     {
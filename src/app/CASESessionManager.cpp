@@ -24,11 +24,21 @@ namespace chip {
 CHIP_ERROR CASESessionManager::Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params)
 {
     ReturnErrorOnFailure(params.sessionInitParams.Validate());
-    mConfig = params;
+    mConfig      = params;
+    mSystemLayer = systemLayer;
     params.sessionInitParams.exchangeMgr->GetReliableMessageMgr()->RegisterSessionUpdateDelegate(this);
     return AddressResolve::Resolver::Instance().Init(systemLayer);
 }
 
+void CASESessionManager::Shutdown()
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(KeepWarmTimerExpired, this);
+    }
+    mKeepWarmPeers = Span<const ScopedNodeId>();
+}
+
 void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
                                                 Callback::Callback<OnDeviceConnectionFailure> * onFailure
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
@@ -69,6 +79,87 @@ void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Cal
     session->Connect(onConnection, onFailure);
 }
 
+CHIP_ERROR CASESessionManager::SetKeepWarmPeers(Span<const ScopedNodeId> peers, System::Clock::Timeout checkInterval)
+{
+    VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    // A zero check interval would keep retrying unreachable peers from back-to-back timers.
+    VerifyOrReturnError(checkInterval > System::Clock::kZero, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer->CancelTimer(KeepWarmTimerExpired, this);
+    mKeepWarmPeers         = peers;
+    mKeepWarmCheckInterval = checkInterval;
+    mNextKeepWarmPeer      = 0;
+    VerifyOrReturnError(!peers.empty(), CHIP_NO_ERROR);
+
+    // If a session is being established in the background, the peers are checked again once it is done.
+    VerifyOrReturnError(!mKeepWarmSessionPending, CHIP_NO_ERROR);
+    return mSystemLayer->StartTimer(System::Clock::kZero, KeepWarmTimerExpired, this);
+}
+
+void CASESessionManager::KeepSessionsWarm()
+{
+    VerifyOrReturn(!mKeepWarmSessionPending);
+
+    for (size_t i = 0; i < mKeepWarmPeers.size(); i++)
+    {
+        const ScopedNodeId & peerId = mKeepWarmPeers[mNextKeepWarmPeer];
+        mNextKeepWarmPeer           = (mNextKeepWarmPeer + 1) % mKeepWarmPeers.size();
+
+        // Sessions being established for FindOrEstablishSession callers are left alone.
+        if (FindExistingSession(peerId).HasValue() || FindExistingSessionSetup(peerId) != nullptr)
+        {
+            continue;
+        }
+
+        ChipLogProgress(CASESessionManager, "Re-establishing session with keep-warm peer [%d:" ChipLogFormatX64 "]",
+                        peerId.GetFabricIndex(), ChipLogValueX64(peerId.GetNodeId()));
+
+        // The callbacks schedule the next check, possibly before FindOrEstablishSession returns.
+        mKeepWarmSessionPending = true;
+        FindOrEstablishSession(peerId, &mOnKeepWarmSessionConnected, &mOnKeepWarmSessionFailure);
+        return;
+    }
+
+    ScheduleKeepSessionsWarm(mKeepWarmCheckInterval);
+}
+
+void CASESessionManager::ScheduleKeepSessionsWarm(System::Clock::Timeout delay)
+{
+    VerifyOrReturn(!mKeepWarmPeers.empty());
+
+    CHIP_ERROR err = mSystemLayer->StartTimer(delay, KeepWarmTimerExpired, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(CASESessionManager, "Failed to schedule the keep-warm check: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void CASESessionManager::KeepWarmTimerExpired(System::Layer * systemLayer, void * appState)
+{
+    static_cast<CASESessionManager *>(appState)->KeepSessionsWarm();
+}
+
+void CASESessionManager::OnKeepWarmSessionConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                                    const SessionHandle & sessionHandle)
+{
+    auto * self                   = static_cast<CASESessionManager *>(context);
+    self->mKeepWarmSessionPending = false;
+
+    // Other peers may be waiting for their session to be re-established.
+    self->ScheduleKeepSessionsWarm(System::Clock::kZero);
+}
+
+void CASESessionManager::OnKeepWarmSessionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    auto * self                   = static_cast<CASESessionManager *>(context);
+    self->mKeepWarmSessionPending = false;
+
+    ChipLogError(CASESessionManager,
+                 "Failed to re-establish session with keep-warm peer [%d:" ChipLogFormatX64 "]: %" CHIP_ERROR_FORMAT,
+                 peerId.GetFabricIndex(), ChipLogValueX64(peerId.GetNodeId()), error.Format());
+    self->ScheduleKeepSessionsWarm(self->mKeepWarmCheckInterval);
+}
+
 void CASESessionManager::ReleaseSessionsForFabric(FabricIndex fabricIndex)
 {
     mConfig.sessionSetupPool->ReleaseAllSessionSetupsForFabric(fabricIndex);
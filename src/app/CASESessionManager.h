@@ -24,7 +24,9 @@
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/Pool.h>
+#include <lib/support/Span.h>
 #include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
 #include <transport/SessionDelegate.h>
 #include <transport/SessionUpdateDelegate.h>
 
@@ -48,11 +50,14 @@ struct CASESessionManagerConfig
  * 3. API to lookup an existing proxy object, or allocate a new one by triggering session establishment with the peer node.
  * 4. During session establishment, trigger node ID resolution (if needed), and update the DNS-SD cache (if resolution is
  * successful)
+ * 5. Optionally, keep sessions with a set of peers established in the background (see SetKeepWarmPeers).
  */
 class CASESessionManager : public OperationalSessionReleaseDelegate, public SessionUpdateDelegate
 {
 public:
-    CASESessionManager() = default;
+    CASESessionManager() :
+        mOnKeepWarmSessionConnected(OnKeepWarmSessionConnected, this), mOnKeepWarmSessionFailure(OnKeepWarmSessionFailure, this)
+    {}
     virtual ~CASESessionManager()
     {
         if (mConfig.sessionInitParams.Validate() == CHIP_NO_ERROR)
@@ -62,7 +67,7 @@ public:
     }
 
     CHIP_ERROR Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params);
-    void Shutdown() {}
+    void Shutdown();
 
     /**
      * Find an existing session for the given node ID, or trigger a new session
@@ -89,6 +94,23 @@ public:
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
     );
 
+    /**
+     * Keep sessions with the given peers established, so that the first command sent to one of them after a
+     * period of inactivity does not wait for address resolution and CASE.
+     *
+     * The peers are checked every checkInterval, which must not be zero. A peer that has no active CASE session,
+     * because its session was evicted, released or marked as defunct, gets one established in the background. That
+     * session is resumed if the session resumption storage still holds the previous one.
+     *
+     * Only one session is established in the background at a time, so that the OperationalSessionSetupPool remains
+     * available to FindOrEstablishSession callers. A peer that could not be reached is tried again after
+     * checkInterval at the earliest.
+     *
+     * The peers must remain valid until SetKeepWarmPeers is called again or the CASESessionManager is shut down.
+     * An empty set of peers stops keeping sessions warm.
+     */
+    CHIP_ERROR SetKeepWarmPeers(Span<const ScopedNodeId> peers, System::Clock::Timeout checkInterval);
+
     void ReleaseSessionsForFabric(FabricIndex fabricIndex);
 
     void ReleaseAllSessions();
@@ -114,7 +136,23 @@ private:
 
     Optional<SessionHandle> FindExistingSession(const ScopedNodeId & peerId) const;
 
+    void KeepSessionsWarm();
+    void ScheduleKeepSessionsWarm(System::Clock::Timeout delay);
+    static void KeepWarmTimerExpired(System::Layer * systemLayer, void * appState);
+    static void OnKeepWarmSessionConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                           const SessionHandle & sessionHandle);
+    static void OnKeepWarmSessionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error);
+
     CASESessionManagerConfig mConfig;
+    System::Layer * mSystemLayer = nullptr;
+
+    Span<const ScopedNodeId> mKeepWarmPeers;
+    System::Clock::Timeout mKeepWarmCheckInterval = System::Clock::kZero;
+    // The keep-warm peer to check first, so that an unreachable peer does not keep the others from being checked.
+    size_t mNextKeepWarmPeer     = 0;
+    bool mKeepWarmSessionPending = false;
+    Callback::Callback<OnDeviceConnected> mOnKeepWarmSessionConnected;
+    Callback::Callback<OnDeviceConnectionFailure> mOnKeepWarmSessionFailure;
 };
 
 } // namespace chip
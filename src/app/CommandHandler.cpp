@@ -24,6 +24,7 @@
 
 #include "CommandHandler.h"
 #include "InteractionModelEngine.h"
+#include "InteractionModelTimeout.h"
 #include "RequiredPrivilege.h"
 #include "messaging/ExchangeContext.h"
 
@@ -42,6 +43,13 @@ namespace chip {
 namespace app {
 using Status = Protocols::InteractionModel::Status;
 
+namespace {
+// Space kept to close the InvokeResponseIBs and the InvokeResponseMessage, whose end carries the MoreChunkedMessages flag and
+// the interaction model revision.
+constexpr uint32_t kReservedSizeForEndOfInvokeResponseMessage = 1 /* End of InvokeResponseIBs */ + 2 /* MoreChunkedMessages */ +
+    3 /* InteractionModelRevision */ + 1 /* End of InvokeResponseMessage */;
+} // anonymous namespace
+
 CommandHandler::CommandHandler(Callback * apCallback) : mExchangeCtx(*this), mpCallback(apCallback), mSuppressResponse(false) {}
 
 CHIP_ERROR CommandHandler::AllocateBuffer()
@@ -61,6 +69,8 @@ CHIP_ERROR CommandHandler::AllocateBuffer()
 
         mInvokeResponseBuilder.CreateInvokeResponses();
         ReturnErrorOnFailure(mInvokeResponseBuilder.GetError());
+
+        ReturnErrorOnFailure(mCommandMessageWriter.ReserveBuffer(kReservedSizeForEndOfInvokeResponseMessage));
         mBufferAllocated = true;
     }
 
@@ -117,19 +127,25 @@ Status CommandHandler::ProcessInvokeRequest(System::PacketBufferHandle && payloa
     invokeRequests.GetReader(&invokeRequestsReader);
 
     {
-        // We don't support handling multiple commands but the protocol is ready to support it in the future, reject all of them and
-        // IM Engine will send a status response.
+        // Requests with more commands than we can keep the CommandRefs of are rejected as a whole, and IM Engine will send a
+        // status response.
         size_t commandCount = 0;
         TLV::Utilities::Count(invokeRequestsReader, commandCount, false /* recurse */);
-        VerifyOrReturnError(commandCount == 1, Status::InvalidAction);
+        VerifyOrReturnError(commandCount > 0 && commandCount <= CHIP_CONFIG_MAX_PATHS_PER_INVOKE, Status::InvalidAction);
+
+        Status status = ValidateCommandRefs(invokeRequestsReader, commandCount);
+        VerifyOrReturnError(status == Status::Success, status);
     }
 
-    while (CHIP_NO_ERROR == (err = invokeRequestsReader.Next()))
+    for (size_t commandIndex = 0; CHIP_NO_ERROR == (err = invokeRequestsReader.Next()); commandIndex++)
     {
         VerifyOrReturnError(TLV::AnonymousTag() == invokeRequestsReader.GetTag(), Status::InvalidAction);
         CommandDataIB::Parser commandData;
         VerifyOrReturnError(commandData.Init(invokeRequestsReader) == CHIP_NO_ERROR, Status::InvalidAction);
         Status status = Status::Success;
+        // ValidateCommandRefs has recorded the commands in the order they are dispatched in.
+        VerifyOrReturnError(commandIndex < mCommandPathRefCount, Status::InvalidAction);
+        mDispatchingCommand = &mCommandPathRefs[commandIndex];
         if (mExchangeCtx->IsGroupExchangeContext())
         {
             status = ProcessGroupCommandDataIB(commandData);
@@ -138,6 +154,7 @@ Status CommandHandler::ProcessInvokeRequest(System::PacketBufferHandle && payloa
         {
             status = ProcessCommandDataIB(commandData);
         }
+        mDispatchingCommand = nullptr;
         if (status != Status::Success)
         {
             return status;
@@ -154,14 +171,113 @@ Status CommandHandler::ProcessInvokeRequest(System::PacketBufferHandle && payloa
     return Status::Success;
 }
 
+Status CommandHandler::ValidateCommandRefs(TLV::TLVReader aInvokeRequestsReader, size_t aCommandCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mCommandPathRefCount = 0;
+    while (CHIP_NO_ERROR == (err = aInvokeRequestsReader.Next()))
+    {
+        VerifyOrReturnError(mCommandPathRefCount < ArraySize(mCommandPathRefs), Status::InvalidAction);
+        CommandPathRef & commandPathRef = mCommandPathRefs[mCommandPathRefCount];
+        CommandDataIB::Parser commandData;
+        CommandPathIB::Parser commandPath;
+        uint16_t ref;
+
+        VerifyOrReturnError(commandData.Init(aInvokeRequestsReader) == CHIP_NO_ERROR, Status::InvalidAction);
+        VerifyOrReturnError(commandData.GetPath(&commandPath) == CHIP_NO_ERROR, Status::InvalidAction);
+        // Group commands have no endpoint in their path.
+        if (commandPath.GetEndpointId(&commandPathRef.mPath.mEndpointId) != CHIP_NO_ERROR)
+        {
+            commandPathRef.mPath.mEndpointId = kInvalidEndpointId;
+        }
+        VerifyOrReturnError(commandPath.GetClusterId(&commandPathRef.mPath.mClusterId) == CHIP_NO_ERROR, Status::InvalidAction);
+        VerifyOrReturnError(commandPath.GetCommandId(&commandPathRef.mPath.mCommandId) == CHIP_NO_ERROR, Status::InvalidAction);
+
+        err = commandData.GetRef(&ref);
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, Status::InvalidAction);
+        commandPathRef.mRef = (err == CHIP_NO_ERROR) ? MakeOptional(ref) : NullOptional;
+
+        // The responses to the commands of a batch are told apart by their CommandRef, so every command of the batch needs one,
+        // and no two commands may share a CommandRef or a path.
+        if (aCommandCount > 1)
+        {
+            VerifyOrReturnError(commandPathRef.mRef.HasValue(), Status::InvalidAction);
+            for (size_t i = 0; i < mCommandPathRefCount; i++)
+            {
+                VerifyOrReturnError(mCommandPathRefs[i].mRef != commandPathRef.mRef, Status::InvalidAction);
+                VerifyOrReturnError(mCommandPathRefs[i].mPath != commandPathRef.mPath, Status::InvalidAction);
+            }
+        }
+        mCommandPathRefCount++;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, Status::InvalidAction);
+    return Status::Success;
+}
+
+Optional<uint16_t> CommandHandler::GetRefForRequestPath(const ConcreteCommandPath & aCommandPath) const
+{
+    for (size_t i = 0; i < mCommandPathRefCount; i++)
+    {
+        if (mCommandPathRefs[i].mPath == aCommandPath)
+        {
+            return mCommandPathRefs[i].mRef;
+        }
+    }
+
+    // Not a request path, so this is the path of a response command.  It answers the command being dispatched, or, once the
+    // commands have all been dispatched, the only command of the request.
+    if (mDispatchingCommand != nullptr)
+    {
+        return mDispatchingCommand->mRef;
+    }
+    return (mCommandPathRefCount == 1) ? mCommandPathRefs[0].mRef : NullOptional;
+}
+
 CHIP_ERROR CommandHandler::OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PayloadHeader & aPayloadHeader,
                                              System::PacketBufferHandle && aPayload)
 {
+    if (mState == State::AwaitingChunkStatus && aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::StatusResponse))
+    {
+        CHIP_ERROR statusError = CHIP_NO_ERROR;
+        CHIP_ERROR err         = StatusResponse::ProcessStatusResponse(std::move(aPayload), statusError);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = statusError;
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = SendNextInvokeResponseMessage();
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to send command response: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+        if (err != CHIP_NO_ERROR || mState != State::AwaitingChunkStatus)
+        {
+            Close();
+        }
+        return err;
+    }
+
     ChipLogDetail(DataManagement, "CommandHandler: Unexpected message type %d", aPayloadHeader.GetMessageType());
     StatusResponse::Send(Status::InvalidAction, mExchangeCtx.Get(), false /*aExpectResponse*/);
+    if (mState == State::AwaitingChunkStatus)
+    {
+        // The rest of the response will not be sent.
+        Close();
+    }
     return CHIP_ERROR_INVALID_MESSAGE_TYPE;
 }
 
+void CommandHandler::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext)
+{
+    VerifyOrDie(mState == State::AwaitingChunkStatus);
+    ChipLogProgress(DataManagement, "Time out! failed to receive status response from Exchange: " ChipLogFormatExchange,
+                    ChipLogValueExchange(apExchangeContext));
+    Close();
+}
+
 void CommandHandler::Close()
 {
     mSuppressResponse = false;
@@ -207,6 +323,11 @@ void CommandHandler::DecrementHoldOff()
             {
                 ChipLogError(DataManagement, "Failed to send command response: %" CHIP_ERROR_FORMAT, err.Format());
             }
+            else if (mState == State::AwaitingChunkStatus)
+            {
+                // The rest of the chunks are sent as the peer acknowledges the previous ones, and we close once the last is sent.
+                return;
+            }
         }
     }
 
@@ -222,12 +343,38 @@ CHIP_ERROR CommandHandler::SendCommandResponse()
     VerifyOrReturnError(mExchangeCtx, CHIP_ERROR_INCORRECT_STATE);
 
     ReturnErrorOnFailure(Finalize(commandPacket));
-    ReturnErrorOnFailure(
-        mExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::InvokeCommandResponse, std::move(commandPacket)));
-    // The ExchangeContext is automatically freed here, and it makes mpExchangeCtx be temporarily dangling, but in
-    // all cases, we are going to call Close immediately after this function, which nulls out mpExchangeCtx.
+    if (mChunks.IsNull())
+    {
+        mChunks = std::move(commandPacket);
+    }
+    else
+    {
+        mChunks.AddToEnd(std::move(commandPacket));
+    }
+
+    return SendNextInvokeResponseMessage();
+}
+
+CHIP_ERROR CommandHandler::SendNextInvokeResponseMessage()
+{
+    VerifyOrReturnError(!mChunks.IsNull(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mExchangeCtx, CHIP_ERROR_INCORRECT_STATE);
+
+    System::PacketBufferHandle commandPacket = mChunks.PopHead();
+    bool moreChunkedMessages                 = !mChunks.IsNull();
+
+    if (moreChunkedMessages)
+    {
+        mExchangeCtx->UseSuggestedResponseTimeout(app::kExpectedIMProcessingTime);
+    }
+    ReturnErrorOnFailure(mExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::InvokeCommandResponse,
+                                                   std::move(commandPacket),
+                                                   moreChunkedMessages ? Messaging::SendMessageFlags::kExpectResponse
+                                                                       : Messaging::SendMessageFlags::kNone));
+    // After the last chunk, the ExchangeContext is automatically freed here, and it makes mpExchangeCtx be temporarily dangling,
+    // but in all cases, we are going to call Close immediately after this function, which nulls out mpExchangeCtx.
 
-    MoveToState(State::CommandSent);
+    MoveToState(moreChunkedMessages ? State::AwaitingChunkStatus : State::CommandSent);
 
     return CHIP_NO_ERROR;
 }
@@ -455,6 +602,30 @@ Status CommandHandler::ProcessGroupCommandDataIB(CommandDataIB::Parser & aComman
 }
 
 CHIP_ERROR CommandHandler::AddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus)
+{
+    // We must not be in the middle of preparing another response, which a rollback would drop.
+    VerifyOrReturnError(mState == State::Idle || mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_ERROR err = TryAddStatusInternal(aCommandPath, aStatus);
+    if (err != CHIP_NO_ERROR)
+    {
+        RollbackResponse();
+
+        // A status that does not fit after the responses to the previous commands goes in the next message.
+        if (ShouldStartNextInvokeResponseMessage(err))
+        {
+            ReturnErrorOnFailure(StartNextInvokeResponseMessage());
+            err = TryAddStatusInternal(aCommandPath, aStatus);
+            if (err != CHIP_NO_ERROR)
+            {
+                RollbackResponse();
+            }
+        }
+    }
+    return err;
+}
+
+CHIP_ERROR CommandHandler::TryAddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus)
 {
     ReturnErrorOnFailure(PrepareStatus(aCommandPath));
     CommandStatusIB::Builder & commandStatus = mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus();
@@ -481,14 +652,22 @@ CHIP_ERROR CommandHandler::AddClusterSpecificFailure(const ConcreteCommandPath &
 }
 
 CHIP_ERROR CommandHandler::PrepareCommand(const ConcreteCommandPath & aCommandPath, bool aStartDataStruct)
+{
+    return PrepareInvokeResponseCommand(GetRefForRequestPath(aCommandPath), aCommandPath, aStartDataStruct);
+}
+
+CHIP_ERROR CommandHandler::PrepareInvokeResponseCommand(const Optional<uint16_t> & aRef,
+                                                        const ConcreteCommandPath & aResponseCommandPath, bool aStartDataStruct)
 {
     ReturnErrorOnFailure(AllocateBuffer());
 
-    mInvokeResponseBuilder.Checkpoint(mBackupWriter);
     //
-    // We must not be in the middle of preparing a command, or having prepared or sent one.
+    // We must not be in the middle of preparing a command, or having sent one.
     //
-    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mState == State::Idle || mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    mInvokeResponseBuilder.Checkpoint(mBackupWriter);
+    mBackupState = mState;
+    mResponseRef = aRef;
     MoveToState(State::Preparing);
     InvokeResponseIBs::Builder & invokeResponses = mInvokeResponseBuilder.GetInvokeResponses();
     InvokeResponseIB::Builder & invokeResponse   = invokeResponses.CreateInvokeResponse();
@@ -498,7 +677,7 @@ CHIP_ERROR CommandHandler::PrepareCommand(const ConcreteCommandPath & aCommandPa
     ReturnErrorOnFailure(commandData.GetError());
     CommandPathIB::Builder & path = commandData.CreatePath();
     ReturnErrorOnFailure(commandData.GetError());
-    ReturnErrorOnFailure(path.Encode(aCommandPath));
+    ReturnErrorOnFailure(path.Encode(aResponseCommandPath));
     if (aStartDataStruct)
     {
         ReturnErrorOnFailure(commandData.GetWriter()->StartContainer(TLV::ContextTag(CommandDataIB::Tag::kFields),
@@ -516,10 +695,12 @@ CHIP_ERROR CommandHandler::FinishCommand(bool aStartDataStruct)
     {
         ReturnErrorOnFailure(commandData.GetWriter()->EndContainer(mDataElementContainerType));
     }
+    if (mResponseRef.HasValue())
+    {
+        ReturnErrorOnFailure(commandData.Ref(mResponseRef.Value()).GetError());
+    }
     ReturnErrorOnFailure(commandData.EndOfCommandDataIB());
     ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().EndOfInvokeResponseIB());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().EndOfInvokeResponses());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.EndOfInvokeResponseMessage());
     MoveToState(State::AddedCommand);
     return CHIP_NO_ERROR;
 }
@@ -528,9 +709,12 @@ CHIP_ERROR CommandHandler::PrepareStatus(const ConcreteCommandPath & aCommandPat
 {
     ReturnErrorOnFailure(AllocateBuffer());
     //
-    // We must not be in the middle of preparing a command, or having prepared or sent one.
+    // We must not be in the middle of preparing a command, or having sent one.
     //
-    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mState == State::Idle || mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    mInvokeResponseBuilder.Checkpoint(mBackupWriter);
+    mBackupState = mState;
+    mResponseRef = GetRefForRequestPath(aCommandPath);
     MoveToState(State::Preparing);
     InvokeResponseIBs::Builder & invokeResponses = mInvokeResponseBuilder.GetInvokeResponses();
     InvokeResponseIB::Builder & invokeResponse   = invokeResponses.CreateInvokeResponse();
@@ -547,10 +731,13 @@ CHIP_ERROR CommandHandler::PrepareStatus(const ConcreteCommandPath & aCommandPat
 CHIP_ERROR CommandHandler::FinishStatus()
 {
     VerifyOrReturnError(mState == State::AddingCommand, CHIP_ERROR_INCORRECT_STATE);
-    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus().EndOfCommandStatusIB());
+    CommandStatusIB::Builder & commandStatus = mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus();
+    if (mResponseRef.HasValue())
+    {
+        ReturnErrorOnFailure(commandStatus.Ref(mResponseRef.Value()).GetError());
+    }
+    ReturnErrorOnFailure(commandStatus.EndOfCommandStatusIB());
     ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().EndOfInvokeResponseIB());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().EndOfInvokeResponses());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.EndOfInvokeResponseMessage());
     MoveToState(State::AddedCommand);
     return CHIP_NO_ERROR;
 }
@@ -559,9 +746,9 @@ CHIP_ERROR CommandHandler::RollbackResponse()
 {
     VerifyOrReturnError(mState == State::Preparing || mState == State::AddingCommand, CHIP_ERROR_INCORRECT_STATE);
     mInvokeResponseBuilder.Rollback(mBackupWriter);
-    // Note: We only support one command per request, so we reset the state to Idle here, need to review the states when adding
-    // supports of having multiple requests in the same transaction.
-    MoveToState(State::Idle);
+    // The rollback may drop a response that failed to be added to the InvokeResponseIBs.
+    mInvokeResponseBuilder.GetInvokeResponses().ResetError();
+    MoveToState(mBackupState);
     return CHIP_NO_ERROR;
 }
 
@@ -615,7 +802,39 @@ CommandHandler::Handle::Handle(CommandHandler * handle)
 CHIP_ERROR CommandHandler::Finalize(System::PacketBufferHandle & commandPacket)
 {
     VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
-    return mCommandMessageWriter.Finalize(&commandPacket);
+    return FinishInvokeResponseMessage(/* aMoreChunkedMessages = */ false, commandPacket);
+}
+
+CHIP_ERROR CommandHandler::FinishInvokeResponseMessage(bool aMoreChunkedMessages, System::PacketBufferHandle & aPacket)
+{
+    ReturnErrorOnFailure(mCommandMessageWriter.UnreserveBuffer(kReservedSizeForEndOfInvokeResponseMessage));
+    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().EndOfInvokeResponses());
+    if (aMoreChunkedMessages)
+    {
+        ReturnErrorOnFailure(mInvokeResponseBuilder.MoreChunkedMessages(true).GetError());
+    }
+    ReturnErrorOnFailure(mInvokeResponseBuilder.EndOfInvokeResponseMessage());
+    return mCommandMessageWriter.Finalize(&aPacket);
+}
+
+CHIP_ERROR CommandHandler::StartNextInvokeResponseMessage()
+{
+    System::PacketBufferHandle commandPacket;
+
+    VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(FinishInvokeResponseMessage(/* aMoreChunkedMessages = */ true, commandPacket));
+    if (mChunks.IsNull())
+    {
+        mChunks = std::move(commandPacket);
+    }
+    else
+    {
+        mChunks.AddToEnd(std::move(commandPacket));
+    }
+
+    mBufferAllocated = false;
+    MoveToState(State::Idle);
+    return AllocateBuffer();
 }
 
 const char * CommandHandler::GetStateStr() const
@@ -635,6 +854,9 @@ const char * CommandHandler::GetStateStr() const
     case State::AddedCommand:
         return "AddedCommand";
 
+    case State::AwaitingChunkStatus:
+        return "AwaitingChunkStatus";
+
     case State::CommandSent:
         return "CommandSent";
 
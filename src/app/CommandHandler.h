@@ -23,6 +23,11 @@
  *      Allows adding responses to be sent in an InvokeResponse: see the various
  *      "Add*" methods.
  *
+ *      An InvokeRequest may carry up to CHIP_CONFIG_MAX_PATHS_PER_INVOKE
+ *      commands, each with its own CommandRef.  Responses carry the CommandRef
+ *      of the command they respond to, and are split into several
+ *      InvokeResponse messages when they do not fit in one.
+ *
  *      Allows adding the responses asynchronously.  See the documentation
  *      for the CommandHandler::Handle class below.
  *
@@ -32,7 +37,9 @@
 
 #include <app/ConcreteCommandPath.h>
 #include <app/data-model/Encode.h>
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPCore.h>
+#include <lib/core/Optional.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/BitFlags.h>
@@ -211,6 +218,17 @@ public:
             // The state guarantees that either we can rollback or we don't have to rollback the buffer, so we don't care about the
             // return value of RollbackResponse.
             RollbackResponse();
+
+            // A response that does not fit after the responses to the previous commands goes in the next message.
+            if (ShouldStartNextInvokeResponseMessage(err))
+            {
+                ReturnErrorOnFailure(StartNextInvokeResponseMessage());
+                err = TryAddResponseData(aRequestCommandPath, aData);
+                if (err != CHIP_NO_ERROR)
+                {
+                    RollbackResponse();
+                }
+            }
         }
         return err;
     }
@@ -298,13 +316,10 @@ private:
     CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
                                  System::PacketBufferHandle && payload) override;
 
-    void OnResponseTimeout(Messaging::ExchangeContext * ec) override
-    {
-        //
-        // We're not expecting responses to any messages we send out on this EC.
-        //
-        VerifyOrDie(false);
-    }
+    //
+    // We only expect responses to the chunks of an invoke response.
+    //
+    void OnResponseTimeout(Messaging::ExchangeContext * ec) override;
 
     enum class State
     {
@@ -312,10 +327,20 @@ private:
         Preparing,           ///< We are prepaing the command or status header.
         AddingCommand,       ///< In the process of adding a command.
         AddedCommand,        ///< A command has been completely encoded and is awaiting transmission.
+        AwaitingChunkStatus, ///< A chunk of the response has been sent, and we are waiting for a status response to send the next.
         CommandSent,         ///< The command has been sent successfully.
         AwaitingDestruction, ///< The object has completed its work and is awaiting destruction by the application.
     };
 
+    /**
+     * The CommandRef of a command in the InvokeRequest, to be echoed in the response to that command.
+     */
+    struct CommandPathRef
+    {
+        ConcreteCommandPath mPath = ConcreteCommandPath(0, 0, 0);
+        Optional<uint16_t> mRef;
+    };
+
     void MoveToState(const State aTargetState);
     const char * GetStateStr() const;
 
@@ -356,6 +381,46 @@ private:
 
     CHIP_ERROR Finalize(System::PacketBufferHandle & commandPacket);
 
+    /**
+     * Close the InvokeResponseMessage being encoded and finalize it into aPacket.
+     */
+    CHIP_ERROR FinishInvokeResponseMessage(bool aMoreChunkedMessages, System::PacketBufferHandle & aPacket);
+
+    /**
+     * Queue the InvokeResponseMessage being encoded as a chunk of the response, and start encoding the next one.
+     */
+    CHIP_ERROR StartNextInvokeResponseMessage();
+
+    /**
+     * Whether a response that failed to be encoded with aError should be retried in the next InvokeResponseMessage: it did not
+     * fit after the responses already encoded.
+     */
+    bool ShouldStartNextInvokeResponseMessage(CHIP_ERROR aError) const
+    {
+        return (aError == CHIP_ERROR_NO_MEMORY || aError == CHIP_ERROR_BUFFER_TOO_SMALL) && mState == State::AddedCommand;
+    }
+
+    /**
+     * Send the next queued InvokeResponseMessage, expecting a status response if more follow.
+     */
+    CHIP_ERROR SendNextInvokeResponseMessage();
+
+    /**
+     * Validate the CommandRefs of the commands in the InvokeRequest, and remember them for the responses.
+     */
+    Protocols::InteractionModel::Status ValidateCommandRefs(TLV::TLVReader aInvokeRequestsReader, size_t aCommandCount);
+
+    /**
+     * The CommandRef to echo in a response to the command at aCommandPath. The path may also be the path of the response
+     * command, in which case the response is for the command being dispatched, or for the only command of the request once
+     * dispatching is over.
+     */
+    Optional<uint16_t> GetRefForRequestPath(const ConcreteCommandPath & aCommandPath) const;
+
+    CHIP_ERROR PrepareInvokeResponseCommand(const Optional<uint16_t> & aRef, const ConcreteCommandPath & aResponseCommandPath,
+                                            bool aStartDataStruct);
+    CHIP_ERROR TryAddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus);
+
     /**
      * Called internally to signal the completion of all work on this object, gracefully close the
      * exchange (by calling into the base class) and finally, signal to a registerd callback that it's
@@ -389,7 +454,7 @@ private:
     CHIP_ERROR TryAddResponseData(const ConcreteCommandPath & aRequestCommandPath, const CommandData & aData)
     {
         ConcreteCommandPath path = { aRequestCommandPath.mEndpointId, aRequestCommandPath.mClusterId, CommandData::GetCommandId() };
-        ReturnErrorOnFailure(PrepareCommand(path, false));
+        ReturnErrorOnFailure(PrepareInvokeResponseCommand(GetRefForRequestPath(aRequestCommandPath), path, false));
         TLV::TLVWriter * writer = GetCommandDataIBTLVWriter();
         VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
         ReturnErrorOnFailure(DataModel::Encode(*writer, TLV::ContextTag(CommandDataIB::Tag::kFields), aData));
@@ -408,9 +473,20 @@ private:
     bool mSentStatusResponse = false;
 
     State mState = State::Idle;
+    // The state to go back to when rolling back the response being encoded.
+    State mBackupState = State::Idle;
     chip::System::PacketBufferTLVWriter mCommandMessageWriter;
     TLV::TLVWriter mBackupWriter;
     bool mBufferAllocated = false;
+
+    CommandPathRef mCommandPathRefs[CHIP_CONFIG_MAX_PATHS_PER_INVOKE];
+    size_t mCommandPathRefCount = 0;
+    // The command of the request that is being dispatched, if any.
+    const CommandPathRef * mDispatchingCommand = nullptr;
+    // The CommandRef of the response being encoded.
+    Optional<uint16_t> mResponseRef;
+    // The finalized InvokeResponseMessages that are yet to be sent, when the response is chunked.
+    System::PacketBufferHandle mChunks;
     // If mGoneAsync is true, we have finished out initial processing of the
     // incoming invoke.  After this point, our session could go away at any
     // time.
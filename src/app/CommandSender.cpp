@@ -32,6 +32,12 @@
 namespace chip {
 namespace app {
 
+namespace {
+// Space kept to close the InvokeRequests and the InvokeRequestMessage, whose end carries the interaction model revision.
+constexpr uint32_t kReservedSizeForEndOfInvokeRequestMessage =
+    1 /* End of InvokeRequests */ + 3 /* InteractionModelRevision */ + 1 /* End of InvokeRequestMessage */;
+} // anonymous namespace
+
 CommandSender::CommandSender(Callback * apCallback, Messaging::ExchangeManager * apExchangeMgr, bool aIsTimedRequest) :
     mExchangeCtx(*this), mpCallback(apCallback), mpExchangeMgr(apExchangeMgr), mSuppressResponse(false),
     mTimedRequest(aIsTimedRequest)
@@ -55,12 +61,21 @@ CHIP_ERROR CommandSender::AllocateBuffer()
         mInvokeRequestBuilder.CreateInvokeRequests();
         ReturnErrorOnFailure(mInvokeRequestBuilder.GetError());
 
+        ReturnErrorOnFailure(mCommandMessageWriter.ReserveBuffer(kReservedSizeForEndOfInvokeRequestMessage));
         mBufferAllocated = true;
     }
 
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CommandSender::SetRemoteMaxPathsPerInvoke(uint16_t aRemoteMaxPathsPerInvoke)
+{
+    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aRemoteMaxPathsPerInvoke > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    mRemoteMaxPathsPerInvoke = aRemoteMaxPathsPerInvoke;
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CommandSender::SendCommandRequest(const SessionHandle & session, Optional<System::Clock::Timeout> timeout)
 {
     VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
@@ -162,9 +177,16 @@ CHIP_ERROR CommandSender::OnMessageReceived(Messaging::ExchangeContext * apExcha
 
     if (aPayloadHeader.HasMessageType(MsgType::InvokeCommandResponse))
     {
-        err = ProcessInvokeResponse(std::move(aPayload));
+        bool moreChunkedMessages = false;
+        err                      = ProcessInvokeResponse(std::move(aPayload), moreChunkedMessages);
         SuccessOrExit(err);
         sendStatusResponse = false;
+        if (moreChunkedMessages)
+        {
+            // Acknowledge the chunk, and wait for the next one.
+            SuccessOrExit(err = StatusResponse::Send(Status::Success, apExchangeContext, true /*aExpectResponse*/));
+            MoveToState(State::CommandSent);
+        }
     }
     else if (aPayloadHeader.HasMessageType(MsgType::StatusResponse))
     {
@@ -196,12 +218,12 @@ exit:
     {
         Close();
     }
-    // Else we got a response to a Timed Request and just sent the invoke.
+    // Else we got a response to a Timed Request and just sent the invoke, or we are waiting for the next chunk of the response.
 
     return err;
 }
 
-CHIP_ERROR CommandSender::ProcessInvokeResponse(System::PacketBufferHandle && payload)
+CHIP_ERROR CommandSender::ProcessInvokeResponse(System::PacketBufferHandle && payload, bool & aMoreChunkedMessages)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader reader;
@@ -219,6 +241,12 @@ CHIP_ERROR CommandSender::ProcessInvokeResponse(System::PacketBufferHandle && pa
 
     ReturnErrorOnFailure(invokeResponseMessage.GetSuppressResponse(&suppressResponse));
     ReturnErrorOnFailure(invokeResponseMessage.GetInvokeResponses(&invokeResponses));
+
+    aMoreChunkedMessages = false;
+    err                  = invokeResponseMessage.GetMoreChunkedMessages(&aMoreChunkedMessages);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+    err = CHIP_NO_ERROR;
+
     invokeResponses.GetReader(&invokeResponsesReader);
 
     while (CHIP_NO_ERROR == (err = invokeResponsesReader.Next()))
@@ -269,6 +297,7 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
     ClusterId clusterId;
     CommandId commandId;
     EndpointId endpointId;
+    uint16_t commandRef = 0;
     // Default to success when an invoke response is received.
     StatusIB statusIB;
 
@@ -289,6 +318,10 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
             StatusIB::Parser status;
             commandStatus.GetErrorStatus(&status);
             ReturnErrorOnFailure(status.DecodeStatusIB(statusIB));
+            if (IsBatchingCommands())
+            {
+                err = commandStatus.GetRef(&commandRef);
+            }
         }
         else if (CHIP_END_OF_TLV == err)
         {
@@ -302,6 +335,16 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
             commandData.GetFields(&commandDataReader);
             err             = CHIP_NO_ERROR;
             hasDataResponse = true;
+            if (IsBatchingCommands())
+            {
+                err = commandData.GetRef(&commandRef);
+            }
+        }
+
+        // The CommandRef may only be left out of the response when a single command was sent.
+        if (CHIP_END_OF_TLV == err && IsBatchingCommands() && mCommandCount == 1)
+        {
+            err = CHIP_NO_ERROR;
         }
 
         if (err != CHIP_NO_ERROR)
@@ -328,7 +371,12 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
         }
         ReturnErrorOnFailure(err);
 
-        if (mpCallback != nullptr)
+        if (mpCallback != nullptr && IsBatchingCommands())
+        {
+            mpCallback->OnBatchResponse(this, commandRef, ConcreteCommandPath(endpointId, clusterId, commandId), statusIB,
+                                        hasDataResponse ? &commandDataReader : nullptr);
+        }
+        else if (mpCallback != nullptr)
         {
             if (statusIB.IsSuccess())
             {
@@ -349,9 +397,12 @@ CHIP_ERROR CommandSender::PrepareCommand(const CommandPathParams & aCommandPathP
     ReturnErrorOnFailure(AllocateBuffer());
 
     //
-    // We must not be in the middle of preparing a command, or having prepared or sent one.
+    // We must not be in the middle of preparing a command, or having sent one. More commands may only follow the first one
+    // when batching them.
     //
-    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mState == State::Idle || (mState == State::AddedCommand && IsBatchingCommands()),
+                        CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mCommandCount < mRemoteMaxPathsPerInvoke, CHIP_ERROR_NO_MEMORY);
     InvokeRequests::Builder & invokeRequests = mInvokeRequestBuilder.GetInvokeRequests();
     CommandDataIB::Builder & invokeRequest   = invokeRequests.CreateCommandData();
     ReturnErrorOnFailure(invokeRequests.GetError());
@@ -382,9 +433,12 @@ CHIP_ERROR CommandSender::FinishCommand(bool aEndDataStruct)
         ReturnErrorOnFailure(commandData.GetWriter()->EndContainer(mDataElementContainerType));
     }
 
+    if (IsBatchingCommands())
+    {
+        ReturnErrorOnFailure(commandData.Ref(mCommandCount).GetError());
+    }
     ReturnErrorOnFailure(commandData.EndOfCommandDataIB());
-    ReturnErrorOnFailure(mInvokeRequestBuilder.GetInvokeRequests().EndOfInvokeRequests());
-    ReturnErrorOnFailure(mInvokeRequestBuilder.EndOfInvokeRequestMessage());
+    mCommandCount++;
 
     MoveToState(State::AddedCommand);
 
@@ -419,6 +473,9 @@ CHIP_ERROR CommandSender::FinishCommand(const Optional<uint16_t> & aTimedInvokeT
 CHIP_ERROR CommandSender::Finalize(System::PacketBufferHandle & commandPacket)
 {
     VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mCommandMessageWriter.UnreserveBuffer(kReservedSizeForEndOfInvokeRequestMessage));
+    ReturnErrorOnFailure(mInvokeRequestBuilder.GetInvokeRequests().EndOfInvokeRequests());
+    ReturnErrorOnFailure(mInvokeRequestBuilder.EndOfInvokeRequestMessage());
     return mCommandMessageWriter.Finalize(&commandPacket);
 }
 
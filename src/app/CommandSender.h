@@ -97,6 +97,32 @@ public:
          */
         virtual void OnError(const CommandSender * apCommandSender, CHIP_ERROR aError) {}
 
+        /**
+         * OnBatchResponse will be called instead of OnResponse and OnError for the response to each command of a batch, once the
+         * CommandSender was allowed to send more than one command per invoke request with SetRemoteMaxPathsPerInvoke(). The
+         * responses may be received in any order, and are told apart by aCommandRef.
+         *
+         * The default implementation calls OnResponse for a successful status, and OnError otherwise.
+         *
+         * @param[in] apCommandSender The command sender object that initiated the command transaction.
+         * @param[in] aCommandRef     The index of the command in the batch, in the order the commands were added.
+         * @param[in] aPath           The command path field in invoke command response.
+         * @param[in] aStatusIB       The status of the command.
+         * @param[in] apData          The command data, will be nullptr if the server returns a StatusIB.
+         */
+        virtual void OnBatchResponse(CommandSender * apCommandSender, uint16_t aCommandRef, const ConcreteCommandPath & aPath,
+                                     const StatusIB & aStatusIB, TLV::TLVReader * apData)
+        {
+            if (aStatusIB.IsSuccess())
+            {
+                OnResponse(apCommandSender, aPath, aStatusIB, apData);
+            }
+            else
+            {
+                OnError(apCommandSender, aStatusIB.ToChipError());
+            }
+        }
+
         /**
          * OnDone will be called when CommandSender has finished all work and is safe to destroy and free the
          * allocated CommandSender object.
@@ -122,6 +148,15 @@ public:
      * If callbacks are passed the only one that will be called in a group sesttings is the onDone
      */
     CommandSender(Callback * apCallback, Messaging::ExchangeManager * apExchangeMgr, bool aIsTimedRequest = false);
+
+    /**
+     * Allow up to aRemoteMaxPathsPerInvoke commands to be added to the invoke request, which the server must support. Each command
+     * is then given a CommandRef, and the responses are delivered through Callback::OnBatchResponse.
+     *
+     * Must be called before the first command is prepared.
+     */
+    CHIP_ERROR SetRemoteMaxPathsPerInvoke(uint16_t aRemoteMaxPathsPerInvoke);
+
     CHIP_ERROR PrepareCommand(const CommandPathParams & aCommandPathParams, bool aStartDataStruct = true);
     CHIP_ERROR FinishCommand(bool aEndDataStruct = true);
     TLV::TLVWriter * GetCommandDataIBTLVWriter();
@@ -256,7 +291,7 @@ private:
      */
     void Abort();
 
-    CHIP_ERROR ProcessInvokeResponse(System::PacketBufferHandle && payload);
+    CHIP_ERROR ProcessInvokeResponse(System::PacketBufferHandle && payload, bool & aMoreChunkedMessages);
     CHIP_ERROR ProcessInvokeResponseIB(InvokeResponseIB::Parser & aInvokeResponse);
 
     // Send our queued-up Invoke Request message.  Assumes the exchange is ready
@@ -265,6 +300,8 @@ private:
 
     CHIP_ERROR Finalize(System::PacketBufferHandle & commandPacket);
 
+    bool IsBatchingCommands() const { return mRemoteMaxPathsPerInvoke > 1; }
+
     Messaging::ExchangeHolder mExchangeCtx;
     Callback * mpCallback                      = nullptr;
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
@@ -283,6 +320,10 @@ private:
     State mState = State::Idle;
     chip::System::PacketBufferTLVWriter mCommandMessageWriter;
     bool mBufferAllocated = false;
+
+    uint16_t mRemoteMaxPathsPerInvoke = 1;
+    // The number of commands added to the invoke request, which is also the CommandRef of the next one.
+    uint16_t mCommandCount = 0;
 };
 
 } // namespace app
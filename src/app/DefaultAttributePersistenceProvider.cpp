@@ -73,6 +73,81 @@ CHIP_ERROR DefaultAttributePersistenceProvider::ReadValue(const ConcreteAttribut
 
 namespace {
 
+// Parses a lowercase hex id as formatted by DefaultStorageKeyAllocator::AttributeValue, up to `terminator`.
+bool ParseKeyId(const char *& aKey, char aTerminator, uint32_t & aId)
+{
+    uint64_t id   = 0;
+    size_t digits = 0;
+    for (; *aKey != aTerminator; aKey++, digits++)
+    {
+        char c = *aKey;
+        if (c >= '0' && c <= '9')
+        {
+            id = (id << 4) | static_cast<uint64_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            id = (id << 4) | static_cast<uint64_t>(c - 'a' + 10);
+        }
+        else
+        {
+            return false;
+        }
+        VerifyOrReturnValue(digits < 8, false);
+    }
+    VerifyOrReturnValue(digits > 0, false);
+    aId = static_cast<uint32_t>(id);
+    return true;
+}
+
+class AttributeValueKeyVisitor : public PersistentStorageDelegate::KeyValueVisitor
+{
+public:
+    AttributeValueKeyVisitor(EndpointId aEndpointId, size_t aPrefixLength,
+                             AttributePersistenceProvider::AttributeValueVisitor & aVisitor) :
+        mEndpointId(aEndpointId),
+        mPrefixLength(aPrefixLength), mVisitor(aVisitor)
+    {}
+
+    CHIP_ERROR OnKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        // The remainder of the key is "<cluster>/<attribute>".  Skip anything else stored under the prefix.
+        const char * ids = key + mPrefixLength;
+        ClusterId clusterId;
+        AttributeId attributeId;
+        if (!ParseKeyId(ids, '/', clusterId))
+        {
+            return CHIP_NO_ERROR;
+        }
+        ids++;
+        if (!ParseKeyId(ids, '\0', attributeId))
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        return mVisitor.OnAttributeValue(ConcreteAttributePath(mEndpointId, clusterId, attributeId),
+                                         ByteSpan(static_cast<const uint8_t *>(value), size));
+    }
+
+private:
+    const EndpointId mEndpointId;
+    const size_t mPrefixLength;
+    AttributePersistenceProvider::AttributeValueVisitor & mVisitor;
+};
+
+} // anonymous namespace
+
+CHIP_ERROR DefaultAttributePersistenceProvider::ReadEndpointValues(EndpointId aEndpointId, AttributeValueVisitor & aVisitor)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    StorageKeyName prefix = DefaultStorageKeyAllocator::AttributeValuePrefix(aEndpointId);
+    AttributeValueKeyVisitor keyVisitor(aEndpointId, strlen(prefix.KeyName()), aVisitor);
+    return mStorage->SyncForEachKeyValueWithPrefix(prefix.KeyName(), keyVisitor);
+}
+
+namespace {
+
 AttributePersistenceProvider * gAttributeSaver = nullptr;
 
 } // anonymous namespace
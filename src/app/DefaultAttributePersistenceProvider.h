@@ -52,6 +52,7 @@ public:
     CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
+    CHIP_ERROR ReadEndpointValues(EndpointId aEndpointId, AttributeValueVisitor & aVisitor) override;
 
 protected:
     PersistentStorageDelegate * mStorage;
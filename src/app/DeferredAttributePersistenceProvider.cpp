@@ -63,6 +63,11 @@ CHIP_ERROR DeferredAttributePersistenceProvider::ReadValue(const ConcreteAttribu
     return mPersister.ReadValue(path, metadata, value);
 }
 
+CHIP_ERROR DeferredAttributePersistenceProvider::ReadEndpointValues(EndpointId endpointId, AttributeValueVisitor & visitor)
+{
+    return mPersister.ReadEndpointValues(endpointId, visitor);
+}
+
 void DeferredAttributePersistenceProvider::FlushAndScheduleNext()
 {
     const System::Clock::Timestamp now     = System::SystemClock().GetMonotonicTimestamp();
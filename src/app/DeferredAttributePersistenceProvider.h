@@ -69,6 +69,7 @@ public:
     CHIP_ERROR WriteValue(const ConcreteAttributePath & path, const ByteSpan & value) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & path, const EmberAfAttributeMetadata * metadata,
                          MutableByteSpan & value) override;
+    CHIP_ERROR ReadEndpointValues(EndpointId endpointId, AttributeValueVisitor & visitor) override;
 
 private:
     void FlushAndScheduleNext();
@@ -64,7 +64,7 @@ CHIP_ERROR InteractionModelEngine::Init(Messaging::ExchangeManager * apExchangeM
     ReturnErrorOnFailure(mpFabricTable->AddFabricDelegate(this));
     ReturnErrorOnFailure(mpExchangeMgr->RegisterUnsolicitedMessageHandlerForProtocol(Protocols::InteractionModel::Id, this));
 
-    mReportingEngine.Init();
+    ReturnErrorOnFailure(mReportingEngine.Init(mpExchangeMgr->GetSessionManager()->SystemLayer()));
     mMagic++;
 
     StatusIB::RegisterErrorFormatter();
@@ -75,6 +75,10 @@ CHIP_ERROR InteractionModelEngine::Init(Messaging::ExchangeManager * apExchangeM
 void InteractionModelEngine::Shutdown()
 {
     mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(ResumeSubscriptionsTimerCallback, this);
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(ResumeNextSubscriptionsCallback, this);
+    StopSubscriptionResumption();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
     CommandHandlerInterface * handlerIter = mCommandHandlerList;
 
@@ -1652,12 +1656,82 @@ void InteractionModelEngine::ResumeSubscriptionsTimerCallback(System::Layer * ap
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     VerifyOrReturn(apAppState != nullptr);
     InteractionModelEngine * imEngine = static_cast<InteractionModelEngine *>(apAppState);
+
+    // Subscriptions are resumed a few at a time: keep iterating over them as resumptions complete.
+    if (imEngine->mpSubscriptionResumptionIterator == nullptr)
+    {
+        imEngine->mpSubscriptionResumptionIterator = imEngine->mpSubscriptionResumptionStorage->IterateSubscriptions();
+        VerifyOrReturn(imEngine->mpSubscriptionResumptionIterator != nullptr,
+                       ChipLogError(InteractionModel, "no resource for Subscription resumption iterator"));
+    }
+    imEngine->ResumeNextSubscriptions();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+}
+
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+void InteractionModelEngine::ResumeNextSubscriptionsCallback(System::Layer * apSystemLayer, void * apAppState)
+{
+    VerifyOrReturn(apAppState != nullptr);
+    static_cast<InteractionModelEngine *>(apAppState)->ResumeNextSubscriptions();
+}
+
+void InteractionModelEngine::OnSubscriptionResumptionSessionDone()
+{
+    // The ReadHandler calling this may be in the middle of ResumeNextSubscriptions: continue from a fresh stack.
+    VerifyOrReturn(mpSubscriptionResumptionIterator != nullptr);
+    System::Layer * systemLayer = mpExchangeMgr->GetSessionManager()->SystemLayer();
+    CHIP_ERROR err              = systemLayer->ScheduleWork(ResumeNextSubscriptionsCallback, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        // The work queue is full: retry a bit later rather than leaving the remaining subscriptions unresumed.
+        ChipLogError(InteractionModel, "Failed to schedule subscription resumption: %" CHIP_ERROR_FORMAT ", retrying", err.Format());
+        err = systemLayer->StartTimer(kSubscriptionResumptionRetryDelay, ResumeNextSubscriptionsCallback, this);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(InteractionModel, "Failed to resume the remaining subscriptions: %" CHIP_ERROR_FORMAT, err.Format());
+        StopSubscriptionResumption();
+    }
+}
+
+size_t InteractionModelEngine::GetNumSubscriptionsAwaitingResumptionSession()
+{
+    size_t count = 0;
+    mReadHandlers.ForEachActiveObject([&count](ReadHandler * handler) {
+        if (handler->IsAwaitingResumptionSession())
+        {
+            count++;
+        }
+        return Loop::Continue;
+    });
+    return count;
+}
+
+void InteractionModelEngine::StopSubscriptionResumption()
+{
+    if (mpSubscriptionResumptionIterator != nullptr)
+    {
+        mpSubscriptionResumptionIterator->Release();
+        mpSubscriptionResumptionIterator = nullptr;
+    }
+}
+
+void InteractionModelEngine::ResumeNextSubscriptions()
+{
+    VerifyOrReturn(mpSubscriptionResumptionIterator != nullptr);
+
     SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
-    auto * iterator = imEngine->mpSubscriptionResumptionStorage->IterateSubscriptions();
-    while (iterator->Next(subscriptionInfo))
+    while (GetNumSubscriptionsAwaitingResumptionSession() < CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS)
     {
+        if (!mpSubscriptionResumptionIterator->Next(subscriptionInfo))
+        {
+            ChipLogProgress(InteractionModel, "All persisted subscriptions resumed");
+            StopSubscriptionResumption();
+            return;
+        }
+
         // If subscription happens between reboot and this timer callback, it's already live and should skip resumption
-        if (Loop::Break == imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        if (Loop::Break == mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
                 SubscriptionId subscriptionId;
                 handler->GetSubscriptionId(subscriptionId);
                 if (subscriptionId == subscriptionInfo.mSubscriptionId)
@@ -1673,28 +1747,26 @@ void InteractionModelEngine::ResumeSubscriptionsTimerCallback(System::Layer * ap
 
         auto requestedAttributePathCount = subscriptionInfo.mAttributePaths.AllocatedSize();
         auto requestedEventPathCount     = subscriptionInfo.mEventPaths.AllocatedSize();
-        if (!imEngine->EnsureResourceForSubscription(subscriptionInfo.mFabricIndex, requestedAttributePathCount,
-                                                     requestedEventPathCount))
+        if (!EnsureResourceForSubscription(subscriptionInfo.mFabricIndex, requestedAttributePathCount, requestedEventPathCount))
         {
             ChipLogProgress(InteractionModel, "no resource for Subscription resumption");
-            iterator->Release();
+            StopSubscriptionResumption();
             return;
         }
 
-        ReadHandler * handler = imEngine->mReadHandlers.CreateObject(*imEngine);
+        ReadHandler * handler = mReadHandlers.CreateObject(*this);
         if (handler == nullptr)
         {
             ChipLogProgress(InteractionModel, "no resource for ReadHandler creation");
-            iterator->Release();
+            StopSubscriptionResumption();
             return;
         }
 
         ChipLogProgress(InteractionModel, "Resuming subscriptionId %" PRIu32, subscriptionInfo.mSubscriptionId);
-        handler->ResumeSubscription(*imEngine->mpCASESessionMgr, subscriptionInfo);
+        handler->ResumeSubscription(*mpCASESessionMgr, subscriptionInfo);
     }
-    iterator->Release();
-#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 }
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
 } // namespace app
 } // namespace chip
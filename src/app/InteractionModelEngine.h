@@ -297,6 +297,14 @@ public:
 
     CHIP_ERROR ResumeSubscriptions();
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    /**
+     * Called by a resumed ReadHandler once the attempt to establish its CASE session is over, successful or not,
+     * so that the resumption of the remaining persisted subscriptions can continue.
+     */
+    void OnSubscriptionResumptionSessionDone();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     //
     // Get direct access to the underlying read handler pool
@@ -538,6 +546,21 @@ private:
 
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    // How long to wait before resuming more subscriptions when that work could not be scheduled right away.
+    static constexpr System::Clock::Milliseconds32 kSubscriptionResumptionRetryDelay = System::Clock::Milliseconds32(100);
+
+    static void ResumeNextSubscriptionsCallback(System::Layer * apSystemLayer, void * apAppState);
+
+    /**
+     * Resume persisted subscriptions until CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS of them are waiting
+     * for their session, or all of them have been resumed.
+     */
+    void ResumeNextSubscriptions();
+    void StopSubscriptionResumption();
+    size_t GetNumSubscriptionsAwaitingResumptionSession();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     template <typename T, size_t N>
     void ReleasePool(ObjectList<T> *& aObjectList, ObjectPool<ObjectList<T>, N> & aObjectPool);
     template <typename T, size_t N>
@@ -605,6 +628,11 @@ private:
 
     SubscriptionResumptionStorage * mpSubscriptionResumptionStorage = nullptr;
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    // Walks through the persisted subscriptions while they are being resumed.
+    SubscriptionResumptionStorage::SubscriptionInfoIterator * mpSubscriptionResumptionIterator = nullptr;
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     // A magic number for tracking values between stack Shutdown()-s and Init()-s.
     // An ObjectHandle is valid iff. its magic equals to this one.
     uint32_t mMagic = 0;
@@ -37,6 +37,7 @@ enum class Tag : uint8_t
 {
     kPath   = 0,
     kFields = 1,
+    kRef    = 2,
 };
 
 class Parser : public StructParser
@@ -66,6 +67,17 @@ public:
      *          #CHIP_END_OF_TLV if there is no such element
      */
     CHIP_ERROR GetFields(TLV::TLVReader * const apReader) const;
+
+    /**
+     *  @brief Get the reference that correlates this command with its response, when the request carries several commands.
+     *
+     *  @param [in] apRef    A pointer to apRef
+     *
+     *  @return #CHIP_NO_ERROR on success
+     *          #CHIP_ERROR_WRONG_TLV_TYPE if there is such element but it's not an unsigned integer
+     *          #CHIP_END_OF_TLV if there is no such element
+     */
+    CHIP_ERROR GetRef(uint16_t * const apRef) const;
 };
 
 class Builder : public StructBuilder
@@ -78,6 +90,15 @@ public:
      */
     CommandPathIB::Builder & CreatePath();
 
+    /**
+     *  @brief Inject the reference that correlates this command with its response into the TLV stream
+     *
+     *  @param [in] aRef The reference of the command within the invoke request
+     *
+     *  @return A reference to *this
+     */
+    CommandDataIB::Builder & Ref(const uint16_t aRef);
+
     /**
      *  @brief Mark the end of this CommandDataIB
      *
@@ -33,8 +33,9 @@ namespace app {
 namespace InvokeResponseMessage {
 enum class Tag : uint8_t
 {
-    kSuppressResponse = 0,
-    kInvokeResponses  = 1,
+    kSuppressResponse    = 0,
+    kInvokeResponses     = 1,
+    kMoreChunkedMessages = 2,
 };
 
 class Parser : public MessageParser
@@ -61,6 +62,17 @@ public:
      *          #CHIP_END_OF_TLV if there is no such element
      */
     CHIP_ERROR GetInvokeResponses(InvokeResponseIBs::Parser * const apInvokeResponses) const;
+
+    /**
+     *  @brief Get MoreChunkedMessages boolean
+     *
+     *  @param [in] apMoreChunkedMessages    A pointer to apMoreChunkedMessages
+     *
+     *  @return #CHIP_NO_ERROR on success
+     *          #CHIP_ERROR_WRONG_TLV_TYPE if there is such element but it's not a boolean
+     *          #CHIP_END_OF_TLV if there is no such element
+     */
+    CHIP_ERROR GetMoreChunkedMessages(bool * const apMoreChunkedMessages) const;
 };
 
 class Builder : public MessageBuilder
@@ -86,6 +98,15 @@ public:
      */
     InvokeResponseIBs::Builder & GetInvokeResponses() { return mInvokeResponses; }
 
+    /**
+     *  @brief This flag is set to ‘true’ when the responses do not fit in this message and more messages follow.
+     *
+     *  @param [in] aMoreChunkedMessages true if more chunked messages follow
+     *
+     *  @return A reference to *this
+     */
+    InvokeResponseMessage::Builder & MoreChunkedMessages(const bool aMoreChunkedMessages);
+
     /**
      *  @brief Mark the end of this InvokeResponseMessage
      *
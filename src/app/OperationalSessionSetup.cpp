@@ -234,7 +234,7 @@ void OperationalSessionSetup::UpdateDeviceData(const Transport::PeerAddress & ad
     // Move to the ResolvingAddress state, in case we have more results,
     // since we expect to receive results in that state.
     MoveToState(State::ResolvingAddress);
-    if (CHIP_NO_ERROR == Resolver::Instance().TryNextResult(mAddressLookupHandle))
+    if (CHIP_NO_ERROR == GetAddressResolver().TryNextResult(mAddressLookupHandle))
     {
         // No need to NotifyRetryHandlers, since we never actually
         // spent any time trying the previous result.
@@ -357,7 +357,7 @@ void OperationalSessionSetup::OnSessionEstablishmentError(CHIP_ERROR error)
         // Move to the ResolvingAddress state, in case we have more results,
         // since we expect to receive results in that state.
         MoveToState(State::ResolvingAddress);
-        if (CHIP_NO_ERROR == Resolver::Instance().TryNextResult(mAddressLookupHandle))
+        if (CHIP_NO_ERROR == GetAddressResolver().TryNextResult(mAddressLookupHandle))
         {
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
             // Our retry has already been kicked off.
@@ -430,7 +430,7 @@ OperationalSessionSetup::~OperationalSessionSetup()
 
         // Skip cancel callback since the destructor is being called, so we assume that this object is
         // obviously not used anymore
-        CHIP_ERROR err = Resolver::Instance().CancelLookup(mAddressLookupHandle, Resolver::FailureCallback::Skip);
+        CHIP_ERROR err = GetAddressResolver().CancelLookup(mAddressLookupHandle, Resolver::FailureCallback::Skip);
         if (err != CHIP_NO_ERROR)
         {
             ChipLogError(Discovery, "Lookup cancel failed: %" CHIP_ERROR_FORMAT, err.Format());
@@ -486,7 +486,7 @@ CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
 
     NodeLookupRequest request(peerId);
 
-    return Resolver::Instance().LookupNode(request, mAddressLookupHandle);
+    return GetAddressResolver().LookupNode(request, mAddressLookupHandle);
 }
 
 void OperationalSessionSetup::PerformAddressUpdate()
@@ -515,6 +515,11 @@ void OperationalSessionSetup::PerformAddressUpdate()
     }
 }
 
+Resolver & OperationalSessionSetup::GetAddressResolver() const
+{
+    return (mInitParams.addressResolver != nullptr) ? *mInitParams.addressResolver : Resolver::Instance();
+}
+
 void OperationalSessionSetup::OnNodeAddressResolved(const PeerId & peerId, const ResolveResult & result)
 {
     UpdateDeviceData(result.address, result.mrpRemoteConfig);
@@ -325,6 +325,11 @@ private:
      */
     CHIP_ERROR LookupPeerAddress();
 
+    /**
+     * The resolver of the init params, or the default one if they have none.
+     */
+    AddressResolve::Resolver & GetAddressResolver() const;
+
     /**
      * This function will set new IP address, port and MRP retransmission intervals of the device.
      */
@@ -512,8 +512,12 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload,
     SubscriptionId subscriptionId = 0;
     EventReportIBs::Parser eventReportIBs;
     AttributeReportIBs::Parser attributeReportIBs;
-    System::PacketBufferTLVReader reader;
-    reader.Init(std::move(aPayload));
+    TLV::TLVReader reader;
+
+    // The message is read in place, without a backing store, so that the readers handed to the callback stay valid for as
+    // long as the callback retains the message.
+    mpCallback.OnReportPayload(aPayload);
+    reader.Init(aPayload->Start(), aPayload->DataLength());
     err = report.Init(reader);
     SuccessOrExit(err);
 
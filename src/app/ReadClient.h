@@ -93,6 +93,18 @@ public:
          */
         virtual void OnReportEnd() {}
 
+        /**
+         * Used to hand over each report data message received in a given exchange, right before its event and attribute
+         * reports are processed.
+         *
+         * The TLVReaders passed to OnEventData and OnAttributeData, until the next report data message, read from aPayload.
+         * A callback that needs the reported data after those calls return can retain aPayload instead of copying the data
+         * out of it. The contents of aPayload must not be modified.
+         *
+         * @param[in] aPayload The report data message.
+         */
+        virtual void OnReportPayload(const System::PacketBufferHandle & aPayload) {}
+
         /**
          * Used to deliver event data received through the Read and Subscribe interactions
          *
@@ -36,6 +36,53 @@
 
 namespace chip {
 namespace app {
+
+namespace {
+
+ConcreteClusterPath GetClusterPath(const DataVersionFilter & aFilter)
+{
+    return ConcreteClusterPath(aFilter.mEndpointId, aFilter.mClusterId);
+}
+
+// The data version filters are sorted by endpoint, then by cluster.
+bool ClusterPathPrecedes(const ConcreteClusterPath & aPath, const ConcreteClusterPath & aOther)
+{
+    return aPath.mEndpointId < aOther.mEndpointId ||
+        (aPath.mEndpointId == aOther.mEndpointId && aPath.mClusterId < aOther.mClusterId);
+}
+
+ObjectList<DataVersionFilter> * SortDataVersionFilters(ObjectList<DataVersionFilter> * aList)
+{
+    VerifyOrReturnValue(aList != nullptr && aList->mpNext != nullptr, aList);
+
+    // Split the list in halves and sort them.
+    ObjectList<DataVersionFilter> * middle = aList;
+    for (auto end = aList->mpNext; end != nullptr && end->mpNext != nullptr; end = end->mpNext->mpNext)
+    {
+        middle = middle->mpNext;
+    }
+    ObjectList<DataVersionFilter> * first  = aList;
+    ObjectList<DataVersionFilter> * second = middle->mpNext;
+    middle->mpNext                         = nullptr;
+    first                                  = SortDataVersionFilters(first);
+    second                                 = SortDataVersionFilters(second);
+
+    // Merge them.
+    ObjectList<DataVersionFilter> * head   = nullptr;
+    ObjectList<DataVersionFilter> ** tail = &head;
+    while (first != nullptr && second != nullptr)
+    {
+        ObjectList<DataVersionFilter> *& next =
+            ClusterPathPrecedes(GetClusterPath(second->mValue), GetClusterPath(first->mValue)) ? second : first;
+        *tail = next;
+        tail  = &next->mpNext;
+        next  = next->mpNext;
+    }
+    *tail = (first != nullptr) ? first : second;
+    return head;
+}
+
+} // anonymous namespace
 using Status = Protocols::InteractionModel::Status;
 
 ReadHandler::ReadHandler(ManagementCallback & apCallback, Messaging::ExchangeContext * apExchangeContext,
@@ -107,7 +154,8 @@ void ReadHandler::ResumeSubscription(CASESessionManager & caseSessionManager,
     }
 
     // Ask IM engine to start CASE session with subscriber
-    ScopedNodeId peerNode = ScopedNodeId(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex);
+    ScopedNodeId peerNode      = ScopedNodeId(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex);
+    mAwaitingResumptionSession = true;
     caseSessionManager.FindOrEstablishSession(peerNode, &mOnConnectedCallback, &mOnConnectionFailureCallback);
 }
 
@@ -121,19 +169,20 @@ ReadHandler::~ReadHandler()
         appCallback->OnSubscriptionTerminated(*this);
     }
 
-    if (IsType(InteractionType::Subscribe))
-    {
-        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-            OnUnblockHoldReportCallback, this);
-
-        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-            OnRefreshSubscribeTimerSyncCallback, this);
-    }
+    InteractionModelEngine::GetInstance()->GetReportingEngine().GetReportScheduler().Unschedule(*this);
 
     if (IsAwaitingReportResponse())
     {
         InteractionModelEngine::GetInstance()->GetReportingEngine().OnReportConfirm();
     }
+
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    if (mAwaitingResumptionSession)
+    {
+        // Let the resumption of other subscriptions take the place of this one.
+        InteractionModelEngine::GetInstance()->OnSubscriptionResumptionSessionDone();
+    }
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     InteractionModelEngine::GetInstance()->ReleaseAttributePathList(mpAttributePathList);
     InteractionModelEngine::GetInstance()->ReleaseEventPathList(mpEventPathList);
     InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -330,6 +379,7 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, b
         mPreviousReportsBeginGeneration = mCurrentReportsBeginGeneration;
         ClearForceDirtyFlag();
         InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
+        mpDataVersionFilterCursor = nullptr;
     }
 
     return err;
@@ -506,7 +556,36 @@ CHIP_ERROR ReadHandler::ProcessDataVersionFilterList(DataVersionFilterIBs::Parse
     {
         err = CHIP_NO_ERROR;
     }
-    return err;
+    ReturnErrorOnFailure(err);
+    SortDataVersionFilterList();
+    return CHIP_NO_ERROR;
+}
+
+void ReadHandler::SortDataVersionFilterList()
+{
+    mpDataVersionFilterList      = SortDataVersionFilters(mpDataVersionFilterList);
+    mpDataVersionFilterCursor    = mpDataVersionFilterList;
+    mDataVersionFilterCursorPath = ConcreteClusterPath(0, 0);
+}
+
+const ObjectList<DataVersionFilter> * ReadHandler::FindDataVersionFilter(const ConcreteClusterPath & aPath)
+{
+    VerifyOrReturnValue(mpDataVersionFilterList != nullptr, nullptr);
+
+    // Start over from the first filter when the clusters are not looked up in order.
+    if (mpDataVersionFilterCursor == nullptr || ClusterPathPrecedes(aPath, mDataVersionFilterCursorPath))
+    {
+        mpDataVersionFilterCursor = mpDataVersionFilterList;
+    }
+    while (mpDataVersionFilterCursor != nullptr && ClusterPathPrecedes(GetClusterPath(mpDataVersionFilterCursor->mValue), aPath))
+    {
+        mpDataVersionFilterCursor = mpDataVersionFilterCursor->mpNext;
+    }
+    mDataVersionFilterCursorPath = aPath;
+
+    VerifyOrReturnValue(mpDataVersionFilterCursor != nullptr && GetClusterPath(mpDataVersionFilterCursor->mValue) == aPath,
+                        nullptr);
+    return mpDataVersionFilterCursor;
 }
 
 CHIP_ERROR ReadHandler::ProcessEventPaths(EventPathIBs::Parser & aEventPathsParser)
@@ -753,32 +832,22 @@ void ReadHandler::PersistSubscription()
     }
 }
 
-void ReadHandler::OnUnblockHoldReportCallback(System::Layer * apSystemLayer, void * apAppState)
+void ReadHandler::OnMinIntervalElapsed()
 {
-    VerifyOrReturn(apAppState != nullptr);
-    ReadHandler * readHandler = static_cast<ReadHandler *>(apAppState);
-    ChipLogDetail(DataManagement, "Unblock report hold after min %d seconds", readHandler->mMinIntervalFloorSeconds);
-    readHandler->ClearStateFlag(ReadHandlerFlags::HoldReport);
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-        System::Clock::Seconds16(readHandler->mMaxInterval - readHandler->mMinIntervalFloorSeconds),
-        OnRefreshSubscribeTimerSyncCallback, readHandler);
+    ChipLogDetail(DataManagement, "Unblock report hold after min %d seconds", mMinIntervalFloorSeconds);
+    ClearStateFlag(ReadHandlerFlags::HoldReport);
 }
 
-void ReadHandler::OnRefreshSubscribeTimerSyncCallback(System::Layer * apSystemLayer, void * apAppState)
+void ReadHandler::OnMaxIntervalElapsed()
 {
-    VerifyOrReturn(apAppState != nullptr);
-    ReadHandler * readHandler = static_cast<ReadHandler *>(apAppState);
-    readHandler->ClearStateFlag(ReadHandlerFlags::HoldSync);
-    ChipLogProgress(DataManagement, "Refresh subscribe timer sync after %d seconds",
-                    readHandler->mMaxInterval - readHandler->mMinIntervalFloorSeconds);
+    ClearStateFlag(ReadHandlerFlags::HoldSync);
+    ChipLogProgress(DataManagement, "Refresh subscribe timer sync after %d seconds", mMaxInterval - mMinIntervalFloorSeconds);
 }
 
 CHIP_ERROR ReadHandler::RefreshSubscribeSyncTimer()
 {
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnUnblockHoldReportCallback, this);
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnRefreshSubscribeTimerSyncCallback, this);
+    reporting::ReportScheduler & scheduler = InteractionModelEngine::GetInstance()->GetReportingEngine().GetReportScheduler();
+    scheduler.Unschedule(*this);
 
     if (!IsChunkedReport())
     {
@@ -787,8 +856,7 @@ CHIP_ERROR ReadHandler::RefreshSubscribeSyncTimer()
         SetStateFlag(ReadHandlerFlags::HoldReport);
         SetStateFlag(ReadHandlerFlags::HoldSync);
         ReturnErrorOnFailure(
-            InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-                System::Clock::Seconds16(mMinIntervalFloorSeconds), OnUnblockHoldReportCallback, this));
+            scheduler.Schedule(*this, System::Clock::Seconds16(mMinIntervalFloorSeconds), System::Clock::Seconds16(mMaxInterval)));
     }
 
     return CHIP_NO_ERROR;
@@ -870,6 +938,11 @@ void ReadHandler::HandleDeviceConnected(void * context, Messaging::ExchangeManag
 {
     ReadHandler * const _this = static_cast<ReadHandler *>(context);
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    _this->mAwaitingResumptionSession = false;
+    InteractionModelEngine::GetInstance()->OnSubscriptionResumptionSessionDone();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     _this->mSessionHandle.Grab(sessionHandle);
 
     _this->MoveToState(HandlerState::GeneratingReports);
@@ -887,6 +960,11 @@ void ReadHandler::HandleDeviceConnectionFailure(void * context, const ScopedNode
     ReadHandler * const _this = static_cast<ReadHandler *>(context);
     VerifyOrDie(_this != nullptr);
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    _this->mAwaitingResumptionSession = false;
+    InteractionModelEngine::GetInstance()->OnSubscriptionResumptionSessionDone();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     // TODO: Have a retry mechanism tied to wake interval for IC devices
     ChipLogError(DataManagement, "Failed to establish CASE for subscription-resumption with error '%" CHIP_ERROR_FORMAT "'",
                  err.Format());
@@ -39,6 +39,7 @@
 #include <app/ObjectList.h>
 #include <app/OperationalSessionSetup.h>
 #include <app/SubscriptionResumptionStorage.h>
+#include <app/reporting/ReportScheduler.h>
 #include <lib/core/CHIPCallback.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
@@ -75,7 +76,7 @@ class InteractionModelEngine;
  *         for the relevant data, and sending a reply.
  *
  */
-class ReadHandler : public Messaging::ExchangeDelegate
+class ReadHandler : public Messaging::ExchangeDelegate, public reporting::ReportScheduler::Node
 {
 public:
     using SubjectDescriptor = Access::SubjectDescriptor;
@@ -184,6 +185,15 @@ public:
     const ObjectList<EventPathParams> * GetEventPathList() const { return mpEventPathList; }
     const ObjectList<DataVersionFilter> * GetDataVersionFilterList() const { return mpDataVersionFilterList; }
 
+    /**
+     * Find the first data version filter for the cluster of aPath, or nullptr if there is none. The filters are sorted by
+     * endpoint and cluster, so any other filter for the cluster follows it.
+     *
+     * The lookup resumes where the previous one ended, so looking up the clusters in increasing order, as the paths of a
+     * report mostly are, only walks the filter list once per report.
+     */
+    const ObjectList<DataVersionFilter> * FindDataVersionFilter(const ConcreteClusterPath & aPath);
+
     void GetReportingIntervals(uint16_t & aMinInterval, uint16_t & aMaxInterval) const
     {
         aMinInterval = mMinIntervalFloorSeconds;
@@ -290,6 +300,9 @@ private:
     bool IsFromSubscriber(Messaging::ExchangeContext & apExchangeContext) const;
 
     bool IsIdle() const { return mState == HandlerState::Idle; }
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    bool IsAwaitingResumptionSession() const { return mAwaitingResumptionSession; }
+#endif
     bool IsReportable() const
     {
         // Important: Anything that changes the state IsReportable depends on in
@@ -305,6 +318,7 @@ private:
     void ResetPathIterator();
 
     CHIP_ERROR ProcessDataVersionFilterList(DataVersionFilterIBs::Parser & aDataVersionFilterListParser);
+    void SortDataVersionFilterList();
 
     // if current priority is in the middle, it has valid snapshoted last event number, it check cleaness via comparing
     // with snapshotted last event number. if current priority  is in the end, no valid
@@ -396,8 +410,8 @@ private:
      */
     void Close(CloseOptions options = CloseOptions::kDropPersistedSubscription);
 
-    static void OnUnblockHoldReportCallback(System::Layer * apSystemLayer, void * apAppState);
-    static void OnRefreshSubscribeTimerSyncCallback(System::Layer * apSystemLayer, void * apAppState);
+    void OnMinIntervalElapsed() override;
+    void OnMaxIntervalElapsed() override;
     CHIP_ERROR RefreshSubscribeSyncTimer();
     CHIP_ERROR SendSubscribeResponse();
     CHIP_ERROR ProcessSubscribeRequest(System::PacketBufferHandle && aPayload);
@@ -489,6 +503,9 @@ private:
     ObjectList<AttributePathParams> * mpAttributePathList   = nullptr;
     ObjectList<EventPathParams> * mpEventPathList           = nullptr;
     ObjectList<DataVersionFilter> * mpDataVersionFilterList = nullptr;
+    // The first data version filter that does not precede mDataVersionFilterCursorPath, the cluster of the previous lookup.
+    const ObjectList<DataVersionFilter> * mpDataVersionFilterCursor = nullptr;
+    ConcreteClusterPath mDataVersionFilterCursorPath;
 
     ManagementCallback & mManagementCallback;
 
@@ -508,6 +525,9 @@ private:
     // Callbacks to handle server-initiated session success/failure
     chip::Callback::Callback<OnDeviceConnected> mOnConnectedCallback;
     chip::Callback::Callback<OnDeviceConnectionFailure> mOnConnectionFailureCallback;
+
+    // Whether this resumed subscription is waiting for its CASE session to be established
+    bool mAwaitingResumptionSession = false;
 #endif
 };
 } // namespace app
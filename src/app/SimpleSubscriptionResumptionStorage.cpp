@@ -46,6 +46,7 @@ constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kClusterIdTag;
 constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kAttributeIdTag;
 constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kEventIdTag;
 constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kEventPathTypeTag;
+constexpr TLV::Tag SimpleSubscriptionResumptionStorage::kSubscriptionIndexTag;
 
 SimpleSubscriptionResumptionStorage::SimpleSubscriptionInfoIterator::SimpleSubscriptionInfoIterator(
     SimpleSubscriptionResumptionStorage & storage) :
@@ -111,9 +112,163 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Init(PersistentStorageDelegate *
     ReturnErrorOnFailure(mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionMaxCount().KeyName(),
                                                    &countMaxToSave, sizeof(uint16_t)));
 
+    // The index only summarizes the subscriptions stored: rebuild it from them if it is missing, unreadable, or out of sync
+    // (for instance when the subscriptions were stored by an older version, or a write was interrupted).
+    if ((LoadIndex() != CHIP_NO_ERROR) || !IsIndexConsistent())
+    {
+        ChipLogProgress(DataManagement, "Rebuilding subscription resumption index");
+        ReturnErrorOnFailure(RebuildIndex());
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SimpleSubscriptionResumptionStorage::LoadIndex()
+{
+    for (auto & entry : mIndex)
+    {
+        entry.mInUse = false;
+    }
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxIndexSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    uint16_t len   = static_cast<uint16_t>(MaxIndexSize());
+    CHIP_ERROR err = mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName(),
+                                               backingBuffer.Get(), len);
+    // No index is stored when there are no subscriptions
+    ReturnErrorCodeIf(err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(err);
+
+    TLV::ScopedBufferTLVReader reader(std::move(backingBuffer), len);
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+
+    TLV::TLVType indexContainerType;
+    ReturnErrorOnFailure(reader.EnterContainer(indexContainerType));
+
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType entryContainerType;
+        ReturnErrorOnFailure(reader.EnterContainer(entryContainerType));
+
+        uint16_t subscriptionIndex;
+        ReturnErrorOnFailure(reader.Next(kSubscriptionIndexTag));
+        ReturnErrorOnFailure(reader.Get(subscriptionIndex));
+        VerifyOrReturnError(subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        IndexEntry & entry = mIndex[subscriptionIndex];
+
+        ReturnErrorOnFailure(reader.Next(kPeerNodeIdTag));
+        ReturnErrorOnFailure(reader.Get(entry.mNodeId));
+
+        ReturnErrorOnFailure(reader.Next(kFabricIndexTag));
+        ReturnErrorOnFailure(reader.Get(entry.mFabricIndex));
+
+        ReturnErrorOnFailure(reader.Next(kSubscriptionIdTag));
+        ReturnErrorOnFailure(reader.Get(entry.mSubscriptionId));
+
+        entry.mInUse = true;
+
+        ReturnErrorOnFailure(reader.ExitContainer(entryContainerType));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(reader.ExitContainer(indexContainerType));
+
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR SimpleSubscriptionResumptionStorage::SaveIndex()
+{
+    bool empty = true;
+    for (const auto & entry : mIndex)
+    {
+        empty = empty && !entry.mInUse;
+    }
+
+    if (empty)
+    {
+        CHIP_ERROR err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName());
+        return (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) ? CHIP_NO_ERROR : err;
+    }
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxIndexSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), MaxIndexSize());
+
+    TLV::TLVType indexContainerType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, indexContainerType));
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        const IndexEntry & entry = mIndex[subscriptionIndex];
+        if (!entry.mInUse)
+        {
+            continue;
+        }
+
+        TLV::TLVType entryContainerType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, entryContainerType));
+        ReturnErrorOnFailure(writer.Put(kSubscriptionIndexTag, subscriptionIndex));
+        ReturnErrorOnFailure(writer.Put(kPeerNodeIdTag, entry.mNodeId));
+        ReturnErrorOnFailure(writer.Put(kFabricIndexTag, entry.mFabricIndex));
+        ReturnErrorOnFailure(writer.Put(kSubscriptionIdTag, entry.mSubscriptionId));
+        ReturnErrorOnFailure(writer.EndContainer(entryContainerType));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(indexContainerType));
+
+    const auto len = writer.GetLengthWritten();
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    writer.Finalize(backingBuffer);
+
+    return mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName(), backingBuffer.Get(),
+                                     static_cast<uint16_t>(len));
+}
+
+CHIP_ERROR SimpleSubscriptionResumptionStorage::RebuildIndex()
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        IndexEntry & entry = mIndex[subscriptionIndex];
+        entry.mInUse       = false;
+
+        SubscriptionInfo subscriptionInfo;
+        CHIP_ERROR err = Load(subscriptionIndex, subscriptionInfo);
+        if (err == CHIP_NO_ERROR)
+        {
+            entry.mNodeId         = subscriptionInfo.mNodeId;
+            entry.mFabricIndex    = subscriptionInfo.mFabricIndex;
+            entry.mSubscriptionId = subscriptionInfo.mSubscriptionId;
+            entry.mInUse          = true;
+        }
+        else if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            ChipLogError(DataManagement, "Failed to load subscription at index %u error %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(subscriptionIndex), err.Format());
+            Delete(subscriptionIndex);
+        }
+    }
+
+    return SaveIndex();
+}
+
+bool SimpleSubscriptionResumptionStorage::IsIndexConsistent()
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        if (mIndex[subscriptionIndex].mInUse !=
+            mStorage->SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 SubscriptionResumptionStorage::SubscriptionInfoIterator * SimpleSubscriptionResumptionStorage::IterateSubscriptions()
 {
     return mSubscriptionInfoIterators.CreateObject(*this);
@@ -135,7 +290,15 @@ uint16_t SimpleSubscriptionResumptionStorage::Count()
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Delete(uint16_t subscriptionIndex)
 {
-    return mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+    CHIP_ERROR err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+
+    if ((subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS) && mIndex[subscriptionIndex].mInUse)
+    {
+        mIndex[subscriptionIndex].mInUse = false;
+        ReturnErrorOnFailure(SaveIndex());
+    }
+
+    return err;
 }
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Load(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo)
@@ -315,33 +478,27 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(TLV::TLVWriter & writer, Su
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(SubscriptionInfo & subscriptionInfo)
 {
-    // Find empty index or duplicate if exists
+    // Find empty index or duplicate if exists, using the index rather than loading every subscription
     uint16_t subscriptionIndex;
     uint16_t firstEmptySubscriptionIndex = CHIP_IM_MAX_NUM_SUBSCRIPTIONS; // initialize to out of bounds as "not set"
     for (subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
     {
-        SubscriptionInfo currentSubscriptionInfo;
-        CHIP_ERROR err = Load(subscriptionIndex, currentSubscriptionInfo);
+        const IndexEntry & entry = mIndex[subscriptionIndex];
 
         // if empty and firstEmptySubscriptionIndex isn't set yet, then mark empty spot
-        if ((firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS) && (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
+        if ((firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS) && !entry.mInUse)
         {
             firstEmptySubscriptionIndex = subscriptionIndex;
         }
 
         // delete duplicate
-        if (err == CHIP_NO_ERROR)
+        if (entry.Matches(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex, subscriptionInfo.mSubscriptionId))
         {
-            if ((subscriptionInfo.mNodeId == currentSubscriptionInfo.mNodeId) &&
-                (subscriptionInfo.mFabricIndex == currentSubscriptionInfo.mFabricIndex) &&
-                (subscriptionInfo.mSubscriptionId == currentSubscriptionInfo.mSubscriptionId))
+            Delete(subscriptionIndex);
+            // if duplicate is the first empty spot, then also set it
+            if (firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
             {
-                Delete(subscriptionIndex);
-                // if duplicate is the first empty spot, then also set it
-                if (firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
-                {
-                    firstEmptySubscriptionIndex = subscriptionIndex;
-                }
+                firstEmptySubscriptionIndex = subscriptionIndex;
             }
         }
     }
@@ -370,7 +527,13 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(SubscriptionInfo & subscrip
         mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(firstEmptySubscriptionIndex).KeyName(),
                                   backingBuffer.Get(), static_cast<uint16_t>(len)));
 
-    return CHIP_NO_ERROR;
+    IndexEntry & entry    = mIndex[firstEmptySubscriptionIndex];
+    entry.mNodeId         = subscriptionInfo.mNodeId;
+    entry.mFabricIndex    = subscriptionInfo.mFabricIndex;
+    entry.mSubscriptionId = subscriptionInfo.mSubscriptionId;
+    entry.mInUse          = true;
+
+    return SaveIndex();
 }
 
 CHIP_ERROR SimpleSubscriptionResumptionStorage::Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId)
@@ -381,27 +544,33 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Delete(NodeId nodeId, FabricInde
     uint16_t remainingSubscriptionsCount = 0;
     for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
     {
-        SubscriptionInfo subscriptionInfo;
-        CHIP_ERROR err = Load(subscriptionIndex, subscriptionInfo);
+        IndexEntry & entry = mIndex[subscriptionIndex];
 
         // delete match
-        if (err == CHIP_NO_ERROR)
+        if (entry.Matches(nodeId, fabricIndex, subscriptionId))
         {
-            if ((nodeId == subscriptionInfo.mNodeId) && (fabricIndex == subscriptionInfo.mFabricIndex) &&
-                (subscriptionId == subscriptionInfo.mSubscriptionId))
+            subscriptionFound    = true;
+            entry.mInUse         = false;
+            CHIP_ERROR deleteErr = mStorage->SyncDeleteKeyValue(
+                DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+            if (deleteErr != CHIP_NO_ERROR)
             {
-                subscriptionFound    = true;
-                CHIP_ERROR deleteErr = Delete(subscriptionIndex);
-                if (deleteErr != CHIP_NO_ERROR)
-                {
-                    lastDeleteErr = deleteErr;
-                }
-            }
-            else
-            {
-                remainingSubscriptionsCount++;
+                lastDeleteErr = deleteErr;
             }
         }
+        else if (entry.mInUse)
+        {
+            remainingSubscriptionsCount++;
+        }
+    }
+
+    if (subscriptionFound)
+    {
+        CHIP_ERROR saveErr = SaveIndex();
+        if (saveErr != CHIP_NO_ERROR)
+        {
+            lastDeleteErr = saveErr;
+        }
     }
 
     // if there are no persisted subscriptions, the MaxCount can also be deleted
@@ -427,27 +596,40 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::DeleteAll(FabricIndex fabricInde
 {
     CHIP_ERROR deleteErr = CHIP_NO_ERROR;
 
-    uint16_t count = 0;
+    uint16_t count     = 0;
+    bool indexModified = false;
     for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
     {
-        SubscriptionInfo subscriptionInfo;
-        CHIP_ERROR err = Load(subscriptionIndex, subscriptionInfo);
+        IndexEntry & entry = mIndex[subscriptionIndex];
+        if (!entry.mInUse)
+        {
+            continue;
+        }
 
-        if (err == CHIP_NO_ERROR)
+        if (fabricIndex == entry.mFabricIndex)
         {
-            if (fabricIndex == subscriptionInfo.mFabricIndex)
+            entry.mInUse   = false;
+            indexModified  = true;
+            CHIP_ERROR err = mStorage->SyncDeleteKeyValue(
+                DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+            if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
             {
-                err = Delete(subscriptionIndex);
-                if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
-                {
-                    deleteErr = err;
-                }
-            }
-            else
-            {
-                count++;
+                deleteErr = err;
             }
         }
+        else
+        {
+            count++;
+        }
+    }
+
+    if (indexModified)
+    {
+        CHIP_ERROR err = SaveIndex();
+        if (err != CHIP_NO_ERROR)
+        {
+            deleteErr = err;
+        }
     }
 
     // if there are no persisted subscriptions, the MaxCount can also be deleted
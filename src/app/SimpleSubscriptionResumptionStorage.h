@@ -57,6 +57,11 @@ protected:
     uint16_t Count();
     CHIP_ERROR DeleteMaxCount();
 
+    CHIP_ERROR LoadIndex();
+    CHIP_ERROR SaveIndex();
+    CHIP_ERROR RebuildIndex();
+    bool IsIndexConsistent();
+
     class SimpleSubscriptionInfoIterator : public SubscriptionInfoIterator
     {
     public:
@@ -89,6 +94,14 @@ protected:
                                            sizeof(bool), MaxSubscriptionPathsSize());
     }
 
+    static constexpr size_t MaxIndexSize()
+    {
+        // An array holding the summary of every subscription
+        return TLV::EstimateStructOverhead(
+            TLV::EstimateStructOverhead(sizeof(uint16_t), MaxScopedNodeIdSize(), sizeof(SubscriptionId)) *
+            CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+    }
+
     enum class EventPathType : uint8_t
     {
         kUrgent    = 0x1,
@@ -116,6 +129,14 @@ protected:
     //         Endpoint ID
     //         Cluster ID
     //         Event ID
+    //
+    // The index is a compact snapshot of the list, used to find subscriptions without loading all their paths. It is a TLV
+    // array with an entry for each subscription stored:
+    //   Structure of: (Subscription summary)
+    //     Subscription index
+    //     Node ID
+    //     Fabric Index
+    //     Subscription ID
 
     static constexpr TLV::Tag kPeerNodeIdTag         = TLV::ContextTag(1);
     static constexpr TLV::Tag kFabricIndexTag        = TLV::ContextTag(2);
@@ -132,8 +153,23 @@ protected:
     static constexpr TLV::Tag kAttributeIdTag        = TLV::ContextTag(13);
     static constexpr TLV::Tag kEventIdTag            = TLV::ContextTag(14);
     static constexpr TLV::Tag kEventPathTypeTag      = TLV::ContextTag(16);
+    static constexpr TLV::Tag kSubscriptionIndexTag  = TLV::ContextTag(17);
+
+    struct IndexEntry
+    {
+        NodeId mNodeId;
+        SubscriptionId mSubscriptionId;
+        FabricIndex mFabricIndex;
+        bool mInUse;
+
+        bool Matches(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId) const
+        {
+            return mInUse && (mNodeId == nodeId) && (mFabricIndex == fabricIndex) && (mSubscriptionId == subscriptionId);
+        }
+    };
 
     PersistentStorageDelegate * mStorage;
+    IndexEntry mIndex[CHIP_IM_MAX_NUM_SUBSCRIPTIONS] = {};
     ObjectPool<SimpleSubscriptionInfoIterator, kIteratorsMax> mSubscriptionInfoIterators;
 };
 } // namespace app
@@ -0,0 +1,205 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteBackAttributePersistenceProvider.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <string.h>
+#include <utility>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR WriteBackCacheEntry::Set(const ConcreteAttributePath & path, const ByteSpan & value)
+{
+    // The buffer is kept across flushes and only grows, so that rewriting an attribute does not allocate. Allocate at
+    // least a byte so that empty values are cached too, and keep the current buffer if the allocation fails.
+    size_t allocationSize = value.empty() ? 1 : value.size();
+    if (mValue.AllocatedSize() < allocationSize)
+    {
+        Platform::ScopedMemoryBufferWithSize<uint8_t> buffer;
+        buffer.Alloc(allocationSize);
+        ReturnErrorCodeIf(!buffer, CHIP_ERROR_NO_MEMORY);
+        mValue = std::move(buffer);
+    }
+
+    if (!value.empty())
+    {
+        memcpy(mValue.Get(), value.data(), value.size());
+    }
+    mPath  = path;
+    mSize  = value.size();
+    mDirty = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteBackCacheEntry::Flush(AttributePersistenceProvider & persister)
+{
+    VerifyOrReturnError(mDirty, CHIP_NO_ERROR);
+    // A value that failed to be written stays dirty, to be retried by the next flush.
+    ReturnErrorOnFailure(persister.WriteValue(mPath, GetValue()));
+    mDirty = false;
+    return CHIP_NO_ERROR;
+}
+
+WriteBackAttributePersistenceProvider::~WriteBackAttributePersistenceProvider()
+{
+    if (mFlushPending)
+    {
+        mSystemLayer.CancelTimer(OnFlushTimer, this);
+    }
+}
+
+CHIP_ERROR WriteBackAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & path, const ByteSpan & value)
+{
+    WriteBackCacheEntry * entry = FindEntry(path);
+    if (entry == nullptr)
+    {
+        entry = FindFreeEntry();
+        if (entry == nullptr)
+        {
+            // Every entry is in use: write them all back to make room. Values that fail to be written keep their entry.
+            Flush();
+            entry = FindFreeEntry();
+        }
+    }
+    else
+    {
+        VerifyOrReturnError(!entry->GetValue().data_equal(value), CHIP_NO_ERROR);
+        mDirtyBytes -= entry->GetSize();
+    }
+
+    if (entry == nullptr || entry->Set(path, value) != CHIP_NO_ERROR)
+    {
+        // The value written through supersedes the one cached for the attribute, if any.
+        if (entry != nullptr)
+        {
+            entry->Discard();
+        }
+        return mPersister.WriteValue(path, value);
+    }
+    mDirtyBytes += entry->GetSize();
+
+    if (mDirtyBytes >= mFlushThreshold)
+    {
+        return Flush();
+    }
+
+    // The timer is not restarted by later writes, so that values which keep changing still get flushed.
+    if (!mFlushPending)
+    {
+        ReturnErrorOnFailure(mSystemLayer.StartTimer(mFlushDelay, OnFlushTimer, this));
+        mFlushPending = true;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteBackAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & path,
+                                                            const EmberAfAttributeMetadata * metadata, MutableByteSpan & value)
+{
+    WriteBackCacheEntry * entry = FindEntry(path);
+    if (entry == nullptr)
+    {
+        return mPersister.ReadValue(path, metadata, value);
+    }
+
+    return CopySpanToMutableSpan(entry->GetValue(), value);
+}
+
+CHIP_ERROR WriteBackAttributePersistenceProvider::ReadEndpointValues(EndpointId endpointId, AttributeValueVisitor & visitor)
+{
+    ReturnErrorOnFailure(Flush());
+    return mPersister.ReadEndpointValues(endpointId, visitor);
+}
+
+CHIP_ERROR WriteBackAttributePersistenceProvider::Flush()
+{
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+
+    mDirtyBytes = 0;
+    for (WriteBackCacheEntry & entry : mEntries)
+    {
+        CHIP_ERROR err = entry.Flush(mPersister);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to write back attribute value: %" CHIP_ERROR_FORMAT, err.Format());
+            if (firstError == CHIP_NO_ERROR)
+            {
+                firstError = err;
+            }
+            mDirtyBytes += entry.GetSize();
+        }
+    }
+
+    if (mFlushPending)
+    {
+        mSystemLayer.CancelTimer(OnFlushTimer, this);
+        mFlushPending = false;
+    }
+
+    // Retry the values that failed once the flush delay has passed again.
+    if (firstError != CHIP_NO_ERROR && mSystemLayer.StartTimer(mFlushDelay, OnFlushTimer, this) == CHIP_NO_ERROR)
+    {
+        mFlushPending = true;
+    }
+    return firstError;
+}
+
+void WriteBackAttributePersistenceProvider::Shutdown()
+{
+    Flush();
+    if (mFlushPending)
+    {
+        mSystemLayer.CancelTimer(OnFlushTimer, this);
+        mFlushPending = false;
+    }
+}
+
+void WriteBackAttributePersistenceProvider::OnFlushTimer(System::Layer * layer, void * me)
+{
+    auto * provider         = static_cast<WriteBackAttributePersistenceProvider *>(me);
+    provider->mFlushPending = false;
+    provider->Flush();
+}
+
+WriteBackCacheEntry * WriteBackAttributePersistenceProvider::FindEntry(const ConcreteAttributePath & path)
+{
+    for (WriteBackCacheEntry & entry : mEntries)
+    {
+        if (entry.Matches(path))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+WriteBackCacheEntry * WriteBackAttributePersistenceProvider::FindFreeEntry()
+{
+    for (WriteBackCacheEntry & entry : mEntries)
+    {
+        if (!entry.IsDirty())
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace app
+} // namespace chip
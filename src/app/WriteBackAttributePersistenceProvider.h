@@ -0,0 +1,136 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/AttributePersistenceProvider.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Slot of the WriteBackAttributePersistenceProvider cache, holding the latest
+ * value written to an attribute until it is flushed.
+ */
+class WriteBackCacheEntry
+{
+public:
+    bool IsDirty() const { return mDirty; }
+    bool Matches(const ConcreteAttributePath & path) const { return mDirty && mPath == path; }
+    size_t GetSize() const { return mSize; }
+    ByteSpan GetValue() const { return ByteSpan(mValue.Get(), mSize); }
+
+    CHIP_ERROR Set(const ConcreteAttributePath & path, const ByteSpan & value);
+    CHIP_ERROR Flush(AttributePersistenceProvider & persister);
+    void Discard() { mDirty = false; }
+
+private:
+    ConcreteAttributePath mPath;
+    Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+    size_t mSize = 0;
+    bool mDirty  = false;
+};
+
+/**
+ * Decorator class for the AttributePersistenceProvider implementation that
+ * caches writes to any attribute and writes them back in batches.
+ *
+ * Repeated writes to an attribute are coalesced in its cache entry, so only
+ * the latest value is written to non-volatile memory.  All the dirty entries
+ * are flushed together:
+ *
+ *   - once the oldest of them has been dirty for the flush delay, so a value
+ *     reaches non-volatile memory at most that long after it was written, even
+ *     if it keeps changing;
+ *   - as soon as the dirty values amount to the flush threshold, or every
+ *     cache entry is in use;
+ *   - on Flush() and Shutdown(), which must be called before the decorated
+ *     persister or its storage are shut down.
+ *
+ * Unlike DeferredAttributePersistenceProvider, which only defers a fixed list
+ * of attributes, this class does not need to know the fast-changing
+ * attributes in advance.  Values written but not flushed yet are lost on a
+ * power failure, so the flush delay bounds what can be lost.
+ */
+class WriteBackAttributePersistenceProvider : public AttributePersistenceProvider
+{
+public:
+    WriteBackAttributePersistenceProvider(System::Layer & systemLayer, AttributePersistenceProvider & persister,
+                                          const Span<WriteBackCacheEntry> & entries, System::Clock::Milliseconds32 flushDelay,
+                                          size_t flushThreshold) :
+        mSystemLayer(systemLayer),
+        mPersister(persister), mEntries(entries), mFlushDelay(flushDelay), mFlushThreshold(flushThreshold)
+    {}
+
+    ~WriteBackAttributePersistenceProvider() override;
+
+    /*
+     * Cache the value, replacing any value written earlier to the same
+     * attribute and not flushed yet.  If the value cannot be cached, it is
+     * written through to the decorated persister.
+     */
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & path, const ByteSpan & value) override;
+
+    /*
+     * Read the cached value of the attribute if it has one, and otherwise the
+     * value of the decorated persister.
+     */
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & path, const EmberAfAttributeMetadata * metadata,
+                         MutableByteSpan & value) override;
+
+    /*
+     * Flush the cache, then read the values of the decorated persister.
+     */
+    CHIP_ERROR ReadEndpointValues(EndpointId endpointId, AttributeValueVisitor & visitor) override;
+
+    /**
+     * Write all the dirty values to the decorated persister.  Returns the
+     * first error encountered; the values that failed stay dirty and are
+     * retried once the flush delay has passed again.
+     */
+    CHIP_ERROR Flush();
+
+    /**
+     * Flush the cache synchronously and stop the flush timer.  Values that
+     * fail to be written are not retried.
+     */
+    void Shutdown();
+
+    /**
+     * Number of bytes written but not flushed yet.
+     */
+    size_t GetDirtyBytes() const { return mDirtyBytes; }
+
+private:
+    static void OnFlushTimer(System::Layer * layer, void * me);
+
+    WriteBackCacheEntry * FindEntry(const ConcreteAttributePath & path);
+    WriteBackCacheEntry * FindFreeEntry();
+
+    System::Layer & mSystemLayer;
+    AttributePersistenceProvider & mPersister;
+    const Span<WriteBackCacheEntry> mEntries;
+    const System::Clock::Milliseconds32 mFlushDelay;
+    const size_t mFlushThreshold;
+    size_t mDirtyBytes = 0;
+    bool mFlushPending = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -135,11 +135,13 @@ function(chip_configure_data_model APP_TARGET)
         ${CHIP_APP_BASE_DIR}/util/binding-table.cpp
         ${CHIP_APP_BASE_DIR}/util/IcdMonitoringTable.cpp
         ${CHIP_APP_BASE_DIR}/util/DataModelHandler.cpp
+        ${CHIP_APP_BASE_DIR}/util/DeferredAttributeChanges.cpp
         ${CHIP_APP_BASE_DIR}/util/ember-compatibility-functions.cpp
         ${CHIP_APP_BASE_DIR}/util/error-mapping.cpp
         ${CHIP_APP_BASE_DIR}/util/generic-callback-stubs.cpp
         ${CHIP_APP_BASE_DIR}/util/message.cpp
         ${CHIP_APP_BASE_DIR}/util/privilege-storage.cpp
+        ${CHIP_APP_BASE_DIR}/util/TransitionScheduler.cpp
         ${CHIP_APP_BASE_DIR}/util/util.cpp
         ${APP_GEN_FILES}
         ${APP_TEMPLATES_GEN_FILES}
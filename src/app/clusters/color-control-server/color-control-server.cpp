@@ -19,6 +19,7 @@
 #include <app-common/zap-generated/attributes/Accessors.h>
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
+#include <app/util/TransitionScheduler.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <app/util/config.h>
@@ -42,7 +43,8 @@ void ColorControlServer::timerCallback(System::Layer *, void * callbackContext)
 
 void ColorControlServer::scheduleTimerCallbackMs(EmberEventControl * control, uint32_t delayMs)
 {
-    CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(delayMs), timerCallback, control);
+    CHIP_ERROR err =
+        app::TransitionScheduler::Instance().StartTimer(chip::System::Clock::Milliseconds32(delayMs), timerCallback, control);
 
     if (err != CHIP_NO_ERROR)
     {
@@ -52,7 +54,7 @@ void ColorControlServer::scheduleTimerCallbackMs(EmberEventControl * control, ui
 
 void ColorControlServer::cancelEndpointTimerCallback(EmberEventControl * control)
 {
-    DeviceLayer::SystemLayer().CancelTimer(timerCallback, control);
+    app::TransitionScheduler::Instance().CancelTimer(timerCallback, control);
 }
 
 void ColorControlServer::cancelEndpointTimerCallback(EndpointId endpoint)
@@ -23,6 +23,7 @@
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
+#include <app/util/TransitionScheduler.h>
 #include <app/util/af.h>
 #include <app/util/config.h>
 #include <app/util/error-mapping.h>
@@ -179,8 +180,8 @@ static uint32_t computeCallbackWaitTimeMs(CallbackScheduleState & callbackSchedu
 
 static void scheduleTimerCallbackMs(EndpointId endpoint, uint32_t delayMs)
 {
-    CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(delayMs), timerCallback,
-                                                           reinterpret_cast<void *>(static_cast<uintptr_t>(endpoint)));
+    CHIP_ERROR err = app::TransitionScheduler::Instance().StartTimer(chip::System::Clock::Milliseconds32(delayMs), timerCallback,
+                                                                     reinterpret_cast<void *>(static_cast<uintptr_t>(endpoint)));
 
     if (err != CHIP_NO_ERROR)
     {
@@ -190,7 +191,7 @@ static void scheduleTimerCallbackMs(EndpointId endpoint, uint32_t delayMs)
 
 static void cancelEndpointTimerCallback(EndpointId endpoint)
 {
-    DeviceLayer::SystemLayer().CancelTimer(timerCallback, reinterpret_cast<void *>(static_cast<uintptr_t>(endpoint)));
+    app::TransitionScheduler::Instance().CancelTimer(timerCallback, reinterpret_cast<void *>(static_cast<uintptr_t>(endpoint)));
 }
 
 static EmberAfLevelControlState * getState(EndpointId endpoint)
@@ -99,6 +99,152 @@ struct EndpointSceneCount : public PersistentData<kPersistentBufferSceneCountByt
     }
 };
 
+#if CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE > 0
+static constexpr size_t kSceneCacheSize = CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE;
+
+/**
+ * @brief Cache of decoded scenes, indexed by storage, endpoint, fabric and scene storage ID
+ *
+ * The cache is write-through: scenes are persisted first and cached once stored, and any removal from storage drops the
+ * corresponding cached scene. It is shared by all the scene tables so that a scene changed through one table is never served
+ * stale by another table using the same storage. The least recently used scene is evicted when the cache is full.
+ */
+class SceneCache
+{
+public:
+    struct CachedScene
+    {
+        PersistentStorageDelegate * storage = nullptr; // nullptr when unused
+        EndpointId endpoint_id              = kInvalidEndpointId;
+        FabricIndex fabric_index            = kUndefinedFabricIndex;
+        SceneIndex index                    = 0; // position in the fabric scene map
+        uint32_t last_use                   = 0;
+        SceneTableEntry scene;
+    };
+
+    /// @brief Finds a cached scene and marks it as recently used
+    /// @return The cached scene, nullptr if it is not in the cache
+    const CachedScene * Find(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric,
+                             const SceneStorageId & scene_id)
+    {
+        CachedScene * cached = Lookup(storage, endpoint, fabric, scene_id);
+        VerifyOrReturnValue(cached != nullptr, nullptr);
+        cached->last_use = ++mUseCounter;
+        return cached;
+    }
+
+    /// @brief Caches a scene that was just loaded from or saved to storage, replacing any previous version of it
+    void Store(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric, SceneIndex index,
+               const SceneTableEntry & scene)
+    {
+        CachedScene * cached = Lookup(storage, endpoint, fabric, scene.mStorageId);
+        if (cached == nullptr)
+        {
+            cached = &mScenes[0];
+            for (auto & candidate : mScenes)
+            {
+                if (candidate.storage == nullptr)
+                {
+                    cached = &candidate;
+                    break;
+                }
+                if (candidate.last_use < cached->last_use)
+                {
+                    cached = &candidate;
+                }
+            }
+        }
+
+        cached->storage      = storage;
+        cached->endpoint_id  = endpoint;
+        cached->fabric_index = fabric;
+        cached->index        = index;
+        cached->last_use     = ++mUseCounter;
+        cached->scene        = scene;
+    }
+
+    /// @brief Drops a scene from the cache, if present
+    void Invalidate(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric, const SceneStorageId & scene_id)
+    {
+        CachedScene * cached = Lookup(storage, endpoint, fabric, scene_id);
+        if (cached != nullptr)
+        {
+            cached->storage = nullptr;
+        }
+    }
+
+    /// @brief Drops all the scenes of a fabric, on all endpoints
+    void InvalidateFabric(PersistentStorageDelegate * storage, FabricIndex fabric)
+    {
+        for (auto & cached : mScenes)
+        {
+            if (cached.storage == storage && cached.fabric_index == fabric)
+            {
+                cached.storage = nullptr;
+            }
+        }
+    }
+
+    /// @brief Drops all the scenes persisted in the given storage
+    void Clear(PersistentStorageDelegate * storage)
+    {
+        for (auto & cached : mScenes)
+        {
+            if (cached.storage == storage)
+            {
+                cached.storage = nullptr;
+            }
+        }
+    }
+
+private:
+    CachedScene * Lookup(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric,
+                         SceneStorageId scene_id)
+    {
+        for (auto & cached : mScenes)
+        {
+            if (cached.storage == storage && cached.endpoint_id == endpoint && cached.fabric_index == fabric &&
+                scene_id == cached.scene.mStorageId)
+            {
+                return &cached;
+            }
+        }
+        return nullptr;
+    }
+
+    CachedScene mScenes[kSceneCacheSize];
+    uint32_t mUseCounter = 0;
+};
+#else
+/**
+ * @brief Stand-in for the scene cache when it is disabled, every scene is read from storage
+ */
+class SceneCache
+{
+public:
+    struct CachedScene
+    {
+        SceneIndex index;
+        SceneTableEntry scene;
+    };
+
+    const CachedScene * Find(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric,
+                             const SceneStorageId & scene_id)
+    {
+        return nullptr;
+    }
+    void Store(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric, SceneIndex index,
+               const SceneTableEntry & scene)
+    {}
+    void Invalidate(PersistentStorageDelegate * storage, EndpointId endpoint, FabricIndex fabric, const SceneStorageId & scene_id)
+    {}
+    void InvalidateFabric(PersistentStorageDelegate * storage, FabricIndex fabric) {}
+    void Clear(PersistentStorageDelegate * storage) {}
+};
+#endif // CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE > 0
+
+static SceneCache gSceneCache;
+
 // Worst case tested: Add Scene Command with EFS using the default SerializeAdd Method. This yielded a serialized scene of 212bytes
 // when using the OnOff, Level Control and Color Control as well as the maximal name length of 16 bytes. Putting 256 gives some
 // slack in case different clusters are used. Value obtained by using writer.GetLengthWritten at the end of the SceneTableData
@@ -309,6 +455,7 @@ struct FabricSceneData : public PersistentData<kPersistentFabricBufferMax>
                 ReturnErrorOnFailure(reader.Next(TLV::ContextTag(TagScene::kSceneID)));
                 ReturnErrorOnFailure(reader.Get(scene.mStorageId.mSceneId));
                 ReturnErrorOnFailure(reader.ExitContainer(sceneIdContainer));
+                gSceneCache.Invalidate(storage, endpoint_id, fabric_index, scene.mStorageId);
                 ReturnErrorOnFailure(scene.Delete(storage));
                 deleted_scenes_count++;
             }
@@ -365,7 +512,11 @@ struct FabricSceneData : public PersistentData<kPersistentFabricBufferMax>
 
         if (CHIP_NO_ERROR == err)
         {
-            return scene.Save(storage);
+            // The previous version of the scene must not be served if saving the new one fails
+            gSceneCache.Invalidate(storage, endpoint_id, fabric_index, entry.mStorageId);
+            ReturnErrorOnFailure(scene.Save(storage));
+            gSceneCache.Store(storage, endpoint_id, fabric_index, scene.index, entry);
+            return CHIP_NO_ERROR;
         }
 
         if (CHIP_ERROR_NOT_FOUND == err) // If not found, scene.index should be the first free index
@@ -401,6 +552,8 @@ struct FabricSceneData : public PersistentData<kPersistentFabricBufferMax>
                 ReturnErrorOnFailure(this->Save(storage));
                 return err;
             }
+
+            gSceneCache.Store(storage, endpoint_id, fabric_index, scene.index, entry);
         }
 
         return err;
@@ -422,6 +575,7 @@ struct FabricSceneData : public PersistentData<kPersistentFabricBufferMax>
         {
             // If Find doesn't return CHIP_NO_ERROR, the scene wasn't found, which doesn't return an error
             VerifyOrReturnValue(this->Find(scene_id, scene.index) == CHIP_NO_ERROR, CHIP_NO_ERROR);
+            gSceneCache.Invalidate(storage, endpoint_id, fabric_index, scene_id);
 
             // Update the global scene count
             EndpointSceneCount endpoint_scene_count(endpoint_id);
@@ -518,6 +672,7 @@ void DefaultSceneTableImpl::Finish()
 {
     UnregisterAllHandlers();
     mSceneEntryIterators.ReleaseAll();
+    gSceneCache.Clear(mStorage);
 }
 CHIP_ERROR DefaultSceneTableImpl::GetFabricSceneCount(FabricIndex fabric_index, uint8_t & scene_count)
 {
@@ -603,6 +758,14 @@ CHIP_ERROR DefaultSceneTableImpl::GetSceneTableEntry(FabricIndex fabric_index, S
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
 
+    // Scenes beyond the current capacity of the fabric are no longer accessible, and get deleted when the fabric data is loaded
+    const SceneCache::CachedScene * cached = gSceneCache.Find(mStorage, mEndpointId, fabric_index, scene_id);
+    if (cached != nullptr && cached->index < mMaxScenesPerFabric)
+    {
+        entry = cached->scene;
+        return CHIP_NO_ERROR;
+    }
+
     FabricSceneData fabric(mEndpointId, fabric_index, mMaxScenesPerFabric, mMaxScenesPerEndpoint);
     SceneTableData scene(mEndpointId, fabric_index);
 
@@ -621,6 +784,7 @@ CHIP_ERROR DefaultSceneTableImpl::GetSceneTableEntry(FabricIndex fabric_index, S
 
     entry.mStorageId   = scene.mStorageId;
     entry.mStorageData = scene.mStorageData;
+    gSceneCache.Store(mStorage, mEndpointId, fabric_index, scene.index, entry);
 
     return CHIP_NO_ERROR;
 }
@@ -829,6 +993,7 @@ CHIP_ERROR DefaultSceneTableImpl::RemoveFabric(FabricIndex fabric_index)
         ReturnErrorOnFailure(fabric.Delete(mStorage));
     }
 
+    gSceneCache.InvalidateFabric(mStorage, fabric_index);
     return CHIP_NO_ERROR;
 }
 
@@ -894,6 +1059,15 @@ bool DefaultSceneTableImpl::SceneEntryIteratorImpl::Next(SceneTableEntry & outpu
     {
         if (fabric.scene_map[mSceneIndex].IsValid())
         {
+            const SceneCache::CachedScene * cached =
+                gSceneCache.Find(mProvider.mStorage, mEndpoint, mFabric, fabric.scene_map[mSceneIndex]);
+            if (cached != nullptr && cached->index == mSceneIndex)
+            {
+                output = cached->scene;
+                mSceneIndex++;
+                return true;
+            }
+
             scene.index = mSceneIndex;
             VerifyOrReturnError(scene.Load(mProvider.mStorage) == CHIP_NO_ERROR, false);
             output.mStorageId   = scene.mStorageId;
@@ -146,6 +146,9 @@ private:
  * It handles the storage of scenes by their ID, GroupID and EnpointID over multiple fabrics.
  * It is meant to be used exclusively when the scene cluster is enable for at least one endpoint
  * on the device.
+ *
+ * Recently used scenes are kept decoded in a cache shared by all the instances, which is updated whenever scenes are
+ * stored or removed (see CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE). Scenes must therefore only be modified through this class.
  */
 class DefaultSceneTableImpl : public SceneTable<scenes::ExtensionFieldSetsImpl>
 {
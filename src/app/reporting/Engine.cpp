@@ -34,13 +34,17 @@ using namespace chip::Access;
 namespace chip {
 namespace app {
 namespace reporting {
-CHIP_ERROR Engine::Init()
+CHIP_ERROR Engine::Init(System::Layer * apSystemLayer)
 {
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
-    return CHIP_NO_ERROR;
+    return mReportScheduler.Init(apSystemLayer);
 }
 
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+Engine::Engine() : mEncodingCache(IsClusterDataVersionEqual) {}
+#endif
+
 void Engine::Shutdown()
 {
     // Flush out the event buffer synchronously
@@ -49,23 +53,26 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+    mEncodingCache.Clear();
+#endif
+    mReportScheduler.Shutdown();
 }
 
-bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
-                                       const ConcreteReadAttributePath & aPath)
+bool Engine::IsClusterDataVersionMatch(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath)
 {
     bool existPathMatch       = false;
     bool existVersionMismatch = false;
-    for (auto filter = aDataVersionFilterList; filter != nullptr; filter = filter->mpNext)
+    // The filters for the same cluster follow each other.
+    for (auto filter = apReadHandler->FindDataVersionFilter(aPath);
+         filter != nullptr && aPath.mEndpointId == filter->mValue.mEndpointId && aPath.mClusterId == filter->mValue.mClusterId;
+         filter = filter->mpNext)
     {
-        if (aPath.mEndpointId == filter->mValue.mEndpointId && aPath.mClusterId == filter->mValue.mClusterId)
+        existPathMatch = true;
+        if (!IsClusterDataVersionEqual(ConcreteClusterPath(filter->mValue.mEndpointId, filter->mValue.mClusterId),
+                                       filter->mValue.mDataVersion.Value()))
         {
-            existPathMatch = true;
-            if (!IsClusterDataVersionEqual(ConcreteClusterPath(filter->mValue.mEndpointId, filter->mValue.mClusterId),
-                                           filter->mValue.mDataVersion.Value()))
-            {
-                existVersionMismatch = true;
-            }
+            existVersionMismatch = true;
         }
     }
     return existPathMatch && !existVersionMismatch;
@@ -84,6 +91,49 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool a
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+bool Engine::IsReadByOtherHandler(const ReadHandler * apReadHandler, const ConcreteAttributePath & aPath)
+{
+    bool isReadByOtherHandler = false;
+    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        if (handler == apReadHandler)
+        {
+            return Loop::Continue;
+        }
+        for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+        {
+            if (object->mValue.IsAttributePathSupersetOf(aPath))
+            {
+                isReadByOtherHandler = true;
+                return Loop::Break;
+            }
+        }
+        return Loop::Continue;
+    });
+    return isReadByOtherHandler;
+}
+
+bool Engine::RetrieveSharedClusterData(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                       const ConcreteReadAttributePath & aPath)
+{
+    // Sharing the reports of an attribute read by a single ReadHandler would only add an access check and a copy.
+    VerifyOrReturnValue(IsReadByOtherHandler(apReadHandler, aPath), false);
+
+    // The reports only depend on the subject through the access it is granted and its accessing fabric.
+    const SubjectDescriptor & subjectDescriptor = apReadHandler->GetSubjectDescriptor();
+    Access::RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+    CHIP_ERROR accessErr =
+        Access::GetAccessControl().Check(subjectDescriptor, requestPath, RequiredPrivilege::ForReadAttribute(aPath));
+    VerifyOrReturnValue(accessErr == CHIP_NO_ERROR || accessErr == CHIP_ERROR_ACCESS_DENIED, false);
+
+    const bool isFabricFiltered = apReadHandler->IsFabricFiltered();
+    ReportEncodingCache::Key key(aPath, subjectDescriptor.fabricIndex, isFabricFiltered, accessErr == CHIP_NO_ERROR);
+    return mEncodingCache.TryEncode(key, aAttributeReportIBs, [&](AttributeReportIBs::Builder & aBuilder) {
+        return RetrieveClusterData(subjectDescriptor, isFabricFiltered, aBuilder, aPath, nullptr);
+    });
+}
+#endif // CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+
 static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
 {
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
@@ -161,7 +211,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             }
             else
             {
-                if (IsClusterDataVersionMatch(apReadHandler->GetDataVersionFilterList(), readPath))
+                if (IsClusterDataVersionMatch(apReadHandler, readPath))
                 {
                     continue;
                 }
@@ -182,6 +232,15 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeValueEncoder::AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+            // Reports of changes are shared with the other subscriptions reading the same attribute, unless a previous chunk
+            // already encoded part of it.
+            if (!apReadHandler->IsPriming() && !encodeState.AllowPartialData() &&
+                RetrieveSharedClusterData(apReadHandler, attributeReportIBs, pathForRetrieval))
+            {
+                continue;
+            }
+#endif
             err = RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(), attributeReportIBs,
                                       pathForRetrieval, &encodeState);
             if (err != CHIP_NO_ERROR)
@@ -808,6 +867,9 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+    mEncodingCache.Invalidate(aAttributePath);
+#endif
 
     bool intersectsInterestPath = false;
     InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject(
@@ -27,6 +27,8 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/ReportEncodingCache.h>
+#include <app/reporting/ReportScheduler.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -56,13 +58,19 @@ namespace reporting {
 class Engine
 {
 public:
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+    Engine();
+#endif
+
     /**
      * Initializes the reporting engine. Should only be called once.
      *
+     * @param[in]    apSystemLayer  The System Layer running the timer of the report scheduler.
+     *
      * @retval #CHIP_NO_ERROR On success.
      * @retval other           Was unable to retrieve data and write it into the writer.
      */
-    CHIP_ERROR Init();
+    CHIP_ERROR Init(System::Layer * apSystemLayer);
 
     void Shutdown();
 
@@ -130,6 +138,11 @@ public:
      */
     void ScheduleUrgentEventDeliverySync(Optional<FabricIndex> fabricIndex = NullOptional);
 
+    /**
+     * The scheduler of the min and max intervals of the subscriptions.
+     */
+    ReportScheduler & GetReportScheduler() { return mReportScheduler; }
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
 #endif
@@ -166,6 +179,18 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+    /**
+     * Write the reports of a dirty attribute from the reports encoded for the previous subscriptions that read it with the
+     * same access, encoding them for those to come otherwise.
+     *
+     * Returns whether the reports were written. When they were not, nothing was written and the caller encodes them. This
+     * is always the case for attributes that no other ReadHandler reads.
+     */
+    bool RetrieveSharedClusterData(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                   const ConcreteReadAttributePath & aPath);
+    bool IsReadByOtherHandler(const ReadHandler * apReadHandler, const ConcreteAttributePath & aPath);
+#endif
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
     // If version match, it means don't send, if version mismatch, it means send.
@@ -173,8 +198,7 @@ private:
     // of those will fail to match.  This function should return false if either nothing in the list matches the given
     // endpoint+cluster in the path or there is an entry in the list that matches the endpoint+cluster in the path but does not
     // match the current data version of that cluster.
-    bool IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
-                                   const ConcreteReadAttributePath & aPath);
+    bool IsClusterDataVersionMatch(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath);
 
     /**
      * Send Report via ReadHandler
@@ -226,6 +250,12 @@ private:
 
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
+    ReportScheduler mReportScheduler;
+
+#if CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+    ReportEncodingCache mEncodingCache;
+#endif
+
     /**
      * Boolean to indicate if ScheduleRun is pending. This flag is used to prevent calling ScheduleRun multiple times
      * within the same execution context to avoid applying too much pressure on platforms that use small, fixed size event queues.
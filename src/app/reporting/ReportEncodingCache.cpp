@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportEncodingCache.h>
+
+#include <app/MessageDef/AttributeDataIB.h>
+#include <app/MessageDef/AttributeReportIB.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+void ReportEncodingCache::Invalidate(const AttributePathParams & aAttributePath)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mInUse && entry.mIsCacheable && aAttributePath.IsAttributePathSupersetOf(entry.mKey.mPath))
+        {
+            Release(entry);
+        }
+    }
+}
+
+void ReportEncodingCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        Release(entry);
+    }
+}
+
+ReportEncodingCache::Entry * ReportEncodingCache::Find(const Key & aKey)
+{
+    for (auto & entry : mEntries)
+    {
+        if (!entry.mInUse || !(entry.mKey == aKey))
+        {
+            continue;
+        }
+
+        // The reports encoded for a previous data version of the cluster are stale.
+        if (entry.mHasDataVersion && !mDataVersionMatcher(entry.mKey.mPath, entry.mDataVersion))
+        {
+            Release(entry);
+            return nullptr;
+        }
+
+        entry.mLastUsed = ++mUseCount;
+        return &entry;
+    }
+    return nullptr;
+}
+
+ReportEncodingCache::Entry * ReportEncodingCache::Allocate(const Key & aKey)
+{
+    Entry * entry = &mEntries[0];
+    for (auto & candidate : mEntries)
+    {
+        if (!candidate.mInUse)
+        {
+            entry = &candidate;
+            break;
+        }
+        if (candidate.mLastUsed < entry->mLastUsed)
+        {
+            entry = &candidate;
+        }
+    }
+
+    entry->mKey            = aKey;
+    entry->mLastUsed       = ++mUseCount;
+    entry->mReportsOffset  = 0;
+    entry->mReportsLength  = 0;
+    entry->mInUse          = true;
+    entry->mIsCacheable    = true;
+    entry->mHasDataVersion = false;
+    return entry;
+}
+
+CHIP_ERROR ReportEncodingCache::Store(Entry & aEntry, TLV::TLVWriter & aWriter, AttributeReportIBs::Builder & aBuilder)
+{
+    ReturnErrorOnFailure(aBuilder.EndOfAttributeReportIBs());
+    ReturnErrorOnFailure(aWriter.Finalize());
+
+    TLV::TLVReader reader;
+    TLV::TLVType containerType;
+    CHIP_ERROR err;
+    reader.Init(aEntry.mBuffer, aWriter.GetLengthWritten());
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    // Keep the reports as they follow the head of the first one, so that they are copied in a single write.
+    aEntry.mReportsOffset = 0;
+    aEntry.mReportsLength = 0;
+    err                   = reader.Next();
+    VerifyOrReturnError(err != CHIP_END_OF_TLV, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(err);
+    VerifyOrReturnError(reader.GetType() == TLV::kTLVType_Structure && reader.GetTag() == TLV::AnonymousTag(),
+                        CHIP_ERROR_WRONG_TLV_TYPE);
+    aEntry.mReportsOffset = static_cast<uint16_t>(reader.GetReadPoint() - aEntry.mBuffer);
+
+    // Remember the data version the reports were encoded for, if they carry data rather than a status.
+    do
+    {
+        AttributeReportIB::Parser report;
+        AttributeDataIB::Parser data;
+        ReturnErrorOnFailure(report.Init(reader));
+        if (!aEntry.mHasDataVersion && report.GetAttributeData(&data) == CHIP_NO_ERROR &&
+            data.GetDataVersion(&aEntry.mDataVersion) == CHIP_NO_ERROR)
+        {
+            aEntry.mHasDataVersion = true;
+        }
+    } while ((err = reader.Next()) == CHIP_NO_ERROR);
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(reader.ExitContainer(containerType));
+
+    // The reports end right before the end of the AttributeReportIBs container.
+    aEntry.mReportsLength = static_cast<uint16_t>(reader.GetReadPoint() - aEntry.mBuffer - 1 - aEntry.mReportsOffset);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReportEncodingCache::Copy(const Entry & aEntry, AttributeReportIBs::Builder & aAttributeReportIBs)
+{
+    VerifyOrReturnError(aEntry.mIsCacheable, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aEntry.mReportsOffset != 0, CHIP_NO_ERROR);
+
+    TLV::TLVWriter * writer = aAttributeReportIBs.GetWriter();
+    VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // The head of the first report is written anew, followed by the rest of the reports as they were encoded.
+    TLV::TLVWriter backup;
+    aAttributeReportIBs.Checkpoint(backup);
+    CHIP_ERROR err = writer->PutPreEncodedContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure,
+                                                    aEntry.mBuffer + aEntry.mReportsOffset, aEntry.mReportsLength);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Leave no partial report behind.
+        aAttributeReportIBs.Rollback(backup);
+    }
+    return err;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,181 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the cache of the encoded attribute reports shared by the
+ *      subscriptions served by the reporting engine.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <app/util/basic-types.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/TLV.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+static_assert(CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRIES > 0, "The report encoding cache needs at least one entry");
+
+/**
+ * Keeps the AttributeReportIBs encoded for the dirty attributes, so that the reports of an attribute are read from the
+ * data model and encoded once, then copied into the report of every subscription that reads the attribute with the same
+ * access.
+ *
+ * The encoded reports of an attribute are reused as long as the data version of its cluster does not change and the
+ * attribute is not marked dirty again. The reports too large for an entry are not cached: the entry then only records
+ * that the reports must be encoded for each subscription, and is kept until it is evicted, so that they are not encoded
+ * into the cache again after every change.
+ */
+class ReportEncodingCache
+{
+public:
+    /**
+     * Checks whether the cluster has the given data version.
+     */
+    using DataVersionMatcher = bool (*)(const ConcreteClusterPath & aPath, DataVersion aVersion);
+
+    /**
+     * Everything the encoded reports of an attribute depend on, besides its value.
+     */
+    struct Key
+    {
+        Key() {}
+        Key(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered, bool aIsAccessAllowed) :
+            mPath(aPath), mAccessingFabricIndex(aAccessingFabricIndex), mIsFabricFiltered(aIsFabricFiltered),
+            mIsAccessAllowed(aIsAccessAllowed)
+        {}
+
+        bool operator==(const Key & aOther) const
+        {
+            return mPath == aOther.mPath && mPath.mExpanded == aOther.mPath.mExpanded &&
+                mAccessingFabricIndex == aOther.mAccessingFabricIndex && mIsFabricFiltered == aOther.mIsFabricFiltered &&
+                mIsAccessAllowed == aOther.mIsAccessAllowed;
+        }
+
+        ConcreteAttributePath mPath;
+        FabricIndex mAccessingFabricIndex = kUndefinedFabricIndex;
+        bool mIsFabricFiltered            = false;
+        bool mIsAccessAllowed             = false;
+    };
+
+    explicit ReportEncodingCache(DataVersionMatcher aDataVersionMatcher) : mDataVersionMatcher(aDataVersionMatcher) {}
+
+    ReportEncodingCache(const ReportEncodingCache &)             = delete;
+    ReportEncodingCache & operator=(const ReportEncodingCache &) = delete;
+
+    /**
+     * Write the reports of the attribute into aAttributeReportIBs, calling aEncode to encode them unless they are cached.
+     *
+     * aEncode is called as `CHIP_ERROR aEncode(AttributeReportIBs::Builder & aBuilder)`, and must encode the complete
+     * reports of the attribute into aBuilder, without any encoding state from a previous chunk.
+     *
+     * @retval true  The reports were written.
+     * @retval false Nothing was written: the reports cannot be cached, they failed to encode, or they do not fit in
+     *               aAttributeReportIBs. The caller is expected to encode them itself.
+     */
+    template <typename EncodeFunction>
+    bool TryEncode(const Key & aKey, AttributeReportIBs::Builder & aAttributeReportIBs, EncodeFunction && aEncode)
+    {
+        Entry * entry       = Find(aKey);
+        const bool isCached = (entry != nullptr);
+        if (!isCached)
+        {
+            entry = Allocate(aKey);
+
+            TLV::TLVWriter writer;
+            AttributeReportIBs::Builder builder;
+            writer.Init(entry->mBuffer, sizeof(entry->mBuffer));
+            CHIP_ERROR err = builder.Init(&writer);
+            if (err == CHIP_NO_ERROR)
+            {
+                err = aEncode(builder);
+            }
+            if (err == CHIP_NO_ERROR)
+            {
+                err = Store(*entry, writer, builder);
+            }
+            if (err != CHIP_NO_ERROR)
+            {
+                // Only failing to fit in the entry is expected to happen again for this attribute.
+                if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+                {
+                    entry->mIsCacheable = false;
+                }
+                else
+                {
+                    Release(*entry);
+                }
+                return false;
+            }
+        }
+        VerifyOrReturnValue(Copy(*entry, aAttributeReportIBs) == CHIP_NO_ERROR, false);
+        mHitCount += isCached ? 1 : 0;
+        return true;
+    }
+
+    /**
+     * Drop the reports of the attributes within the path, as their value changed. Which attributes are too large to be
+     * cached is remembered.
+     */
+    void Invalidate(const AttributePathParams & aAttributePath);
+
+    /**
+     * Drop the reports of every attribute.
+     */
+    void Clear();
+
+    /**
+     * Number of times the reports of an attribute were written from the cache.
+     */
+    uint32_t GetHitCount() const { return mHitCount; }
+
+private:
+    struct Entry
+    {
+        Key mKey;
+        DataVersion mDataVersion = 0;
+        uint32_t mLastUsed       = 0;
+        uint16_t mReportsOffset  = 0;
+        uint16_t mReportsLength  = 0;
+        bool mInUse              = false;
+        bool mIsCacheable        = false;
+        bool mHasDataVersion     = false;
+        uint8_t mBuffer[CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRY_SIZE];
+    };
+
+    Entry * Find(const Key & aKey);
+    Entry * Allocate(const Key & aKey);
+    void Release(Entry & aEntry) { aEntry.mInUse = false; }
+    CHIP_ERROR Store(Entry & aEntry, TLV::TLVWriter & aWriter, AttributeReportIBs::Builder & aBuilder);
+    CHIP_ERROR Copy(const Entry & aEntry, AttributeReportIBs::Builder & aAttributeReportIBs);
+
+    const DataVersionMatcher mDataVersionMatcher;
+    Entry mEntries[CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRIES];
+    uint32_t mUseCount = 0;
+    uint32_t mHitCount = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
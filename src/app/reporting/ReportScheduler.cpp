@@ -0,0 +1,198 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+CHIP_ERROR ReportScheduler::Init(System::Layer * apSystemLayer)
+{
+    VerifyOrReturnError(apSystemLayer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    mpSystemLayer = apSystemLayer;
+    mTimerArmed   = false;
+    mTickCount    = 0;
+    return CHIP_NO_ERROR;
+}
+
+void ReportScheduler::Shutdown()
+{
+    while (!mNodes.Empty())
+    {
+        mNodes.Remove(&*mNodes.begin());
+    }
+
+    if (mpSystemLayer != nullptr)
+    {
+        mpSystemLayer->CancelTimer(OnTick, this);
+    }
+    mpSystemLayer = nullptr;
+    mTimerArmed   = false;
+}
+
+CHIP_ERROR ReportScheduler::Schedule(Node & aNode, System::Clock::Milliseconds32 aMinInterval,
+                                     System::Clock::Milliseconds32 aMaxInterval)
+{
+    VerifyOrReturnError(mpSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aMinInterval <= aMaxInterval, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (aNode.IsInList())
+    {
+        mNodes.Remove(&aNode);
+    }
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    aNode.mMinDeadline                 = now + aMinInterval;
+    aNode.mMaxDeadline                 = now + aMaxInterval;
+    aNode.mMinIntervalElapsed          = false;
+    Insert(aNode);
+
+    if (!mInTick)
+    {
+        ArmTimer();
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ReportScheduler::Unschedule(Node & aNode)
+{
+    VerifyOrReturn(aNode.IsInList());
+    mNodes.Remove(&aNode);
+
+    if (!mInTick)
+    {
+        ArmTimer();
+    }
+}
+
+void ReportScheduler::OnTick(System::Layer * apSystemLayer, void * apAppState)
+{
+    auto * scheduler = static_cast<ReportScheduler *>(apAppState);
+
+    scheduler->mTickCount++;
+    scheduler->mTimerArmed = false;
+    scheduler->mInTick     = true;
+    scheduler->RunDueNodes();
+    scheduler->mInTick = false;
+    scheduler->ArmTimer();
+}
+
+void ReportScheduler::Insert(Node & aNode)
+{
+    // New deadlines are usually the latest ones, so look for the insertion point from the back of the queue.
+    const System::Clock::Timestamp deadline = aNode.NextDeadline();
+    auto position                           = mNodes.end();
+    while (position != mNodes.begin())
+    {
+        auto previous = position;
+        --previous;
+        if (previous->NextDeadline() <= deadline)
+        {
+            break;
+        }
+        position = previous;
+    }
+    mNodes.InsertBefore(position, &aNode);
+}
+
+void ReportScheduler::RunDueNodes()
+{
+    const System::Clock::Timestamp now     = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timestamp horizon = now + mCoalescingWindow;
+
+    // Select the due nodes first, as the callbacks may schedule or unschedule nodes. A node scheduled anew or unscheduled
+    // by a previous callback leaves the list of due nodes, and is not notified.
+    IntrusiveList<Node> due;
+    auto it = mNodes.begin();
+    while (it != mNodes.end() && it->NextDeadline() <= horizon)
+    {
+        Node & node = *it;
+        ++it;
+
+        // A max interval may end early to coalesce empty reports, but only once the min interval elapsed.
+        node.mMinIntervalDue = !node.mMinIntervalElapsed && node.mMinDeadline <= now;
+        node.mMaxIntervalDue = (node.mMinIntervalElapsed || node.mMinIntervalDue) && node.mMaxDeadline <= horizon;
+        if (node.mMinIntervalDue || node.mMaxIntervalDue)
+        {
+            mNodes.Remove(&node);
+            due.PushBack(&node);
+        }
+    }
+
+    while (!due.Empty())
+    {
+        Node & node = *due.begin();
+        due.Remove(&node);
+
+        if (!node.mMaxIntervalDue)
+        {
+            node.mMinIntervalElapsed = true;
+            Insert(node);
+        }
+
+        if (node.mMinIntervalDue)
+        {
+            node.OnMinIntervalElapsed();
+        }
+        if (node.mMaxIntervalDue)
+        {
+            node.OnMaxIntervalElapsed();
+        }
+    }
+}
+
+void ReportScheduler::ArmTimer()
+{
+    VerifyOrReturn(mpSystemLayer != nullptr);
+
+    if (mNodes.Empty())
+    {
+        if (mTimerArmed)
+        {
+            mpSystemLayer->CancelTimer(OnTick, this);
+            mTimerArmed = false;
+        }
+        return;
+    }
+
+    const System::Clock::Timestamp deadline = mNodes.begin()->NextDeadline();
+    if (mTimerArmed && mArmedDeadline == deadline)
+    {
+        return;
+    }
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timeout delay =
+        (deadline > now) ? std::chrono::duration_cast<System::Clock::Timeout>(deadline - now) : System::Clock::Timeout(0);
+    // StartTimer replaces the pending timer of the scheduler, if any.
+    if (mpSystemLayer->StartTimer(delay, OnTick, this) != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Report scheduler failed to arm its timer");
+        mTimerArmed = false;
+        return;
+    }
+    mTimerArmed    = true;
+    mArmedDeadline = deadline;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
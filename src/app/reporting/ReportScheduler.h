@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the scheduler of the min and max intervals of the
+ *      subscriptions served by the reporting engine.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/IntrusiveList.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * Tracks the min and max intervals of every subscription from a single System Layer timer.
+ *
+ * Scheduled nodes are kept in a queue ordered by their next deadline, which is the end of their min interval until it
+ * elapses, then the end of their max interval. The timer is armed for the head of the queue. When it fires, every node
+ * whose min interval elapsed is notified, as is every node whose max interval ends within
+ * CHIP_CONFIG_REPORT_COALESCING_WINDOW_MS: the empty reports of subscriptions with overlapping report windows are then
+ * sent together, rather than each one waking up the device on its own. Min intervals are never shortened.
+ */
+class ReportScheduler
+{
+public:
+    /**
+     * A subscription paced by the scheduler.
+     */
+    class Node : public IntrusiveListNodeBase<>
+    {
+    public:
+        virtual ~Node() = default;
+
+    protected:
+        /**
+         * The min interval elapsed: reports of changes may be sent.
+         */
+        virtual void OnMinIntervalElapsed() = 0;
+
+        /**
+         * The max interval is about to end: a report must be sent even if nothing changed. The node is no longer
+         * scheduled, until it is scheduled again once the report is sent.
+         */
+        virtual void OnMaxIntervalElapsed() = 0;
+
+    private:
+        friend class ReportScheduler;
+
+        System::Clock::Timestamp NextDeadline() const { return mMinIntervalElapsed ? mMaxDeadline : mMinDeadline; }
+
+        System::Clock::Timestamp mMinDeadline;
+        System::Clock::Timestamp mMaxDeadline;
+        bool mMinIntervalElapsed = false;
+        bool mMinIntervalDue     = false;
+        bool mMaxIntervalDue     = false;
+    };
+
+    ReportScheduler(System::Clock::Milliseconds32 coalescingWindow =
+                        System::Clock::Milliseconds32(CHIP_CONFIG_REPORT_COALESCING_WINDOW_MS)) :
+        mCoalescingWindow(coalescingWindow)
+    {}
+
+    ReportScheduler(const ReportScheduler &)             = delete;
+    ReportScheduler & operator=(const ReportScheduler &) = delete;
+
+    CHIP_ERROR Init(System::Layer * apSystemLayer);
+
+    /**
+     * Unschedule every node and cancel the timer.
+     */
+    void Shutdown();
+
+    /**
+     * Start the min and max intervals of the node from now, replacing those it was scheduled with, if any.
+     */
+    CHIP_ERROR Schedule(Node & aNode, System::Clock::Milliseconds32 aMinInterval, System::Clock::Milliseconds32 aMaxInterval);
+
+    /**
+     * Stop tracking the intervals of the node, if it is scheduled.
+     */
+    void Unschedule(Node & aNode);
+
+    bool IsScheduled(const Node & aNode) const { return aNode.IsInList(); }
+
+    /**
+     * Number of times the timer has fired.
+     */
+    uint32_t GetTickCount() const { return mTickCount; }
+
+private:
+    static void OnTick(System::Layer * apSystemLayer, void * apAppState);
+
+    void Insert(Node & aNode);
+    void RunDueNodes();
+    void ArmTimer();
+
+    System::Layer * mpSystemLayer = nullptr;
+    const System::Clock::Milliseconds32 mCoalescingWindow;
+    IntrusiveList<Node> mNodes;
+    System::Clock::Timestamp mArmedDeadline;
+    bool mTimerArmed    = false;
+    bool mInTick        = false;
+    uint32_t mTickCount = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
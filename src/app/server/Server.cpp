@@ -479,6 +479,7 @@ void Server::Shutdown()
     chip::Dnssd::ServiceAdvertiser::Instance().Shutdown();
 
     chip::Dnssd::Resolver::Instance().Shutdown();
+    ShutdownDataModelHandler();
     chip::app::InteractionModelEngine::GetInstance()->Shutdown();
     mCommissioningWindowManager.Shutdown();
     mMessageCounterManager.Shutdown();
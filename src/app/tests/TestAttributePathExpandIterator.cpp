@@ -20,17 +20,23 @@
 #include <app/AttributePathExpandIterator.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
+#include <app/GlobalAttributes.h>
 #include <app/ObjectList.h>
+#include <app/util/attribute-storage.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
 
 #include <nlunit-test.h>
 
+#include <vector>
+
 using namespace chip;
 using namespace chip::Test;
 using namespace chip::app;
@@ -417,6 +423,150 @@ void TestMultipleClusInfo(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, index == ArraySize(paths));
 }
 
+// Expands a wildcard path the way the iterator used to: looking the endpoint and the cluster up by id for each attribute.
+template <typename Visitor>
+void ExpandByIds(Visitor aVisitor)
+{
+    for (uint16_t endpointIndex = 0; endpointIndex < emberAfEndpointCount(); endpointIndex++)
+    {
+        EndpointId endpointId = emberAfEndpointFromIndex(endpointIndex);
+        for (uint8_t clusterIndex = 0; clusterIndex < emberAfClusterCount(endpointId, true); clusterIndex++)
+        {
+            uint16_t attributeCount = emberAfGetServerAttributeCount(
+                endpointId, emberAfGetNthClusterId(endpointId, clusterIndex, true /* server */).Value());
+            for (uint16_t attributeIndex = 0; attributeIndex < attributeCount; attributeIndex++)
+            {
+                ClusterId clusterId     = emberAfGetNthClusterId(endpointId, clusterIndex, true /* server */).Value();
+                AttributeId attributeId = emberAfGetServerAttributeIdByIndex(endpointId, clusterId, attributeIndex).Value();
+                aVisitor(P(endpointId, clusterId, attributeId));
+            }
+            for (AttributeId attributeId : GlobalAttributesNotInMetadata)
+            {
+                ClusterId clusterId = emberAfGetNthClusterId(endpointId, clusterIndex, true /* server */).Value();
+                aVisitor(P(endpointId, clusterId, attributeId));
+            }
+        }
+    }
+}
+
+void TestWildcardBridgedEndpoints(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint16_t kBridgedEndpointCount = 100;
+    constexpr unsigned kExpansionCount       = 20;
+
+    SetMockBridgedEndpointCount(kBridgedEndpointCount);
+
+    app::ObjectList<app::AttributePathParams> clusInfo;
+    app::ConcreteAttributePath path;
+    std::vector<P> expected;
+    ExpandByIds([&](const P & aPath) { expected.push_back(aPath); });
+
+    // The bridged endpoints follow the mock endpoints, with the clusters and attributes of kMockEndpoint3.
+    size_t index = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+    {
+        NL_TEST_ASSERT(apSuite, index < expected.size() && expected[index] == path);
+        index++;
+    }
+    NL_TEST_ASSERT(apSuite, index == expected.size());
+    NL_TEST_ASSERT(apSuite, expected.back().mEndpointId == kBridgedEndpointCount);
+
+    // A copy of the iterator, as kept by a read handler between the chunks of a report, resumes where it stopped.
+    index = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path);)
+    {
+        app::AttributePathExpandIterator resumed = iter;
+        NL_TEST_ASSERT(apSuite, resumed.Next() == (index + 1 < expected.size()));
+        iter = resumed;
+        index++;
+    }
+    NL_TEST_ASSERT(apSuite, index == expected.size());
+
+    size_t visited                      = 0;
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (unsigned i = 0; i < kExpansionCount; i++)
+    {
+        ExpandByIds([&](const P & aPath) { visited++; });
+    }
+    System::Clock::Microseconds64 byIdTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (unsigned i = 0; i < kExpansionCount; i++)
+    {
+        for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+        {
+            visited--;
+        }
+    }
+    System::Clock::Microseconds64 cursorTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(apSuite, visited == 0);
+
+    ChipLogProgress(Test, "%u wildcard expansions of %u paths on %u endpoints: lookup by id %u us, cursor %u us", kExpansionCount,
+                    static_cast<unsigned>(expected.size()), emberAfEndpointCount(), static_cast<unsigned>(byIdTime.count()),
+                    static_cast<unsigned>(cursorTime.count()));
+
+    SetMockBridgedEndpointCount(0);
+}
+
+void TestReplacedBridgedEndpoint(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr size_t kPathsBeforeChange = 3;
+
+    SetMockBridgedEndpointCount(1);
+
+    app::ObjectList<app::AttributePathParams> clusInfo;
+    clusInfo.mValue.mEndpointId = 1;
+    app::ConcreteAttributePath path;
+
+    auto expand = [&]() {
+        std::vector<P> paths;
+        for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+        {
+            paths.push_back(path);
+        }
+        return paths;
+    };
+    std::vector<P> lastLayoutPaths = expand();
+    NL_TEST_ASSERT(apSuite, lastLayoutPaths.size() > kPathsBeforeChange);
+
+    // Setting the endpoints again without changing them lets the iterator carry on where it was.
+    app::AttributePathExpandIterator iter(&clusInfo);
+    for (size_t i = 0; i < kPathsBeforeChange; i++)
+    {
+        NL_TEST_ASSERT(apSuite, iter.Get(path) && path == lastLayoutPaths[i]);
+        iter.Next();
+    }
+    SetMockBridgedEndpointCount(1);
+    for (size_t i = kPathsBeforeChange; i < lastLayoutPaths.size(); i++)
+    {
+        NL_TEST_ASSERT(apSuite, iter.Get(path) && path == lastLayoutPaths[i]);
+        iter.Next();
+    }
+    NL_TEST_ASSERT(apSuite, !iter.Get(path));
+
+    // An endpoint replaced by one with other clusters, e.g. between two chunks of a report, is expanded again from the start.
+    app::AttributePathExpandIterator resumed(&clusInfo);
+    for (size_t i = 0; i < kPathsBeforeChange; i++)
+    {
+        resumed.Next();
+    }
+    SetMockBridgedEndpointLayout(0);
+    std::vector<P> firstLayoutPaths = expand();
+    NL_TEST_ASSERT(apSuite, firstLayoutPaths != lastLayoutPaths);
+    // The current path was expanded before the change, the next ones are expanded from the new clusters.
+    NL_TEST_ASSERT(apSuite, resumed.Get(path) && path == lastLayoutPaths[kPathsBeforeChange]);
+    resumed.Next();
+    for (const P & expected : firstLayoutPaths)
+    {
+        NL_TEST_ASSERT(apSuite, resumed.Get(path) && path == expected);
+        resumed.Next();
+    }
+    NL_TEST_ASSERT(apSuite, !resumed.Get(path));
+
+    SetMockBridgedEndpointLayout(2);
+    SetMockBridgedEndpointCount(0);
+}
+
 static int TestSetup(void * inContext)
 {
     return SUCCESS;
@@ -445,6 +595,8 @@ const nlTest sTests[] =
         NL_TEST_DEF("TestWildcardAttribute", TestWildcardAttribute),
         NL_TEST_DEF("TestNoWildcard", TestNoWildcard),
         NL_TEST_DEF("TestMultipleClusInfo", TestMultipleClusInfo),
+        NL_TEST_DEF("TestWildcardBridgedEndpoints", TestWildcardBridgedEndpoints),
+        NL_TEST_DEF("TestReplacedBridgedEndpoint", TestReplacedBridgedEndpoint),
         NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -29,6 +29,7 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
+#include <system/SystemClock.h>
 #include <vector>
 
 using TestContext = chip::Test::AppContext;
@@ -282,17 +283,47 @@ void DataSeriesValidator::OnAttributeData(const ConcreteDataAttributePath & aPat
 class DataSeriesGenerator
 {
 public:
-    DataSeriesGenerator(BufferedReadCallback & readCallback, std::vector<ValidationInstruction> instructionList) :
-        mReadCallback(readCallback), mInstructionList(instructionList)
+    DataSeriesGenerator(BufferedReadCallback & readCallback, std::vector<ValidationInstruction> instructionList,
+                        bool handOverPayloads) :
+        mReadCallback(readCallback),
+        mInstructionList(instructionList), mHandOverPayloads(handOverPayloads)
     {}
 
     void Generate();
 
 private:
+    void DeliverAttributeData(const ConcreteDataAttributePath & aPath, System::PacketBufferHandle && aPayload,
+                              const StatusIB & aStatus);
+
     BufferedReadCallback & mReadCallback;
     std::vector<ValidationInstruction> mInstructionList;
+    // Whether the attribute data is delivered the way the ReadClient does it: each payload is handed over before
+    // being read in place.
+    bool mHandOverPayloads;
 };
 
+void DataSeriesGenerator::DeliverAttributeData(const ConcreteDataAttributePath & aPath, System::PacketBufferHandle && aPayload,
+                                               const StatusIB & aStatus)
+{
+    ReadClient::Callback * callback = &mReadCallback;
+
+    if (mHandOverPayloads)
+    {
+        TLV::TLVReader reader;
+        callback->OnReportPayload(aPayload);
+        reader.Init(aPayload->Start(), aPayload->DataLength());
+        NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+        callback->OnAttributeData(aPath, &reader, aStatus);
+    }
+    else
+    {
+        System::PacketBufferTLVReader reader;
+        reader.Init(std::move(aPayload));
+        NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+        callback->OnAttributeData(aPath, &reader, aStatus);
+    }
+}
+
 void DataSeriesGenerator::Generate()
 {
     System::PacketBufferHandle handle;
@@ -429,9 +460,7 @@ void DataSeriesGenerator::Generate()
                 NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
-                reader.Init(std::move(handle));
-                NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
-                callback->OnAttributeData(path, &reader, status);
+                DeliverAttributeData(path, std::move(handle), status);
             }
 
             ChipLogProgress(DataManagement, "\t -- Generating C0..C512");
@@ -452,9 +481,7 @@ void DataSeriesGenerator::Generate()
                 NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), listItem) == CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
-                reader.Init(std::move(handle));
-                NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
-                callback->OnAttributeData(path, &reader, status);
+                DeliverAttributeData(path, std::move(handle), status);
             }
 
             break;
@@ -472,9 +499,7 @@ void DataSeriesGenerator::Generate()
                 NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
-                reader.Init(std::move(handle));
-                NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
-                callback->OnAttributeData(path, &reader, status);
+                DeliverAttributeData(path, std::move(handle), status);
             }
 
             ChipLogProgress(DataManagement, "\t -- Generating D0..D512");
@@ -491,9 +516,7 @@ void DataSeriesGenerator::Generate()
                 NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), (uint8_t)(i)) == CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
-                reader.Init(std::move(handle));
-                NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
-                callback->OnAttributeData(path, &reader, status);
+                DeliverAttributeData(path, std::move(handle), status);
             }
 
             break;
@@ -506,9 +529,7 @@ void DataSeriesGenerator::Generate()
         if (hasData)
         {
             writer.Finalize(&handle);
-            reader.Init(std::move(handle));
-            NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
-            callback->OnAttributeData(path, &reader, status);
+            DeliverAttributeData(path, std::move(handle), status);
         }
 
         index++;
@@ -519,12 +540,16 @@ void DataSeriesGenerator::Generate()
 
 void RunAndValidateSequence(std::vector<ValidationInstruction> instructionList)
 {
-    DataSeriesValidator validator(instructionList);
-    BufferedReadCallback bufferedCallback(validator);
-    DataSeriesGenerator generator(bufferedCallback, instructionList);
-    generator.Generate();
+    constexpr bool allBooleans[] = { true, false };
+    for (auto handOverPayloads : allBooleans)
+    {
+        DataSeriesValidator validator(instructionList);
+        BufferedReadCallback bufferedCallback(validator);
+        DataSeriesGenerator generator(bufferedCallback, instructionList, handOverPayloads);
+        generator.Generate();
 
-    NL_TEST_ASSERT(gSuite, validator.mCurrentInstruction == instructionList.size());
+        NL_TEST_ASSERT(gSuite, validator.mCurrentInstruction == instructionList.size());
+    }
 }
 
 void TestBufferedSequences(nlTestSuite * apSuite, void * apContext)
@@ -599,10 +624,113 @@ void TestBufferedSequences(nlTestSuite * apSuite, void * apContext)
     });
 }
 
+class ListLengthValidator : public BufferedReadCallback::Callback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType value;
+        size_t listLength = 0;
+
+        NL_TEST_ASSERT(gSuite, aPath.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll);
+        NL_TEST_ASSERT(gSuite, DataModel::Decode(*apData, value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, value.ComputeSize(&listLength) == CHIP_NO_ERROR);
+        mListLength = listLength;
+    }
+
+    void OnDone(ReadClient *) override {}
+
+    size_t mListLength = 0;
+};
+
+void TestBufferedListBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint16_t kListLength      = 512;
+    constexpr uint16_t kItemsPerMessage = 16;
+    constexpr unsigned kReportCount     = 50;
+
+    ConcreteDataAttributePath path(0, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::ListStructOctetString::Id);
+    std::vector<System::PacketBufferHandle> messages;
+    uint8_t octets[16] = {};
+
+    //
+    // The list is chunked the way a publisher does it: the first message replaces the list with an array holding the first
+    // items, the following messages each hold a run of items to append.
+    //
+    for (uint16_t firstItem = 0; firstItem < kListLength; firstItem += kItemsPerMessage)
+    {
+        System::PacketBufferTLVWriter writer;
+        System::PacketBufferHandle handle = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+        TLV::TLVType outerType;
+
+        writer.Init(std::move(handle));
+        if (firstItem == 0)
+        {
+            NL_TEST_ASSERT(apSuite, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType) == CHIP_NO_ERROR);
+        }
+        for (uint16_t i = firstItem; i < firstItem + kItemsPerMessage; i++)
+        {
+            Clusters::UnitTesting::Structs::TestListStructOctet::Type listItem;
+            listItem.member1 = i;
+            listItem.member2 = ByteSpan(octets);
+            NL_TEST_ASSERT(apSuite, DataModel::Encode(writer, TLV::AnonymousTag(), listItem) == CHIP_NO_ERROR);
+        }
+        if (firstItem == 0)
+        {
+            NL_TEST_ASSERT(apSuite, writer.EndContainer(outerType) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, writer.Finalize(&handle) == CHIP_NO_ERROR);
+        messages.push_back(std::move(handle));
+    }
+
+    System::Clock::Microseconds64 reportTime[2];
+    constexpr bool allBooleans[] = { true, false };
+    for (auto handOverPayloads : allBooleans)
+    {
+        reportTime[handOverPayloads] = System::Clock::kZero;
+
+        for (unsigned report = 0; report < kReportCount; report++)
+        {
+            ListLengthValidator validator;
+            BufferedReadCallback bufferedCallback(validator);
+            ReadClient::Callback * callback = &bufferedCallback;
+
+            System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+            callback->OnReportBegin();
+            for (auto & message : messages)
+            {
+                TLV::TLVReader reader;
+                StatusIB status;
+
+                if (handOverPayloads)
+                {
+                    callback->OnReportPayload(message);
+                }
+                reader.Init(message->Start(), message->DataLength());
+                path.mListOp = (&message == &messages.front()) ? ConcreteDataAttributePath::ListOperation::ReplaceAll
+                                                                : ConcreteDataAttributePath::ListOperation::AppendItem;
+                while (reader.Next() == CHIP_NO_ERROR)
+                {
+                    callback->OnAttributeData(path, &reader, status);
+                }
+            }
+            callback->OnReportEnd();
+            reportTime[handOverPayloads] += System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+            NL_TEST_ASSERT(apSuite, validator.mListLength == kListLength);
+        }
+    }
+
+    ChipLogProgress(DataManagement, "%u reports of a %u item list in %u messages: %u us when copied, %u us when retained",
+                    kReportCount, kListLength, static_cast<unsigned>(messages.size()),
+                    static_cast<unsigned>(reportTime[false].count()), static_cast<unsigned>(reportTime[true].count()));
+}
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestBufferedSequences", TestBufferedSequences),
+    NL_TEST_DEF("TestBufferedListBenchmark", TestBufferedListBenchmark),
     NL_TEST_SENTINEL()
 };
 
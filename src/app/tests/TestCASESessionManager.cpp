@@ -0,0 +1,377 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/OperationalSessionSetupPool.h>
+#include <app/tests/AppTestContext.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <lib/address_resolve/AddressResolve.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <protocols/secure_channel/CASEServer.h>
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <system/SystemClock.h>
+#include <transport/SessionManager.h>
+
+#include <nlunit-test.h>
+
+#include <functional>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+
+namespace {
+
+constexpr size_t kPoolSize = 4;
+
+constexpr NodeId kUnreachableNodeId = 0x1234;
+
+constexpr System::Clock::Milliseconds32 kKeepWarmCheckInterval(20);
+constexpr System::Clock::Milliseconds32 kSessionSetupTimeout(1000);
+
+// Keeps track of the sessions the CASESessionManager starts to set up.
+class TestSessionSetupPool : public OperationalSessionSetupPool<kPoolSize>
+{
+public:
+    OperationalSessionSetup * Allocate(const CASEClientInitParams & params, CASEClientPoolDelegate * clientPool,
+                                       ScopedNodeId peerId, OperationalSessionReleaseDelegate * releaseDelegate) override
+    {
+        mAllocationCount++;
+        mLastPeerId = peerId;
+        return OperationalSessionSetupPool::Allocate(params, clientPool, peerId, releaseDelegate);
+    }
+
+    unsigned mAllocationCount = 0;
+    ScopedNodeId mLastPeerId;
+};
+
+// Resolves Alice, whose messages go through the loopback transport, and no other node.
+class LoopbackAddressResolver : public AddressResolve::Resolver
+{
+public:
+    LoopbackAddressResolver(NodeId nodeId, const Transport::PeerAddress & address) : mNodeId(nodeId), mAddress(address) {}
+
+    CHIP_ERROR Init(System::Layer * systemLayer) override { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR LookupNode(const AddressResolve::NodeLookupRequest & request,
+                          AddressResolve::Impl::NodeLookupHandle & handle) override
+    {
+        VerifyOrReturnError(request.GetPeerId().GetNodeId() == mNodeId, CHIP_ERROR_NOT_FOUND);
+
+        AddressResolve::ResolveResult result;
+        result.address = mAddress;
+        handle.GetListener()->OnNodeAddressResolved(request.GetPeerId(), result);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR TryNextResult(AddressResolve::Impl::NodeLookupHandle & handle) override { return CHIP_ERROR_WELL_EMPTY; }
+    CHIP_ERROR CancelLookup(AddressResolve::Impl::NodeLookupHandle & handle, FailureCallback cancel_method) override
+    {
+        return CHIP_NO_ERROR;
+    }
+    void Shutdown() override {}
+
+private:
+    NodeId mNodeId;
+    Transport::PeerAddress mAddress;
+};
+
+// Counts the sessions resumed by the responder.
+class TestSessionResumptionStorage : public SimpleSessionResumptionStorage
+{
+public:
+    CHIP_ERROR FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override
+    {
+        CHIP_ERROR err = SimpleSessionResumptionStorage::FindByResumptionId(resumptionId, node, sharedSecret, peerCATs);
+        if (err == CHIP_NO_ERROR)
+        {
+            mResumedSessionCount++;
+        }
+        return err;
+    }
+
+    unsigned mResumedSessionCount = 0;
+};
+
+struct ConnectionResult
+{
+    static void OnConnected(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle)
+    {
+        static_cast<ConnectionResult *>(context)->mConnected = true;
+    }
+
+    static void OnFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+    {
+        static_cast<ConnectionResult *>(context)->mError = error;
+    }
+
+    bool mConnected   = false;
+    CHIP_ERROR mError = CHIP_NO_ERROR;
+};
+
+// Drives IO, along with the work CASE schedules on the platform manager, until done() or maxWait.
+void DriveIOUntil(TestContext & ctx, System::Clock::Timeout maxWait, std::function<bool(void)> done)
+{
+    ctx.GetIOContext().DriveIOUntil(maxWait, [&done]() {
+        DeviceLayer::PlatformMgr().ScheduleWork([](intptr_t) { DeviceLayer::PlatformMgr().StopEventLoopTask(); }, 0);
+        DeviceLayer::PlatformMgr().RunEventLoop();
+        return done();
+    });
+}
+
+// Bob sets up CASE sessions with Alice through a CASESessionManager, and Alice answers them with a CASEServer, over the
+// loopback transport. Both share the session resumption storage, in which each keeps the sessions with the other one.
+class CASESessionManagerTestContext
+{
+public:
+    CASESessionManagerTestContext(TestContext & ctx) :
+        mCtx(ctx), mAddressResolver(ctx.GetAliceFabric()->GetNodeId(), ctx.GetAliceAddress())
+    {}
+
+    ~CASESessionManagerTestContext()
+    {
+        mCASESessionManager.Shutdown();
+        mCASESessionManager.ReleaseAllSessions();
+        mCASEServer.Shutdown();
+        // The next test starts without the sessions of both Bob and Alice.
+        ExpireCASESessions(GetAlice());
+        ExpireCASESessions(ScopedNodeId(mCtx.GetBobFabric()->GetNodeId(), mCtx.GetAliceFabricIndex()));
+        mGroupDataProvider.Finish();
+    }
+
+    CHIP_ERROR Init()
+    {
+        mGroupDataProvider.SetStorageDelegate(&mStorage);
+        mGroupDataProvider.SetSessionKeystore(&mCtx.GetSessionKeystore());
+        ReturnErrorOnFailure(mGroupDataProvider.Init());
+        ReturnErrorOnFailure(SetIpk(*mCtx.GetBobFabric()));
+        ReturnErrorOnFailure(SetIpk(*mCtx.GetAliceFabric()));
+        ReturnErrorOnFailure(mResumptionStorage.Init(&mStorage));
+
+        ReturnErrorOnFailure(mCASEServer.ListenForSessionEstablishment(&mCtx.GetExchangeManager(), &mCtx.GetSecureSessionManager(),
+                                                                       &mCtx.GetFabricTable(), &mResumptionStorage, nullptr,
+                                                                       &mGroupDataProvider));
+
+        CASESessionManagerConfig config;
+        config.sessionInitParams.sessionManager           = &mCtx.GetSecureSessionManager();
+        config.sessionInitParams.sessionResumptionStorage = &mResumptionStorage;
+        config.sessionInitParams.exchangeMgr              = &mCtx.GetExchangeManager();
+        config.sessionInitParams.fabricTable              = &mCtx.GetFabricTable();
+        config.sessionInitParams.groupDataProvider        = &mGroupDataProvider;
+        config.sessionInitParams.addressResolver          = &mAddressResolver;
+        config.clientPool                                 = &mCASEClientPool;
+        config.sessionSetupPool                           = &mSessionSetupPool;
+        return mCASESessionManager.Init(&mCtx.GetSystemLayer(), config);
+    }
+
+    ScopedNodeId GetAlice() { return ScopedNodeId(mCtx.GetAliceFabric()->GetNodeId(), mCtx.GetBobFabricIndex()); }
+
+    bool HasSessionWithAlice() { return FindCASESession(GetAlice()).HasValue(); }
+
+    // Drops the session Bob has with Alice, as when it is evicted to make room for another one.
+    void LoseSessionWithAlice() { ExpireCASESessions(GetAlice()); }
+
+    void WaitForSessionWithAlice(System::Clock::Timeout maxWait)
+    {
+        DriveIOUntil(mCtx, maxWait, [this]() { return HasSessionWithAlice(); });
+    }
+
+    TestContext & mCtx;
+    TestPersistentStorageDelegate mStorage;
+    Credentials::GroupDataProviderImpl mGroupDataProvider;
+    TestSessionResumptionStorage mResumptionStorage;
+    LoopbackAddressResolver mAddressResolver;
+    CASEServer mCASEServer;
+    CASEClientPool<kPoolSize> mCASEClientPool;
+    TestSessionSetupPool mSessionSetupPool;
+    CASESessionManager mCASESessionManager;
+
+private:
+    CHIP_ERROR SetIpk(const FabricInfo & fabric)
+    {
+        const uint8_t ipk[Crypto::CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES] = {};
+        uint8_t compressedFabricId[sizeof(uint64_t)];
+        MutableByteSpan compressedFabricIdSpan(compressedFabricId);
+        ReturnErrorOnFailure(fabric.GetCompressedFabricIdBytes(compressedFabricIdSpan));
+        return Credentials::SetSingleIpkEpochKey(&mGroupDataProvider, fabric.GetFabricIndex(), ByteSpan(ipk),
+                                                 compressedFabricIdSpan);
+    }
+
+    Optional<SessionHandle> FindCASESession(const ScopedNodeId & peer)
+    {
+        return mCtx.GetSecureSessionManager().FindSecureSessionForNode(peer, MakeOptional(Transport::SecureSession::Type::kCASE));
+    }
+
+    void ExpireCASESessions(const ScopedNodeId & peer)
+    {
+        for (auto session = FindCASESession(peer); session.HasValue(); session = FindCASESession(peer))
+        {
+            session.Value()->AsSecureSession()->MarkForEviction();
+        }
+    }
+};
+
+void DriveKeepWarmChecks(TestContext & ctx, unsigned checkCount)
+{
+    DriveIOUntil(ctx, kKeepWarmCheckInterval * checkCount, []() { return false; });
+}
+
+void TestKeepWarmReestablishesLostSessions(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CASESessionManagerTestContext testContext(ctx);
+    NL_TEST_ASSERT(apSuite, testContext.Init() == CHIP_NO_ERROR);
+    CASESessionManager & manager = testContext.mCASESessionManager;
+    TestSessionSetupPool & pool  = testContext.mSessionSetupPool;
+
+    const ScopedNodeId alice = testContext.GetAlice();
+    const ScopedNodeId unreachable(kUnreachableNodeId, ctx.GetBobFabricIndex());
+    const ScopedNodeId peers[] = { alice, unreachable };
+
+    // Checking the peers back-to-back would keep retrying the unreachable one.
+    NL_TEST_ASSERT(apSuite,
+                   manager.SetKeepWarmPeers(Span<const ScopedNodeId>(peers), System::Clock::kZero) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Alice has no session yet, so one is established in the background, through address resolution and CASE.
+    NL_TEST_ASSERT(apSuite, manager.SetKeepWarmPeers(Span<const ScopedNodeId>(peers), kKeepWarmCheckInterval) == CHIP_NO_ERROR);
+    testContext.WaitForSessionWithAlice(kSessionSetupTimeout);
+    NL_TEST_ASSERT(apSuite, testContext.HasSessionWithAlice());
+    NL_TEST_ASSERT(apSuite, testContext.mResumptionStorage.mResumedSessionCount == 0);
+
+    // The unreachable peer cannot be resolved, and is only retried once per check interval.
+    unsigned allocationCount = pool.mAllocationCount;
+    DriveKeepWarmChecks(ctx, 5);
+    NL_TEST_ASSERT(apSuite, pool.mAllocationCount > allocationCount);
+    NL_TEST_ASSERT(apSuite, pool.mAllocationCount <= allocationCount + 6);
+    NL_TEST_ASSERT(apSuite, pool.mLastPeerId == unreachable);
+
+    // Once the session with Alice is lost, it gets re-established in the background, resuming the previous one.
+    testContext.LoseSessionWithAlice();
+    NL_TEST_ASSERT(apSuite, !testContext.HasSessionWithAlice());
+    testContext.WaitForSessionWithAlice(kSessionSetupTimeout);
+    NL_TEST_ASSERT(apSuite, testContext.HasSessionWithAlice());
+    NL_TEST_ASSERT(apSuite, testContext.mResumptionStorage.mResumedSessionCount == 1);
+
+    // No more sessions are set up once keep-warm is turned off.
+    NL_TEST_ASSERT(apSuite, manager.SetKeepWarmPeers(Span<const ScopedNodeId>(), kKeepWarmCheckInterval) == CHIP_NO_ERROR);
+    testContext.LoseSessionWithAlice();
+    allocationCount = pool.mAllocationCount;
+    DriveKeepWarmChecks(ctx, 5);
+    NL_TEST_ASSERT(apSuite, pool.mAllocationCount == allocationCount);
+    NL_TEST_ASSERT(apSuite, !testContext.HasSessionWithAlice());
+}
+
+void TestFirstCommandLatencyAfterIdle(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CASESessionManagerTestContext testContext(ctx);
+    NL_TEST_ASSERT(apSuite, testContext.Init() == CHIP_NO_ERROR);
+    CASESessionManager & manager = testContext.mCASESessionManager;
+    auto & loopback              = ctx.GetLoopback();
+
+    const ScopedNodeId alice   = testContext.GetAlice();
+    const ScopedNodeId peers[] = { alice };
+
+    // The session with Alice is lost while the node is idle, and the keep-warm check re-establishes it.
+    NL_TEST_ASSERT(apSuite, manager.SetKeepWarmPeers(Span<const ScopedNodeId>(peers), kKeepWarmCheckInterval) == CHIP_NO_ERROR);
+    testContext.WaitForSessionWithAlice(kSessionSetupTimeout);
+    testContext.LoseSessionWithAlice();
+    testContext.WaitForSessionWithAlice(kSessionSetupTimeout);
+    NL_TEST_ASSERT(apSuite, testContext.HasSessionWithAlice());
+
+    ConnectionResult warm;
+    Callback::Callback<OnDeviceConnected> onWarmConnected(ConnectionResult::OnConnected, &warm);
+    Callback::Callback<OnDeviceConnectionFailure> onWarmFailure(ConnectionResult::OnFailure, &warm);
+
+    loopback.mSentMessageCount               = 0;
+    System::Clock::Microseconds64 start      = System::SystemClock().GetMonotonicMicroseconds64();
+    manager.FindOrEstablishSession(alice, &onWarmConnected, &onWarmFailure);
+    System::Clock::Microseconds64 warmLatency = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(apSuite, warm.mConnected);
+    NL_TEST_ASSERT(apSuite, loopback.mSentMessageCount == 0);
+
+    // Without keep-warm, the session lost while idle is only re-established by the first command.
+    NL_TEST_ASSERT(apSuite, manager.SetKeepWarmPeers(Span<const ScopedNodeId>(), kKeepWarmCheckInterval) == CHIP_NO_ERROR);
+    testContext.LoseSessionWithAlice();
+
+    ConnectionResult cold;
+    Callback::Callback<OnDeviceConnected> onColdConnected(ConnectionResult::OnConnected, &cold);
+    Callback::Callback<OnDeviceConnectionFailure> onColdFailure(ConnectionResult::OnFailure, &cold);
+
+    loopback.mSentMessageCount = 0;
+    start                      = System::SystemClock().GetMonotonicMicroseconds64();
+    manager.FindOrEstablishSession(alice, &onColdConnected, &onColdFailure);
+    NL_TEST_ASSERT(apSuite, !cold.mConnected);
+    DriveIOUntil(ctx, kSessionSetupTimeout, [&cold]() { return cold.mConnected || cold.mError != CHIP_NO_ERROR; });
+    System::Clock::Microseconds64 coldLatency = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(apSuite, cold.mConnected);
+    NL_TEST_ASSERT(apSuite, loopback.mSentMessageCount > 0);
+
+    ChipLogProgress(Test,
+                    "First command after idle: session found in %u us when kept warm, resumed in %u us with %u messages otherwise",
+                    static_cast<unsigned>(warmLatency.count()), static_cast<unsigned>(coldLatency.count()),
+                    static_cast<unsigned>(loopback.mSentMessageCount));
+}
+
+int Initialize(void * apContext)
+{
+    // CASE hands its cryptographic work over to the platform manager.
+    VerifyOrReturnError(DeviceLayer::PlatformMgr().InitChipStack() == CHIP_NO_ERROR, FAILURE);
+    VerifyOrReturnError(TestContext::Initialize(apContext) == SUCCESS, FAILURE);
+    DeviceLayer::SetSystemLayerForTesting(&static_cast<TestContext *>(apContext)->GetSystemLayer());
+    return SUCCESS;
+}
+
+int Finalize(void * apContext)
+{
+    DeviceLayer::SetSystemLayerForTesting(nullptr);
+    int result = TestContext::Finalize(apContext);
+    DeviceLayer::PlatformMgr().Shutdown();
+    return result;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestKeepWarmReestablishesLostSessions", TestKeepWarmReestablishesLostSessions),
+    NL_TEST_DEF("TestFirstCommandLatencyAfterIdle", TestFirstCommandLatencyAfterIdle),
+    NL_TEST_SENTINEL()
+};
+
+nlTestSuite sSuite =
+{
+    "TestCASESessionManager",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+} // namespace
+
+int TestCASESessionManager()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCASESessionManager)
@@ -81,13 +81,37 @@ constexpr ClusterId kTestClusterId                        = 3;
 constexpr CommandId kTestCommandIdWithData                = 4;
 constexpr CommandId kTestCommandIdNoData                  = 5;
 constexpr CommandId kTestCommandIdCommandSpecificResponse = 6;
+constexpr CommandId kTestCommandIdResponseOnOwnPath       = 7;
+constexpr CommandId kTestResponseCommandId                = 0x80;
 constexpr CommandId kTestNonExistCommandId                = 0;
+// Commands from this id up get a response large enough that a few of them fill an InvokeResponseMessage.
+constexpr CommandId kTestCommandIdLargeResponse = 0x100;
+constexpr size_t kTestLargeResponseSize         = 400;
 } // namespace
 
 namespace app {
 
 CommandHandler::Handle asyncCommandHandle;
 
+struct LargeResponseFields
+{
+    LargeResponseFields(CommandId aCommandId) : mCommandId(aCommandId) {}
+
+    // The response is sent with the id of the request, so the id here is only a placeholder.
+    static constexpr chip::CommandId GetCommandId() { return kTestCommandIdLargeResponse; }
+    CHIP_ERROR Encode(TLV::TLVWriter & aWriter, TLV::Tag aTag) const
+    {
+        TLV::TLVType outerContainerType;
+        uint8_t data[kTestLargeResponseSize] = { 0 };
+        ReturnErrorOnFailure(aWriter.StartContainer(aTag, TLV::kTLVType_Structure, outerContainerType));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(0), mCommandId));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(1), ByteSpan(data)));
+        return aWriter.EndContainer(outerContainerType);
+    }
+
+    CommandId mCommandId;
+};
+
 InteractionModel::Status ServerClusterCommandExists(const ConcreteCommandPath & aCommandPath)
 {
     // Mock cluster catalog, only support commands on one cluster on one endpoint.
@@ -159,6 +183,19 @@ void DispatchSingleClusterCommand(const ConcreteCommandPath & aCommandPath, chip
         {
             apCommandObj->AddStatus(aCommandPath, Protocols::InteractionModel::Status::Success);
         }
+        else if (aCommandPath.mCommandId == kTestCommandIdResponseOnOwnPath)
+        {
+            // Answer with a response command, whose path is not the one of the request.
+            ConcreteCommandPath responsePath(aCommandPath.mEndpointId, aCommandPath.mClusterId, kTestResponseCommandId);
+            apCommandObj->PrepareCommand(responsePath);
+            chip::TLV::TLVWriter * writer = apCommandObj->GetCommandDataIBTLVWriter();
+            writer->PutBoolean(chip::TLV::ContextTag(1), true);
+            apCommandObj->FinishCommand();
+        }
+        else if (aCommandPath.mCommandId >= kTestCommandIdLargeResponse)
+        {
+            apCommandObj->AddResponse(aCommandPath, LargeResponseFields(aCommandPath.mCommandId));
+        }
         else
         {
             apCommandObj->PrepareCommand(aCommandPath);
@@ -190,6 +227,15 @@ public:
         onErrorCalledTimes++;
         mError = aError;
     }
+    void OnBatchResponse(chip::app::CommandSender * apCommandSender, uint16_t aCommandRef,
+                         const chip::app::ConcreteCommandPath & aPath, const chip::app::StatusIB & aStatus,
+                         chip::TLV::TLVReader * aData) override
+    {
+        NL_TEST_ASSERT(gSuite, aCommandRef < ArraySize(batchResponseCommandIds));
+        batchResponseRefs |= (1u << aCommandRef);
+        batchResponseCommandIds[aCommandRef] = aPath.mCommandId;
+        CommandSender::Callback::OnBatchResponse(apCommandSender, aCommandRef, aPath, aStatus, aData);
+    }
     void OnDone(chip::app::CommandSender * apCommandSender) override { onFinalCalledTimes++; }
 
     void ResetCounter()
@@ -197,11 +243,15 @@ public:
         onResponseCalledTimes = 0;
         onErrorCalledTimes    = 0;
         onFinalCalledTimes    = 0;
+        batchResponseRefs     = 0;
     }
 
     int onResponseCalledTimes = 0;
     int onErrorCalledTimes    = 0;
     int onFinalCalledTimes    = 0;
+    // The CommandRefs of the batched responses received, as a bitmask, and the command id of each response.
+    uint32_t batchResponseRefs = 0;
+    CommandId batchResponseCommandIds[32];
     CHIP_ERROR mError         = CHIP_NO_ERROR;
 } mockCommandSenderDelegate;
 
@@ -245,6 +295,10 @@ public:
 
     static void TestCommandHandlerWithProcessReceivedEmptyDataMsg(nlTestSuite * apSuite, void * apContext);
     static void TestCommandHandlerRejectMultipleCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandSenderBatchedCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandHandlerBatchedResponseCommandRefs(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandHandlerChunkedResponses(nlTestSuite * apSuite, void * apContext);
+    static void TestBatchedCommandsBenchmark(nlTestSuite * apSuite, void * apContext);
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void TestCommandHandlerReleaseWithExchangeClosed(nlTestSuite * apSuite, void * apContext);
@@ -532,8 +586,10 @@ void TestCommandInteraction::TestCommandSenderWithSendCommand(nlTestSuite * apSu
     ctx.DrainAndServiceIO();
 
     GenerateInvokeResponse(apSuite, apContext, buf, kTestCommandIdWithData);
-    err = commandSender.ProcessInvokeResponse(std::move(buf));
+    bool moreChunkedMessages = true;
+    err                      = commandSender.ProcessInvokeResponse(std::move(buf), moreChunkedMessages);
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !moreChunkedMessages);
 }
 
 void TestCommandInteraction::TestCommandHandlerWithSendEmptyCommand(nlTestSuite * apSuite, void * apContext)
@@ -569,8 +625,10 @@ void TestCommandInteraction::TestCommandSenderWithProcessReceivedMsg(nlTestSuite
     System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
 
     GenerateInvokeResponse(apSuite, apContext, buf, kTestCommandIdWithData);
-    err = commandSender.ProcessInvokeResponse(std::move(buf));
+    bool moreChunkedMessages = true;
+    err                      = commandSender.ProcessInvokeResponse(std::move(buf), moreChunkedMessages);
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !moreChunkedMessages);
 }
 
 void TestCommandInteraction::ValidateCommandHandlerWithSendCommand(nlTestSuite * apSuite, void * apContext, bool aNeedStatusCode)
@@ -1347,7 +1405,8 @@ void TestCommandInteraction::TestCommandHandlerRejectMultipleCommands(nlTestSuit
 
         commandSender.AllocateBuffer();
 
-        // CommandSender does not support sending multiple commands with public API, so we craft a message manaully.
+        // Commands without a CommandRef cannot be told apart in the response, so the command handler rejects them. CommandSender
+        // always gives the commands of a batch a CommandRef, so we craft a message manually.
         for (int i = 0; i < 2; i++)
         {
             InvokeRequests::Builder & invokeRequests = commandSender.mInvokeRequestBuilder.GetInvokeRequests();
@@ -1367,9 +1426,6 @@ void TestCommandInteraction::TestCommandHandlerRejectMultipleCommands(nlTestSuit
             NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == invokeRequest.EndOfCommandDataIB());
         }
 
-        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == commandSender.mInvokeRequestBuilder.GetInvokeRequests().EndOfInvokeRequests());
-        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == commandSender.mInvokeRequestBuilder.EndOfInvokeRequestMessage());
-
         commandSender.MoveToState(app::CommandSender::State::AddedCommand);
     }
 
@@ -1388,6 +1444,151 @@ void TestCommandInteraction::TestCommandHandlerRejectMultipleCommands(nlTestSuit
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+namespace {
+
+// Sends aCommandCount commands starting at aFirstCommandId, in batches of up to aBatchSize commands.
+void SendTestCommands(nlTestSuite * apSuite, TestContext & ctx, CommandId aFirstCommandId, uint16_t aCommandCount,
+                      uint16_t aBatchSize)
+{
+    for (uint16_t sent = 0; sent < aCommandCount;)
+    {
+        app::CommandSender commandSender(&mockCommandSenderDelegate, &ctx.GetExchangeManager());
+        if (aBatchSize > 1)
+        {
+            NL_TEST_ASSERT(apSuite, commandSender.SetRemoteMaxPathsPerInvoke(aBatchSize) == CHIP_NO_ERROR);
+        }
+        for (uint16_t i = 0; i < aBatchSize && sent < aCommandCount; i++, sent++)
+        {
+            auto commandPathParams = MakeTestCommandPath(static_cast<CommandId>(aFirstCommandId + sent));
+            NL_TEST_ASSERT(apSuite, commandSender.PrepareCommand(commandPathParams) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite,
+                           commandSender.GetCommandDataIBTLVWriter()->PutBoolean(chip::TLV::ContextTag(1), true) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, commandSender.FinishCommand() == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, commandSender.SendCommandRequest(ctx.GetSessionBobToAlice()) == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+    }
+}
+
+} // namespace
+
+void TestCommandInteraction::TestCommandSenderBatchedCommands(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    mockCommandSenderDelegate.ResetCounter();
+    app::CommandSender commandSender(&mockCommandSenderDelegate, &ctx.GetExchangeManager());
+    NL_TEST_ASSERT(apSuite, commandSender.SetRemoteMaxPathsPerInvoke(0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, commandSender.SetRemoteMaxPathsPerInvoke(2) == CHIP_NO_ERROR);
+
+    // One command answered with a status, and one with data.
+    AddInvokeRequestData(apSuite, apContext, &commandSender, kTestCommandIdWithData);
+    AddInvokeRequestData(apSuite, apContext, &commandSender, kTestCommandIdCommandSpecificResponse);
+
+    // The batch is full.
+    NL_TEST_ASSERT(apSuite, commandSender.PrepareCommand(MakeTestCommandPath(kTestCommandIdLargeResponse)) == CHIP_ERROR_NO_MEMORY);
+
+    NL_TEST_ASSERT(apSuite, commandSender.SendCommandRequest(ctx.GetSessionBobToAlice()) == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite,
+                   mockCommandSenderDelegate.onResponseCalledTimes == 2 && mockCommandSenderDelegate.onFinalCalledTimes == 1 &&
+                       mockCommandSenderDelegate.onErrorCalledTimes == 0);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseRefs == 0x3);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseCommandIds[0] == kTestCommandIdWithData);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseCommandIds[1] == kTestCommandIdCommandSpecificResponse);
+    NL_TEST_ASSERT(apSuite, GetNumActiveHandlerObjects() == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestCommandHandlerBatchedResponseCommandRefs(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    mockCommandSenderDelegate.ResetCounter();
+    app::CommandSender commandSender(&mockCommandSenderDelegate, &ctx.GetExchangeManager());
+    NL_TEST_ASSERT(apSuite, commandSender.SetRemoteMaxPathsPerInvoke(2) == CHIP_NO_ERROR);
+
+    // Two commands on the same cluster, the second one answered with a response command on its own path, which must still carry
+    // the CommandRef of the command it answers.
+    AddInvokeRequestData(apSuite, apContext, &commandSender, kTestCommandIdWithData);
+    AddInvokeRequestData(apSuite, apContext, &commandSender, kTestCommandIdResponseOnOwnPath);
+
+    NL_TEST_ASSERT(apSuite, commandSender.SendCommandRequest(ctx.GetSessionBobToAlice()) == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite,
+                   mockCommandSenderDelegate.onResponseCalledTimes == 2 && mockCommandSenderDelegate.onFinalCalledTimes == 1 &&
+                       mockCommandSenderDelegate.onErrorCalledTimes == 0);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseRefs == 0x3);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseCommandIds[0] == kTestCommandIdWithData);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseCommandIds[1] == kTestResponseCommandId);
+    NL_TEST_ASSERT(apSuite, GetNumActiveHandlerObjects() == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestCommandHandlerChunkedResponses(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx             = *static_cast<TestContext *>(apContext);
+    constexpr uint16_t kBatchSize = 6;
+
+    mockCommandSenderDelegate.ResetCounter();
+    ctx.GetLoopback().mSentMessageCount = 0;
+
+    // The responses do not fit in a single InvokeResponseMessage.
+    static_assert(kBatchSize * kTestLargeResponseSize > kMaxSecureSduLengthBytes, "The responses must be chunked");
+    static_assert(kBatchSize <= CHIP_CONFIG_MAX_PATHS_PER_INVOKE, "The handler must accept the batch");
+    SendTestCommands(apSuite, ctx, kTestCommandIdLargeResponse, kBatchSize, kBatchSize);
+
+    NL_TEST_ASSERT(apSuite,
+                   mockCommandSenderDelegate.onResponseCalledTimes == kBatchSize &&
+                       mockCommandSenderDelegate.onFinalCalledTimes == 1 && mockCommandSenderDelegate.onErrorCalledTimes == 0);
+    NL_TEST_ASSERT(apSuite, mockCommandSenderDelegate.batchResponseRefs == (1u << kBatchSize) - 1);
+    // The request, at least two chunks of the response, and the status response acknowledging the first chunk.
+    NL_TEST_ASSERT(apSuite, ctx.GetLoopback().mSentMessageCount >= 4);
+    NL_TEST_ASSERT(apSuite, GetNumActiveHandlerObjects() == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestBatchedCommandsBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx             = *static_cast<TestContext *>(apContext);
+    constexpr uint16_t kCommands  = 256;
+    constexpr uint16_t kBatchSize = 16;
+    // Ids at which the test cluster answers with a small data response.
+    constexpr CommandId kFirstCommandId = 0x10;
+    static_assert(kFirstCommandId + kBatchSize <= kTestCommandIdLargeResponse, "The responses must be small");
+    static_assert(kBatchSize <= CHIP_CONFIG_MAX_PATHS_PER_INVOKE, "The handler must accept the batches");
+
+    mockCommandSenderDelegate.ResetCounter();
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    SendTestCommands(apSuite, ctx, kFirstCommandId, kCommands, 1);
+    System::Clock::Microseconds64 unbatchedTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(apSuite,
+                   mockCommandSenderDelegate.onResponseCalledTimes == kCommands &&
+                       mockCommandSenderDelegate.onErrorCalledTimes == 0);
+
+    // The same commands, with the CommandRefs of each batch starting at 0 again.
+    mockCommandSenderDelegate.ResetCounter();
+    start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint16_t i = 0; i < kCommands; i += kBatchSize)
+    {
+        SendTestCommands(apSuite, ctx, kFirstCommandId, kBatchSize, kBatchSize);
+    }
+    System::Clock::Microseconds64 batchedTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(apSuite,
+                   mockCommandSenderDelegate.onResponseCalledTimes == kCommands &&
+                       mockCommandSenderDelegate.onErrorCalledTimes == 0);
+
+    NL_TEST_ASSERT(apSuite, GetNumActiveHandlerObjects() == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+    ChipLogProgress(Test, "%u commands: unbatched %u commands/s, batched by %u %u commands/s", static_cast<unsigned>(kCommands),
+                    static_cast<unsigned>(kCommands * 1000000ull / std::max<uint64_t>(unbatchedTime.count(), 1)),
+                    static_cast<unsigned>(kBatchSize),
+                    static_cast<unsigned>(kCommands * 1000000ull / std::max<uint64_t>(batchedTime.count(), 1)));
+}
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
 //
 // This test needs a special unit-test only API being exposed in ExchangeContext to be able to correctly simulate
@@ -1445,6 +1646,10 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestCommandHandlerWithProcessReceivedNotExistCommand", chip::app::TestCommandInteraction::TestCommandHandlerWithProcessReceivedNotExistCommand),
     NL_TEST_DEF("TestCommandHandlerWithProcessReceivedEmptyDataMsg", chip::app::TestCommandInteraction::TestCommandHandlerWithProcessReceivedEmptyDataMsg),
     NL_TEST_DEF("TestCommandHandlerRejectMultipleCommands", chip::app::TestCommandInteraction::TestCommandHandlerRejectMultipleCommands),
+    NL_TEST_DEF("TestCommandSenderBatchedCommands", chip::app::TestCommandInteraction::TestCommandSenderBatchedCommands),
+    NL_TEST_DEF("TestCommandHandlerBatchedResponseCommandRefs", chip::app::TestCommandInteraction::TestCommandHandlerBatchedResponseCommandRefs),
+    NL_TEST_DEF("TestCommandHandlerChunkedResponses", chip::app::TestCommandInteraction::TestCommandHandlerChunkedResponses),
+    NL_TEST_DEF("TestBatchedCommandsBenchmark", chip::app::TestCommandInteraction::TestBatchedCommandsBenchmark),
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("TestCommandHandlerReleaseWithExchangeClosed", chip::app::TestCommandInteraction::TestCommandHandlerReleaseWithExchangeClosed),
@@ -36,6 +36,7 @@ using chip::Server;
 
 // Mock function for linking
 void InitDataModelHandler() {}
+void ShutdownDataModelHandler() {}
 
 namespace {
 bool sAdminFabricIndexDirty = false;
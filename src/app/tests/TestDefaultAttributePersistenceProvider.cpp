@@ -0,0 +1,228 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <map>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+// Number of persisted attributes per endpoint in the restore benchmark, about what a bridged light uses
+// (OnOff, LevelControl, ColorControl and a few Basic Information attributes).
+constexpr uint16_t kPersistedAttributesPerEndpoint = 12;
+
+constexpr ClusterId kClusterIds[] = { 0x0006, 0x0008, 0x0300, 0x0039 };
+
+class ValueCollector : public AttributePersistenceProvider::AttributeValueVisitor
+{
+public:
+    CHIP_ERROR OnAttributeValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override
+    {
+        values[aPath] = std::vector<uint8_t>(aValue.data(), aValue.data() + aValue.size());
+        return CHIP_NO_ERROR;
+    }
+
+    std::map<ConcreteAttributePath, std::vector<uint8_t>> values;
+};
+
+// Storage that counts the accesses made through each API.
+class CountingStorage : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        getCount++;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+
+    CHIP_ERROR SyncForEachKeyValueWithPrefix(const char * prefix, KeyValueVisitor & visitor) override
+    {
+        forEachCount++;
+        VerifyOrReturnError(supportsForEach, CHIP_ERROR_NOT_IMPLEMENTED);
+        return TestPersistentStorageDelegate::SyncForEachKeyValueWithPrefix(prefix, visitor);
+    }
+
+    size_t getCount      = 0;
+    size_t forEachCount  = 0;
+    bool supportsForEach = true;
+};
+
+ConcreteAttributePath PersistedAttributePath(EndpointId endpoint, uint16_t index)
+{
+    return ConcreteAttributePath(endpoint, kClusterIds[index % ArraySize(kClusterIds)], index);
+}
+
+void TestReadEndpointValues(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    DefaultAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(inSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+
+    const uint8_t onOff[]      = { 1 };
+    const uint8_t level[]      = { 0xfe };
+    const uint8_t label[]      = { 3, 'a', 'b', 'c' };
+    const uint8_t otherOnOff[] = { 0 };
+    const ConcreteAttributePath onOffPath(1, 0x0006, 0x0000);
+    const ConcreteAttributePath levelPath(1, 0x0008, 0x0000);
+    const ConcreteAttributePath labelPath(1, 0xFFF1FC05, 0xFFF10001);
+
+    NL_TEST_ASSERT(inSuite, provider.WriteValue(onOffPath, ByteSpan(onOff)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, provider.WriteValue(levelPath, ByteSpan(level)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, provider.WriteValue(labelPath, ByteSpan(label)) == CHIP_NO_ERROR);
+    // Endpoints whose key shares the first characters of the key of endpoint 1.
+    for (EndpointId otherEndpoint : { EndpointId(0x10), EndpointId(0x100) })
+    {
+        ConcreteAttributePath otherOnOffPath(otherEndpoint, 0x0006, 0x0000);
+        NL_TEST_ASSERT(inSuite, provider.WriteValue(otherOnOffPath, ByteSpan(otherOnOff)) == CHIP_NO_ERROR);
+    }
+    // Malformed keys under the endpoint prefix are skipped.
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/1/6", onOff, sizeof(onOff)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/1/6/x", onOff, sizeof(onOff)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/1/6/123456789", onOff, sizeof(onOff)) == CHIP_NO_ERROR);
+
+    ValueCollector collector;
+    NL_TEST_ASSERT(inSuite, provider.ReadEndpointValues(1, collector) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, collector.values.size() == 3);
+    NL_TEST_ASSERT(inSuite, collector.values[onOffPath] == std::vector<uint8_t>(onOff, onOff + sizeof(onOff)));
+    NL_TEST_ASSERT(inSuite, collector.values[levelPath] == std::vector<uint8_t>(level, level + sizeof(level)));
+    NL_TEST_ASSERT(inSuite, collector.values[labelPath] == std::vector<uint8_t>(label, label + sizeof(label)));
+
+    ValueCollector emptyCollector;
+    NL_TEST_ASSERT(inSuite, provider.ReadEndpointValues(2, emptyCollector) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, emptyCollector.values.empty());
+}
+
+void TestReadEndpointValuesNotImplemented(nlTestSuite * inSuite, void * inContext)
+{
+    CountingStorage storage;
+    storage.supportsForEach = false;
+    DefaultAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(inSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+
+    ValueCollector collector;
+    NL_TEST_ASSERT(inSuite, provider.ReadEndpointValues(1, collector) == CHIP_ERROR_NOT_IMPLEMENTED);
+
+    DefaultAttributePersistenceProvider uninitialized;
+    NL_TEST_ASSERT(inSuite, uninitialized.ReadEndpointValues(1, collector) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+// Restores the persisted attributes of `endpointCount` endpoints, once with a read per attribute and once
+// with a single enumeration per endpoint, and logs the time and storage accesses each approach takes.
+void RunRestoreBenchmark(nlTestSuite * inSuite, EndpointId endpointCount)
+{
+    CountingStorage storage;
+    DefaultAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(inSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+
+    for (EndpointId endpoint = 1; endpoint <= endpointCount; endpoint++)
+    {
+        for (uint16_t i = 0; i < kPersistedAttributesPerEndpoint; i++)
+        {
+            uint8_t value = static_cast<uint8_t>(endpoint + i);
+            NL_TEST_ASSERT(inSuite, provider.WriteValue(PersistedAttributePath(endpoint, i), ByteSpan(&value, 1)) == CHIP_NO_ERROR);
+        }
+    }
+
+    const EmberAfAttributeMetadata metadata = { EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)), 0, 1, ZCL_INT8U_ATTRIBUTE_TYPE,
+                                                ATTRIBUTE_MASK_NONVOLATILE };
+
+    size_t restored                     = 0;
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (EndpointId endpoint = 1; endpoint <= endpointCount; endpoint++)
+    {
+        for (uint16_t i = 0; i < kPersistedAttributesPerEndpoint; i++)
+        {
+            uint8_t value;
+            MutableByteSpan bytes(&value, 1);
+            if (provider.ReadValue(PersistedAttributePath(endpoint, i), &metadata, bytes) == CHIP_NO_ERROR)
+            {
+                restored++;
+            }
+        }
+    }
+    System::Clock::Microseconds64 perAttributeTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    size_t perAttributeAccesses                    = storage.getCount;
+
+    NL_TEST_ASSERT(inSuite, restored == size_t{ endpointCount } * kPersistedAttributesPerEndpoint);
+
+    restored = 0;
+    start    = System::SystemClock().GetMonotonicMicroseconds64();
+    for (EndpointId endpoint = 1; endpoint <= endpointCount; endpoint++)
+    {
+        ValueCollector collector;
+        NL_TEST_ASSERT(inSuite, provider.ReadEndpointValues(endpoint, collector) == CHIP_NO_ERROR);
+        restored += collector.values.size();
+    }
+    System::Clock::Microseconds64 bulkTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    NL_TEST_ASSERT(inSuite, restored == size_t{ endpointCount } * kPersistedAttributesPerEndpoint);
+    NL_TEST_ASSERT(inSuite, storage.forEachCount == endpointCount);
+
+    ChipLogProgress(Test, "%u endpoint(s): per-attribute restore %u us (%u reads), bulk restore %u us (%u reads)",
+                    static_cast<unsigned>(endpointCount), static_cast<unsigned>(perAttributeTime.count()),
+                    static_cast<unsigned>(perAttributeAccesses), static_cast<unsigned>(bulkTime.count()),
+                    static_cast<unsigned>(storage.forEachCount));
+}
+
+void TestRestoreBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    // The in-memory storage understates the cost of a read on flash or file backed storage, so the
+    // number of storage accesses matters as much as the timings, which are only logged.
+    RunRestoreBenchmark(inSuite, 1);
+    RunRestoreBenchmark(inSuite, 50);
+    RunRestoreBenchmark(inSuite, 200);
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test ReadEndpointValues", TestReadEndpointValues),
+                          NL_TEST_DEF("Test ReadEndpointValues without storage support", TestReadEndpointValuesNotImplemented),
+                          NL_TEST_DEF("Test restore benchmark", TestRestoreBenchmark),
+                          NL_TEST_SENTINEL() };
+
+int TestSetup(void * inContext)
+{
+    VerifyOrReturnError(CHIP_NO_ERROR == Platform::MemoryInit(), FAILURE);
+    return SUCCESS;
+}
+
+int TestTearDown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestDefaultAttributePersistenceProvider()
+{
+    nlTestSuite theSuite = { "DefaultAttributePersistenceProvider", &sTests[0], TestSetup, TestTearDown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDefaultAttributePersistenceProvider)
@@ -0,0 +1,179 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/DeferredAttributeChanges.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemLayerImpl.h>
+
+#include <nlunit-test.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+struct TestContext
+{
+    System::LayerImpl systemLayer;
+};
+
+// Stands in for MatterReportingAttributeChangeCallback.
+std::vector<ConcreteAttributePath> gReportedChanges;
+
+void RecordReport(const ConcreteAttributePath & aPath)
+{
+    gReportedChanges.push_back(aPath);
+}
+
+void ServiceEvents(System::LayerImpl & layer)
+{
+    layer.PrepareEvents();
+    layer.WaitForEvents();
+    layer.HandleEvents();
+}
+
+void TestReportsEachAttributeOnce(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeferredAttributeChanges changes(RecordReport);
+    gReportedChanges.clear();
+
+    // A list written as a ReplaceAll followed by one AppendItem per entry, and another attribute of the same cluster.
+    constexpr unsigned kEntryCount = 30;
+    const ConcreteAttributePath list(1, 2, 3);
+    const ConcreteAttributePath other(1, 2, 4);
+    for (unsigned i = 0; i <= kEntryCount; i++)
+    {
+        changes.OnAttributeChanged(&ctx.systemLayer, list);
+    }
+    changes.OnAttributeChanged(&ctx.systemLayer, other);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.empty());
+    NL_TEST_ASSERT(inSuite, changes.GetRecordedChangeCount() == 2);
+
+    // The changes are reported once the event loop is done with the event that made them.
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 2);
+    NL_TEST_ASSERT(inSuite, gReportedChanges[0] == list);
+    NL_TEST_ASSERT(inSuite, gReportedChanges[1] == other);
+    NL_TEST_ASSERT(inSuite, changes.GetRecordedChangeCount() == 0);
+
+    // Later changes get reports of their own.
+    changes.OnAttributeChanged(&ctx.systemLayer, list);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 3);
+}
+
+void TestReportsClusterBeforeVersionCheck(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeferredAttributeChanges changes(RecordReport);
+    gReportedChanges.clear();
+
+    const ConcreteAttributePath first(1, 2, 3);
+    const ConcreteAttributePath second(1, 5, 3);
+    changes.OnAttributeChanged(&ctx.systemLayer, first);
+    changes.OnAttributeChanged(&ctx.systemLayer, second);
+
+    // Checking the data version of the second cluster only reports the changes to it.
+    const ConcreteClusterPath secondCluster(1, 5);
+    changes.ReportChanges(&secondCluster);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 1);
+    NL_TEST_ASSERT(inSuite, gReportedChanges[0] == second);
+
+    // A change recorded again after the data version check is reported again, after the message.
+    changes.OnAttributeChanged(&ctx.systemLayer, second);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 3);
+    NL_TEST_ASSERT(inSuite, gReportedChanges[1] == first);
+    NL_TEST_ASSERT(inSuite, gReportedChanges[2] == second);
+}
+
+void TestReportsRightAwayWhenUnrecorded(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeferredAttributeChanges changes(RecordReport);
+    gReportedChanges.clear();
+
+    // Without a system layer to report from, nothing is deferred.
+    changes.OnAttributeChanged(nullptr, ConcreteAttributePath(1, 2, 3));
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 1);
+
+    // Changes to attributes beyond the ones that can be recorded are reported right away.
+    for (AttributeId id = 0; id <= CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE; id++)
+    {
+        changes.OnAttributeChanged(&ctx.systemLayer, ConcreteAttributePath(1, 2, id));
+    }
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 2);
+    NL_TEST_ASSERT(inSuite, gReportedChanges[1] == ConcreteAttributePath(1, 2, CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE));
+
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 2 + CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE);
+}
+
+void TestShutdownReportsChanges(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeferredAttributeChanges changes(RecordReport);
+    gReportedChanges.clear();
+
+    // Shutting down reports the recorded changes, and the work scheduled to report them does nothing more.
+    changes.OnAttributeChanged(&ctx.systemLayer, ConcreteAttributePath(1, 2, 3));
+    changes.Shutdown();
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 1);
+    NL_TEST_ASSERT(inSuite, changes.GetRecordedChangeCount() == 0);
+
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, gReportedChanges.size() == 1);
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test each attribute reported once", TestReportsEachAttributeOnce),
+                          NL_TEST_DEF("Test cluster reported before version check", TestReportsClusterBeforeVersionCheck),
+                          NL_TEST_DEF("Test changes reported right away", TestReportsRightAwayWhenUnrecorded),
+                          NL_TEST_DEF("Test shutdown reports changes", TestShutdownReportsChanges),
+                          NL_TEST_SENTINEL() };
+
+int TestSetup(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    VerifyOrReturnError(CHIP_NO_ERROR == Platform::MemoryInit(), FAILURE);
+    VerifyOrReturnError(CHIP_NO_ERROR == ctx.systemLayer.Init(), FAILURE);
+    return SUCCESS;
+}
+
+int TestTearDown(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestDeferredAttributeChanges()
+{
+    TestContext context;
+    nlTestSuite theSuite = { "DeferredAttributeChanges", &sTests[0], TestSetup, TestTearDown };
+
+    nlTestRunner(&theSuite, &context);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDeferredAttributeChanges)
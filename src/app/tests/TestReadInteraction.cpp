@@ -27,6 +27,14 @@
 #include <app/AttributeAccessInterface.h>
 #include <app/InteractionModelEngine.h>
 #include <app/InteractionModelHelper.h>
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/OperationalSessionSetupPool.h>
+#include <app/SimpleSubscriptionResumptionStorage.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 #include <app/MessageDef/AttributeReportIBs.h>
 #include <app/MessageDef/EventDataIB.h>
 #include <app/tests/AppTestContext.h>
@@ -46,6 +54,7 @@
 #include <nlunit-test.h>
 #include <protocols/interaction_model/Constants.h>
 
+#include <memory>
 #include <type_traits>
 
 namespace {
@@ -359,6 +368,9 @@ public:
     static void TestShutdownSubscription(nlTestSuite * apSuite, void * apContext);
     static void TestSubscriptionReportWithDefunctSession(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandlerMalformedSubscribeRequest(nlTestSuite * apSuite, void * apContext);
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    static void TestSubscriptionResumption(nlTestSuite * apSuite, void * apContext);
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
 private:
     static void GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
@@ -4191,6 +4203,148 @@ void TestReadInteraction::TestShutdownSubscription(nlTestSuite * apSuite, void *
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+/**
+ * Tests that persisted subscriptions are resumed after the publisher reboots, and measures how long it takes for all the
+ * subscribers to receive a report again.
+ */
+void TestReadInteraction::TestSubscriptionResumption(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    // More subscriptions than can be resumed at the same time.
+    constexpr size_t kNumSubscriptions = 3 * CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS;
+    constexpr uint16_t kBobCaseKeyId   = 100;
+    constexpr uint16_t kAliceCaseKeyId = 101;
+
+    // Subscriptions are resumed over CASE: use CASE sessions between the subscriber (Bob) and the publisher (Alice), so
+    // that the publisher finds an existing session when resuming.
+    SessionHolder sessionBobToAlice;
+    SessionHolder sessionAliceToBob;
+    err = ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+        sessionBobToAlice, kBobCaseKeyId, kAliceCaseKeyId, ctx.GetBobFabric()->GetNodeId(), ctx.GetAliceFabric()->GetNodeId(),
+        ctx.GetBobFabricIndex(), ctx.GetAliceAddress(), CryptoContext::SessionRole::kInitiator);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+        sessionAliceToBob, kAliceCaseKeyId, kBobCaseKeyId, ctx.GetAliceFabric()->GetNodeId(), ctx.GetBobFabric()->GetNodeId(),
+        ctx.GetAliceFabricIndex(), ctx.GetBobAddress(), CryptoContext::SessionRole::kResponder);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    chip::TestPersistentStorageDelegate storage;
+    SimpleSubscriptionResumptionStorage subscriptionStorage;
+    err = subscriptionStorage.Init(&storage);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // Only used to establish new CASE sessions, which the publisher does not need to do here.
+    Credentials::GroupDataProviderImpl groupDataProvider;
+
+    CASEClientPool<kNumSubscriptions> caseClientPool;
+    OperationalSessionSetupPool<kNumSubscriptions> sessionSetupPool;
+    CASESessionManagerConfig caseSessionManagerConfig;
+    caseSessionManagerConfig.sessionInitParams.sessionManager    = &ctx.GetSecureSessionManager();
+    caseSessionManagerConfig.sessionInitParams.exchangeMgr       = &ctx.GetExchangeManager();
+    caseSessionManagerConfig.sessionInitParams.fabricTable       = &ctx.GetFabricTable();
+    caseSessionManagerConfig.sessionInitParams.groupDataProvider = &groupDataProvider;
+    caseSessionManagerConfig.clientPool                          = &caseClientPool;
+    caseSessionManagerConfig.sessionSetupPool                    = &sessionSetupPool;
+
+    CASESessionManager caseSessionManager;
+    err = caseSessionManager.Init(&ctx.GetSystemLayer(), caseSessionManagerConfig);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    err           = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), &caseSessionManager, &subscriptionStorage);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    MockInteractionModelApp delegates[kNumSubscriptions];
+    std::unique_ptr<app::ReadClient> readClients[kNumSubscriptions];
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        ReadPrepareParams readPrepareParams(sessionBobToAlice.Get().Value());
+        readPrepareParams.mpEventPathParamsList    = new chip::app::EventPathParams[1];
+        readPrepareParams.mEventPathParamsListSize = 1;
+
+        readPrepareParams.mpEventPathParamsList[0].mEndpointId = kTestEndpointId;
+        readPrepareParams.mpEventPathParamsList[0].mClusterId  = kTestClusterId;
+        readPrepareParams.mpEventPathParamsList[0].mEventId    = kTestEventIdDebug;
+
+        readPrepareParams.mpAttributePathParamsList    = new chip::app::AttributePathParams[1];
+        readPrepareParams.mAttributePathParamsListSize = 1;
+
+        readPrepareParams.mpAttributePathParamsList[0].mEndpointId  = kTestEndpointId;
+        readPrepareParams.mpAttributePathParamsList[0].mClusterId   = kTestClusterId;
+        readPrepareParams.mpAttributePathParamsList[0].mAttributeId = 1;
+
+        readPrepareParams.mMinIntervalFloorSeconds   = 0;
+        readPrepareParams.mMaxIntervalCeilingSeconds = 10;
+        readPrepareParams.mKeepSubscriptions         = true;
+
+        readClients[i] = std::make_unique<app::ReadClient>(engine, &ctx.GetExchangeManager(), delegates[i],
+                                                           chip::app::ReadClient::InteractionType::Subscribe);
+        err            = readClients[i]->SendAutoResubscribeRequest(std::move(readPrepareParams));
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe) == kNumSubscriptions);
+
+    // Reboot the publisher: its subscriptions go away, but remain persisted and the subscribers do not know.
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        NL_TEST_ASSERT(apSuite, delegates[i].mGotReport);
+        delegates[i].mGotReport = false;
+    }
+    while (engine->GetNumActiveReadHandlers() > 0)
+    {
+        engine->ActiveHandlerAt(0)->Close(ReadHandler::CloseOptions::kKeepPersistedSubscription);
+    }
+
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(apSuite, iterator->Count() == kNumSubscriptions);
+    iterator->Release();
+
+    const uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+
+    err = engine->ResumeSubscriptions();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() {
+        for (auto & delegate : delegates)
+        {
+            if (!delegate.mGotReport)
+            {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    const uint64_t elapsed = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    ChipLogProgress(DataManagement, "All %u subscribers got a report %u us after resumption started",
+                    static_cast<unsigned>(kNumSubscriptions), static_cast<unsigned>(elapsed));
+
+    ctx.DrainAndServiceIO();
+
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        NL_TEST_ASSERT(apSuite, delegates[i].mGotReport);
+        NL_TEST_ASSERT(apSuite, readClients[i]->IsSubscriptionActive());
+    }
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe) == kNumSubscriptions);
+
+    for (auto & readClient : readClients)
+    {
+        readClient.reset();
+    }
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadClients() == 0);
+
+    sessionBobToAlice->AsSecureSession()->MarkForEviction();
+    sessionAliceToBob->AsSecureSession()->MarkForEviction();
+}
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
 /**
  * Tests what happens when a subscription tries to deliver reports but the
  * session it has is defunct.  Makes sure we correctly tear down the ReadHandler
@@ -4347,6 +4501,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestPostSubscribeRoundtripChunkReportTimeout", chip::app::TestReadInteraction::TestPostSubscribeRoundtripChunkReportTimeout),
     NL_TEST_DEF("TestReadShutdown", chip::app::TestReadInteraction::TestReadShutdown),
     NL_TEST_DEF("TestSubscriptionReportWithDefunctSession", chip::app::TestReadInteraction::TestSubscriptionReportWithDefunctSession),
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    NL_TEST_DEF("TestSubscriptionResumption", chip::app::TestReadInteraction::TestSubscriptionResumption),
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,319 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeAccessInterface.h>
+#include <app/reporting/ReportEncodingCache.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+#include <cstring>
+#include <ctime>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr EndpointId kTestEndpointId = 1;
+constexpr ClusterId kTestClusterId   = 0x28;
+constexpr FabricIndex kTestFabric    = 1;
+
+DataVersion gClusterVersion = 7;
+
+bool MatchesClusterVersion(const ConcreteClusterPath & aPath, DataVersion aVersion)
+{
+    return aVersion == gClusterVersion;
+}
+
+/**
+ * Stands for the data model: encodes a label of the given length, counting how many times it does so.
+ */
+struct LabelReader
+{
+    CHIP_ERROR operator()(AttributeReportIBs::Builder & aBuilder)
+    {
+        reads++;
+        return AttributeValueEncoder(aBuilder, kTestFabric, path, gClusterVersion).Encode(CharSpan(label, labelLength));
+    }
+
+    ConcreteAttributePath path;
+    const char * label = "Living room lamp";
+    size_t labelLength = strlen(label);
+    uint32_t reads     = 0;
+};
+
+/**
+ * A report message being built, holding the reports of a single subscription.
+ */
+struct Report
+{
+    Report()
+    {
+        writer.Init(buffer, sizeof(buffer));
+        builder.Init(&writer);
+    }
+
+    size_t Finish()
+    {
+        builder.EndOfAttributeReportIBs();
+        writer.Finalize();
+        return writer.GetLengthWritten();
+    }
+
+    uint8_t buffer[1024];
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder builder;
+};
+
+ReportEncodingCache::Key KeyFor(const ConcreteAttributePath & aPath, FabricIndex aFabric = kTestFabric, bool aAccessAllowed = true)
+{
+    return ReportEncodingCache::Key(aPath, aFabric, /* aIsFabricFiltered = */ true, aAccessAllowed);
+}
+
+void TestReusesEncodedReports(nlTestSuite * inSuite, void * inContext)
+{
+    ReportEncodingCache cache(MatchesClusterVersion);
+    LabelReader reader;
+    reader.path = ConcreteAttributePath(kTestEndpointId, kTestClusterId, 5);
+
+    Report direct;
+    NL_TEST_ASSERT(inSuite, reader(direct.builder) == CHIP_NO_ERROR);
+    size_t directLength = direct.Finish();
+
+    // Every subscription gets the same bytes, while the attribute is only read once.
+    for (int i = 0; i < 3; i++)
+    {
+        Report shared;
+        NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), shared.builder, reader));
+        NL_TEST_ASSERT(inSuite, shared.Finish() == directLength);
+        NL_TEST_ASSERT(inSuite, memcmp(shared.buffer, direct.buffer, directLength) == 0);
+    }
+    NL_TEST_ASSERT(inSuite, reader.reads == 2);
+    NL_TEST_ASSERT(inSuite, cache.GetHitCount() == 2);
+}
+
+void TestKeyMismatch(nlTestSuite * inSuite, void * inContext)
+{
+    ReportEncodingCache cache(MatchesClusterVersion);
+    LabelReader reader;
+    reader.path = ConcreteAttributePath(kTestEndpointId, kTestClusterId, 5);
+
+    Report report;
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 1);
+
+    // Another accessing fabric, another access decision or an expanded path all need their own reports.
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path, kTestFabric + 1), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 2);
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path, kTestFabric, false), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 3);
+
+    ConcreteAttributePath expandedPath(reader.path);
+    expandedPath.mExpanded = true;
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(expandedPath), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 4);
+
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 4);
+}
+
+void TestInvalidation(nlTestSuite * inSuite, void * inContext)
+{
+    ReportEncodingCache cache(MatchesClusterVersion);
+    LabelReader reader;
+    reader.path = ConcreteAttributePath(kTestEndpointId, kTestClusterId, 5);
+    LabelReader otherReader;
+    otherReader.path = ConcreteAttributePath(kTestEndpointId, kTestClusterId, 6);
+
+    Report report;
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(otherReader.path), report.builder, otherReader));
+
+    // A new data version of the cluster makes the reports stale.
+    gClusterVersion++;
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 2);
+
+    // So does marking the attribute dirty, even if its cluster data version did not change.
+    cache.Invalidate(AttributePathParams(kTestEndpointId, kTestClusterId, 5));
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 3);
+
+    // A dirty cluster covers all its attributes.
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(otherReader.path), report.builder, otherReader));
+    NL_TEST_ASSERT(inSuite, otherReader.reads == 2);
+    cache.Invalidate(AttributePathParams(kTestEndpointId, kTestClusterId));
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(otherReader.path), report.builder, otherReader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 4);
+    NL_TEST_ASSERT(inSuite, otherReader.reads == 3);
+}
+
+void TestUncacheableReports(nlTestSuite * inSuite, void * inContext)
+{
+    ReportEncodingCache cache(MatchesClusterVersion);
+    char longLabel[CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRY_SIZE];
+    memset(longLabel, 'a', sizeof(longLabel));
+
+    LabelReader reader;
+    reader.path        = ConcreteAttributePath(kTestEndpointId, kTestClusterId, 5);
+    reader.label       = longLabel;
+    reader.labelLength = sizeof(longLabel);
+
+    // Reports too large for an entry are left to the caller, which is not asked to try again.
+    Report report;
+    NL_TEST_ASSERT(inSuite, !cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, !cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 1);
+    NL_TEST_ASSERT(inSuite, report.writer.GetLengthWritten() == 1);
+
+    // Nor after the attribute changes, so that its reports are only encoded once per subscription.
+    cache.Invalidate(AttributePathParams(kTestEndpointId, kTestClusterId, 5));
+    gClusterVersion++;
+    NL_TEST_ASSERT(inSuite, !cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 1);
+}
+
+void TestReportOutOfSpace(nlTestSuite * inSuite, void * inContext)
+{
+    ReportEncodingCache cache(MatchesClusterVersion);
+    LabelReader reader;
+    reader.path = ConcreteAttributePath(kTestEndpointId, kTestClusterId, 5);
+
+    Report report;
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+
+    // When the reports do not fit in the message, nothing is written, and the reports remain cached for the next chunk.
+    uint8_t buffer[16];
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder builder;
+    writer.Init(buffer, sizeof(buffer));
+    NL_TEST_ASSERT(inSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !cache.TryEncode(KeyFor(reader.path), builder, reader));
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == 1);
+
+    NL_TEST_ASSERT(inSuite, cache.TryEncode(KeyFor(reader.path), report.builder, reader));
+    NL_TEST_ASSERT(inSuite, reader.reads == 1);
+}
+
+constexpr size_t kBenchmarkAttributes = 4;
+constexpr int kBenchmarkRounds        = 200;
+
+struct BenchmarkResult
+{
+    uint32_t reads;
+    double cpuMicroseconds;
+};
+
+/**
+ * Builds the reports of every subscription to the dirty attributes, as the reporting engine does after they change.
+ */
+BenchmarkResult RunSubscribers(size_t aSubscribers, bool aShareEncoding)
+{
+    ReportEncodingCache cache(MatchesClusterVersion);
+    LabelReader readers[kBenchmarkAttributes];
+    for (size_t i = 0; i < kBenchmarkAttributes; i++)
+    {
+        readers[i].path = ConcreteAttributePath(kTestEndpointId, kTestClusterId, static_cast<AttributeId>(i));
+    }
+
+    std::clock_t start = std::clock();
+    for (int round = 0; round < kBenchmarkRounds; round++)
+    {
+        gClusterVersion++;
+        for (size_t subscriber = 0; subscriber < aSubscribers; subscriber++)
+        {
+            Report report;
+            for (auto & reader : readers)
+            {
+                // As in the reporting engine, the reports are only shared between several subscriptions.
+                if (!aShareEncoding || aSubscribers == 1 || !cache.TryEncode(KeyFor(reader.path), report.builder, reader))
+                {
+                    reader(report.builder);
+                }
+            }
+            report.Finish();
+        }
+    }
+    std::clock_t end = std::clock();
+
+    BenchmarkResult result = { 0, 1e6 * static_cast<double>(end - start) / CLOCKS_PER_SEC / kBenchmarkRounds };
+    for (auto & reader : readers)
+    {
+        result.reads += reader.reads;
+    }
+    return result;
+}
+
+void TestReportEncodingBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t subscriberCounts[] = { 1, 4, 16, 64 };
+
+    for (size_t subscribers : subscriberCounts)
+    {
+        // The timings depend on the host and are only logged.
+        BenchmarkResult perSubscriber = RunSubscribers(subscribers, false);
+        BenchmarkResult shared        = RunSubscribers(subscribers, true);
+
+        ChipLogProgress(Test,
+                        "%u identical subscriptions, %u dirty attributes: per-subscription encoding %u reads (%u us per report "
+                        "round), shared encoding %u reads (%u us per report round)",
+                        static_cast<unsigned>(subscribers), static_cast<unsigned>(kBenchmarkAttributes),
+                        static_cast<unsigned>(perSubscriber.reads), static_cast<unsigned>(perSubscriber.cpuMicroseconds),
+                        static_cast<unsigned>(shared.reads), static_cast<unsigned>(shared.cpuMicroseconds));
+
+        // Each dirty attribute is read once per data version, whatever the number of subscriptions.
+        NL_TEST_ASSERT(inSuite, perSubscriber.reads == subscribers * kBenchmarkAttributes * kBenchmarkRounds);
+        NL_TEST_ASSERT(inSuite, shared.reads == kBenchmarkAttributes * kBenchmarkRounds);
+    }
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test reused encoded reports", TestReusesEncodedReports),
+                          NL_TEST_DEF("Test key mismatch", TestKeyMismatch),
+                          NL_TEST_DEF("Test invalidation", TestInvalidation),
+                          NL_TEST_DEF("Test uncacheable reports", TestUncacheableReports),
+                          NL_TEST_DEF("Test report out of space", TestReportOutOfSpace),
+                          NL_TEST_DEF("Test report encoding benchmark", TestReportEncodingBenchmark),
+                          NL_TEST_SENTINEL() };
+
+int TestSetup(void * inContext)
+{
+    VerifyOrReturnError(CHIP_NO_ERROR == Platform::MemoryInit(), FAILURE);
+    return SUCCESS;
+}
+
+int TestTearDown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestReportEncodingCache()
+{
+    nlTestSuite theSuite = { "ReportEncodingCache", &sTests[0], TestSetup, TestTearDown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestReportEncodingCache)
@@ -0,0 +1,335 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/ReadClient.h>
+#include <app/reporting/ReportScheduler.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+
+#include <nlunit-test.h>
+
+#include <ctime>
+#include <memory>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+/**
+ * Replaces the system clock with a mock one, starting from the current time, for the lifetime of the object.
+ */
+class MockClockScope
+{
+public:
+    MockClockScope() : mRealClock(System::SystemClock())
+    {
+        mMockClock.SetMonotonic(mRealClock.GetMonotonicMilliseconds64());
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+    ~MockClockScope() { System::Clock::Internal::SetSystemClockForTesting(&mRealClock); }
+
+    System::Clock::Internal::MockClock & Get() { return mMockClock; }
+
+private:
+    System::Clock::ClockBase & mRealClock;
+    System::Clock::Internal::MockClock mMockClock;
+};
+
+/**
+ * Services the events due at the current time of the mock clock, along with the messages they send, without waiting
+ * for later ones.
+ */
+void ServiceDueEvents(TestContext & ctx)
+{
+    auto & layer = static_cast<System::LayerImpl &>(ctx.GetSystemLayer());
+    bool hadPendingMessages;
+    do
+    {
+        hadPendingMessages = ctx.GetLoopback().HasPendingMessages();
+        // A timer due now keeps WaitForEvents from blocking until the next timer.
+        layer.StartTimer(System::Clock::kZero, [](System::Layer *, void *) {}, nullptr);
+        layer.PrepareEvents();
+        layer.WaitForEvents();
+        layer.HandleEvents();
+    } while (hadPendingMessages || ctx.GetLoopback().HasPendingMessages());
+}
+
+/**
+ * Advances the mock clock by aDuration, one aStep at a time, servicing the events due after each step.
+ */
+void AdvanceClock(TestContext & ctx, MockClockScope & clock, System::Clock::Milliseconds32 aDuration,
+                  System::Clock::Milliseconds32 aStep = 1_ms32)
+{
+    for (System::Clock::Milliseconds32 elapsed = 0_ms32; elapsed < aDuration; elapsed += aStep)
+    {
+        clock.Get().AdvanceMonotonic(aStep);
+        ServiceDueEvents(ctx);
+    }
+}
+
+struct TestNode : public ReportScheduler::Node
+{
+    void OnMinIntervalElapsed() override
+    {
+        minElapsedAt = System::SystemClock().GetMonotonicTimestamp();
+        minIntervalsElapsed++;
+    }
+    void OnMaxIntervalElapsed() override
+    {
+        maxElapsedAt = System::SystemClock().GetMonotonicTimestamp();
+        maxIntervalsElapsed++;
+    }
+
+    System::Clock::Timestamp minElapsedAt;
+    System::Clock::Timestamp maxElapsedAt;
+    uint32_t minIntervalsElapsed = 0;
+    uint32_t maxIntervalsElapsed = 0;
+};
+
+void TestMinThenMaxInterval(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    MockClockScope clock;
+    ReportScheduler scheduler(0_ms32);
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer()) == CHIP_NO_ERROR);
+
+    TestNode node;
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(node, 20_ms32, 10_ms32) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, !scheduler.IsScheduled(node));
+
+    const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(node, 20_ms32, 40_ms32) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.IsScheduled(node));
+
+    AdvanceClock(ctx, clock, 20_ms32);
+    NL_TEST_ASSERT(inSuite, node.minIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, node.maxIntervalsElapsed == 0);
+    NL_TEST_ASSERT(inSuite, node.minElapsedAt == start + 20_ms32);
+
+    AdvanceClock(ctx, clock, 20_ms32);
+    NL_TEST_ASSERT(inSuite, node.minIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, node.maxIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, node.maxElapsedAt == start + 40_ms32);
+
+    // The node waits to be scheduled again once its max interval elapsed, and the timer fired once per interval.
+    NL_TEST_ASSERT(inSuite, !scheduler.IsScheduled(node));
+    NL_TEST_ASSERT(inSuite, scheduler.GetTickCount() == 2);
+
+    scheduler.Shutdown();
+}
+
+void TestRescheduleAndUnschedule(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    MockClockScope clock;
+    ReportScheduler scheduler(0_ms32);
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer()) == CHIP_NO_ERROR);
+
+    TestNode rescheduled, unscheduled, reference;
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(rescheduled, 10_ms32, 20_ms32) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(unscheduled, 10_ms32, 20_ms32) == CHIP_NO_ERROR);
+
+    // Scheduling a node again replaces its intervals, as sending a report restarts them.
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(rescheduled, 60_ms32, 80_ms32) == CHIP_NO_ERROR);
+    scheduler.Unschedule(unscheduled);
+    NL_TEST_ASSERT(inSuite, !scheduler.IsScheduled(unscheduled));
+    // Unscheduling a node that is not scheduled is harmless.
+    scheduler.Unschedule(unscheduled);
+
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(reference, 30_ms32, 40_ms32) == CHIP_NO_ERROR);
+    AdvanceClock(ctx, clock, 40_ms32);
+    NL_TEST_ASSERT(inSuite, reference.maxIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, rescheduled.minIntervalsElapsed == 0);
+    NL_TEST_ASSERT(inSuite, unscheduled.minIntervalsElapsed == 0);
+
+    AdvanceClock(ctx, clock, 40_ms32);
+    NL_TEST_ASSERT(inSuite, rescheduled.minIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, rescheduled.maxIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, unscheduled.minIntervalsElapsed == 0);
+    NL_TEST_ASSERT(inSuite, unscheduled.maxIntervalsElapsed == 0);
+
+    // Shutting down unschedules the remaining nodes.
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(unscheduled, 10_ms32, 20_ms32) == CHIP_NO_ERROR);
+    scheduler.Shutdown();
+    NL_TEST_ASSERT(inSuite, !scheduler.IsScheduled(unscheduled));
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(unscheduled, 10_ms32, 20_ms32) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+void TestCoalescesMaxIntervals(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    MockClockScope clock;
+    ReportScheduler scheduler(50_ms32);
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.GetSystemLayer()) == CHIP_NO_ERROR);
+
+    // The report windows of the first two nodes overlap within the coalescing window, so their max intervals end
+    // together. The min interval of the third one has not elapsed by then, so its report is not sent early.
+    TestNode first, second, late;
+    const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(first, 0_ms32, 100_ms32) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(second, 10_ms32, 130_ms32) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.Schedule(late, 200_ms32, 210_ms32) == CHIP_NO_ERROR);
+
+    AdvanceClock(ctx, clock, 100_ms32);
+    NL_TEST_ASSERT(inSuite, first.maxIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, second.maxIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, first.maxElapsedAt == start + 100_ms32);
+    NL_TEST_ASSERT(inSuite, second.maxElapsedAt == start + 100_ms32);
+    NL_TEST_ASSERT(inSuite, late.minIntervalsElapsed == 0);
+    NL_TEST_ASSERT(inSuite, late.maxIntervalsElapsed == 0);
+
+    // The max interval of the last node ends with its min interval, which is never shortened.
+    AdvanceClock(ctx, clock, 100_ms32);
+    NL_TEST_ASSERT(inSuite, late.minIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, late.maxIntervalsElapsed == 1);
+    NL_TEST_ASSERT(inSuite, late.minElapsedAt == start + 200_ms32);
+    NL_TEST_ASSERT(inSuite, late.maxElapsedAt == start + 200_ms32);
+
+    scheduler.Shutdown();
+}
+
+// Tracks a subscription, and counts the reports of its publisher.
+class SubscriptionCallback : public ReadClient::Callback
+{
+public:
+    void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override { mEstablished = true; }
+    void OnError(CHIP_ERROR aError) override { mError = aError; }
+    void OnDone(ReadClient * apReadClient) override {}
+    // Called for every report from the publisher, to any of its subscriptions, including the empty ones sent when the
+    // max interval elapses.
+    void OnUnsolicitedMessageFromPublisher(ReadClient * apReadClient) override { mPublisherReports++; }
+
+    bool mEstablished          = false;
+    CHIP_ERROR mError          = CHIP_NO_ERROR;
+    uint32_t mPublisherReports = 0;
+};
+
+constexpr size_t kBenchmarkSubscriptions             = 32;
+constexpr uint16_t kBenchmarkMinIntervalSeconds      = 1;
+constexpr uint16_t kBenchmarkMaxIntervalSeconds      = 10;
+constexpr uint16_t kBenchmarkMaxIntervalSpreadSeconds = 6;
+constexpr System::Clock::Milliseconds32 kBenchmarkSubscriptionSpacing(100);
+constexpr System::Clock::Milliseconds32 kBenchmarkDuration(120 * 1000);
+constexpr System::Clock::Milliseconds32 kBenchmarkClockStep(10);
+
+// Subscriptions to unchanging data, established 100 ms apart, with max intervals of 10 to 15 s, are served by the
+// reporting engine for two minutes. Their report windows overlap, so their max intervals are coalesced by the scheduler
+// of the engine. Each report used to take two System Layer timers, for the min and for the max interval of the
+// ReadHandler.
+void TestReportSchedulerBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    MockClockScope clock;
+
+    auto * engine = InteractionModelEngine::GetInstance();
+    ReportScheduler & scheduler = engine->GetReportingEngine().GetReportScheduler();
+
+    SubscriptionCallback callbacks[kBenchmarkSubscriptions];
+    std::unique_ptr<ReadClient> clients[kBenchmarkSubscriptions];
+    for (size_t i = 0; i < kBenchmarkSubscriptions; i++)
+    {
+        AttributePathParams attributePath(Test::kMockEndpoint2, Test::MockClusterId(3), Test::MockAttributeId(1));
+        ReadPrepareParams readPrepareParams(ctx.GetSessionBobToAlice());
+        readPrepareParams.mpAttributePathParamsList    = &attributePath;
+        readPrepareParams.mAttributePathParamsListSize = 1;
+        readPrepareParams.mMinIntervalFloorSeconds     = kBenchmarkMinIntervalSeconds;
+        readPrepareParams.mKeepSubscriptions           = true;
+        readPrepareParams.mMaxIntervalCeilingSeconds =
+            static_cast<uint16_t>(kBenchmarkMaxIntervalSeconds + i % kBenchmarkMaxIntervalSpreadSeconds);
+
+        clients[i] = std::make_unique<ReadClient>(engine, &ctx.GetExchangeManager(), callbacks[i],
+                                                  ReadClient::InteractionType::Subscribe);
+        NL_TEST_ASSERT(inSuite, clients[i]->SendRequest(readPrepareParams) == CHIP_NO_ERROR);
+        ServiceDueEvents(ctx);
+        NL_TEST_ASSERT(inSuite, callbacks[i].mEstablished);
+        AdvanceClock(ctx, clock, kBenchmarkSubscriptionSpacing, kBenchmarkClockStep);
+    }
+
+    const uint32_t startTicks   = scheduler.GetTickCount();
+    const uint32_t startReports = callbacks[0].mPublisherReports;
+
+    std::clock_t startCpu = std::clock();
+    AdvanceClock(ctx, clock, kBenchmarkDuration, kBenchmarkClockStep);
+    std::clock_t cpu = std::clock() - startCpu;
+
+    const uint32_t ticks   = scheduler.GetTickCount() - startTicks;
+    const uint32_t reports = callbacks[0].mPublisherReports - startReports;
+    // A subscription that missed its reports would have failed its liveness check.
+    for (auto & callback : callbacks)
+    {
+        NL_TEST_ASSERT(inSuite, callback.mError == CHIP_NO_ERROR);
+    }
+
+    // The timings depend on the host, and include the loopback messaging, so they are only logged.
+    ChipLogProgress(Test,
+                    "%u subscriptions over %u s: %u reports, %u report scheduler timer callbacks (per-handler timers: %u), "
+                    "%u us CPU per simulated second",
+                    static_cast<unsigned>(kBenchmarkSubscriptions), static_cast<unsigned>(kBenchmarkDuration.count() / 1000),
+                    static_cast<unsigned>(reports), static_cast<unsigned>(ticks), static_cast<unsigned>(2 * reports),
+                    static_cast<unsigned>(static_cast<uint64_t>(cpu) * 1000000u / CLOCKS_PER_SEC /
+                                          (kBenchmarkDuration.count() / 1000)));
+
+    // Coalescing the max intervals must not leave subscriptions without their reports, and takes fewer timer callbacks.
+    const uint32_t maxIntervalSeconds = kBenchmarkMaxIntervalSeconds + kBenchmarkMaxIntervalSpreadSeconds - 1;
+    NL_TEST_ASSERT(inSuite,
+                   reports >= kBenchmarkSubscriptions * (kBenchmarkDuration.count() / 1000 / maxIntervalSeconds - 1));
+    NL_TEST_ASSERT(inSuite, ticks < 2 * reports);
+
+    engine->ShutdownActiveReads();
+    ServiceDueEvents(ctx);
+    NL_TEST_ASSERT(inSuite, engine->GetNumActiveReadHandlers() == 0);
+    NL_TEST_ASSERT(inSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Test min then max interval", TestMinThenMaxInterval),
+    NL_TEST_DEF("Test rescheduled and unscheduled nodes", TestRescheduleAndUnschedule),
+    NL_TEST_DEF("Test coalesced max intervals", TestCoalescesMaxIntervals),
+    NL_TEST_DEF("Test report scheduler benchmark", TestReportSchedulerBenchmark),
+    NL_TEST_SENTINEL()
+};
+
+nlTestSuite sSuite =
+{
+    "TestReportScheduler",
+    &sTests[0],
+    TestContext::Initialize,
+    TestContext::Finalize
+};
+// clang-format on
+
+} // namespace
+
+int TestReportScheduler()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestReportScheduler)
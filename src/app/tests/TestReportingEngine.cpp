@@ -26,6 +26,7 @@
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
 #include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVDebug.h>
@@ -56,6 +57,7 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestDataVersionFilterLookup(nlTestSuite * apSuite, void * apContext);
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
@@ -121,6 +123,31 @@ public:
     chip::app::ReadHandler::ApplicationCallback * GetAppCallback() override { return nullptr; }
 };
 
+namespace {
+
+// The lookup of the data version filters before they were sorted, for reference.
+bool IsClusterDataVersionMatchLinear(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
+                                     const ConcreteReadAttributePath & aPath)
+{
+    bool existPathMatch       = false;
+    bool existVersionMismatch = false;
+    for (auto filter = aDataVersionFilterList; filter != nullptr; filter = filter->mpNext)
+    {
+        if (aPath.mEndpointId == filter->mValue.mEndpointId && aPath.mClusterId == filter->mValue.mClusterId)
+        {
+            existPathMatch = true;
+            if (!IsClusterDataVersionEqual(ConcreteClusterPath(filter->mValue.mEndpointId, filter->mValue.mClusterId),
+                                           filter->mValue.mDataVersion.Value()))
+            {
+                existVersionMismatch = true;
+            }
+        }
+    }
+    return existPathMatch && !existVersionMismatch;
+}
+
+} // namespace
+
 void TestReportingEngine::TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
@@ -321,6 +348,101 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestDataVersionFilterLookup(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx                      = *static_cast<TestContext *>(apContext);
+    constexpr size_t kFilterCount          = 300;
+    constexpr size_t kMockClusterFilters   = 12;
+    constexpr unsigned kPrimingReportCount = 100;
+    DummyDelegate dummy;
+
+    NL_TEST_ASSERT(apSuite, InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable()) ==
+                       CHIP_NO_ERROR);
+    Engine & reportingEngine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    TestExchangeDelegate delegate;
+    Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(&delegate);
+    app::ReadHandler readHandler(dummy, exchangeCtx, chip::app::ReadHandler::InteractionType::Read);
+
+    // Filters for the clusters of the mock endpoints, among many for clusters the device does not have, in no particular order.
+    ObjectList<DataVersionFilter> filters[kFilterCount];
+    for (size_t i = 0; i < kFilterCount; i++)
+    {
+        size_t n = (i * 7919) % kFilterCount;
+        if (n < kMockClusterFilters)
+        {
+            filters[i].mValue = DataVersionFilter(static_cast<EndpointId>(Test::kMockEndpoint1 - n / 4),
+                                                  Test::MockClusterId(static_cast<uint16_t>(n % 4 + 1)), 0);
+        }
+        else
+        {
+            filters[i].mValue = DataVersionFilter(static_cast<EndpointId>(n / 8), static_cast<ClusterId>(n % 8), 0);
+        }
+        filters[i].mpNext = (i + 1 < kFilterCount) ? &filters[i + 1] : nullptr;
+    }
+    // Keep the filters in their original order for the reference lookup.
+    ObjectList<DataVersionFilter> unsortedFilters[kFilterCount];
+    for (size_t i = 0; i < kFilterCount; i++)
+    {
+        unsortedFilters[i].mValue  = filters[i].mValue;
+        unsortedFilters[i].mpNext = (i + 1 < kFilterCount) ? &unsortedFilters[i + 1] : nullptr;
+    }
+
+    readHandler.mpDataVersionFilterList = &filters[0];
+    readHandler.SortDataVersionFilterList();
+    NL_TEST_ASSERT(apSuite, readHandler.GetDataVersionFilterCount() == kFilterCount);
+    for (auto filter = readHandler.GetDataVersionFilterList(); filter->mpNext != nullptr; filter = filter->mpNext)
+    {
+        const DataVersionFilter & next = filter->mpNext->mValue;
+        NL_TEST_ASSERT(apSuite,
+                       filter->mValue.mEndpointId < next.mEndpointId ||
+                           (filter->mValue.mEndpointId == next.mEndpointId && filter->mValue.mClusterId <= next.mClusterId));
+    }
+
+    // Filter the attributes of the mock endpoints as priming reports do.
+    ObjectList<AttributePathParams> wildcardPath;
+    ConcreteReadAttributePath path;
+    size_t linearMatches = 0;
+    size_t matches       = 0;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (unsigned i = 0; i < kPrimingReportCount; i++)
+    {
+        for (AttributePathExpandIterator iterator(&wildcardPath); iterator.Get(path); iterator.Next())
+        {
+            linearMatches += IsClusterDataVersionMatchLinear(&unsortedFilters[0], path) ? 1 : 0;
+        }
+    }
+    System::Clock::Microseconds64 linearTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (unsigned i = 0; i < kPrimingReportCount; i++)
+    {
+        for (AttributePathExpandIterator iterator(&wildcardPath); iterator.Get(path); iterator.Next())
+        {
+            matches += reportingEngine.IsClusterDataVersionMatch(&readHandler, path) ? 1 : 0;
+        }
+    }
+    System::Clock::Microseconds64 sortedTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    NL_TEST_ASSERT(apSuite, matches == linearMatches);
+    for (AttributePathExpandIterator iterator(&wildcardPath); iterator.Get(path); iterator.Next())
+    {
+        NL_TEST_ASSERT(apSuite,
+                       reportingEngine.IsClusterDataVersionMatch(&readHandler, path) ==
+                           IsClusterDataVersionMatchLinear(&unsortedFilters[0], path));
+        // Every cluster of the mock endpoints has a filter.
+        NL_TEST_ASSERT(apSuite, readHandler.FindDataVersionFilter(path) != nullptr);
+    }
+
+    ChipLogProgress(Test, "%u priming reports with %u data version filters: linear lookup %u us, sorted lookup %u us",
+                    kPrimingReportCount, static_cast<unsigned>(kFilterCount), static_cast<unsigned>(linearTime.count()),
+                    static_cast<unsigned>(sortedTime.count()));
+
+    // The filters are not from the pool of the interaction model engine.
+    readHandler.mpDataVersionFilterList   = nullptr;
+    readHandler.mpDataVersionFilterCursor = nullptr;
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -332,6 +454,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestDataVersionFilterLookup", chip::app::reporting::TestReportingEngine::TestDataVersionFilterLookup),
     NL_TEST_SENTINEL()
 };
 // clang-format on
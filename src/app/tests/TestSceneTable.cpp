@@ -23,7 +23,9 @@
 #include <lib/support/Span.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <nlunit-test.h>
+#include <system/SystemClock.h>
 
 using namespace chip;
 
@@ -1602,6 +1604,102 @@ void TestEndpointScenes(nlTestSuite * aSuite, void * aContext)
     NL_TEST_ASSERT(aSuite, 0 == fabric_capacity);
 }
 
+void TestSceneCache(nlTestSuite * aSuite, void * aContext)
+{
+    SceneTable * sceneTable = scenes::GetSceneTableImpl(kTestEndpoint1);
+    NL_TEST_ASSERT(aSuite, nullptr != sceneTable);
+    VerifyOrReturn(nullptr != sceneTable);
+
+    // Reset test
+    ResetSceneTable(sceneTable);
+    sceneTable = scenes::GetSceneTableImpl(kTestEndpoint1);
+
+    SceneTableEntry scene;
+
+    // Cached scenes follow overwrites and removals
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->SetSceneTableEntry(kFabric1, scene1));
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    NL_TEST_ASSERT(aSuite, scene == scene1);
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->SetSceneTableEntry(kFabric1, scene10));
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    NL_TEST_ASSERT(aSuite, scene == scene10);
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->RemoveSceneTableEntry(kFabric1, sceneId1));
+    NL_TEST_ASSERT(aSuite, CHIP_ERROR_NOT_FOUND == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+
+    // Scenes are cached per endpoint
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->SetSceneTableEntry(kFabric1, scene1));
+    sceneTable = scenes::GetSceneTableImpl(kTestEndpoint2);
+    NL_TEST_ASSERT(aSuite, CHIP_ERROR_NOT_FOUND == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->SetSceneTableEntry(kFabric1, scene10));
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    NL_TEST_ASSERT(aSuite, scene == scene10);
+    sceneTable = scenes::GetSceneTableImpl(kTestEndpoint1);
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    NL_TEST_ASSERT(aSuite, scene == scene1);
+
+    // A change made through another table using the same storage is visible right away
+    TestSceneTableImpl otherTable;
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == otherTable.Init(&testStorage));
+    otherTable.SetEndpoint(kTestEndpoint1);
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == otherTable.SetSceneTableEntry(kFabric1, scene10));
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    NL_TEST_ASSERT(aSuite, scene == scene10);
+    NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == otherTable.RemoveFabric(kFabric1));
+    NL_TEST_ASSERT(aSuite, CHIP_ERROR_NOT_FOUND == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+    otherTable.Finish();
+
+#if CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE > 0
+    // Recall latency: a device with many endpoints recalls scenes stored in persistent storage when they are not cached
+    constexpr EndpointId kFirstEndpoint = 100;
+    constexpr uint16_t kEndpointCount   = 50;
+    constexpr size_t kRecallRounds      = 20;
+    constexpr size_t kCachedEndpoints =
+        (CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE < kEndpointCount) ? CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE : kEndpointCount;
+
+    for (uint16_t i = 0; i < kEndpointCount; i++)
+    {
+        sceneTable = scenes::GetSceneTableImpl(static_cast<EndpointId>(kFirstEndpoint + i));
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->SetSceneTableEntry(kFabric1, scene1));
+    }
+
+    // Going through all the endpoints in turn evicts each scene before it is recalled again
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t round = 0; round < kRecallRounds; round++)
+    {
+        for (uint16_t i = 0; i < kEndpointCount; i++)
+        {
+            sceneTable = scenes::GetSceneTableImpl(static_cast<EndpointId>(kFirstEndpoint + i));
+            NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+        }
+    }
+    System::Clock::Microseconds64 uncachedTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(aSuite, scene == scene1);
+
+    start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t round = 0; round < kRecallRounds * kEndpointCount / kCachedEndpoints; round++)
+    {
+        for (uint16_t i = 0; i < kCachedEndpoints; i++)
+        {
+            sceneTable = scenes::GetSceneTableImpl(static_cast<EndpointId>(kFirstEndpoint + i));
+            NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->GetSceneTableEntry(kFabric1, sceneId1, scene));
+        }
+    }
+    System::Clock::Microseconds64 cachedTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT(aSuite, scene == scene1);
+
+    const size_t recallCount = kRecallRounds * kEndpointCount;
+    ChipLogProgress(Zcl, "Scene recall on %u endpoints: %u us uncached, %u us cached (%u recalls each)",
+                    static_cast<unsigned>(kEndpointCount), static_cast<unsigned>(uncachedTime.count()),
+                    static_cast<unsigned>(cachedTime.count()), static_cast<unsigned>(recallCount));
+
+    for (uint16_t i = 0; i < kEndpointCount; i++)
+    {
+        sceneTable = scenes::GetSceneTableImpl(static_cast<EndpointId>(kFirstEndpoint + i));
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == sceneTable->RemoveSceneTableEntry(kFabric1, sceneId1));
+    }
+#endif // CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE > 0
+}
+
 void TestOTAChanges(nlTestSuite * aSuite, void * aContext)
 {
     SceneTable * sceneTable = scenes::GetSceneTableImpl(kTestEndpoint1);
@@ -1785,6 +1883,7 @@ int TestSceneTable()
                                NL_TEST_DEF("TestRemoveScenes", TestScenes::TestRemoveScenes),
                                NL_TEST_DEF("TestFabricScenes", TestScenes::TestFabricScenes),
                                NL_TEST_DEF("TestEndpointScenes", TestScenes::TestEndpointScenes),
+                               NL_TEST_DEF("TestSceneCache", TestScenes::TestSceneCache),
                                NL_TEST_DEF("TestOTAChanges", TestScenes::TestOTAChanges),
 
                                NL_TEST_SENTINEL() };
@@ -407,6 +407,45 @@ void TestSubscriptionStateJunkData(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, iterator->Count() == 0);
     iterator->Release();
 }
+
+void TestSubscriptionIndex(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    SimpleSubscriptionResumptionStorageTest subscriptionStorage;
+    subscriptionStorage.Init(&storage);
+
+    // Saving subscriptions maintains the index
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo = { .mNodeId = 6666, .mFabricIndex = 46 };
+    for (size_t i = 0; i < 3; i++)
+    {
+        subscriptionInfo.mSubscriptionId = static_cast<chip::SubscriptionId>(i);
+        NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite,
+                   storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()));
+
+    // Subscriptions saved before the index existed are found again after a reboot
+    NL_TEST_ASSERT(inSuite,
+                   storage.SyncDeleteKeyValue(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()) ==
+                       CHIP_NO_ERROR);
+    SimpleSubscriptionResumptionStorageTest rebootedStorage;
+    rebootedStorage.Init(&storage);
+    NL_TEST_ASSERT(inSuite,
+                   storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()));
+
+    NL_TEST_ASSERT(inSuite, rebootedStorage.Delete(6666, 46, 1) == CHIP_NO_ERROR);
+    auto * iterator = rebootedStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 2);
+    iterator->Release();
+
+    // The index follows the subscriptions when they are all deleted
+    NL_TEST_ASSERT(inSuite, rebootedStorage.DeleteAll(46) == CHIP_NO_ERROR);
+    iterator = rebootedStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 0);
+    iterator->Release();
+    NL_TEST_ASSERT(inSuite,
+                   !storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()));
+}
 /**
  *  Set up the test suite.
  */
@@ -440,6 +479,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("TestSubscriptionStateUnexpectedFields", TestSubscriptionStateUnexpectedFields),
     NL_TEST_DEF("TestSubscriptionStateTooBigToLoad", TestSubscriptionStateTooBigToLoad),
     NL_TEST_DEF("TestSubscriptionStateJunkData", TestSubscriptionStateJunkData),
+    NL_TEST_DEF("TestSubscriptionIndex", TestSubscriptionIndex),
 
     NL_TEST_SENTINEL()
 };
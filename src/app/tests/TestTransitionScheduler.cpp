@@ -0,0 +1,269 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/TransitionScheduler.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemLayerImpl.h>
+
+#include <nlunit-test.h>
+
+#include <ctime>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+struct TestContext
+{
+    System::LayerImpl systemLayer;
+};
+
+void ServiceEvents(System::LayerImpl & layer)
+{
+    layer.PrepareEvents();
+    layer.WaitForEvents();
+    layer.HandleEvents();
+}
+
+// A transition of an endpoint, stepped either by a TransitionScheduler or by a System Layer timer of its own,
+// the way the Level Control and Color Control servers step theirs.
+struct Transition
+{
+    static void OnStep(System::Layer * layer, void * context)
+    {
+        auto * transition = static_cast<Transition *>(context);
+
+        // Stand-in for recomputing the state and writing the attribute.
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            transition->value = transition->value * 31 + i;
+        }
+
+        transition->steps++;
+        if (transition->steps < transition->stepCount)
+        {
+            transition->Schedule();
+        }
+    }
+
+    void Schedule()
+    {
+        CHIP_ERROR err = (scheduler != nullptr) ? scheduler->StartTimer(interval, OnStep, this)
+                                                : systemLayer->StartTimer(interval, OnStep, this);
+        VerifyOrDie(err == CHIP_NO_ERROR);
+    }
+
+    bool IsDone() const { return steps == stepCount; }
+
+    System::Layer * systemLayer     = nullptr;
+    TransitionScheduler * scheduler = nullptr;
+    System::Clock::Milliseconds32 interval;
+    uint32_t stepCount = 0;
+    uint32_t steps     = 0;
+    uint32_t value     = 0;
+};
+
+// Services the events until every transition is done, and returns the number of passes of the event loop it took.
+uint32_t RunUntilDone(System::LayerImpl & layer, std::vector<Transition> & transitions)
+{
+    uint32_t passes = 0;
+    bool done       = false;
+    while (!done)
+    {
+        ServiceEvents(layer);
+        passes++;
+        done = true;
+        for (const Transition & transition : transitions)
+        {
+            done = done && transition.IsDone();
+        }
+    }
+    return passes;
+}
+
+void TestCoalescesSteps(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    TransitionScheduler scheduler(ctx.systemLayer);
+
+    constexpr uint32_t kStepCount = 5;
+    std::vector<Transition> transitions(10);
+    for (Transition & transition : transitions)
+    {
+        transition.scheduler = &scheduler;
+        transition.interval  = 20_ms32;
+        transition.stepCount = kStepCount;
+        transition.Schedule();
+    }
+
+    RunUntilDone(ctx.systemLayer, transitions);
+
+    // The transitions started together, so each pass steps all of them.
+    NL_TEST_ASSERT(inSuite, scheduler.GetTickCount() == kStepCount);
+}
+
+void TestReplacesAndCancelsSteps(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    TransitionScheduler scheduler(ctx.systemLayer);
+
+    std::vector<Transition> transitions(2);
+    for (Transition & transition : transitions)
+    {
+        transition.scheduler = &scheduler;
+        transition.interval  = 10_ms32;
+        transition.stepCount = 1;
+    }
+
+    // Scheduling the same step again replaces it.
+    transitions[0].Schedule();
+    transitions[0].Schedule();
+    transitions[1].Schedule();
+    scheduler.CancelTimer(Transition::OnStep, &transitions[1]);
+    // Cancelling a step that is not scheduled is harmless.
+    scheduler.CancelTimer(Transition::OnStep, &transitions[1]);
+
+    transitions[1].steps = transitions[1].stepCount;
+    RunUntilDone(ctx.systemLayer, transitions);
+    NL_TEST_ASSERT(inSuite, transitions[0].steps == 1);
+    NL_TEST_ASSERT(inSuite, scheduler.GetTickCount() == 1);
+
+    // The cancelled step never runs, even once the shared timer fires again.
+    transitions[0].steps     = 0;
+    transitions[0].stepCount = 2;
+    transitions[0].Schedule();
+    RunUntilDone(ctx.systemLayer, transitions);
+    NL_TEST_ASSERT(inSuite, transitions[1].steps == 1);
+    NL_TEST_ASSERT(inSuite, scheduler.GetTickCount() == 3);
+}
+
+void TestFallsBackWhenExhausted(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    TransitionScheduler scheduler(ctx.systemLayer);
+
+    // More transitions than the scheduler steps together still complete, and can be cancelled.
+    std::vector<Transition> transitions(CHIP_CONFIG_MAX_CONCURRENT_TRANSITIONS + 2);
+    for (Transition & transition : transitions)
+    {
+        transition.scheduler = &scheduler;
+        transition.interval  = 10_ms32;
+        transition.stepCount = 3;
+        transition.Schedule();
+    }
+    scheduler.CancelTimer(Transition::OnStep, &transitions.back());
+    transitions.back().steps = transitions.back().stepCount;
+
+    RunUntilDone(ctx.systemLayer, transitions);
+    for (const Transition & transition : transitions)
+    {
+        NL_TEST_ASSERT(inSuite, transition.steps == transition.stepCount);
+    }
+}
+
+constexpr uint32_t kBenchmarkStepCount = 25;
+
+// Runs `count` concurrent transitions stepping every 20 ms for half a second, and returns the CPU time, in
+// microseconds, the process spent per second of transition.
+uint32_t RunTransitions(TestContext & ctx, size_t count, TransitionScheduler * scheduler, uint32_t & passes)
+{
+    std::vector<Transition> transitions(count);
+    for (Transition & transition : transitions)
+    {
+        transition.systemLayer = &ctx.systemLayer;
+        transition.scheduler   = scheduler;
+        transition.interval    = 20_ms32;
+        transition.stepCount   = kBenchmarkStepCount;
+    }
+
+    System::Clock::Timestamp startTime = System::SystemClock().GetMonotonicTimestamp();
+    std::clock_t startCpu              = std::clock();
+    for (Transition & transition : transitions)
+    {
+        transition.Schedule();
+    }
+
+    passes = RunUntilDone(ctx.systemLayer, transitions);
+
+    std::clock_t cpu                   = std::clock() - startCpu;
+    System::Clock::Milliseconds64 wall = System::SystemClock().GetMonotonicTimestamp() - startTime;
+    return static_cast<uint32_t>(static_cast<uint64_t>(cpu) * 1000000u / CLOCKS_PER_SEC * 1000u /
+                                 static_cast<uint64_t>(wall.count() == 0 ? 1 : wall.count()));
+}
+
+void TestTransitionBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    // The timings depend on the host and are only logged.
+    for (size_t count : { size_t(1), size_t(10), size_t(100) })
+    {
+        TransitionScheduler scheduler(ctx.systemLayer);
+        uint32_t timerPasses     = 0;
+        uint32_t schedulerPasses = 0;
+        uint32_t timerCpu        = RunTransitions(ctx, count, nullptr, timerPasses);
+        uint32_t schedulerCpu    = RunTransitions(ctx, count, &scheduler, schedulerPasses);
+
+        ChipLogProgress(Test,
+                        "%u transition(s): per-endpoint timers %u us CPU/s (%u loop passes), "
+                        "transition scheduler %u us CPU/s (%u loop passes, %u ticks)",
+                        static_cast<unsigned>(count), static_cast<unsigned>(timerCpu), static_cast<unsigned>(timerPasses),
+                        static_cast<unsigned>(schedulerCpu), static_cast<unsigned>(schedulerPasses),
+                        static_cast<unsigned>(scheduler.GetTickCount()));
+        NL_TEST_ASSERT(inSuite, scheduler.GetTickCount() <= kBenchmarkStepCount + 1);
+    }
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test coalesced steps", TestCoalescesSteps),
+                          NL_TEST_DEF("Test replaced and cancelled steps", TestReplacesAndCancelsSteps),
+                          NL_TEST_DEF("Test fallback when the scheduler is exhausted", TestFallsBackWhenExhausted),
+                          NL_TEST_DEF("Test transition benchmark", TestTransitionBenchmark),
+                          NL_TEST_SENTINEL() };
+
+int TestSetup(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    VerifyOrReturnError(CHIP_NO_ERROR == Platform::MemoryInit(), FAILURE);
+    VerifyOrReturnError(CHIP_NO_ERROR == ctx.systemLayer.Init(), FAILURE);
+    return SUCCESS;
+}
+
+int TestTearDown(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestTransitionScheduler()
+{
+    TestContext context;
+    nlTestSuite theSuite = { "TransitionScheduler", &sTests[0], TestSetup, TestTearDown };
+
+    nlTestRunner(&theSuite, &context);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestTransitionScheduler)
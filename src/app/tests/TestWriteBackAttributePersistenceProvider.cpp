@@ -0,0 +1,308 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <app/WriteBackAttributePersistenceProvider.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemLayerImpl.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+const ConcreteAttributePath kCurrentLevelPath(1, 0x0008, 0x0000);
+const ConcreteAttributePath kOnOffPath(1, 0x0006, 0x0000);
+const ConcreteAttributePath kStartUpLevelPath(1, 0x0008, 0x4000);
+
+const EmberAfAttributeMetadata kUint8Metadata = { EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)), 0, 1,
+                                                  ZCL_INT8U_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_NONVOLATILE };
+
+// Storage that counts the values written to it.
+class CountingStorage : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        setCount++;
+        return TestPersistentStorageDelegate::SyncSetKeyValue(key, value, size);
+    }
+
+    size_t setCount = 0;
+};
+
+struct TestContext
+{
+    System::LayerImpl systemLayer;
+    CountingStorage storage;
+    DefaultAttributePersistenceProvider persister;
+};
+
+void ServiceEvents(System::LayerImpl & layer)
+{
+    layer.PrepareEvents();
+    layer.WaitForEvents();
+    layer.HandleEvents();
+}
+
+uint8_t ReadUint8(nlTestSuite * inSuite, AttributePersistenceProvider & provider, const ConcreteAttributePath & path)
+{
+    uint8_t value = 0;
+    MutableByteSpan bytes(&value, 1);
+    NL_TEST_ASSERT(inSuite, provider.ReadValue(path, &kUint8Metadata, bytes) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, bytes.size() == 1);
+    return value;
+}
+
+CHIP_ERROR WriteUint8(AttributePersistenceProvider & provider, const ConcreteAttributePath & path, uint8_t value)
+{
+    return provider.WriteValue(path, ByteSpan(&value, 1));
+}
+
+void TestCoalescesWrites(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.storage.setCount = 0;
+
+    WriteBackCacheEntry entries[4];
+    WriteBackAttributePersistenceProvider provider(ctx.systemLayer, ctx.persister, Span<WriteBackCacheEntry>(entries),
+                                                   System::Clock::Seconds32(60), 64);
+
+    for (uint8_t level = 1; level <= 100; level++)
+    {
+        NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, level) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kOnOffPath, 1) == CHIP_NO_ERROR);
+
+    // Nothing reaches the storage before a flush, but reads see the latest values.
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 0);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 2);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, provider, kCurrentLevelPath) == 100);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, provider, kOnOffPath) == 1);
+
+    // Rewriting the cached value is not a change.
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, 100) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 2);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 0);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, ctx.persister, kCurrentLevelPath) == 100);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, ctx.persister, kOnOffPath) == 1);
+
+    // Flushing a clean cache does not write anything.
+    NL_TEST_ASSERT(inSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 2);
+
+    // Shutdown flushes synchronously.
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, 42) == CHIP_NO_ERROR);
+    provider.Shutdown();
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 3);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, ctx.persister, kCurrentLevelPath) == 42);
+}
+
+void TestFlushesOnThreshold(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.storage.setCount = 0;
+
+    WriteBackCacheEntry entries[4];
+    WriteBackAttributePersistenceProvider provider(ctx.systemLayer, ctx.persister, Span<WriteBackCacheEntry>(entries),
+                                                   System::Clock::Seconds32(60), 3);
+
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kOnOffPath, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 0);
+
+    // The third dirty byte reaches the threshold and flushes everything.
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kStartUpLevelPath, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 3);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 0);
+
+    provider.Shutdown();
+}
+
+void TestFlushesWhenFull(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.storage.setCount = 0;
+
+    WriteBackCacheEntry entries[2];
+    WriteBackAttributePersistenceProvider provider(ctx.systemLayer, ctx.persister, Span<WriteBackCacheEntry>(entries),
+                                                   System::Clock::Seconds32(60), 64);
+
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, 7) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kOnOffPath, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 0);
+
+    // A third attribute makes room by writing back the two cached ones.
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kStartUpLevelPath, 9) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 2);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 1);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, provider, kStartUpLevelPath) == 9);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, provider, kCurrentLevelPath) == 7);
+
+    provider.Shutdown();
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount == 3);
+}
+
+void TestKeepsFailedWrites(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.storage.setCount = 0;
+
+    WriteBackCacheEntry entries[2];
+    WriteBackAttributePersistenceProvider provider(ctx.systemLayer, ctx.persister, Span<WriteBackCacheEntry>(entries),
+                                                   System::Clock::Seconds32(60), 64);
+
+    const std::string currentLevelKey =
+        DefaultStorageKeyAllocator::AttributeValue(kCurrentLevelPath.mEndpointId, kCurrentLevelPath.mClusterId,
+                                                   kCurrentLevelPath.mAttributeId)
+            .KeyName();
+    ctx.storage.AddPoisonKey(currentLevelKey);
+
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, 5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kOnOffPath, 1) == CHIP_NO_ERROR);
+
+    // The value that fails to be written stays cached and dirty, the other one is written.
+    NL_TEST_ASSERT(inSuite, provider.Flush() == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 1);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, provider, kCurrentLevelPath) == 5);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, ctx.persister, kOnOffPath) == 1);
+
+    // Cached values can still be rewritten, and are written once the storage accepts them.
+    NL_TEST_ASSERT(inSuite, WriteUint8(provider, kCurrentLevelPath, 6) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 1);
+    ctx.storage.ClearPoisonKeys();
+    NL_TEST_ASSERT(inSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 0);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, ctx.persister, kCurrentLevelPath) == 6);
+
+    provider.Shutdown();
+}
+
+struct LevelTransition
+{
+    static constexpr System::Clock::Milliseconds32 kStepInterval{ 2 };
+
+    WriteBackAttributePersistenceProvider * provider;
+    uint8_t level;
+    uint8_t targetLevel;
+    size_t writes;
+
+    static void Step(System::Layer * layer, void * appState)
+    {
+        auto * transition = static_cast<LevelTransition *>(appState);
+        transition->level++;
+        transition->writes++;
+        WriteUint8(*transition->provider, kCurrentLevelPath, transition->level);
+        if (transition->level != transition->targetLevel)
+        {
+            layer->StartTimer(kStepInterval, Step, appState);
+        }
+    }
+};
+
+// A level control transition updates CurrentLevel many times per second.  Check that the number of values
+// written to the storage is bounded by the flush delay rather than by the number of updates.
+void TestLevelControlWriteAmplification(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.storage.setCount = 0;
+
+    constexpr System::Clock::Milliseconds32 kFlushDelay(100);
+
+    WriteBackCacheEntry entries[4];
+    WriteBackAttributePersistenceProvider provider(ctx.systemLayer, ctx.persister, Span<WriteBackCacheEntry>(entries), kFlushDelay,
+                                                   64);
+
+    LevelTransition transition = { &provider, 0, 254, 0 };
+    System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    NL_TEST_ASSERT(inSuite, ctx.systemLayer.StartTimer(LevelTransition::kStepInterval, LevelTransition::Step, &transition) ==
+                       CHIP_NO_ERROR);
+    while (transition.level != transition.targetLevel)
+    {
+        ServiceEvents(ctx.systemLayer);
+    }
+    System::Clock::Milliseconds64 elapsed =
+        std::chrono::duration_cast<System::Clock::Milliseconds64>(System::SystemClock().GetMonotonicTimestamp() - start);
+    size_t writesDuringTransition = ctx.storage.setCount;
+
+    // The last level is flushed at most a flush delay later.
+    System::Clock::Timestamp flushDeadline = System::SystemClock().GetMonotonicTimestamp() + kFlushDelay * 2;
+    while (provider.GetDirtyBytes() != 0 && System::SystemClock().GetMonotonicTimestamp() < flushDeadline)
+    {
+        ServiceEvents(ctx.systemLayer);
+    }
+    NL_TEST_ASSERT(inSuite, provider.GetDirtyBytes() == 0);
+    NL_TEST_ASSERT(inSuite, ReadUint8(inSuite, ctx.persister, kCurrentLevelPath) == 254);
+
+    // Values that keep changing are still flushed during the transition, once per flush delay.
+    size_t maxWrites = static_cast<size_t>(elapsed.count() / kFlushDelay.count()) + 2;
+    NL_TEST_ASSERT(inSuite, transition.writes == 254);
+    NL_TEST_ASSERT(inSuite, ctx.storage.setCount <= maxWrites);
+    NL_TEST_ASSERT(inSuite, elapsed < kFlushDelay || writesDuringTransition > 0);
+
+    ChipLogProgress(Test, "Level transition: %u attribute writes in %u ms, %u storage writes",
+                    static_cast<unsigned>(transition.writes), static_cast<unsigned>(elapsed.count()),
+                    static_cast<unsigned>(ctx.storage.setCount));
+
+    provider.Shutdown();
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test coalesced writes", TestCoalescesWrites),
+                          NL_TEST_DEF("Test flush on dirty bytes threshold", TestFlushesOnThreshold),
+                          NL_TEST_DEF("Test flush when the cache is full", TestFlushesWhenFull),
+                          NL_TEST_DEF("Test failed writes are kept", TestKeepsFailedWrites),
+                          NL_TEST_DEF("Test level control write amplification", TestLevelControlWriteAmplification),
+                          NL_TEST_SENTINEL() };
+
+int TestSetup(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    VerifyOrReturnError(CHIP_NO_ERROR == Platform::MemoryInit(), FAILURE);
+    VerifyOrReturnError(CHIP_NO_ERROR == ctx.systemLayer.Init(), FAILURE);
+    VerifyOrReturnError(CHIP_NO_ERROR == ctx.persister.Init(&ctx.storage), FAILURE);
+    return SUCCESS;
+}
+
+int TestTearDown(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestWriteBackAttributePersistenceProvider()
+{
+    TestContext context;
+    nlTestSuite theSuite = { "WriteBackAttributePersistenceProvider", &sTests[0], TestSetup, TestTearDown };
+
+    nlTestRunner(&theSuite, &context);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestWriteBackAttributePersistenceProvider)
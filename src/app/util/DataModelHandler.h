@@ -33,3 +33,10 @@
  *
  */
 void InitDataModelHandler();
+
+/**
+ * Release what the data model internal code holds on to, before the system
+ * layer is shut down.
+ *
+ */
+void ShutdownDataModelHandler();
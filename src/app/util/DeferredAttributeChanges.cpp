@@ -0,0 +1,93 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/DeferredAttributeChanges.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+
+void DeferredAttributeChanges::OnAttributeChanged(System::Layer * aSystemLayer, const ConcreteAttributePath & aPath)
+{
+    for (uint8_t i = 0; i < mChangeCount; i++)
+    {
+        VerifyOrReturn(!(mChanges[i] == aPath));
+    }
+
+    if (aSystemLayer == nullptr || mChangeCount == ArraySize(mChanges))
+    {
+        mReport(aPath);
+        return;
+    }
+
+    if (mSystemLayer == nullptr)
+    {
+        if (aSystemLayer->ScheduleWork(ReportScheduledChanges, this) != CHIP_NO_ERROR)
+        {
+            mReport(aPath);
+            return;
+        }
+        mSystemLayer = aSystemLayer;
+    }
+
+    mChanges[mChangeCount++] = aPath;
+}
+
+void DeferredAttributeChanges::ReportChanges(const ConcreteClusterPath * aClusterPath)
+{
+    // Reports may change attributes, so the changes are removed before they are reported.
+    uint8_t remaining = 0;
+    uint8_t reported  = 0;
+    ConcreteAttributePath changes[ArraySize(mChanges)];
+    for (uint8_t i = 0; i < mChangeCount; i++)
+    {
+        const ConcreteAttributePath & path = mChanges[i];
+        if (aClusterPath != nullptr && !(ConcreteClusterPath(path) == *aClusterPath))
+        {
+            mChanges[remaining++] = path;
+            continue;
+        }
+        changes[reported++] = path;
+    }
+    mChangeCount = remaining;
+
+    for (uint8_t i = 0; i < reported; i++)
+    {
+        mReport(changes[i]);
+    }
+}
+
+void DeferredAttributeChanges::Shutdown()
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(ReportScheduledChanges, this);
+        mSystemLayer = nullptr;
+    }
+    ReportChanges();
+}
+
+void DeferredAttributeChanges::ReportScheduledChanges(System::Layer * aSystemLayer, void * aContext)
+{
+    auto * self        = static_cast<DeferredAttributeChanges *>(aContext);
+    self->mSystemLayer = nullptr;
+    self->ReportChanges();
+}
+
+} // namespace app
+} // namespace chip
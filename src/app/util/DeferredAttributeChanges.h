@@ -0,0 +1,77 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Defers the reports of attribute changes made while a write request message is applied, so that each attribute is
+ * reported once per message.
+ *
+ * A list written as a ReplaceAll followed by one AppendItem AttributeDataIB per entry changes the attribute once per
+ * AttributeDataIB. Reporting each of these changes increases the cluster data version and marks the attribute dirty
+ * every time. Instead, the changes are recorded, and each distinct attribute is reported once the event loop is done
+ * with the current event, that is once the whole message is applied.
+ *
+ * Up to CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE attributes are recorded; changes to further attributes are
+ * reported right away.
+ */
+class DeferredAttributeChanges
+{
+public:
+    using ReportFunction = void (*)(const ConcreteAttributePath & aPath);
+
+    DeferredAttributeChanges(ReportFunction aReport) : mReport(aReport) {}
+
+    /**
+     * Record that the attribute at aPath changed. The change is reported from work scheduled on aSystemLayer, or right
+     * away if aSystemLayer is null or the change cannot be recorded.
+     */
+    void OnAttributeChanged(System::Layer * aSystemLayer, const ConcreteAttributePath & aPath);
+
+    /**
+     * Report the recorded changes now, to the attributes of the given cluster only if aClusterPath is not null. Needs
+     * to be called before the data version of a cluster is checked, so that the check accounts for recorded changes.
+     */
+    void ReportChanges(const ConcreteClusterPath * aClusterPath = nullptr);
+
+    /**
+     * Report the recorded changes and cancel the work scheduled to report them. Needs to be called before the system
+     * layer the reports are scheduled on is shut down.
+     */
+    void Shutdown();
+
+    size_t GetRecordedChangeCount() const { return mChangeCount; }
+
+private:
+    static void ReportScheduledChanges(System::Layer * aSystemLayer, void * aContext);
+
+    ReportFunction mReport;
+    // The system layer the reports are scheduled on, while they are.
+    System::Layer * mSystemLayer = nullptr;
+    ConcreteAttributePath mChanges[CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE];
+    uint8_t mChangeCount = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/TransitionScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+namespace chip {
+namespace app {
+
+TransitionScheduler::~TransitionScheduler()
+{
+    mSystemLayer.CancelTimer(OnTick, this);
+    mSteps.ReleaseAll();
+}
+
+TransitionScheduler & TransitionScheduler::Instance()
+{
+    static TransitionScheduler sInstance(DeviceLayer::SystemLayer());
+    return sInstance;
+}
+
+CHIP_ERROR TransitionScheduler::StartTimer(System::Clock::Timeout delay, System::TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(onComplete != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    Step * step = FindStep(onComplete, appState);
+    if (step == nullptr)
+    {
+        step = mSteps.CreateObject(onComplete, appState);
+        if (step == nullptr)
+        {
+            // Too many transitions to step together: this one gets a timer of its own.
+            return mSystemLayer.StartTimer(delay, onComplete, appState);
+        }
+        // In case the step was scheduled on its own timer while the pool was exhausted.
+        mSystemLayer.CancelTimer(onComplete, appState);
+    }
+
+    step->mDueTime = System::SystemClock().GetMonotonicTimestamp() + delay;
+    step->mReady   = false;
+
+    if (!mInTick)
+    {
+        ArmTimer();
+    }
+    return CHIP_NO_ERROR;
+}
+
+void TransitionScheduler::CancelTimer(System::TimerCompleteCallback onComplete, void * appState)
+{
+    Step * step = FindStep(onComplete, appState);
+    if (step == nullptr)
+    {
+        mSystemLayer.CancelTimer(onComplete, appState);
+        return;
+    }
+
+    mSteps.ReleaseObject(step);
+    if (!mInTick)
+    {
+        ArmTimer();
+    }
+}
+
+void TransitionScheduler::OnTick(System::Layer * layer, void * me)
+{
+    auto * scheduler = static_cast<TransitionScheduler *>(me);
+
+    scheduler->mTickCount++;
+    scheduler->mInTick = true;
+    scheduler->RunDueSteps();
+    scheduler->mInTick = false;
+    scheduler->ArmTimer();
+}
+
+TransitionScheduler::Step * TransitionScheduler::FindStep(System::TimerCompleteCallback onComplete, void * appState)
+{
+    Step * found = nullptr;
+    mSteps.ForEachActiveObject([&](Step * step) {
+        if (step->mCallback == onComplete && step->mContext == appState)
+        {
+            found = step;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+void TransitionScheduler::RunDueSteps()
+{
+    const System::Clock::Timestamp horizon = System::SystemClock().GetMonotonicTimestamp() + mCoalescingWindow;
+
+    // Select the steps first: the callbacks schedule their next step, which must not run in this pass.
+    mSteps.ForEachActiveObject([&](Step * step) {
+        step->mReady = (step->mDueTime <= horizon);
+        return Loop::Continue;
+    });
+
+    mSteps.ForEachActiveObject([&](Step * step) {
+        // A callback may have cancelled or rescheduled this step already.
+        if (step->mReady)
+        {
+            System::TimerCompleteCallback callback = step->mCallback;
+            void * context                         = step->mContext;
+            mSteps.ReleaseObject(step);
+            callback(&mSystemLayer, context);
+        }
+        return Loop::Continue;
+    });
+}
+
+void TransitionScheduler::ArmTimer()
+{
+    bool pending                      = false;
+    System::Clock::Timestamp earliest = System::Clock::Timestamp(0);
+    mSteps.ForEachActiveObject([&](Step * step) {
+        if (!pending || step->mDueTime < earliest)
+        {
+            earliest = step->mDueTime;
+            pending  = true;
+        }
+        return Loop::Continue;
+    });
+
+    if (!pending)
+    {
+        mSystemLayer.CancelTimer(OnTick, this);
+        return;
+    }
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timeout delay =
+        (earliest > now) ? std::chrono::duration_cast<System::Clock::Timeout>(earliest - now) : System::Clock::Timeout(0);
+    // StartTimer replaces the pending timer of the scheduler, if any.
+    if (mSystemLayer.StartTimer(delay, OnTick, this) != CHIP_NO_ERROR)
+    {
+        ChipLogError(Zcl, "Transition scheduler failed to arm its timer");
+    }
+}
+
+} // namespace app
+} // namespace chip
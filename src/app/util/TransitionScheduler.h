@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Pool.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Steps the transitions of the clusters, such as Level Control and Color
+ * Control, from a single System Layer timer.
+ *
+ * Each endpoint in transition schedules its next step with StartTimer(), the
+ * way it would with System::Layer.  Rather than one timer per endpoint, the
+ * scheduler arms a single timer for the earliest step, and when it fires runs
+ * every step due within CHIP_CONFIG_TRANSITION_COALESCING_WINDOW_MS in the
+ * same pass.  When many endpoints are in transition, for instance after a
+ * group command, their steps and the attribute changes they report are
+ * therefore handled together, and the reporting engine builds a single report
+ * for all of them.
+ */
+class TransitionScheduler
+{
+public:
+    TransitionScheduler(System::Layer & systemLayer,
+                        System::Clock::Milliseconds32 coalescingWindow =
+                            System::Clock::Milliseconds32(CHIP_CONFIG_TRANSITION_COALESCING_WINDOW_MS)) :
+        mSystemLayer(systemLayer),
+        mCoalescingWindow(coalescingWindow)
+    {}
+
+    ~TransitionScheduler();
+
+    TransitionScheduler(const TransitionScheduler &)             = delete;
+    TransitionScheduler & operator=(const TransitionScheduler &) = delete;
+
+    /**
+     * The scheduler of the transitions of the clusters, running on the System Layer of the device.
+     */
+    static TransitionScheduler & Instance();
+
+    /**
+     * Schedule `onComplete(layer, appState)` to run after `delay`.  As with System::Layer::StartTimer(), any step
+     * scheduled earlier with the same callback and context is replaced.
+     */
+    CHIP_ERROR StartTimer(System::Clock::Timeout delay, System::TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Cancel the step scheduled with the given callback and context, if any.
+     */
+    void CancelTimer(System::TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Number of times the shared timer has fired.
+     */
+    uint32_t GetTickCount() const { return mTickCount; }
+
+private:
+    struct Step
+    {
+        Step(System::TimerCompleteCallback callback, void * context) : mCallback(callback), mContext(context) {}
+
+        System::TimerCompleteCallback mCallback;
+        void * mContext;
+        System::Clock::Timestamp mDueTime;
+        // Set for the steps run by the current pass, so that steps scheduled by their callbacks wait for the next one.
+        bool mReady = false;
+    };
+
+    static void OnTick(System::Layer * layer, void * me);
+
+    Step * FindStep(System::TimerCompleteCallback onComplete, void * appState);
+    void RunDueSteps();
+    void ArmTimer();
+
+    System::Layer & mSystemLayer;
+    const System::Clock::Milliseconds32 mCoalescingWindow;
+    ObjectPool<Step, CHIP_CONFIG_MAX_CONCURRENT_TRANSITIONS> mSteps;
+    uint32_t mTickCount = 0;
+    bool mInTick        = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -63,7 +63,7 @@ typedef void (*EmberAfGenericClusterFunction)(void);
 /**
  * @brief Struct describing cluster
  */
-typedef struct
+typedef struct EmberAfCluster
 {
     /**
      *  ID of cluster according to ZCL spec
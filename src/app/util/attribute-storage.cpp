@@ -66,6 +66,9 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Bumped whenever a dynamic endpoint is set or cleared.
+uint32_t metadataStructureGeneration = 0;
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -254,6 +257,7 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
 
     // Now enable the endpoint.
     emberAfEndpointEnableDisable(id, true);
+    metadataStructureGeneration++;
 
     return EMBER_ZCL_STATUS_SUCCESS;
 }
@@ -270,11 +274,17 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        metadataStructureGeneration++;
     }
 
     return ep;
 }
 
+uint32_t emberAfMetadataStructureGeneration()
+{
+    return metadataStructureGeneration;
+}
+
 uint16_t emberAfFixedEndpointCount()
 {
     return FIXED_ENDPOINT_COUNT;
@@ -1093,15 +1103,25 @@ CHIP_ERROR emberAfSetDeviceTypeList(EndpointId endpoint, Span<const EmberAfDevic
 const EmberAfCluster * emberAfGetNthCluster(EndpointId endpoint, uint8_t n, bool server)
 {
     uint16_t index = emberAfIndexFromEndpoint(endpoint);
-    EmberAfDefinedEndpoint * de;
+    if (index == kEmberInvalidEndpointIndex)
+    {
+        return nullptr;
+    }
+    return emberAfGetNthClusterFromIndex(index, n, server);
+}
+
+// Returns the cluster of Nth server or client cluster on the endpoint at the given index,
+// depending on server toggle.
+const EmberAfCluster * emberAfGetNthClusterFromIndex(uint16_t endpointIndex, uint8_t n, bool server)
+{
+    const EmberAfDefinedEndpoint * de = &(emAfEndpoints[endpointIndex]);
     uint8_t i, c = 0;
     const EmberAfCluster * cluster;
 
-    if (index == kEmberInvalidEndpointIndex)
+    if (de->endpointType == nullptr)
     {
         return nullptr;
     }
-    de = &(emAfEndpoints[index]);
 
     for (i = 0; i < de->endpointType->clusterCount; i++)
     {
@@ -1161,6 +1181,151 @@ void emberAfResetAttributes(EndpointId endpoint)
     emAfLoadAttributeDefaults(endpoint, true);
 }
 
+static void restorePersistedAttribute(EndpointId endpoint, ClusterId clusterId, const EmberAfAttributeMetadata * am,
+                                      const ByteSpan & value)
+{
+    uint8_t attrData[ATTRIBUTE_LARGEST];
+    VerifyOrReturn(value.size() <= sizeof(attrData));
+    if (!value.empty())
+    {
+        memcpy(attrData, value.data(), value.size());
+    }
+
+    EmberAfAttributeSearchRecord record;
+    record.endpoint    = endpoint;
+    record.clusterId   = clusterId;
+    record.attributeId = am->attributeId;
+    emAfReadOrWriteAttribute(&record,
+                             nullptr, // metadata - unused
+                             attrData,
+                             0,     // buffer size - unused
+                             true); // write?
+}
+
+namespace {
+
+// Restores the values enumerated by AttributePersistenceProvider::ReadEndpointValues.  The values are
+// checked against the metadata the same way DefaultAttributePersistenceProvider::ReadValue does.
+class PersistedAttributeRestorer : public app::AttributePersistenceProvider::AttributeValueVisitor
+{
+public:
+    PersistedAttributeRestorer(const EmberAfDefinedEndpoint * de, const Optional<ClusterId> & clusterId) :
+        mEndpoint(de), mClusterId(clusterId)
+    {}
+
+    CHIP_ERROR OnAttributeValue(const app::ConcreteAttributePath & aPath, const ByteSpan & aValue) override
+    {
+        if (mClusterId.HasValue() && mClusterId.Value() != aPath.mClusterId)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        const EmberAfEndpointType * endpointType = mEndpoint->endpointType;
+        for (uint8_t clusterI = 0; clusterI < endpointType->clusterCount; clusterI++)
+        {
+            const EmberAfCluster * cluster = &(endpointType->cluster[clusterI]);
+            if (cluster->clusterId != aPath.mClusterId)
+            {
+                continue;
+            }
+
+            for (uint16_t attr = 0; attr < cluster->attributeCount; attr++)
+            {
+                const EmberAfAttributeMetadata * am = &(cluster->attributes[attr]);
+                if (am->attributeId != aPath.mAttributeId || !am->IsAutomaticallyPersisted())
+                {
+                    continue;
+                }
+
+                if (IsValidValue(am, aValue))
+                {
+                    restorePersistedAttribute(mEndpoint->endpoint, cluster->clusterId, am, aValue);
+                }
+                else
+                {
+                    ChipLogDetail(DataManagement, "Invalid stored attribute (%u, " ChipLogFormatMEI ", " ChipLogFormatMEI ")",
+                                  mEndpoint->endpoint, ChipLogValueMEI(cluster->clusterId), ChipLogValueMEI(am->attributeId));
+                    // Just keep the default value.
+                }
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    static bool IsValidValue(const EmberAfAttributeMetadata * am, const ByteSpan & value)
+    {
+        VerifyOrReturnValue(value.size() <= emberAfAttributeSize(am), false);
+        if (emberAfIsStringAttributeType(am->attributeType))
+        {
+            return value.size() >= 1 && value.size() >= emberAfStringLength(value.data()) + 1u;
+        }
+        if (emberAfIsLongStringAttributeType(am->attributeType))
+        {
+            return value.size() >= 2 && value.size() >= emberAfLongStringLength(value.data()) + 2u;
+        }
+        return value.size() == am->size;
+    }
+
+    const EmberAfDefinedEndpoint * mEndpoint;
+    const Optional<ClusterId> mClusterId;
+};
+
+} // anonymous namespace
+
+// Overwrites the defaults of the attributes of `de` that have a persisted value.
+static void restorePersistedAttributes(const EmberAfDefinedEndpoint * de, const Optional<ClusterId> & clusterId,
+                                       app::AttributePersistenceProvider & attrStorage)
+{
+    // Restore all the values of the endpoint in one pass over the storage when the provider supports it.
+    PersistedAttributeRestorer restorer(de, clusterId);
+    CHIP_ERROR err = attrStorage.ReadEndpointValues(de->endpoint, restorer);
+    if (err == CHIP_NO_ERROR)
+    {
+        return;
+    }
+    if (err != CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        ChipLogError(DataManagement, "Failed to read stored attributes of endpoint %u: %" CHIP_ERROR_FORMAT, de->endpoint,
+                     err.Format());
+    }
+
+    // Otherwise read the attributes one by one.
+    uint8_t attrData[ATTRIBUTE_LARGEST];
+    for (uint8_t clusterI = 0; clusterI < de->endpointType->clusterCount; clusterI++)
+    {
+        const EmberAfCluster * cluster = &(de->endpointType->cluster[clusterI]);
+        if (clusterId.HasValue() && clusterId.Value() != cluster->clusterId)
+        {
+            continue;
+        }
+
+        for (uint16_t attr = 0; attr < cluster->attributeCount; attr++)
+        {
+            const EmberAfAttributeMetadata * am = &(cluster->attributes[attr]);
+            if (!am->IsAutomaticallyPersisted())
+            {
+                continue;
+            }
+
+            MutableByteSpan bytes(attrData);
+            err = attrStorage.ReadValue(app::ConcreteAttributePath(de->endpoint, cluster->clusterId, am->attributeId), am, bytes);
+            if (err == CHIP_NO_ERROR)
+            {
+                restorePersistedAttribute(de->endpoint, cluster->clusterId, am, bytes);
+            }
+            else
+            {
+                ChipLogDetail(DataManagement,
+                              "Failed to read stored attribute (%u, " ChipLogFormatMEI ", " ChipLogFormatMEI
+                              ": %" CHIP_ERROR_FORMAT,
+                              de->endpoint, ChipLogValueMEI(cluster->clusterId), ChipLogValueMEI(am->attributeId), err.Format());
+                // Just fall back to default value.
+            }
+        }
+    }
+}
+
 void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional<ClusterId> clusterId)
 {
     uint16_t ep;
@@ -1168,7 +1333,6 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
     uint16_t attr;
     uint8_t * ptr;
     uint16_t epCount = emberAfEndpointCount();
-    uint8_t attrData[ATTRIBUTE_LARGEST];
     auto * attrStorage = ignoreStorage ? nullptr : app::GetAttributePersistenceProvider();
     // Don't check whether we actually have an attrStorage here, because it's OK
     // to have one if none of our attributes have NVM storage.
@@ -1176,6 +1340,7 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
     for (ep = 0; ep < epCount; ep++)
     {
         EmberAfDefinedEndpoint * de;
+        bool hasPersistedAttributes = false;
         if (endpoint != EMBER_BROADCAST_ENDPOINT)
         {
             ep = emberAfIndexFromEndpoint(endpoint);
@@ -1208,27 +1373,12 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
             for (attr = 0; attr < cluster->attributeCount; attr++)
             {
                 const EmberAfAttributeMetadata * am = &(cluster->attributes[attr]);
-                ptr                                 = nullptr; // Will get set to the value to write, as needed.
 
-                // First check for a persisted value.
+                // Persisted values overwrite the defaults once all the attributes of the endpoint are loaded.
                 if (!ignoreStorage && am->IsAutomaticallyPersisted())
                 {
                     VerifyOrDie(attrStorage && "Attribute persistence needs a persistence provider");
-                    MutableByteSpan bytes(attrData);
-                    CHIP_ERROR err = attrStorage->ReadValue(
-                        app::ConcreteAttributePath(de->endpoint, cluster->clusterId, am->attributeId), am, bytes);
-                    if (err == CHIP_NO_ERROR)
-                    {
-                        ptr = attrData;
-                    }
-                    else
-                    {
-                        ChipLogDetail(
-                            DataManagement,
-                            "Failed to read stored attribute (%u, " ChipLogFormatMEI ", " ChipLogFormatMEI ": %" CHIP_ERROR_FORMAT,
-                            de->endpoint, ChipLogValueMEI(cluster->clusterId), ChipLogValueMEI(am->attributeId), err.Format());
-                        // Just fall back to default value.
-                    }
+                    hasPersistedAttributes = true;
                 }
 
                 if (!am->IsExternal())
@@ -1238,56 +1388,53 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
                     record.clusterId   = cluster->clusterId;
                     record.attributeId = am->attributeId;
 
-                    if (ptr == nullptr)
+                    size_t defaultValueSizeForBigEndianNudger = 0;
+                    // Bypasses compiler warning about unused variable for little endian platforms.
+                    (void) defaultValueSizeForBigEndianNudger;
+                    if ((am->mask & ATTRIBUTE_MASK_MIN_MAX) != 0U)
                     {
-                        size_t defaultValueSizeForBigEndianNudger = 0;
-                        // Bypasses compiler warning about unused variable for little endian platforms.
-                        (void) defaultValueSizeForBigEndianNudger;
-                        if ((am->mask & ATTRIBUTE_MASK_MIN_MAX) != 0U)
+                        // This is intentionally 2 and not 4 bytes since defaultValue in min/max
+                        // attributes is still uint16_t.
+                        if (emberAfAttributeSize(am) <= 2)
                         {
-                            // This is intentionally 2 and not 4 bytes since defaultValue in min/max
-                            // attributes is still uint16_t.
-                            if (emberAfAttributeSize(am) <= 2)
-                            {
-                                static_assert(sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue) == 2,
-                                              "if statement relies on size of max/min defaultValue being 2");
-                                ptr = (uint8_t *) &(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
-                                defaultValueSizeForBigEndianNudger =
-                                    sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
-                            }
-                            else
-                            {
-                                ptr = (uint8_t *) am->defaultValue.ptrToMinMaxValue->defaultValue.ptrToDefaultValue;
-                            }
+                            static_assert(sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue) == 2,
+                                          "if statement relies on size of max/min defaultValue being 2");
+                            ptr = (uint8_t *) &(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
+                            defaultValueSizeForBigEndianNudger =
+                                sizeof(am->defaultValue.ptrToMinMaxValue->defaultValue.defaultValue);
                         }
                         else
                         {
-                            if ((emberAfAttributeSize(am) <= 4) && !emberAfIsStringAttributeType(am->attributeType))
-                            {
-                                ptr                                = (uint8_t *) &(am->defaultValue.defaultValue);
-                                defaultValueSizeForBigEndianNudger = sizeof(am->defaultValue.defaultValue);
-                            }
-                            else
-                            {
-                                ptr = (uint8_t *) am->defaultValue.ptrToDefaultValue;
-                            }
+                            ptr = (uint8_t *) am->defaultValue.ptrToMinMaxValue->defaultValue.ptrToDefaultValue;
                         }
-                        // At this point, ptr either points to a default value, or is NULL, in which case
-                        // it should be treated as if it is pointing to an array of all zeroes.
-
-#if (BIGENDIAN_CPU)
-                        // The default values for attributes that are less than or equal to
-                        // defaultValueSizeForBigEndianNudger in bytes are stored in an
-                        // uint32_t.  On big-endian platforms, a pointer to the default value
-                        // of size less than defaultValueSizeForBigEndianNudger will point to the wrong
-                        // byte.  So, for those cases, nudge the pointer forward so it points
-                        // to the correct byte.
-                        if (emberAfAttributeSize(am) < defaultValueSizeForBigEndianNudger && ptr != NULL)
+                    }
+                    else
+                    {
+                        if ((emberAfAttributeSize(am) <= 4) && !emberAfIsStringAttributeType(am->attributeType))
                         {
-                            ptr += (defaultValueSizeForBigEndianNudger - emberAfAttributeSize(am));
+                            ptr                                = (uint8_t *) &(am->defaultValue.defaultValue);
+                            defaultValueSizeForBigEndianNudger = sizeof(am->defaultValue.defaultValue);
+                        }
+                        else
+                        {
+                            ptr = (uint8_t *) am->defaultValue.ptrToDefaultValue;
                         }
-#endif // BIGENDIAN
                     }
+                    // At this point, ptr either points to a default value, or is NULL, in which case
+                    // it should be treated as if it is pointing to an array of all zeroes.
+
+#if (BIGENDIAN_CPU)
+                    // The default values for attributes that are less than or equal to
+                    // defaultValueSizeForBigEndianNudger in bytes are stored in an
+                    // uint32_t.  On big-endian platforms, a pointer to the default value
+                    // of size less than defaultValueSizeForBigEndianNudger will point to the wrong
+                    // byte.  So, for those cases, nudge the pointer forward so it points
+                    // to the correct byte.
+                    if (emberAfAttributeSize(am) < defaultValueSizeForBigEndianNudger && ptr != NULL)
+                    {
+                        ptr += (defaultValueSizeForBigEndianNudger - emberAfAttributeSize(am));
+                    }
+#endif // BIGENDIAN
 
                     emAfReadOrWriteAttribute(&record,
                                              nullptr, // metadata - unused
@@ -1301,6 +1448,12 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
                 }
             }
         }
+
+        if (hasPersistedAttributes)
+        {
+            restorePersistedAttributes(de, clusterId, *attrStorage);
+        }
+
         if (endpoint != EMBER_BROADCAST_ENDPOINT)
         {
             break;
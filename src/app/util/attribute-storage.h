@@ -139,6 +139,10 @@ uint8_t emberAfClusterCountForEndpointType(const EmberAfEndpointType * endpointT
 // depending on server toggle.
 const EmberAfCluster * emberAfGetNthCluster(chip::EndpointId endpoint, uint8_t n, bool server);
 
+// Returns the cluster of Nth server or client cluster on the endpoint at the given index,
+// depending on server toggle.
+const EmberAfCluster * emberAfGetNthClusterFromIndex(uint16_t endpointIndex, uint8_t n, bool server);
+
 // Returns the clusterId of Nth server or client cluster,
 // depending on server toggle.
 // Returns Optional<ClusterId>::Missing if cluster does not exist.
@@ -238,6 +242,10 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, chip::EndpointId id, con
 chip::EndpointId emberAfClearDynamicEndpoint(uint16_t index);
 uint16_t emberAfGetDynamicIndexFromEndpoint(chip::EndpointId id);
 
+// Get a number that changes whenever a dynamic endpoint is set or cleared. Metadata pointers obtained before it changed, e.g.
+// from emberAfGetNthClusterFromIndex, may no longer describe the endpoint they were obtained for.
+uint32_t emberAfMetadataStructureGeneration();
+
 // Get the number of attributes of the specific cluster under the endpoint.
 // Returns 0 if the cluster does not exist.
 uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
@@ -30,6 +30,8 @@
 #include <app/att-storage.h>
 #include <app/reporting/Engine.h>
 #include <app/reporting/reporting.h>
+#include <app/util/DataModelHandler.h>
+#include <app/util/DeferredAttributeChanges.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage-null-handling.h>
 #include <app/util/attribute-storage.h>
@@ -963,6 +965,21 @@ const EmberAfAttributeMetadata * GetAttributeMetadata(const ConcreteAttributePat
                                           aConcreteClusterPath.mAttributeId);
 }
 
+namespace {
+
+// Lists are written through AttributeAccessInterface as one AttributeDataIB per entry, so their changes are reported
+// once per write request message. Shut down by ShutdownDataModelHandler(), as the system layer is gone by the time
+// static objects are destroyed.
+DeferredAttributeChanges gDeferredAttributeChanges(MatterReportingAttributeChangeCallback);
+
+System::Layer * GetSystemLayer()
+{
+    Messaging::ExchangeManager * exchangeManager = InteractionModelEngine::GetInstance()->GetExchangeManager();
+    return exchangeManager != nullptr ? exchangeManager->GetSessionManager()->SystemLayer() : nullptr;
+}
+
+} // namespace
+
 CHIP_ERROR WriteSingleClusterData(const SubjectDescriptor & aSubjectDescriptor, const ConcreteDataAttributePath & aPath,
                                   TLV::TLVReader & aReader, WriteHandler * apWriteHandler)
 {
@@ -1014,7 +1031,7 @@ CHIP_ERROR WriteSingleClusterData(const SubjectDescriptor & aSubjectDescriptor,
 
         if (valueDecoder.TriedDecode())
         {
-            MatterReportingAttributeChangeCallback(aPath);
+            gDeferredAttributeChanges.OnAttributeChanged(GetSystemLayer(), aPath);
             return apWriteHandler->AddStatus(aPath, Protocols::InteractionModel::Status::Success);
         }
     }
@@ -1040,6 +1057,9 @@ CHIP_ERROR WriteSingleClusterData(const SubjectDescriptor & aSubjectDescriptor,
 
 bool IsClusterDataVersionEqual(const ConcreteClusterPath & aConcreteClusterPath, DataVersion aRequiredVersion)
 {
+    // The data version must account for the changes the write request being applied already made to the cluster.
+    gDeferredAttributeChanges.ReportChanges(&aConcreteClusterPath);
+
     DataVersion * version = emberAfDataVersionStorage(aConcreteClusterPath);
     if (version == nullptr)
     {
@@ -1107,3 +1127,8 @@ void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 
     InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info);
 }
+
+void ShutdownDataModelHandler()
+{
+    gDeferredAttributeChanges.Shutdown();
+}
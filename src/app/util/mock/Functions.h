@@ -36,5 +36,17 @@ CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const ap
                                      app::AttributeValueEncoder::AttributeEncodeState * apEncoderState);
 void BumpVersion();
 DataVersion GetVersion();
+
+/**
+ * Adds aCount bridged endpoints, with endpoint ids 1 to aCount, after the mock endpoints. Each of them has the clusters and
+ * attributes of kMockEndpoint3. A count of 0 removes them.
+ */
+void SetMockBridgedEndpointCount(uint16_t aCount);
+
+/**
+ * Gives the bridged endpoints the clusters and attributes of the mock endpoint at aMockEndpointIndex instead, as if they had
+ * been cleared and set again with another endpoint type.
+ */
+void SetMockBridgedEndpointLayout(uint16_t aMockEndpointIndex);
 } // namespace Test
 } // namespace chip
@@ -23,6 +23,7 @@
  *     - It contains four clusters: 0xFFF1'0001 to 0xFFF1'0004
  *     - All cluster has two global attribute (0x0000'FFFC, 0x0000'FFFD)
  *     - Some clusters has some cluster-specific attributes, with 0xFFF1 prefix.
+ *     - Tests may add bridged endpoints after them, see SetMockBridgedEndpointCount.
  *
  *    Note: The ember's attribute-storage.cpp will include some app specific generated files. So we cannot use it directly. This
  *    might be fixed with a mock endpoint-config.h
@@ -50,6 +51,8 @@
 
 #include <app/util/attribute-metadata.h>
 
+#include <algorithm>
+
 typedef uint8_t EmberAfClusterMask;
 
 using namespace chip;
@@ -65,20 +68,42 @@ ClusterId clusters[]      = { MockClusterId(1), MockClusterId(2), MockClusterId(
                          MockClusterId(1), MockClusterId(2), MockClusterId(3), MockClusterId(4) };
 uint16_t attributeIndex[] = { 0, 2, 5, 7, 11, 16, 19, 25, 27 };
 uint16_t attributeCount[] = { 2, 3, 2, 4, 5, 3, 6, 2, 2 };
-AttributeId attributes[]  = {
+// The metadata of the mock attributes only holds their ids.
+EmberAfAttributeMetadata MockAttribute(AttributeId id)
+{
+    return EmberAfAttributeMetadata{ EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)), id, 0, 0, 0 };
+}
+
+constexpr AttributeId kClusterRevision = Clusters::Globals::Attributes::ClusterRevision::Id;
+constexpr AttributeId kFeatureMap      = Clusters::Globals::Attributes::FeatureMap::Id;
+
+EmberAfAttributeMetadata attributes[] = {
     // clang-format off
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id, MockAttributeId(1),
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id, MockAttributeId(1), MockAttributeId(2),
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id, MockAttributeId(1), MockAttributeId(2), MockAttributeId(3),
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id, MockAttributeId(1),
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id, MockAttributeId(1), MockAttributeId(2), MockAttributeId(3), MockAttributeId(4),
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,
-    Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap), MockAttribute(MockAttributeId(1)),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap), MockAttribute(MockAttributeId(1)),
+        MockAttribute(MockAttributeId(2)),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap), MockAttribute(MockAttributeId(1)),
+        MockAttribute(MockAttributeId(2)), MockAttribute(MockAttributeId(3)),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap), MockAttribute(MockAttributeId(1)),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap), MockAttribute(MockAttributeId(1)),
+        MockAttribute(MockAttributeId(2)), MockAttribute(MockAttributeId(3)), MockAttribute(MockAttributeId(4)),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap),
+    MockAttribute(kClusterRevision), MockAttribute(kFeatureMap)
     // clang-format on
 };
 
+// The cluster metadata returned by emberAfGetNthClusterFromIndex, laid out like the generated one.
+#define MOCK_CLUSTER(index)                                                                                                        \
+    {                                                                                                                              \
+        clusters[index], &attributes[attributeIndex[index]], attributeCount[index]                                                 \
+    }
+
+EmberAfCluster clusterMetadata[] = { MOCK_CLUSTER(0), MOCK_CLUSTER(1), MOCK_CLUSTER(2), MOCK_CLUSTER(3), MOCK_CLUSTER(4),
+                                     MOCK_CLUSTER(5), MOCK_CLUSTER(6), MOCK_CLUSTER(7), MOCK_CLUSTER(8) };
+static_assert(ArraySize(clusterMetadata) == ArraySize(clusters), "Each mock cluster needs its metadata");
+
 uint16_t mockClusterRevision = 1;
 uint32_t mockFeatureMap      = 0x1234;
 bool mockAttribute1          = true;
@@ -95,22 +120,32 @@ uint8_t mockAttribute4[256]  = {
     0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf,
 };
 
+uint16_t bridgedEndpointCount        = 0;
+uint16_t bridgedEndpointLayout       = static_cast<uint16_t>(ArraySize(endpoints) - 1);
+uint32_t metadataStructureGeneration = 0;
+
+// Bridged endpoints share the clusters and attributes of one of the mock endpoints, the last one by default.
+uint16_t LayoutIndex(uint16_t endpointIndex)
+{
+    return endpointIndex < ArraySize(endpoints) ? endpointIndex : bridgedEndpointLayout;
+}
+
 } // namespace
 
 uint16_t emberAfEndpointCount()
 {
-    return ArraySize(endpoints);
+    return static_cast<uint16_t>(ArraySize(endpoints) + bridgedEndpointCount);
 }
 
 uint16_t emberAfIndexFromEndpoint(chip::EndpointId endpoint)
 {
     static_assert(ArraySize(endpoints) < UINT16_MAX, "Need to be able to return endpoint index as a 16-bit value.");
 
-    for (size_t i = 0; i < ArraySize(endpoints); i++)
+    for (uint16_t i = 0; i < emberAfEndpointCount(); i++)
     {
-        if (endpoints[i] == endpoint)
+        if (emberAfEndpointFromIndex(i) == endpoint)
         {
-            return static_cast<uint16_t>(i);
+            return i;
         }
     }
     return UINT16_MAX;
@@ -118,14 +153,12 @@ uint16_t emberAfIndexFromEndpoint(chip::EndpointId endpoint)
 
 uint8_t emberAfGetClusterCountForEndpoint(chip::EndpointId endpoint)
 {
-    for (size_t i = 0; i < ArraySize(endpoints); i++)
+    uint16_t endpointIndex = emberAfIndexFromEndpoint(endpoint);
+    if (endpointIndex == UINT16_MAX)
     {
-        if (endpoints[i] == endpoint)
-        {
-            return clusterCount[i];
-        }
+        return 0;
     }
-    return 0;
+    return clusterCount[LayoutIndex(endpointIndex)];
 }
 
 uint8_t emberAfClusterCount(chip::EndpointId endpoint, bool server)
@@ -133,15 +166,24 @@ uint8_t emberAfClusterCount(chip::EndpointId endpoint, bool server)
     return emberAfGetClusterCountForEndpoint(endpoint);
 }
 
+uint8_t emberAfClusterCountByIndex(uint16_t endpointIndex, bool server)
+{
+    if (endpointIndex >= emberAfEndpointCount())
+    {
+        return 0;
+    }
+    return clusterCount[LayoutIndex(endpointIndex)];
+}
+
 uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster)
 {
     uint16_t endpointIndex         = emberAfIndexFromEndpoint(endpoint);
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
-            return attributeCount[i + clusterIndex[endpointIndex]];
+            return attributeCount[i + clusterIndex[LayoutIndex(endpointIndex)]];
         }
     }
     return 0;
@@ -154,12 +196,12 @@ uint16_t emberAfGetServerAttributeIndexByAttributeId(chip::EndpointId endpoint,
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
-            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[endpointIndex]];
+            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[LayoutIndex(endpointIndex)]];
             for (uint16_t j = 0; j < emberAfGetServerAttributeCount(endpoint, cluster); j++)
             {
-                if (attributes[clusterAttributeOffset + j] == attributeId)
+                if (attributes[clusterAttributeOffset + j].attributeId == attributeId)
                 {
                     return j;
                 }
@@ -177,17 +219,32 @@ bool emberAfContainsAttribute(chip::EndpointId endpoint, chip::ClusterId cluster
 
 chip::EndpointId emberAfEndpointFromIndex(uint16_t index)
 {
-    VerifyOrDie(index < ArraySize(endpoints));
-    return endpoints[index];
+    VerifyOrDie(index < emberAfEndpointCount());
+    if (index < ArraySize(endpoints))
+    {
+        return endpoints[index];
+    }
+    // Bridged endpoints are numbered from 1.
+    return static_cast<EndpointId>(index - ArraySize(endpoints) + 1);
+}
+
+const EmberAfCluster * emberAfGetNthClusterFromIndex(uint16_t endpointIndex, uint8_t n, bool server)
+{
+    if (n >= emberAfClusterCountByIndex(endpointIndex, server))
+    {
+        return nullptr;
+    }
+    return &clusterMetadata[clusterIndex[LayoutIndex(endpointIndex)] + n];
 }
 
 chip::Optional<chip::ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint, uint8_t n, bool server)
 {
-    if (n >= emberAfClusterCount(endpoint, server))
+    const EmberAfCluster * cluster = emberAfGetNthClusterFromIndex(emberAfIndexFromEndpoint(endpoint), n, server);
+    if (cluster == nullptr)
     {
         return chip::Optional<chip::ClusterId>::Missing();
     }
-    return chip::Optional<chip::ClusterId>(clusters[clusterIndex[emberAfIndexFromEndpoint(endpoint)] + n]);
+    return chip::Optional<chip::ClusterId>(cluster->clusterId);
 }
 
 // Returns number of clusters put into the passed cluster list
@@ -215,12 +272,12 @@ chip::Optional<chip::AttributeId> emberAfGetServerAttributeIdByIndex(chip::Endpo
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
-            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[endpointIndex]];
+            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[LayoutIndex(endpointIndex)]];
             if (index < emberAfGetServerAttributeCount(endpoint, cluster))
             {
-                return Optional<AttributeId>(attributes[clusterAttributeOffset + index]);
+                return Optional<AttributeId>(attributes[clusterAttributeOffset + index].attributeId);
             }
             break;
         }
@@ -234,7 +291,7 @@ uint8_t emberAfClusterIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
             return i;
         }
@@ -244,7 +301,12 @@ uint8_t emberAfClusterIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
 
 bool emberAfEndpointIndexIsEnabled(uint16_t index)
 {
-    return index < ArraySize(endpoints);
+    return index < emberAfEndpointCount();
+}
+
+uint32_t emberAfMetadataStructureGeneration()
+{
+    return metadataStructureGeneration;
 }
 
 // This duplication of basic utilities is really unfortunate, but we can't link
@@ -335,6 +397,20 @@ DataVersion GetVersion()
     return dataVersion;
 }
 
+void SetMockBridgedEndpointCount(uint16_t aCount)
+{
+    VerifyOrDie(aCount < kMockEndpointMin);
+    bridgedEndpointCount = aCount;
+    metadataStructureGeneration++;
+}
+
+void SetMockBridgedEndpointLayout(uint16_t aMockEndpointIndex)
+{
+    VerifyOrDie(aMockEndpointIndex < ArraySize(endpoints));
+    bridgedEndpointLayout = aMockEndpointIndex;
+    metadataStructureGeneration++;
+}
+
 CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const ConcreteAttributePath & aPath,
                                      AttributeReportIBs::Builder & aAttributeReports,
                                      AttributeValueEncoder::AttributeEncodeState * apEncoderState)
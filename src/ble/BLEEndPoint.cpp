@@ -160,6 +160,8 @@ CHIP_ERROR BLEEndPoint::HandleConnectComplete()
     // Cancel the connect timer.
     StopConnectTimer();
 
+    SetMaxGattSendsInFlight();
+
     // We've successfully completed the BLE transport protocol handshake, so let the application know we're open for business.
     if (mBleTransport != nullptr)
     {
@@ -185,6 +187,8 @@ CHIP_ERROR BLEEndPoint::HandleReceiveConnectionComplete()
     // Cancel receive connection timer.
     StopReceiveConnectionTimer();
 
+    SetMaxGattSendsInFlight();
+
     // We've successfully completed the BLE transport protocol handshake, so let the transport know we're open for business.
     if (mBleTransport != nullptr)
     {
@@ -563,6 +567,8 @@ CHIP_ERROR BLEEndPoint::Init(BleLayer * bleLayer, BLE_CONNECTION_OBJECT connObj,
     mLocalReceiveWindowSize  = 0;
     mRemoteReceiveWindowSize = 0;
     mReceiveWindowMaxSize    = 0;
+    mGattSendsInFlight       = 0;
+    mMaxGattSendsInFlight    = 1;
     mSendQueue               = nullptr;
     mAckToSend               = nullptr;
 
@@ -693,6 +699,22 @@ exit:
     return err;
 }
 
+CHIP_ERROR BLEEndPoint::SendFragment()
+{
+    PacketBufferHandle fragment = mBtpEngine.BorrowTxPacket();
+
+    if (mMaxGattSendsInFlight > 1)
+    {
+        // The fragmenter writes the header of the next fragment over the end of this one while the platform may still be
+        // sending it, so each fragment in flight gets a buffer of its own.
+        fragment =
+            PacketBufferHandle::NewWithData(fragment->Start(), fragment->DataLength(), 0, CHIP_CONFIG_BLE_PKT_RESERVED_SIZE);
+        VerifyOrReturnError(!fragment.IsNull(), CHIP_ERROR_NO_MEMORY);
+    }
+
+    return SendCharacteristic(std::move(fragment));
+}
+
 bool BLEEndPoint::PrepareNextFragment(PacketBufferHandle && data, bool & sentAck)
 {
     // If we have a pending fragment acknowledgement to send, piggyback it on the fragment we're about to transmit.
@@ -757,7 +779,7 @@ CHIP_ERROR BLEEndPoint::SendNextMessage()
         ExitNow();
     });
      */
-    ReturnErrorOnFailure(SendCharacteristic(mBtpEngine.BorrowTxPacket()));
+    ReturnErrorOnFailure(SendFragment());
 
     if (sentAck)
     {
@@ -782,7 +804,7 @@ CHIP_ERROR BLEEndPoint::ContinueMessageSend()
         return BLE_ERROR_CHIPOBLE_PROTOCOL_ABORT;
     }
 
-    ReturnErrorOnFailure(SendCharacteristic(mBtpEngine.BorrowTxPacket()));
+    ReturnErrorOnFailure(SendFragment());
 
     if (sentAck)
     {
@@ -914,8 +936,15 @@ CHIP_ERROR BLEEndPoint::HandleGattSendConfirmationReceived()
 {
     ChipLogDebugBleEndPoint(Ble, "entered HandleGattSendConfirmationReceived");
 
-    // Mark outstanding GATT operation as finished.
-    mConnStateFlags.Clear(ConnectionStateFlag::kGattOperationInFlight);
+    // Mark outstanding GATT operation as finished. Others may remain in flight if fragments are pipelined.
+    if (mGattSendsInFlight > 0)
+    {
+        mGattSendsInFlight--;
+    }
+    if (mGattSendsInFlight == 0)
+    {
+        mConnStateFlags.Clear(ConnectionStateFlag::kGattOperationInFlight);
+    }
 
     // If confirmation was for outbound portion of BTP connect handshake...
     if (!mConnStateFlags.Has(ConnectionStateFlag::kCapabilitiesConfReceived))
@@ -962,15 +991,43 @@ CHIP_ERROR BLEEndPoint::DoSendStandAloneAck()
     return StartAckReceivedTimer();
 }
 
+bool BLEEndPoint::CanSendFragment() const
+{
+    if (!mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight))
+    {
+        return true;
+    }
+
+    // Only message fragments are pipelined: handshake, subscribe and stand-alone ack operations must be confirmed before
+    // anything else is sent.
+    return mConnStateFlags.Has(ConnectionStateFlag::kCapabilitiesConfReceived) &&
+        !mConnStateFlags.Has(ConnectionStateFlag::kStandAloneAckInFlight) && mAckToSend.IsNull() && mGattSendsInFlight > 0 &&
+        mGattSendsInFlight < mMaxGattSendsInFlight;
+}
+
 CHIP_ERROR BLEEndPoint::DriveSending()
 {
     ChipLogDebugBleEndPoint(Ble, "entered DriveSending");
 
+    // Keep sending while the remote receive window and the platform allow more fragments in flight.
+    bool didSend = true;
+    while (didSend)
+    {
+        ReturnErrorOnFailure(DriveSendingOnce(didSend));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BLEEndPoint::DriveSendingOnce(bool & didSend)
+{
+    didSend = false;
+
     // If receiver's window is almost closed and we don't have an ack to send, OR we do have an ack to send but
-    // receiver's window is completely empty, OR another GATT operation is in flight, awaiting confirmation...
+    // receiver's window is completely empty, OR no more GATT operations may be in flight, awaiting confirmation...
     if ((mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
          !mTimerStateFlags.Has(TimerStateFlag::kSendAckTimerRunning) && mAckToSend.IsNull()) ||
-        (mRemoteReceiveWindowSize == 0) || (mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight)))
+        (mRemoteReceiveWindowSize == 0) || !CanSendFragment())
     {
 #ifdef CHIP_BLE_END_POINT_DEBUG_LOGGING_ENABLED
         if (mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
@@ -984,7 +1041,7 @@ CHIP_ERROR BLEEndPoint::DriveSending()
             ChipLogDebugBleEndPoint(Ble, "NO SEND: remote receive window closed");
         }
 
-        if (mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight))
+        if (!CanSendFragment())
         {
             ChipLogDebugBleEndPoint(Ble, "NO SEND: Gatt op in flight");
         }
@@ -999,6 +1056,7 @@ CHIP_ERROR BLEEndPoint::DriveSending()
     if (!mAckToSend.IsNull()) // If immediate, stand-alone ack is pending, send it.
     {
         ReturnErrorOnFailure(DoSendStandAloneAck());
+        didSend = true;
     }
     else if (mBtpEngine.TxState() == BtpEngine::kState_Idle) // Else send next message fragment, if any.
     {
@@ -1007,6 +1065,7 @@ CHIP_ERROR BLEEndPoint::DriveSending()
         {
             // Transmit first fragment of next whole message in send queue.
             ReturnErrorOnFailure(SendNextMessage());
+            didSend = true;
         }
         else
         {
@@ -1017,6 +1076,7 @@ CHIP_ERROR BLEEndPoint::DriveSending()
     {
         // Send next fragment of message currently held by fragmenter.
         ReturnErrorOnFailure(ContinueMessageSend());
+        didSend = true;
     }
     else if (mBtpEngine.TxState() == BtpEngine::kState_Complete)
     {
@@ -1031,6 +1091,7 @@ CHIP_ERROR BLEEndPoint::DriveSending()
         {
             // Transmit first fragment of next whole message in send queue.
             ReturnErrorOnFailure(SendNextMessage());
+            didSend = true;
         }
         else if (mState == kState_Closing && !mBtpEngine.ExpectingAck()) // and mSendQueue is NULL, per above...
         {
@@ -1393,6 +1454,7 @@ exit:
 bool BLEEndPoint::SendWrite(PacketBufferHandle && buf)
 {
     mConnStateFlags.Set(ConnectionStateFlag::kGattOperationInFlight);
+    mGattSendsInFlight++;
 
     return mBle->mPlatformDelegate->SendWriteRequest(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_1_ID, std::move(buf));
 }
@@ -1400,10 +1462,21 @@ bool BLEEndPoint::SendWrite(PacketBufferHandle && buf)
 bool BLEEndPoint::SendIndication(PacketBufferHandle && buf)
 {
     mConnStateFlags.Set(ConnectionStateFlag::kGattOperationInFlight);
+    mGattSendsInFlight++;
 
     return mBle->mPlatformDelegate->SendIndication(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_2_ID, std::move(buf));
 }
 
+void BLEEndPoint::SetMaxGattSendsInFlight()
+{
+    // Fragments can be pipelined only if the platform allows it; the remote receive window still applies.
+    mMaxGattSendsInFlight = chip::max(mBle->mPlatformDelegate->GetMaxGattSendsInFlight(mConnObj), static_cast<uint8_t>(1));
+    if (mMaxGattSendsInFlight > 1)
+    {
+        ChipLogProgress(Ble, "sending up to %u fragments before confirmation", mMaxGattSendsInFlight);
+    }
+}
+
 CHIP_ERROR BLEEndPoint::StartConnectTimer()
 {
     const CHIP_ERROR timerErr =
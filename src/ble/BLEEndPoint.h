@@ -164,6 +164,8 @@ private:
     SequenceNumber_t mLocalReceiveWindowSize;
     SequenceNumber_t mRemoteReceiveWindowSize;
     SequenceNumber_t mReceiveWindowMaxSize;
+    uint8_t mGattSendsInFlight;    // GATT writes or indications awaiting confirmation.
+    uint8_t mMaxGattSendsInFlight; // Message fragments that may await confirmation at once, as allowed by the platform.
 #if CHIP_ENABLE_CHIPOBLE_TEST
     chip::System::Mutex mTxQueueMutex; // For MT-safe Tx queuing
 #endif
@@ -178,14 +180,18 @@ private:
 
     // Transmit path:
     CHIP_ERROR DriveSending();
+    CHIP_ERROR DriveSendingOnce(bool & didSend);
+    bool CanSendFragment() const;
     CHIP_ERROR DriveStandAloneAck();
     bool PrepareNextFragment(PacketBufferHandle && data, bool & sentAck);
     CHIP_ERROR SendNextMessage();
     CHIP_ERROR ContinueMessageSend();
     CHIP_ERROR DoSendStandAloneAck();
+    CHIP_ERROR SendFragment();
     CHIP_ERROR SendCharacteristic(PacketBufferHandle && buf);
     bool SendIndication(PacketBufferHandle && buf);
     bool SendWrite(PacketBufferHandle && buf);
+    void SetMaxGattSendsInFlight();
 
     // Receive path:
     CHIP_ERROR HandleConnectComplete();
@@ -154,6 +154,10 @@
  *    Default value of 3 is absolute minimum for stable performance, and an attempt to ensure safe window sizes on new
  *    platforms.
  *
+ *    On platforms which let end points send message fragments without waiting for the confirmation of the previous
+ *    ones (see BlePlatformDelegate::GetMaxGattSendsInFlight), the negotiated window also bounds the number of fragments
+ *    in flight, so a larger window directly increases throughput.
+ *
  */
 #ifndef BLE_MAX_RECEIVE_WINDOW_SIZE
 #define BLE_MAX_RECEIVE_WINDOW_SIZE 6
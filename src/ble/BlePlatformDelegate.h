@@ -77,6 +77,16 @@ public:
     // Send response to remote host's GATT chacteristic read response
     virtual bool SendReadResponse(BLE_CONNECTION_OBJECT connObj, BLE_READ_REQUEST_CONTEXT requestContext, const ChipBleUUID * svcId,
                                   const ChipBleUUID * charId) = 0;
+
+    // Following APIs may be implemented by platform:
+
+    // Get the number of GATT writes or indications that may await confirmation on the specified BLE connection at the same
+    // time. By default, BLE end points wait for the confirmation of each message fragment before sending the next one.
+    //
+    // Platforms which queue GATT operations may return a larger value to let end points send the next fragments of a message
+    // without waiting, up to the BTP receive window of the remote device. Each of these fragments is then passed to
+    // SendIndication or SendWriteRequest in a buffer of its own, which the platform may hold until it is sent.
+    virtual uint8_t GetMaxGattSendsInFlight(BLE_CONNECTION_OBJECT connObj) const { return 1; }
 };
 
 } /* namespace Ble */
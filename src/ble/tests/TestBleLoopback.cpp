@@ -0,0 +1,509 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a test of BLE transport protocol throughput between
+ *      a central BleLayer and a simulated peripheral, connected by a loopback
+ *      platform delegate which models the connection events of a BLE link.
+ */
+
+#include <ble/BleLayer.h>
+#include <ble/BleLayerDelegate.h>
+#include <ble/BtpEngine.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemLayerImpl.h>
+
+#include <nlunit-test.h>
+
+#include <deque>
+
+using namespace chip;
+using namespace chip::Ble;
+
+namespace {
+
+constexpr uint16_t kMtu                  = 247;
+constexpr uint16_t kFragmentSize         = kMtu - 3;
+constexpr uint32_t kConnectionIntervalMs = 30;
+constexpr uint16_t kMessageSize          = 1024;
+constexpr size_t kNumMessages            = 2;
+constexpr uint32_t kMaxConnectionEvents  = 1000;
+
+// Characteristics of the CHIPoBLE service, as defined in BleLayer.cpp.
+const ChipBleUUID kChar1Id = { { 0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C, 0x42, 0x9F, 0x9D, 0x11 } };
+const ChipBleUUID kChar2Id = { { 0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C, 0x42, 0x9F, 0x9D, 0x12 } };
+
+/**
+ * GATT operations queued by one side of the link.
+ *
+ * Like a BLE stack, each side sends at most one queued GATT operation per connection event, and learns that it was
+ * confirmed by the remote device at the next event. Operations queued during an event are sent at the next one at the
+ * earliest, so an application that only sends after a confirmation needs two connection events per operation.
+ */
+struct OperationQueue
+{
+    enum class Kind
+    {
+        kSubscribe,
+        kUnsubscribe,
+        kWrite,
+        kIndication,
+        kStandAloneAck
+    };
+
+    struct Operation
+    {
+        Kind kind;
+        System::PacketBufferHandle data;
+        uint32_t queuedAt;
+    };
+
+    OperationQueue(const uint32_t & connectionEvent) : mConnectionEvent(connectionEvent) {}
+
+    void Push(Kind kind, System::PacketBufferHandle && data)
+    {
+        mOperations.push_back(Operation{ kind, std::move(data), mConnectionEvent });
+    }
+
+    // Returns whether an operation is to be transmitted during the current connection event.
+    bool Pop(Operation & operation)
+    {
+        if (mOperations.empty() || mOperations.front().queuedAt >= mConnectionEvent)
+        {
+            return false;
+        }
+        operation = std::move(mOperations.front());
+        mOperations.pop_front();
+        return true;
+    }
+
+    const uint32_t & mConnectionEvent;
+    std::deque<Operation> mOperations;
+};
+
+class LoopbackPeripheral;
+
+/**
+ * Platform delegate of the central, which sends GATT operations to a LoopbackPeripheral.
+ */
+class LoopbackPlatformDelegate : public BlePlatformDelegate
+{
+public:
+    LoopbackPlatformDelegate(BleLayer & layer, BLE_CONNECTION_OBJECT connObj, LoopbackPeripheral & peripheral,
+                             const uint32_t & connectionEvent) :
+        mLayer(layer),
+        mConnObj(connObj), mPeripheral(peripheral), mQueue(connectionEvent)
+    {}
+
+    void RunConnectionEvent();
+
+    bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId) override
+    {
+        mQueue.Push(OperationQueue::Kind::kSubscribe, nullptr);
+        return true;
+    }
+
+    bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId) override
+    {
+        mQueue.Push(OperationQueue::Kind::kUnsubscribe, nullptr);
+        return true;
+    }
+
+    bool CloseConnection(BLE_CONNECTION_OBJECT connObj) override { return true; }
+
+    uint16_t GetMTU(BLE_CONNECTION_OBJECT connObj) const override { return kMtu; }
+
+    bool SendIndication(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                        System::PacketBufferHandle pBuf) override
+    {
+        return false;
+    }
+
+    bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                          System::PacketBufferHandle pBuf) override
+    {
+        // Like a BLE stack, keep the buffer until the write is sent.
+        mQueue.Push(OperationQueue::Kind::kWrite, std::move(pBuf));
+        return true;
+    }
+
+    bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                         System::PacketBufferHandle pBuf) override
+    {
+        return false;
+    }
+
+    bool SendReadResponse(BLE_CONNECTION_OBJECT connObj, BLE_READ_REQUEST_CONTEXT requestContext, const ChipBleUUID * svcId,
+                          const ChipBleUUID * charId) override
+    {
+        return false;
+    }
+
+    uint8_t GetMaxGattSendsInFlight(BLE_CONNECTION_OBJECT connObj) const override { return mMaxGattSendsInFlight; }
+
+    uint8_t mMaxGattSendsInFlight = 1;
+
+private:
+    BleLayer & mLayer;
+    BLE_CONNECTION_OBJECT mConnObj;
+    LoopbackPeripheral & mPeripheral;
+    OperationQueue mQueue;
+    bool mInFlight                     = false;
+    OperationQueue::Kind mInFlightKind = OperationQueue::Kind::kWrite;
+};
+
+/**
+ * Peripheral side of the BLE transport protocol, which answers the capabilities request of the central, reassembles
+ * the messages it writes and acknowledges its fragments.
+ */
+class LoopbackPeripheral
+{
+public:
+    LoopbackPeripheral(BleLayer & central, BLE_CONNECTION_OBJECT centralConnObj, const uint32_t & connectionEvent) :
+        mCentral(central), mCentralConnObj(centralConnObj), mQueue(connectionEvent)
+    {}
+
+    CHIP_ERROR Init()
+    {
+        // The capabilities response is the first indication, and is acknowledged by the central.
+        ReturnErrorOnFailure(mBtpEngine.Init(this, true));
+        mBtpEngine.SetRxFragmentSize(kFragmentSize);
+        mBtpEngine.SetTxFragmentSize(kFragmentSize);
+        return CHIP_NO_ERROR;
+    }
+
+    void RunConnectionEvent()
+    {
+        OperationQueue::Operation operation;
+        if (!mQueue.Pop(operation))
+        {
+            return;
+        }
+
+        if (operation.kind == OperationQueue::Kind::kStandAloneAck)
+        {
+            // Encode the ack when it is sent, to acknowledge every fragment received so far.
+            mAckQueued = false;
+            if (mBtpEngine.EncodeStandAloneAck(operation.data) != CHIP_NO_ERROR)
+            {
+                mError = true;
+                return;
+            }
+        }
+        mCentral.HandleIndicationReceived(mCentralConnObj, &CHIP_BLE_SVC_ID, &kChar2Id, std::move(operation.data));
+    }
+
+    void HandleSubscribeReceived()
+    {
+        BleTransportCapabilitiesResponseMessage response;
+        response.mSelectedProtocolVersion = CHIP_BLE_TRANSPORT_PROTOCOL_MAX_SUPPORTED_VERSION;
+        response.mFragmentSize            = kFragmentSize;
+        response.mWindowSize              = BLE_MAX_RECEIVE_WINDOW_SIZE;
+
+        System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+        if (buf.IsNull() || response.Encode(buf) != CHIP_NO_ERROR)
+        {
+            mError = true;
+            return;
+        }
+        mQueue.Push(OperationQueue::Kind::kIndication, std::move(buf));
+    }
+
+    void HandleWriteReceived(System::PacketBufferHandle && data)
+    {
+        if (!mCapabilitiesRequestReceived)
+        {
+            mCapabilitiesRequestReceived = true;
+            return;
+        }
+
+        SequenceNumber_t receivedAck;
+        bool didReceiveAck;
+        if (mBtpEngine.HandleCharacteristicReceived(std::move(data), receivedAck, didReceiveAck) != CHIP_NO_ERROR)
+        {
+            mError = true;
+            return;
+        }
+
+        if (mBtpEngine.RxState() == BtpEngine::kState_Complete)
+        {
+            System::PacketBufferHandle message = mBtpEngine.TakeRxPacket();
+            mBytesReceived += message->DataLength();
+            mMessagesReceived++;
+
+            for (uint16_t i = 0; i < message->DataLength(); i++)
+            {
+                mPayloadValid = mPayloadValid && (message->Start()[i] == static_cast<uint8_t>(i));
+            }
+        }
+
+        if (mBtpEngine.HasUnackedData() && !mAckQueued)
+        {
+            System::PacketBufferHandle ack = System::PacketBufferHandle::New(kTransferProtocolStandaloneAckHeaderSize);
+            if (ack.IsNull())
+            {
+                mError = true;
+                return;
+            }
+            mQueue.Push(OperationQueue::Kind::kStandAloneAck, std::move(ack));
+            mAckQueued = true;
+        }
+    }
+
+    bool mError              = false;
+    size_t mBytesReceived    = 0;
+    size_t mMessagesReceived = 0;
+    bool mPayloadValid       = true;
+
+private:
+    BleLayer & mCentral;
+    BLE_CONNECTION_OBJECT mCentralConnObj;
+    OperationQueue mQueue;
+    BtpEngine mBtpEngine;
+    bool mCapabilitiesRequestReceived = false;
+    bool mAckQueued                   = false;
+};
+
+void LoopbackPlatformDelegate::RunConnectionEvent()
+{
+    if (mInFlight)
+    {
+        mInFlight = false;
+        switch (mInFlightKind)
+        {
+        case OperationQueue::Kind::kSubscribe:
+            mLayer.HandleSubscribeComplete(mConnObj, &CHIP_BLE_SVC_ID, &kChar2Id);
+            break;
+        case OperationQueue::Kind::kUnsubscribe:
+            mLayer.HandleUnsubscribeComplete(mConnObj, &CHIP_BLE_SVC_ID, &kChar2Id);
+            break;
+        default:
+            mLayer.HandleWriteConfirmation(mConnObj, &CHIP_BLE_SVC_ID, &kChar1Id);
+            break;
+        }
+    }
+
+    OperationQueue::Operation operation;
+    if (!mQueue.Pop(operation))
+    {
+        return;
+    }
+
+    mInFlight     = true;
+    mInFlightKind = operation.kind;
+    switch (operation.kind)
+    {
+    case OperationQueue::Kind::kSubscribe:
+        mPeripheral.HandleSubscribeReceived();
+        break;
+    case OperationQueue::Kind::kUnsubscribe:
+        break;
+    default:
+        // The peripheral receives the bytes as they are when the write goes over the air.
+        mPeripheral.HandleWriteReceived(operation.data.CloneData());
+        break;
+    }
+}
+
+class LoopbackTransport : public BleLayerDelegate
+{
+public:
+    void OnBleConnectionComplete(BLEEndPoint * endPoint) override
+    {
+        mEndPoint = endPoint;
+        if (endPoint->StartConnect() != CHIP_NO_ERROR)
+        {
+            mEndPoint = nullptr;
+        }
+    }
+
+    void OnBleConnectionError(CHIP_ERROR err) override {}
+
+    void OnEndPointConnectComplete(BLEEndPoint * endPoint, CHIP_ERROR err) override { mConnected = (err == CHIP_NO_ERROR); }
+
+    void OnEndPointMessageReceived(BLEEndPoint * endPoint, System::PacketBufferHandle && msg) override {}
+
+    void OnEndPointConnectionClosed(BLEEndPoint * endPoint, CHIP_ERROR err) override
+    {
+        mEndPoint  = nullptr;
+        mConnected = false;
+    }
+
+    CHIP_ERROR SetEndPoint(BLEEndPoint * endPoint) override { return CHIP_ERROR_INCORRECT_STATE; }
+
+    BLEEndPoint * mEndPoint = nullptr;
+    bool mConnected         = false;
+};
+
+class LoopbackApplicationDelegate : public BleApplicationDelegate
+{
+public:
+    void NotifyChipConnectionClosed(BLE_CONNECTION_OBJECT connObj) override {}
+};
+
+/**
+ * A central connected to a simulated peripheral over a simulated BLE link.
+ */
+class LoopbackConnection
+{
+public:
+    LoopbackConnection() :
+        mPlatform(mCentral, &mConnObj, mPeripheral, mConnectionEvent), mPeripheral(mCentral, &mConnObj, mConnectionEvent)
+    {}
+
+    CHIP_ERROR Init(uint8_t maxGattSendsInFlight)
+    {
+        ReturnErrorOnFailure(mSystemLayer.Init());
+        ReturnErrorOnFailure(mCentral.Init(&mPlatform, &mApplicationDelegate, &mSystemLayer));
+        ReturnErrorOnFailure(mPeripheral.Init());
+        mCentral.mBleTransport          = &mTransport;
+        mPlatform.mMaxGattSendsInFlight = maxGattSendsInFlight;
+
+        ReturnErrorOnFailure(mCentral.NewBleConnectionByObject(&mConnObj));
+        RunUntil([this]() { return mTransport.mConnected; });
+        return mTransport.mConnected ? CHIP_NO_ERROR : CHIP_ERROR_TIMEOUT;
+    }
+
+    void Shutdown()
+    {
+        mCentral.Shutdown();
+        mSystemLayer.Shutdown();
+    }
+
+    /**
+     * Writes kNumMessages messages of kMessageSize bytes to the peripheral and returns the number of connection events
+     * until the last one is received, or 0 on failure.
+     */
+    uint32_t Transfer()
+    {
+        const uint32_t start = mConnectionEvent;
+
+        for (size_t i = 0; i < kNumMessages; i++)
+        {
+            System::PacketBufferHandle message = System::PacketBufferHandle::New(kMessageSize);
+            if (message.IsNull() || mTransport.mEndPoint == nullptr)
+            {
+                return 0;
+            }
+            for (uint16_t j = 0; j < kMessageSize; j++)
+            {
+                message->Start()[j] = static_cast<uint8_t>(j);
+            }
+            message->SetDataLength(kMessageSize);
+
+            if (mTransport.mEndPoint->Send(std::move(message)) != CHIP_NO_ERROR)
+            {
+                return 0;
+            }
+        }
+
+        RunUntil([this]() { return mPeripheral.mError || mPeripheral.mMessagesReceived == kNumMessages; });
+        return (mPeripheral.mMessagesReceived == kNumMessages) ? mConnectionEvent - start : 0;
+    }
+
+    template <typename Condition>
+    void RunUntil(Condition condition)
+    {
+        for (uint32_t i = 0; i < kMaxConnectionEvents && !condition(); i++)
+        {
+            mConnectionEvent++;
+            mPlatform.RunConnectionEvent();
+            mPeripheral.RunConnectionEvent();
+        }
+    }
+
+    uint32_t mConnectionEvent = 0;
+    int mConnObj              = 0;
+    System::LayerImpl mSystemLayer;
+    BleLayer mCentral;
+    LoopbackPlatformDelegate mPlatform;
+    LoopbackPeripheral mPeripheral;
+    LoopbackTransport mTransport;
+    LoopbackApplicationDelegate mApplicationDelegate;
+};
+
+uint32_t CheckTransfer(nlTestSuite * inSuite, uint8_t maxGattSendsInFlight)
+{
+    LoopbackConnection connection;
+    NL_TEST_ASSERT(inSuite, connection.Init(maxGattSendsInFlight) == CHIP_NO_ERROR);
+
+    const uint32_t connectionEvents = connection.Transfer();
+    NL_TEST_ASSERT(inSuite, connectionEvents > 0);
+    NL_TEST_ASSERT(inSuite, !connection.mPeripheral.mError);
+    NL_TEST_ASSERT(inSuite, connection.mPeripheral.mMessagesReceived == kNumMessages);
+    NL_TEST_ASSERT(inSuite, connection.mPeripheral.mBytesReceived == kNumMessages * kMessageSize);
+    NL_TEST_ASSERT(inSuite, connection.mPeripheral.mPayloadValid);
+
+    if (connectionEvents > 0)
+    {
+        ChipLogProgress(Ble, "%u GATT write(s) in flight: %u bytes in %u connection events, %u B/s at %u ms intervals",
+                        maxGattSendsInFlight, static_cast<unsigned>(kNumMessages * kMessageSize), connectionEvents,
+                        static_cast<unsigned>((kNumMessages * kMessageSize * 1000) / (connectionEvents * kConnectionIntervalMs)),
+                        kConnectionIntervalMs);
+    }
+
+    connection.Shutdown();
+    return connectionEvents;
+}
+
+void CheckTransferOneWriteInFlight(nlTestSuite * inSuite, void * inContext)
+{
+    CheckTransfer(inSuite, 1);
+}
+
+void CheckTransferPipelined(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t connectionEvents          = CheckTransfer(inSuite, 1);
+    const uint32_t pipelinedConnectionEvents = CheckTransfer(inSuite, BLE_MAX_RECEIVE_WINDOW_SIZE);
+
+    // Keeping several fragments in flight must use fewer connection events.
+    NL_TEST_ASSERT(inSuite, pipelinedConnectionEvents > 0);
+    NL_TEST_ASSERT(inSuite, pipelinedConnectionEvents < connectionEvents);
+}
+
+int Setup(void * inContext)
+{
+    return (Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Teardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("CheckTransferOneWriteInFlight", CheckTransferOneWriteInFlight),
+    NL_TEST_DEF("CheckTransferPipelined", CheckTransferPipelined),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestBleLoopback()
+{
+    nlTestSuite theSuite = { "BleLoopback", &sTests[0], Setup, Teardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBleLoopback)
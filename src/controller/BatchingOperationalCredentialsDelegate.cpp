@@ -0,0 +1,139 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/BatchingOperationalCredentialsDelegate.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace Controller {
+
+CHIP_ERROR BatchingOperationalCredentialsDelegate::Init(System::Layer * systemLayer, OperationalCredentialsDelegate * issuer)
+{
+    VerifyOrReturnError(mIssuer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(systemLayer != nullptr && issuer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer = systemLayer;
+    mIssuer      = issuer;
+    return CHIP_NO_ERROR;
+}
+
+void BatchingOperationalCredentialsDelegate::Shutdown()
+{
+    VerifyOrReturn(mIssuer != nullptr);
+
+    if (mIssueScheduled)
+    {
+        mSystemLayer->CancelTimer(IssuePendingWork, this);
+        mIssueScheduled = false;
+    }
+
+    while (mPendingCount > 0)
+    {
+        Callback::Callback<OnNOCChainGeneration> * onCompletion = mPending[--mPendingCount].onCompletion;
+        onCompletion->mCall(onCompletion->mContext, CHIP_ERROR_CANCELLED, ByteSpan(), ByteSpan(), ByteSpan(), NullOptional,
+                            NullOptional);
+    }
+
+    mNextNodeId.ClearValue();
+    mSystemLayer = nullptr;
+    mIssuer      = nullptr;
+}
+
+CHIP_ERROR BatchingOperationalCredentialsDelegate::GenerateNOCChain(const ByteSpan & csrElements, const ByteSpan & csrNonce,
+                                                                    const ByteSpan & attestationSignature,
+                                                                    const ByteSpan & attestationChallenge, const ByteSpan & DAC,
+                                                                    const ByteSpan & PAI,
+                                                                    Callback::Callback<OnNOCChainGeneration> * onCompletion)
+{
+    VerifyOrReturnError(mIssuer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(onCompletion != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mPendingCount < kMaxPendingRequests, CHIP_ERROR_NO_MEMORY);
+
+    if (!mIssueScheduled)
+    {
+        ReturnErrorOnFailure(mSystemLayer->ScheduleWork(IssuePendingWork, this));
+        mIssueScheduled = true;
+    }
+
+    NOCChainRequest & request    = mPending[mPendingCount++];
+    request.csrElements          = csrElements;
+    request.csrNonce             = csrNonce;
+    request.attestationSignature = attestationSignature;
+    request.attestationChallenge = attestationChallenge;
+    request.DAC                  = DAC;
+    request.PAI                  = PAI;
+    request.nodeId               = mNextNodeId;
+    request.onCompletion         = onCompletion;
+    mNextNodeId.ClearValue();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BatchingOperationalCredentialsDelegate::GenerateNOCChains(Span<const NOCChainRequest> requests)
+{
+    VerifyOrReturnError(mIssuer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return mIssuer->GenerateNOCChains(requests);
+}
+
+void BatchingOperationalCredentialsDelegate::SetFabricIdForNextNOCRequest(FabricId fabricId)
+{
+    // The commissioners of a batch all commission into the same fabric.
+    VerifyOrReturn(mIssuer != nullptr);
+    mIssuer->SetFabricIdForNextNOCRequest(fabricId);
+}
+
+CHIP_ERROR BatchingOperationalCredentialsDelegate::ObtainCsrNonce(MutableByteSpan & csrNonce)
+{
+    VerifyOrReturnError(mIssuer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return mIssuer->ObtainCsrNonce(csrNonce);
+}
+
+void BatchingOperationalCredentialsDelegate::IssuePendingWork(System::Layer * systemLayer, void * appState)
+{
+    auto * self           = static_cast<BatchingOperationalCredentialsDelegate *>(appState);
+    self->mIssueScheduled = false;
+    self->IssuePending();
+}
+
+void BatchingOperationalCredentialsDelegate::IssuePending()
+{
+    // Completions may lead commissioners to request chains again, so the batch is taken out of the queue before it is issued.
+    NOCChainRequest batch[kMaxPendingRequests];
+    size_t batchSize = mPendingCount;
+    for (size_t i = 0; i < batchSize; i++)
+    {
+        batch[i] = mPending[i];
+    }
+    mPendingCount = 0;
+
+    ChipLogProgress(Controller, "Issuing a batch of %u NOC chains", static_cast<unsigned>(batchSize));
+    CHIP_ERROR err = mIssuer->GenerateNOCChains(Span<const NOCChainRequest>(batch, batchSize));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Controller, "Failed to issue a batch of NOC chains: %" CHIP_ERROR_FORMAT, err.Format());
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            Callback::Callback<OnNOCChainGeneration> * onCompletion = batch[i].onCompletion;
+            onCompletion->mCall(onCompletion->mContext, err, ByteSpan(), ByteSpan(), ByteSpan(), NullOptional, NullOptional);
+        }
+    }
+}
+
+} // namespace Controller
+} // namespace chip
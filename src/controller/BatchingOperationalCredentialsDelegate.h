@@ -0,0 +1,83 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <controller/OperationalCredentialsDelegate.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace Controller {
+
+/**
+ * Batches the NOC chain requests of several commissioners into GenerateNOCChains() calls on a shared issuer.
+ *
+ * It is meant to be the operational credentials delegate of the DeviceCommissioner lanes of a
+ * CommissioningScheduler.  The requests made by the lanes are held until the event loop is done with the
+ * current event, and are then issued in a single batch, so that the issuer can share its per-chain setup work
+ * between the devices that reach the NOC stage together.
+ *
+ * As for GenerateNOCChain(), the buffers of a request must remain valid until its completion is called, which
+ * DeviceCommissioner guarantees by waiting for the completion before moving on to the next stage.
+ */
+class BatchingOperationalCredentialsDelegate : public OperationalCredentialsDelegate
+{
+public:
+    // Each commissioner has at most one request in progress, and a CommissioningScheduler has at most 16 of them.
+    static constexpr size_t kMaxPendingRequests = 16;
+
+    BatchingOperationalCredentialsDelegate() = default;
+    ~BatchingOperationalCredentialsDelegate() override { Shutdown(); }
+
+    /**
+     * Initialize the delegate with the issuer it forwards the requests to.  The batches are issued from work
+     * scheduled on `systemLayer`, the one the commissioners run on.
+     */
+    CHIP_ERROR Init(System::Layer * systemLayer, OperationalCredentialsDelegate * issuer);
+
+    /**
+     * Fail the requests that have not been issued yet with CHIP_ERROR_CANCELLED and detach from the issuer.
+     */
+    void Shutdown();
+
+    size_t GetPendingCount() const { return mPendingCount; }
+
+    CHIP_ERROR GenerateNOCChain(const ByteSpan & csrElements, const ByteSpan & csrNonce, const ByteSpan & attestationSignature,
+                                const ByteSpan & attestationChallenge, const ByteSpan & DAC, const ByteSpan & PAI,
+                                Callback::Callback<OnNOCChainGeneration> * onCompletion) override;
+    CHIP_ERROR GenerateNOCChains(Span<const NOCChainRequest> requests) override;
+    void SetNodeIdForNextNOCRequest(NodeId nodeId) override { mNextNodeId.SetValue(nodeId); }
+    void SetFabricIdForNextNOCRequest(FabricId fabricId) override;
+    CHIP_ERROR ObtainCsrNonce(MutableByteSpan & csrNonce) override;
+
+private:
+    static void IssuePendingWork(System::Layer * systemLayer, void * appState);
+    void IssuePending();
+
+    System::Layer * mSystemLayer             = nullptr;
+    OperationalCredentialsDelegate * mIssuer = nullptr;
+    NOCChainRequest mPending[kMaxPendingRequests];
+    size_t mPendingCount = 0;
+    Optional<NodeId> mNextNodeId;
+    bool mIssueScheduled = false;
+};
+
+} // namespace Controller
+} // namespace chip
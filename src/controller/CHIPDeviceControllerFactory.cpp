@@ -434,6 +434,7 @@ void DeviceControllerSystemState::Shutdown()
     Dnssd::Resolver::Instance().Shutdown();
 
     // Shut down the interaction model
+    ShutdownDataModelHandler();
     app::InteractionModelEngine::GetInstance()->Shutdown();
 
     // Shut down the TransportMgr. This holds Inet::UDPEndPoints so it must be shut down
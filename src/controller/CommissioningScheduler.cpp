@@ -0,0 +1,244 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/CommissioningScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <string.h>
+
+namespace chip {
+namespace Controller {
+
+CHIP_ERROR CommissioningScheduler::Init(System::Layer * systemLayer, Span<DeviceCommissioner * const> commissioners,
+                                        Delegate * delegate)
+{
+    VerifyOrReturnError(mLaneCount == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(!commissioners.empty() && commissioners.size() <= kMaxLanes, CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (auto * commissioner : commissioners)
+    {
+        VerifyOrReturnError(commissioner != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    for (auto * commissioner : commissioners)
+    {
+        Lane & lane            = mLanes[mLaneCount++];
+        lane.mScheduler        = this;
+        lane.mCommissioner     = commissioner;
+        lane.mPreviousDelegate = commissioner->GetPairingDelegate();
+        lane.mNodeId           = kUndefinedNodeId;
+        lane.mBusy             = false;
+        commissioner->RegisterPairingDelegate(&lane);
+    }
+
+    mSystemLayer = systemLayer;
+    mDelegate    = delegate;
+    mStats       = Stats();
+    mStarted     = false;
+    return CHIP_NO_ERROR;
+}
+
+void CommissioningScheduler::Shutdown()
+{
+    if (mDispatchScheduled)
+    {
+        mSystemLayer->CancelTimer(DispatchPendingWork, this);
+        mDispatchScheduled = false;
+    }
+
+    while (!mQueue.Empty())
+    {
+        Job & job = *mQueue.begin();
+        mQueue.Remove(&job);
+        mJobPool.ReleaseObject(&job);
+    }
+    mPendingCount = 0;
+
+    for (size_t i = 0; i < mLaneCount; i++)
+    {
+        Lane & lane = mLanes[i];
+        if (lane.mCommissioner->GetPairingDelegate() == &lane)
+        {
+            lane.mCommissioner->RegisterPairingDelegate(lane.mPreviousDelegate);
+        }
+        lane = Lane();
+    }
+
+    mLaneCount   = 0;
+    mSystemLayer = nullptr;
+    mDelegate    = nullptr;
+}
+
+CHIP_ERROR CommissioningScheduler::Enqueue(NodeId remoteDeviceId, const char * setUpCode, const CommissioningParameters & params,
+                                           DiscoveryType discoveryType)
+{
+    VerifyOrReturnError(mLaneCount > 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(setUpCode != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    VerifyOrReturnError(strlen(setUpCode) < sizeof(Job::setUpCode), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // Heap-backed pools are not bounded by their size.
+    VerifyOrReturnError(mPendingCount < CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES, CHIP_ERROR_NO_MEMORY);
+    Job * job = mJobPool.CreateObject();
+    VerifyOrReturnError(job != nullptr, CHIP_ERROR_NO_MEMORY);
+    strcpy(job->setUpCode, setUpCode);
+    job->nodeId        = remoteDeviceId;
+    job->params        = params;
+    job->discoveryType = discoveryType;
+
+    mQueue.PushBack(job);
+    mPendingCount++;
+    DispatchPending();
+    return CHIP_NO_ERROR;
+}
+
+size_t CommissioningScheduler::GetActiveCount() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < mLaneCount; i++)
+    {
+        if (mLanes[i].mBusy)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void CommissioningScheduler::DispatchPendingWork(System::Layer * systemLayer, void * appState)
+{
+    auto * self              = static_cast<CommissioningScheduler *>(appState);
+    self->mDispatchScheduled = false;
+    self->DispatchPending();
+}
+
+void CommissioningScheduler::ScheduleDispatch()
+{
+    // Lanes report completion from inside the commissioner's cleanup path, so the next device can only be
+    // handed to the commissioner once that has unwound.
+    VerifyOrReturn(!mDispatchScheduled);
+    if (mSystemLayer->ScheduleWork(DispatchPendingWork, this) == CHIP_NO_ERROR)
+    {
+        mDispatchScheduled = true;
+    }
+}
+
+void CommissioningScheduler::DispatchPending()
+{
+    for (size_t i = 0; i < mLaneCount && !mQueue.Empty(); i++)
+    {
+        Lane & lane = mLanes[i];
+        if (lane.mBusy)
+        {
+            continue;
+        }
+
+        Job & job = *mQueue.begin();
+        mQueue.Remove(&job);
+        mPendingCount--;
+
+        if (!mStarted)
+        {
+            mStartTime = System::SystemClock().GetMonotonicTimestamp();
+            mStarted   = true;
+        }
+
+        lane.mNodeId = job.nodeId;
+        lane.mBusy   = true;
+
+        ChipLogProgress(Controller, "Commissioning scheduler: starting " ChipLogFormatX64 " on lane %u",
+                        ChipLogValueX64(job.nodeId), static_cast<unsigned>(i));
+
+        NodeId nodeId  = job.nodeId;
+        CHIP_ERROR err = StartCommissioning(*lane.mCommissioner, job.nodeId, job.setUpCode, job.params, job.discoveryType);
+        mJobPool.ReleaseObject(&job);
+        if (err != CHIP_NO_ERROR)
+        {
+            OnLaneDone(lane, nodeId, err);
+        }
+    }
+
+    if (mQueue.Empty() && mStarted && GetActiveCount() == 0)
+    {
+        UpdateElapsed();
+        mStarted = false;
+
+        ChipLogProgress(Controller, "Commissioning scheduler: %u succeeded, %u failed in %" PRIu64 " ms (%u devices/minute)",
+                        static_cast<unsigned>(mStats.succeeded), static_cast<unsigned>(mStats.failed), mStats.elapsed.count(),
+                        static_cast<unsigned>(mStats.DevicesPerMinute()));
+
+        if (mDelegate != nullptr)
+        {
+            mDelegate->OnQueueDrained(mStats);
+        }
+    }
+}
+
+void CommissioningScheduler::OnLaneDone(Lane & lane, NodeId nodeId, CHIP_ERROR error)
+{
+    VerifyOrReturn(lane.mBusy);
+
+    lane.mBusy   = false;
+    lane.mNodeId = kUndefinedNodeId;
+
+    if (error == CHIP_NO_ERROR)
+    {
+        mStats.succeeded++;
+    }
+    else
+    {
+        mStats.failed++;
+        ChipLogError(Controller, "Commissioning scheduler: " ChipLogFormatX64 " failed: %" CHIP_ERROR_FORMAT,
+                     ChipLogValueX64(nodeId), error.Format());
+    }
+    UpdateElapsed();
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->OnDeviceCommissioned(nodeId, error);
+    }
+
+    ScheduleDispatch();
+}
+
+void CommissioningScheduler::UpdateElapsed()
+{
+    VerifyOrReturn(mStarted);
+    mStats.elapsed = std::chrono::duration_cast<System::Clock::Milliseconds64>(System::SystemClock().GetMonotonicTimestamp() -
+                                                                               mStartTime);
+}
+
+void CommissioningScheduler::Lane::OnPairingComplete(CHIP_ERROR error)
+{
+    // Successful PASE establishment is followed by commissioning, which reports through OnCommissioningComplete.
+    if (error != CHIP_NO_ERROR)
+    {
+        mScheduler->OnLaneDone(*this, mNodeId, error);
+    }
+}
+
+void CommissioningScheduler::Lane::OnCommissioningComplete(NodeId deviceId, CHIP_ERROR error)
+{
+    mScheduler->OnLaneDone(*this, deviceId, error);
+}
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <controller/CHIPDeviceController.h>
+#include <controller/CommissioningDelegate.h>
+#include <controller/DevicePairingDelegate.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/NodeId.h>
+#include <lib/support/IntrusiveList.h>
+#include <lib/support/Pool.h>
+#include <lib/support/Span.h>
+#include <setup_payload/QRCodeSetupPayloadGenerator.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace Controller {
+
+/**
+ * Commissions a queue of devices using several DeviceCommissioner instances ("lanes") at once.
+ *
+ * A DeviceCommissioner drives a single AutoCommissioner pipeline at a time, so each lane commissions
+ * one device and picks up the next queued device as soon as its pipeline completes. All lanes are
+ * expected to belong to the same fabric (e.g. created through DeviceControllerFactory::SetupCommissioner
+ * with the same operational credentials issuer), so the number of lanes bounds how many devices are
+ * commissioned concurrently.
+ *
+ * While the scheduler is running, it is registered as the DevicePairingDelegate of every lane.  The
+ * previously registered delegates are restored by Shutdown().
+ *
+ * To issue the NOC chains of the devices commissioned concurrently in batches, set up the lanes with a
+ * shared BatchingOperationalCredentialsDelegate as their operational credentials delegate.
+ */
+class CommissioningScheduler
+{
+public:
+    static constexpr size_t kMaxLanes = 16;
+
+    struct Stats
+    {
+        uint32_t succeeded = 0;
+        uint32_t failed    = 0;
+        System::Clock::Milliseconds64 elapsed{ 0 };
+
+        uint32_t Completed() const { return succeeded + failed; }
+
+        // Throughput of successfully commissioned devices since the first device was dispatched.
+        uint32_t DevicesPerMinute() const
+        {
+            return elapsed.count() == 0 ? 0 : static_cast<uint32_t>((uint64_t{ succeeded } * 60000) / elapsed.count());
+        }
+    };
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() {}
+
+        /**
+         * Called once the commissioning pipeline for a queued device completes, successfully or not.
+         */
+        virtual void OnDeviceCommissioned(NodeId nodeId, CHIP_ERROR error) = 0;
+
+        /**
+         * Called when the queue is empty and no lane is busy anymore.
+         */
+        virtual void OnQueueDrained(const Stats & stats) {}
+    };
+
+    CommissioningScheduler() = default;
+    virtual ~CommissioningScheduler() { Shutdown(); }
+
+    /**
+     * Initialize the scheduler with the commissioners it may dispatch to. At most kMaxLanes commissioners
+     * are supported.  The commissioners must outlive the scheduler or be detached with Shutdown() first.
+     * The next device is dispatched from work scheduled on `systemLayer`, the one the commissioners run on.
+     */
+    CHIP_ERROR Init(System::Layer * systemLayer, Span<DeviceCommissioner * const> commissioners, Delegate * delegate);
+
+    /**
+     * Stop dispatching, drop any device that has not started commissioning yet and restore the pairing
+     * delegates of the lanes.  Pipelines that are already running are left to complete on their own.
+     */
+    void Shutdown();
+
+    /**
+     * Queue a device for commissioning.  The device is dispatched immediately if a lane is idle.  At most
+     * CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES devices can be queued.
+     *
+     * @param[in] remoteDeviceId  The node id to assign to the device.
+     * @param[in] setUpCode       The QR code or manual pairing code of the device.  It is copied.
+     * @param[in] params          The commissioning parameters to use for this device.  Buffers referenced by
+     *                            the parameters must remain valid until the device has been commissioned.
+     * @param[in] discoveryType   The network discovery type used to find the device.
+     */
+    CHIP_ERROR Enqueue(NodeId remoteDeviceId, const char * setUpCode, const CommissioningParameters & params,
+                       DiscoveryType discoveryType = DiscoveryType::kAll);
+
+    size_t GetPendingCount() const { return mPendingCount; }
+    size_t GetActiveCount() const;
+    const Stats & GetStats() const { return mStats; }
+
+protected:
+    /**
+     * Start commissioning a device on `commissioner`.  Completion is reported through the pairing
+     * delegate the scheduler registered on the commissioner.
+     */
+    virtual CHIP_ERROR StartCommissioning(DeviceCommissioner & commissioner, NodeId remoteDeviceId, const char * setUpCode,
+                                          const CommissioningParameters & params, DiscoveryType discoveryType)
+    {
+        return commissioner.PairDevice(remoteDeviceId, setUpCode, params, discoveryType);
+    }
+
+private:
+    struct Job : public IntrusiveListNodeBase<>
+    {
+        NodeId nodeId;
+        char setUpCode[QRCodeBasicSetupPayloadGenerator::kMaxQRCodeBase38RepresentationLength + 1];
+        CommissioningParameters params;
+        DiscoveryType discoveryType;
+    };
+
+    class Lane : public DevicePairingDelegate
+    {
+    public:
+        void OnPairingComplete(CHIP_ERROR error) override;
+        void OnCommissioningComplete(NodeId deviceId, CHIP_ERROR error) override;
+
+        CommissioningScheduler * mScheduler       = nullptr;
+        DeviceCommissioner * mCommissioner        = nullptr;
+        DevicePairingDelegate * mPreviousDelegate = nullptr;
+        NodeId mNodeId                            = kUndefinedNodeId;
+        bool mBusy                                = false;
+    };
+
+    static void DispatchPendingWork(System::Layer * systemLayer, void * appState);
+    void ScheduleDispatch();
+    void DispatchPending();
+    void OnLaneDone(Lane & lane, NodeId nodeId, CHIP_ERROR error);
+    void UpdateElapsed();
+
+    Lane mLanes[kMaxLanes];
+    size_t mLaneCount            = 0;
+    System::Layer * mSystemLayer = nullptr;
+    Delegate * mDelegate         = nullptr;
+    ObjectPool<Job, CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES> mJobPool;
+    IntrusiveList<Job> mQueue;
+    size_t mPendingCount = 0;
+
+    Stats mStats;
+    System::Clock::Timestamp mStartTime;
+    bool mStarted           = false;
+    bool mDispatchScheduled = false;
+};
+
+} // namespace Controller
+} // namespace chip
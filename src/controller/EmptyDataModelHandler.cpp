@@ -25,3 +25,4 @@
 #include <app/util/DataModelHandler.h>
 
 __attribute__((weak)) void InitDataModelHandler() {}
+__attribute__((weak)) void ShutdownDataModelHandler() {}
@@ -222,17 +222,20 @@ CHIP_ERROR ExampleOperationalCredentialsIssuer::Initialize(PersistentStorageDele
         ReturnErrorOnFailure(mIntermediateIssuer.Deserialize(serializedKey));
     }
 
-    mStorage     = &storage;
-    mInitialized = true;
+    mStorage       = &storage;
+    mInitialized   = true;
+    mCACertsCached = false;
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChainAfterValidation(NodeId nodeId, FabricId fabricId,
-                                                                                const CATValues & cats,
-                                                                                const Crypto::P256PublicKey & pubkey,
-                                                                                MutableByteSpan & rcac, MutableByteSpan & icac,
-                                                                                MutableByteSpan & noc)
+CHIP_ERROR ExampleOperationalCredentialsIssuer::EnsureCACertificates()
 {
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_WELL_UNINITIALIZED);
+    ReturnErrorCodeIf(mCACertsCached, CHIP_NO_ERROR);
+
+    MutableByteSpan rcac(mRcacCache);
+    MutableByteSpan icac(mIcacCache);
+
     ChipDN rcac_dn;
     CHIP_ERROR err      = CHIP_NO_ERROR;
     uint16_t rcacBufLen = static_cast<uint16_t>(std::min(rcac.size(), static_cast<size_t>(UINT16_MAX)));
@@ -307,38 +310,59 @@ CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChainAfterValidation(
                           ReturnErrorOnFailure(mStorage->SyncSetKeyValue(key, icac.data(), static_cast<uint16_t>(icac.size()))));
     }
 
+    mRcacCacheLength = rcac.size();
+    mIcacCacheLength = icac.size();
+    mIcacDN          = icac_dn;
+    mCACertsCached   = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChainAfterValidation(NodeId nodeId, FabricId fabricId,
+                                                                                const CATValues & cats,
+                                                                                const Crypto::P256PublicKey & pubkey,
+                                                                                MutableByteSpan & rcac, MutableByteSpan & icac,
+                                                                                MutableByteSpan & noc)
+{
+    ReturnErrorOnFailure(EnsureCACertificates());
+    ReturnErrorOnFailure(CopySpanToMutableSpan(ByteSpan(mRcacCache, mRcacCacheLength), rcac));
+    ReturnErrorOnFailure(CopySpanToMutableSpan(ByteSpan(mIcacCache, mIcacCacheLength), icac));
+    return IssueNOC(nodeId, fabricId, cats, pubkey, noc);
+}
+
+CHIP_ERROR ExampleOperationalCredentialsIssuer::IssueNOC(NodeId nodeId, FabricId fabricId, const CATValues & cats,
+                                                         const Crypto::P256PublicKey & pubkey, MutableByteSpan & noc)
+{
+    VerifyOrReturnError(mCACertsCached, CHIP_ERROR_INCORRECT_STATE);
+
     ChipDN noc_dn;
     ReturnErrorOnFailure(noc_dn.AddAttribute_MatterFabricId(fabricId));
     ReturnErrorOnFailure(noc_dn.AddAttribute_MatterNodeId(nodeId));
     ReturnErrorOnFailure(noc_dn.AddCATs(cats));
 
     ChipLogProgress(Controller, "Generating NOC");
-    return IssueX509Cert(mNow, mValidity, icac_dn, noc_dn, CertType::kNoc, mUseMaximallySizedCerts, pubkey, mIntermediateIssuer,
+    return IssueX509Cert(mNow, mValidity, mIcacDN, noc_dn, CertType::kNoc, mUseMaximallySizedCerts, pubkey, mIntermediateIssuer,
                          noc);
 }
 
-CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChain(const ByteSpan & csrElements, const ByteSpan & csrNonce,
-                                                                 const ByteSpan & attestationSignature,
-                                                                 const ByteSpan & attestationChallenge, const ByteSpan & DAC,
-                                                                 const ByteSpan & PAI,
-                                                                 Callback::Callback<OnNOCChainGeneration> * onCompletion)
+NodeId ExampleOperationalCredentialsIssuer::AssignNodeId(const Optional<NodeId> & requestedNodeId)
 {
-    VerifyOrReturnError(mInitialized, CHIP_ERROR_WELL_UNINITIALIZED);
-    // At this point, Credential issuer may wish to validate the CSR information
-    (void) attestationChallenge;
-    (void) csrNonce;
+    if (requestedNodeId.HasValue())
+    {
+        return requestedNodeId.Value();
+    }
 
-    NodeId assignedId;
     if (mNodeIdRequested)
     {
-        assignedId       = mNextRequestedNodeId;
         mNodeIdRequested = false;
-    }
-    else
-    {
-        assignedId = mNextAvailableNodeId++;
+        return mNextRequestedNodeId;
     }
 
+    return mNextAvailableNodeId++;
+}
+
+CHIP_ERROR ExampleOperationalCredentialsIssuer::IssueNOCChain(NodeId nodeId, const ByteSpan & csrElements,
+                                                              Callback::Callback<OnNOCChainGeneration> * onCompletion)
+{
     ChipLogProgress(Controller, "Verifying Certificate Signing Request");
     TLVReader reader;
     reader.Init(csrElements);
@@ -365,16 +389,8 @@ CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChain(const ByteSpan
     ReturnErrorCodeIf(!noc.Alloc(kMaxDERCertLength), CHIP_ERROR_NO_MEMORY);
     MutableByteSpan nocSpan(noc.Get(), kMaxDERCertLength);
 
-    chip::Platform::ScopedMemoryBuffer<uint8_t> icac;
-    ReturnErrorCodeIf(!icac.Alloc(kMaxDERCertLength), CHIP_ERROR_NO_MEMORY);
-    MutableByteSpan icacSpan(icac.Get(), kMaxDERCertLength);
-
-    chip::Platform::ScopedMemoryBuffer<uint8_t> rcac;
-    ReturnErrorCodeIf(!rcac.Alloc(kMaxDERCertLength), CHIP_ERROR_NO_MEMORY);
-    MutableByteSpan rcacSpan(rcac.Get(), kMaxDERCertLength);
-
-    ReturnErrorOnFailure(
-        GenerateNOCChainAfterValidation(assignedId, mNextFabricId, mNextCATs, pubkey, rcacSpan, icacSpan, nocSpan));
+    ReturnErrorOnFailure(EnsureCACertificates());
+    ReturnErrorOnFailure(IssueNOC(nodeId, mNextFabricId, mNextCATs, pubkey, nocSpan));
 
     // TODO(#13825): Should always generate some IPK. Using a temporary fixed value until APIs are plumbed in to set it end-to-end
     // TODO: Force callers to set IPK if used before GenerateNOCChain will succeed.
@@ -391,10 +407,54 @@ CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChain(const ByteSpan
     ReturnErrorCodeIf(defaultIpkSpan.size() != sizeof(ipkValue), CHIP_ERROR_INTERNAL);
     memcpy(&ipkValue[0], defaultIpkSpan.data(), defaultIpkSpan.size());
 
-    // Callback onto commissioner.
+    // Callback onto commissioner.  The RCAC and ICAC are handed out straight from the cache.
     ChipLogProgress(Controller, "Providing certificate chain to the commissioner");
-    onCompletion->mCall(onCompletion->mContext, CHIP_NO_ERROR, nocSpan, icacSpan, rcacSpan, MakeOptional(ipkSpan),
-                        Optional<NodeId>());
+    onCompletion->mCall(onCompletion->mContext, CHIP_NO_ERROR, nocSpan, ByteSpan(mIcacCache, mIcacCacheLength),
+                        ByteSpan(mRcacCache, mRcacCacheLength), MakeOptional(ipkSpan), Optional<NodeId>());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChain(const ByteSpan & csrElements, const ByteSpan & csrNonce,
+                                                                 const ByteSpan & attestationSignature,
+                                                                 const ByteSpan & attestationChallenge, const ByteSpan & DAC,
+                                                                 const ByteSpan & PAI,
+                                                                 Callback::Callback<OnNOCChainGeneration> * onCompletion)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_WELL_UNINITIALIZED);
+    // At this point, Credential issuer may wish to validate the CSR information
+    (void) attestationChallenge;
+    (void) csrNonce;
+
+    return IssueNOCChain(AssignNodeId(NullOptional), csrElements, onCompletion);
+}
+
+CHIP_ERROR ExampleOperationalCredentialsIssuer::GenerateNOCChains(Span<const NOCChainRequest> requests)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_WELL_UNINITIALIZED);
+    for (const auto & request : requests)
+    {
+        VerifyOrReturnError(request.onCompletion != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Load or generate the shared part of the chains once for the whole batch.
+    CHIP_ERROR caErr = EnsureCACertificates();
+
+    for (const auto & request : requests)
+    {
+        NodeId assignedId = AssignNodeId(request.nodeId);
+        CHIP_ERROR err    = caErr;
+        if (err == CHIP_NO_ERROR)
+        {
+            err = IssueNOCChain(assignedId, request.csrElements, request.onCompletion);
+        }
+
+        if (err != CHIP_NO_ERROR)
+        {
+            request.onCompletion->mCall(request.onCompletion->mContext, err, ByteSpan(), ByteSpan(), ByteSpan(), NullOptional,
+                                        NullOptional);
+        }
+    }
+
     return CHIP_NO_ERROR;
 }
 
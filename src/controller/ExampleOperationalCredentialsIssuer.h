@@ -30,6 +30,7 @@
 #pragma once
 
 #include <controller/OperationalCredentialsDelegate.h>
+#include <credentials/CHIPCert.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/CASEAuthTag.h>
 #include <lib/core/CHIPError.h>
@@ -59,13 +60,19 @@ public:
                                 const ByteSpan & attestationChallenge, const ByteSpan & DAC, const ByteSpan & PAI,
                                 Callback::Callback<OnNOCChainGeneration> * onCompletion) override;
 
+    CHIP_ERROR GenerateNOCChains(Span<const NOCChainRequest> requests) override;
+
     void SetNodeIdForNextNOCRequest(NodeId nodeId) override
     {
         mNextRequestedNodeId = nodeId;
         mNodeIdRequested     = true;
     }
 
-    void SetMaximallyLargeCertsUsed(bool areMaximallyLargeCertsUsed) { mUseMaximallySizedCerts = areMaximallyLargeCertsUsed; }
+    void SetMaximallyLargeCertsUsed(bool areMaximallyLargeCertsUsed)
+    {
+        mUseMaximallySizedCerts = areMaximallyLargeCertsUsed;
+        mCACertsCached          = false;
+    }
 
     void SetFabricIdForNextNOCRequest(FabricId fabricId) override { mNextFabricId = fabricId; }
 
@@ -84,11 +91,23 @@ public:
     [[deprecated("This class stores the encryption key in clear storage. Don't use it for production code.")]] CHIP_ERROR
     Initialize(PersistentStorageDelegate & storage);
 
-    void SetIssuerId(uint32_t id) { mIssuerId = id; }
+    void SetIssuerId(uint32_t id)
+    {
+        mIssuerId      = id;
+        mCACertsCached = false;
+    }
 
-    void SetCurrentEpoch(uint32_t epoch) { mNow = epoch; }
+    void SetCurrentEpoch(uint32_t epoch)
+    {
+        mNow           = epoch;
+        mCACertsCached = false;
+    }
 
-    void SetCertificateValidityPeriod(uint32_t validity) { mValidity = validity; }
+    void SetCertificateValidityPeriod(uint32_t validity)
+    {
+        mValidity      = validity;
+        mCACertsCached = false;
+    }
 
     /**
      * Generate a random operational node id.
@@ -109,6 +128,14 @@ public:
                                                MutableByteSpan & noc);
 
 private:
+    // Loads the RCAC and ICAC from storage, or generates them, and keeps them (and their subject DNs) in memory
+    // so that issuing further NOCs only requires signing the NOC itself.
+    CHIP_ERROR EnsureCACertificates();
+    CHIP_ERROR IssueNOC(NodeId nodeId, FabricId fabricId, const CATValues & cats, const Crypto::P256PublicKey & pubkey,
+                        MutableByteSpan & noc);
+    NodeId AssignNodeId(const Optional<NodeId> & requestedNodeId);
+    CHIP_ERROR IssueNOCChain(NodeId nodeId, const ByteSpan & csrElements, Callback::Callback<OnNOCChainGeneration> * onCompletion);
+
     Crypto::P256Keypair mIssuer;
     Crypto::P256Keypair mIntermediateIssuer;
     bool mInitialized              = false;
@@ -128,6 +155,13 @@ private:
     CATValues mNextCATs         = kUndefinedCATs;
     bool mNodeIdRequested       = false;
     uint64_t mIndex             = 0;
+
+    bool mCACertsCached = false;
+    uint8_t mRcacCache[kMaxCHIPDERCertLength];
+    size_t mRcacCacheLength = 0;
+    uint8_t mIcacCache[kMaxCHIPDERCertLength];
+    size_t mIcacCacheLength = 0;
+    Credentials::ChipDN mIcacDN;
 };
 
 } // namespace Controller
@@ -21,7 +21,9 @@
 #include <app/util/basic-types.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/CHIPCallback.h>
+#include <lib/core/Optional.h>
 #include <lib/core/PeerId.h>
+#include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/Span.h>
 #include <transport/raw/MessageHeader.h>
@@ -67,6 +69,62 @@ public:
                                         const ByteSpan & DAC, const ByteSpan & PAI,
                                         Callback::Callback<OnNOCChainGeneration> * onCompletion) = 0;
 
+    /**
+     * A single NOC chain request, as passed to GenerateNOCChains().  The fields match the arguments of
+     * GenerateNOCChain().  If nodeId has a value, it is used as the node ID hint for this request, as if
+     * SetNodeIdForNextNOCRequest() had been called before it.
+     */
+    struct NOCChainRequest
+    {
+        ByteSpan csrElements;
+        ByteSpan csrNonce;
+        ByteSpan attestationSignature;
+        ByteSpan attestationChallenge;
+        ByteSpan DAC;
+        ByteSpan PAI;
+        Optional<NodeId> nodeId;
+        Callback::Callback<OnNOCChainGeneration> * onCompletion = nullptr;
+    };
+
+    /**
+     * @brief
+     *   This function generates operational certificate chains for several remote devices in one call.
+     *
+     *   The `onCompletion` callback of every request is called exactly once with the outcome of that
+     *   request, including when generating that particular chain fails.  Implementations that issue many
+     *   chains from the same ICAC/RCAC should override this to share the per-chain setup work.  The default
+     *   implementation calls GenerateNOCChain() for each request in order.
+     *
+     * @param[in] requests  The requests to process.
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if a request has no completion callback, in which case no callback is
+     *         called; CHIP_NO_ERROR otherwise.
+     */
+    virtual CHIP_ERROR GenerateNOCChains(Span<const NOCChainRequest> requests)
+    {
+        for (const auto & request : requests)
+        {
+            VerifyOrReturnError(request.onCompletion != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+
+        for (const auto & request : requests)
+        {
+            if (request.nodeId.HasValue())
+            {
+                SetNodeIdForNextNOCRequest(request.nodeId.Value());
+            }
+
+            CHIP_ERROR err = GenerateNOCChain(request.csrElements, request.csrNonce, request.attestationSignature,
+                                              request.attestationChallenge, request.DAC, request.PAI, request.onCompletion);
+            if (err != CHIP_NO_ERROR)
+            {
+                request.onCompletion->mCall(request.onCompletion->mContext, err, ByteSpan(), ByteSpan(), ByteSpan(), NullOptional,
+                                            NullOptional);
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
     /**
      *   This function sets the node ID for which the next NOC Chain would be requested. The node ID is
      *   provided as a hint, and the delegate implementation may chose to ignore it and pick node ID of
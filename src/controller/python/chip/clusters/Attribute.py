@@ -22,6 +22,7 @@ import builtins
 import ctypes
 import inspect
 import logging
+import struct
 import sys
 from asyncio.futures import Future
 from ctypes import CFUNCTYPE, c_size_t, c_uint8, c_uint16, c_uint32, c_uint64, c_void_p, py_object
@@ -279,6 +280,20 @@ class ValueDecodeFailure:
     Reason: Exception = None
 
 
+class PendingTLV:
+    '''
+    The TLV of an attribute delivered in a batch of attribute data. It is only decoded once the cache is updated at the end of
+    the report, as a view into the batch rather than a copy of its bytes.
+    '''
+    __slots__ = ('data',)
+
+    def __init__(self, data: memoryview):
+        self.data = data
+
+    def Decode(self):
+        return chip.tlv.TLVReader(self.data).get().get("Any", {})
+
+
 @dataclass
 class EventReadResult(EventStatus):
     Data: Any = None
@@ -360,7 +375,7 @@ class AttributeCache:
     versionList: Dict[int, Dict[int, Dict[int, int]]] = field(
         default_factory=lambda: {})
 
-    def UpdateTLV(self, path: AttributePath, dataVersion: int,  data: Union[bytes, ValueDecodeFailure]):
+    def UpdateTLV(self, path: AttributePath, dataVersion: int,  data: Union[bytes, PendingTLV, ValueDecodeFailure]):
         ''' Store data in TLV since that makes it easiest to eventually convert to either the
             cluster or attribute view representations (see below in UpdateCachedData).
         '''
@@ -402,6 +417,21 @@ class AttributeCache:
         tlvCache = self.attributeTLVCache
         attributeCache = self.attributeCache
 
+        # Decode the TLV of attributes delivered in a batch first, so that no cluster is converted while some of its attributes
+        # are still pending.
+        for attributePath in changedPathSet:
+            clusterTLV = tlvCache[attributePath.EndpointId][attributePath.ClusterId]
+            value = clusterTLV[attributePath.AttributeId]
+            if isinstance(value, PendingTLV):
+                try:
+                    clusterTLV[attributePath.AttributeId] = value.Decode()
+                except Exception as ex:
+                    logging.exception(ex)
+                    clusterTLV[attributePath.AttributeId] = ValueDecodeFailure(None, ex)
+
+        # In the cluster-view, a cluster is converted once however many of its attributes changed.
+        convertedClusters = set()
+
         for attributePath in changedPathSet:
             endpointId = attributePath.EndpointId
 
@@ -429,6 +459,10 @@ class AttributeCache:
                 endpointId, {}).get(clusterId, None)
 
             if self.returnClusterObject:
+                if (endpointId, clusterId) in convertedClusters:
+                    continue
+                convertedClusters.add((endpointId, clusterId))
+
                 try:
                     # Since the TLV data is already organized by attribute tags, we can trivially convert to a cluster object representation.
                     endpointCache[clusterType] = clusterType.FromDict(
@@ -699,6 +733,34 @@ class AsyncReadTransaction:
         except Exception as ex:
             logging.exception(ex)
 
+    def handleAttributeDataBatch(self, index: bytes, data: bytes):
+        ''' Handles the attribute data of a whole report, or of a part of it, received at once.
+
+            Each entry of the index locates the data of an attribute in the TLV buffer. The TLV is decoded when the report
+            ends, in UpdateCachedData.
+        '''
+        try:
+            dataView = memoryview(data)
+            success = chip.interaction_model.Status.Success.value
+            for endpoint, cluster, attribute, dataVersion, status, offset, length in _AttributeDataIndexEntry.iter_unpack(index):
+                path = AttributePath(EndpointId=endpoint, ClusterId=cluster, AttributeId=attribute)
+                if status != success:
+                    imStatus = status
+                    try:
+                        imStatus = chip.interaction_model.Status(status)
+                    except:
+                        pass
+                    attributeValue = ValueDecodeFailure(
+                        None, chip.interaction_model.InteractionModelError(imStatus))
+                else:
+                    attributeValue = PendingTLV(dataView[offset:offset + length])
+
+                self._cache.UpdateTLV(path, dataVersion, attributeValue)
+                self._changedPathSet.add(path)
+
+        except Exception as ex:
+            logging.exception(ex)
+
     def handleEventData(self, header: EventHeader, path: EventPath, data: bytes, status: int):
         try:
             eventType = _EventIndex.get(str(path), None)
@@ -867,6 +929,8 @@ class AsyncWriteTransaction:
 
 _OnReadAttributeDataCallbackFunct = CFUNCTYPE(
     None, py_object, c_uint32, c_uint16, c_uint32, c_uint32, c_uint8, c_void_p, c_size_t)
+_OnReadAttributeDataBatchCallbackFunct = CFUNCTYPE(
+    None, py_object, c_void_p, c_size_t, c_void_p, c_size_t)
 _OnSubscriptionEstablishedCallbackFunct = CFUNCTYPE(None, py_object, c_uint32)
 _OnResubscriptionAttemptedCallbackFunct = CFUNCTYPE(None, py_object, PyChipError, c_uint32)
 _OnReadEventDataCallbackFunct = CFUNCTYPE(
@@ -888,6 +952,15 @@ def _OnReadAttributeDataCallback(closure, dataVersion: int, endpoint: int, clust
         EndpointId=endpoint, ClusterId=cluster, AttributeId=attribute), dataVersion, status, dataBytes[:])
 
 
+# Matches chip::python::AttributeDataIndexEntry: endpoint, cluster, attribute, data version, status, data offset and length.
+_AttributeDataIndexEntry = struct.Struct('<HIIIBII')
+
+
+@_OnReadAttributeDataBatchCallbackFunct
+def _OnReadAttributeDataBatchCallback(closure, index, count: int, data, len: int):
+    closure.handleAttributeDataBatch(ctypes.string_at(index, count * _AttributeDataIndexEntry.size), ctypes.string_at(data, len))
+
+
 @_OnReadEventDataCallbackFunct
 def _OnReadEventDataCallback(closure, endpoint: int, cluster: int, event: c_uint64, number: int, priority: int, timestamp: int, timestampType: int, data, len, status):
     dataBytes = ctypes.string_at(data, len)
@@ -1023,10 +1096,11 @@ _ReadParams = construct.Struct(
     "IsSubscription" / construct.Flag,
     "IsFabricFiltered" / construct.Flag,
     "KeepSubscriptions" / construct.Flag,
+    "BatchAttributeData" / construct.Flag,
 )
 
 
-def Read(future: Future, eventLoop, device, devCtrl, attributes: List[AttributePath] = None, dataVersionFilters: List[DataVersionFilter] = None, events: List[EventPath] = None, eventNumberFilter: Optional[int] = None, returnClusterObject: bool = True, subscriptionParameters: SubscriptionParameters = None, fabricFiltered: bool = True, keepSubscriptions: bool = False) -> PyChipError:
+def Read(future: Future, eventLoop, device, devCtrl, attributes: List[AttributePath] = None, dataVersionFilters: List[DataVersionFilter] = None, events: List[EventPath] = None, eventNumberFilter: Optional[int] = None, returnClusterObject: bool = True, subscriptionParameters: SubscriptionParameters = None, fabricFiltered: bool = True, keepSubscriptions: bool = False, batchAttributeData: bool = True) -> PyChipError:
     if (not attributes) and dataVersionFilters:
         raise ValueError(
             "Must provide valid attribute list when data version filters is not null")
@@ -1101,6 +1175,7 @@ def Read(future: Future, eventLoop, device, devCtrl, attributes: List[AttributeP
         params.IsSubscription = True
         params.KeepSubscriptions = keepSubscriptions
     params.IsFabricFiltered = fabricFiltered
+    params.BatchAttributeData = batchAttributeData
     params = _ReadParams.build(params)
     eventNumberFilterPtr = ctypes.POINTER(ctypes.c_ulonglong)()
     if eventNumberFilter is not None:
@@ -1163,12 +1238,14 @@ def Init():
         setter.Set('pychip_ReadClient_InitCallbacks', None, [
                    _OnReadAttributeDataCallbackFunct, _OnReadEventDataCallbackFunct, _OnSubscriptionEstablishedCallbackFunct, _OnResubscriptionAttemptedCallbackFunct, _OnReadErrorCallbackFunct, _OnReadDoneCallbackFunct,
                    _OnReportBeginCallbackFunct, _OnReportEndCallbackFunct])
+        setter.Set('pychip_ReadClient_InitBatchCallbacks', None, [_OnReadAttributeDataBatchCallbackFunct])
 
     handle.pychip_WriteClient_InitCallbacks(
         _OnWriteResponseCallback, _OnWriteErrorCallback, _OnWriteDoneCallback)
     handle.pychip_ReadClient_InitCallbacks(
         _OnReadAttributeDataCallback, _OnReadEventDataCallback, _OnSubscriptionEstablishedCallback, _OnResubscriptionAttemptedCallback, _OnReadErrorCallback, _OnReadDoneCallback,
         _OnReportBeginCallback, _OnReportEndCallback)
+    handle.pychip_ReadClient_InitBatchCallbacks(_OnReadAttributeDataBatchCallback)
 
     _BuildAttributeIndex()
     _BuildClusterIndex()
@@ -223,6 +223,8 @@ class ClusterCommand(ClusterObject):
 # and are used for quick lookup/mapping from cluster/attribute id to the correct class
 ALL_CLUSTERS = {}
 ALL_ATTRIBUTES = {}
+# The classes wrapping the value of each attribute, see ClusterAttributeDescriptor._cluster_object.
+ATTRIBUTE_CLUSTER_OBJECTS = {}
 
 
 class Cluster(ClusterObject):
@@ -322,6 +324,13 @@ class ClusterAttributeDescriptor:
 
     @ChipUtility.classproperty
     def _cluster_object(cls) -> ClusterObject:
+        # Making the dataclass costs far more than decoding a value with it, so it is made once per attribute.
+        if cls not in ATTRIBUTE_CLUSTER_OBJECTS:
+            ATTRIBUTE_CLUSTER_OBJECTS[cls] = cls._make_cluster_object()
+        return ATTRIBUTE_CLUSTER_OBJECTS[cls]
+
+    @classmethod
+    def _make_cluster_object(cls) -> ClusterObject:
         return make_dataclass('InternalClass',
                               [
                                   ('Value', cls.attribute_type.Type,
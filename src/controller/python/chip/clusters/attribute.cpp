@@ -19,6 +19,7 @@
 #include <cstdarg>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <app/BufferedReadCallback.h>
 #include <app/ChunkedWriteCallback.h>
@@ -67,10 +68,27 @@ struct __attribute__((packed)) DataVersionFilter
     chip::DataVersion dataVersion;
 };
 
+// Locates the data of one attribute in a batch of attribute data.
+struct __attribute__((packed)) AttributeDataIndexEntry
+{
+    chip::EndpointId endpointId;
+    chip::ClusterId clusterId;
+    chip::AttributeId attributeId;
+    chip::DataVersion dataVersion;
+    std::underlying_type_t<Protocols::InteractionModel::Status> imstatus;
+    uint32_t dataOffset;
+    uint32_t dataLen;
+};
+
+// Attribute data accumulated beyond this size is delivered before the end of the report.
+constexpr size_t kMaxBatchedAttributeDataSize = 256 * 1024;
+
 using OnReadAttributeDataCallback       = void (*)(PyObject * appContext, chip::DataVersion version, chip::EndpointId endpointId,
                                              chip::ClusterId clusterId, chip::AttributeId attributeId,
                                              std::underlying_type_t<Protocols::InteractionModel::Status> imstatus, uint8_t * data,
                                              uint32_t dataLen);
+using OnReadAttributeDataBatchCallback  = void (*)(PyObject * appContext, const AttributeDataIndexEntry * index, size_t count,
+                                                  const uint8_t * data, size_t dataLen);
 using OnReadEventDataCallback           = void (*)(PyObject * appContext, chip::EndpointId endpointId, chip::ClusterId clusterId,
                                          chip::EventId eventId, chip::EventNumber eventNumber, uint8_t priority, uint64_t timestamp,
                                          uint8_t timestampType, uint8_t * data, uint32_t dataLen,
@@ -84,6 +102,7 @@ using OnReportBeginCallback             = void (*)(PyObject * appContext);
 using OnReportEndCallback               = void (*)(PyObject * appContext);
 
 OnReadAttributeDataCallback gOnReadAttributeDataCallback             = nullptr;
+OnReadAttributeDataBatchCallback gOnReadAttributeDataBatchCallback   = nullptr;
 OnReadEventDataCallback gOnReadEventDataCallback                     = nullptr;
 OnSubscriptionEstablishedCallback gOnSubscriptionEstablishedCallback = nullptr;
 OnResubscriptionAttemptedCallback gOnResubscriptionAttemptedCallback = nullptr;
@@ -100,7 +119,9 @@ void PythonResubscribePolicy(uint32_t aNumCumulativeRetries, uint32_t & aNextSub
 class ReadClientCallback : public ReadClient::Callback
 {
 public:
-    ReadClientCallback(PyObject * appContext) : mBufferedReadCallback(*this), mAppContext(appContext) {}
+    ReadClientCallback(PyObject * appContext, bool batchAttributeData) :
+        mBufferedReadCallback(*this), mAppContext(appContext), mBatchAttributeData(batchAttributeData)
+    {}
 
     app::BufferedReadCallback * GetBufferedReadCallback() { return &mBufferedReadCallback; }
 
@@ -111,6 +132,13 @@ public:
         // callback. If we do, that's a bug.
         //
         VerifyOrDie(!aPath.IsListItemOperation());
+
+        if (mBatchAttributeData)
+        {
+            AppendAttributeData(aPath, apData, aStatus);
+            return;
+        }
+
         size_t bufferLen                  = (apData == nullptr ? 0 : apData->GetRemainingLength() + apData->GetLengthRead());
         std::unique_ptr<uint8_t[]> buffer = std::unique_ptr<uint8_t[]>(apData == nullptr ? nullptr : new uint8_t[bufferLen]);
         uint32_t size                     = 0;
@@ -215,10 +243,15 @@ public:
         }
     }
 
-    void OnReportEnd() override { gOnReportEndCallback(mAppContext); }
+    void OnReportEnd() override
+    {
+        FlushAttributeData();
+        gOnReportEndCallback(mAppContext);
+    }
 
     void OnDone(ReadClient *) override
     {
+        FlushAttributeData();
         gOnReadDoneCallback(mAppContext);
 
         delete this;
@@ -227,10 +260,62 @@ public:
     void AdoptReadClient(std::unique_ptr<ReadClient> apReadClient) { mReadClient = std::move(apReadClient); }
 
 private:
+    // Copies the attribute data into the batch, which Python receives in a single callback rather than one per attribute.
+    void AppendAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus)
+    {
+        AttributeDataIndexEntry entry;
+        entry.endpointId  = aPath.mEndpointId;
+        entry.clusterId   = aPath.mClusterId;
+        entry.attributeId = aPath.mAttributeId;
+        entry.dataVersion = aPath.mDataVersion.ValueOr(0);
+        entry.imstatus    = to_underlying(aStatus.mStatus);
+        entry.dataOffset  = static_cast<uint32_t>(mBatchData.size());
+        entry.dataLen     = 0;
+
+        // When the apData is nullptr, means we did not receive a valid attribute data from server, status will be some error
+        // status.
+        if (apData != nullptr)
+        {
+            // Normalize the TLV as for the unbatched callback, writing it right after the data of the previous attributes.
+            size_t bufferLen = apData->GetRemainingLength() + apData->GetLengthRead();
+            mBatchData.resize(entry.dataOffset + bufferLen);
+
+            TLV::TLVWriter writer;
+            writer.Init(mBatchData.data() + entry.dataOffset, bufferLen);
+            CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), *apData);
+            mBatchData.resize(entry.dataOffset + (err == CHIP_NO_ERROR ? writer.GetLengthWritten() : 0));
+            if (err != CHIP_NO_ERROR)
+            {
+                this->OnError(err);
+                return;
+            }
+            entry.dataLen = writer.GetLengthWritten();
+        }
+
+        mBatchIndex.push_back(entry);
+        if (mBatchData.size() >= kMaxBatchedAttributeDataSize)
+        {
+            FlushAttributeData();
+        }
+    }
+
+    void FlushAttributeData()
+    {
+        VerifyOrReturn(!mBatchIndex.empty());
+        gOnReadAttributeDataBatchCallback(mAppContext, mBatchIndex.data(), mBatchIndex.size(), mBatchData.data(),
+                                          mBatchData.size());
+        mBatchIndex.clear();
+        mBatchData.clear();
+    }
+
     BufferedReadCallback mBufferedReadCallback;
 
     PyObject * mAppContext;
 
+    bool mBatchAttributeData;
+    std::vector<AttributeDataIndexEntry> mBatchIndex;
+    std::vector<uint8_t> mBatchData;
+
     std::unique_ptr<ReadClient> mReadClient;
 };
 
@@ -243,6 +328,7 @@ struct __attribute__((packed)) PyReadAttributeParams
     bool isSubscription;
     bool isFabricFiltered;
     bool keepSubscriptions;
+    bool batchAttributeData; // Deliver the attribute data of a report in a single callback
 };
 
 // Encodes n attribute write requests, follows 3 * n arguments, in the (AttributeWritePath*=void *, uint8_t*, size_t) order.
@@ -325,6 +411,11 @@ void pychip_ReadClient_InitCallbacks(OnReadAttributeDataCallback onReadAttribute
     gOnReportEndCallback               = onReportEndCallback;
 }
 
+void pychip_ReadClient_InitBatchCallbacks(OnReadAttributeDataBatchCallback onReadAttributeDataBatchCallback)
+{
+    gOnReadAttributeDataBatchCallback = onReadAttributeDataBatchCallback;
+}
+
 PyChipError pychip_WriteClient_WriteAttributes(void * appContext, DeviceProxy * device, size_t timedWriteTimeoutMsSizeT,
                                                size_t interactionTimeoutMsSizeT, size_t busyWaitMsSizeT, size_t n, ...)
 {
@@ -484,7 +575,8 @@ PyChipError pychip_ReadClient_Read(void * appContext, ReadClient ** pReadClient,
     // The readParamsBuf might be not aligned, using a memcpy to avoid some unexpected behaviors.
     memcpy(&pyParams, readParamsBuf, sizeof(pyParams));
 
-    std::unique_ptr<ReadClientCallback> callback = std::make_unique<ReadClientCallback>(appContext);
+    bool batchAttributeData                      = pyParams.batchAttributeData && gOnReadAttributeDataBatchCallback != nullptr;
+    std::unique_ptr<ReadClientCallback> callback = std::make_unique<ReadClientCallback>(appContext, batchAttributeData);
 
     va_list args;
     va_start(args, eventNumberFilter);
@@ -0,0 +1,147 @@
+#
+#    Copyright (c) 2023 Project CHIP Authors
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+import ctypes
+import time
+import unittest
+from unittest import mock
+
+import chip.clusters.Attribute as Attribute
+import chip.interaction_model
+from chip.clusters import Objects as Clusters
+from chip.clusters.ClusterObjects import ClusterObjectDescriptor
+from chip.tlv import TLVWriter
+from chip.tlv import uint as tlvUint
+
+# The attributes of the On/Off cluster on each endpoint of a bridge, with their value.
+_ON_OFF_ATTRIBUTES = [
+    (Clusters.OnOff.Attributes.OnOff.attribute_id, True),
+    (Clusters.OnOff.Attributes.OnTime.attribute_id, tlvUint(30)),
+    (Clusters.OnOff.Attributes.OffWaitTime.attribute_id, tlvUint(60)),
+    (Clusters.OnOff.Attributes.AttributeList.attribute_id, [tlvUint(0), tlvUint(0x4001), tlvUint(0x4002), tlvUint(0xFFFD)]),
+    (Clusters.OnOff.Attributes.ClusterRevision.attribute_id, tlvUint(5)),
+]
+
+
+def _encode(value):
+    writer = TLVWriter()
+    writer.put(None, value)
+    return bytes(writer.encoding)
+
+
+def _buildReport(endpointCount):
+    ''' Returns the attribute data of a report as (endpoint, cluster, attribute, data version, status, TLV) tuples.
+    '''
+    report = []
+    for endpoint in range(1, endpointCount + 1):
+        for attribute, value in _ON_OFF_ATTRIBUTES:
+            report.append((endpoint, Clusters.OnOff.id, attribute, endpoint,
+                           chip.interaction_model.Status.Success.value, _encode(value)))
+    return report
+
+
+def _newTransaction(returnClusterObject):
+    return Attribute.AsyncReadTransaction(future=None, eventLoop=None, devCtrl=None, returnClusterObject=returnClusterObject)
+
+
+def _deliverPerAttribute(report, returnClusterObject=False):
+    ''' Delivers the attribute data the way the bindings do without batching: one callback per attribute.
+    '''
+    transaction = _newTransaction(returnClusterObject)
+    buffers = [ctypes.create_string_buffer(data, len(data)) for (_, _, _, _, _, data) in report]
+    start = time.perf_counter()
+    for (endpoint, cluster, attribute, dataVersion, status, data), buffer in zip(report, buffers):
+        Attribute._OnReadAttributeDataCallback(transaction, dataVersion, endpoint, cluster, attribute, status,
+                                               ctypes.addressof(buffer), len(data))
+    transaction.handleReportEnd()
+    return transaction, time.perf_counter() - start
+
+
+def _deliverBatched(report, returnClusterObject=False):
+    ''' Delivers the attribute data the way the bindings do with batching: the report in a single callback.
+    '''
+    transaction = _newTransaction(returnClusterObject)
+    index = bytearray()
+    data = bytearray()
+    for (endpoint, cluster, attribute, dataVersion, status, tlv) in report:
+        index += Attribute._AttributeDataIndexEntry.pack(endpoint, cluster, attribute, dataVersion, status, len(data), len(tlv))
+        data += tlv
+    indexBuffer = ctypes.create_string_buffer(bytes(index), len(index))
+    dataBuffer = ctypes.create_string_buffer(bytes(data), len(data))
+    start = time.perf_counter()
+    Attribute._OnReadAttributeDataBatchCallback(transaction, ctypes.addressof(indexBuffer), len(report),
+                                                ctypes.addressof(dataBuffer), len(data))
+    transaction.handleReportEnd()
+    return transaction, time.perf_counter() - start
+
+
+class TestAttributeBatching(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        Attribute._BuildAttributeIndex()
+        Attribute._BuildClusterIndex()
+
+    def test_batched_matches_per_attribute(self):
+        report = _buildReport(4)
+        # An attribute the server failed to read carries no data.
+        report.append((5, Clusters.OnOff.id, Clusters.OnOff.Attributes.OnOff.attribute_id, 0,
+                       chip.interaction_model.Status.UnsupportedRead.value, b''))
+
+        perAttribute, _ = _deliverPerAttribute(report)
+        batched, _ = _deliverBatched(report)
+
+        for endpoint in range(1, 5):
+            self.assertEqual(batched._cache.attributeTLVCache[endpoint], perAttribute._cache.attributeTLVCache[endpoint])
+            self.assertEqual(batched._cache.attributeCache[endpoint], perAttribute._cache.attributeCache[endpoint])
+        self.assertEqual(batched._cache.versionList, perAttribute._cache.versionList)
+        self.assertEqual(batched._cache.attributeCache[1][Clusters.OnOff][Clusters.OnOff.Attributes.OnTime], 30)
+
+        failure = batched._cache.attributeCache[5][Clusters.OnOff][Clusters.OnOff.Attributes.OnOff]
+        self.assertIsInstance(failure, Attribute.ValueDecodeFailure)
+        self.assertEqual(failure.Reason.status, chip.interaction_model.Status.UnsupportedRead)
+
+    def test_batched_cluster_objects(self):
+        report = _buildReport(4)
+
+        perAttribute, _ = _deliverPerAttribute(report, returnClusterObject=True)
+        # Each cluster is converted once, after all of its attributes are decoded.
+        with mock.patch.object(ClusterObjectDescriptor, 'TagDictToLabelDict', autospec=True,
+                               side_effect=ClusterObjectDescriptor.TagDictToLabelDict) as convert:
+            batched, _ = _deliverBatched(report, returnClusterObject=True)
+        self.assertEqual(convert.call_count, 4)
+
+        self.assertEqual(batched._cache.attributeCache, perAttribute._cache.attributeCache)
+        onOff = batched._cache.attributeCache[1][Clusters.OnOff]
+        self.assertIsInstance(onOff, Clusters.OnOff)
+        self.assertEqual(onOff.onOff, True)
+        self.assertEqual(onOff.onTime, 30)
+        self.assertEqual(onOff.offWaitTime, 60)
+
+    def test_benchmark_5000_attributes(self):
+        report = _buildReport(1000)
+        self.assertEqual(len(report), 5000)
+
+        perAttribute, perAttributeTime = _deliverPerAttribute(report)
+        batched, batchedTime = _deliverBatched(report)
+
+        self.assertEqual(batched._cache.attributeTLVCache, perAttribute._cache.attributeTLVCache)
+        print(f"\n5000 attributes: per-attribute delivery {perAttributeTime * 1000:.1f} ms, "
+              f"batched delivery {batchedTime * 1000:.1f} ms")
+
+
+if __name__ == '__main__':
+    unittest.main()
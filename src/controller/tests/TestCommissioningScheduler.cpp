@@ -0,0 +1,430 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/BatchingOperationalCredentialsDelegate.h>
+#include <controller/CommissioningScheduler.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+
+#include <nlunit-test.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::Controller;
+
+namespace {
+
+constexpr char kSetUpCode[] = "34970112332";
+
+constexpr System::Clock::Seconds32 kCommissioningDuration(30);
+
+struct TestContext
+{
+    System::LayerImpl systemLayer;
+};
+
+void ServiceEvents(System::LayerImpl & layer)
+{
+    layer.PrepareEvents();
+    layer.WaitForEvents();
+    layer.HandleEvents();
+}
+
+// Records the devices the scheduler starts instead of commissioning them.
+class RecordingCommissioningScheduler : public CommissioningScheduler
+{
+public:
+    struct Start
+    {
+        DeviceCommissioner * commissioner;
+        NodeId nodeId;
+    };
+
+    // Completes the commissioning of the device started on `commissioner`, as the commissioner would.
+    void Complete(DeviceCommissioner & commissioner, CHIP_ERROR error = CHIP_NO_ERROR)
+    {
+        NodeId nodeId = kUndefinedNodeId;
+        for (const Start & start : mStarts)
+        {
+            if (start.commissioner == &commissioner)
+            {
+                nodeId = start.nodeId;
+            }
+        }
+        commissioner.GetPairingDelegate()->OnCommissioningComplete(nodeId, error);
+    }
+
+    std::vector<Start> mStarts;
+    NodeId mRejectedNodeId = kUndefinedNodeId;
+
+protected:
+    CHIP_ERROR StartCommissioning(DeviceCommissioner & commissioner, NodeId remoteDeviceId, const char * setUpCode,
+                                  const CommissioningParameters & params, DiscoveryType discoveryType) override
+    {
+        VerifyOrReturnError(remoteDeviceId != mRejectedNodeId, CHIP_ERROR_INVALID_ARGUMENT);
+        mStarts.push_back({ &commissioner, remoteDeviceId });
+        return CHIP_NO_ERROR;
+    }
+};
+
+class TestDelegate : public CommissioningScheduler::Delegate
+{
+public:
+    void OnDeviceCommissioned(NodeId nodeId, CHIP_ERROR error) override
+    {
+        (error == CHIP_NO_ERROR ? mSucceeded : mFailed).push_back(nodeId);
+    }
+
+    void OnQueueDrained(const CommissioningScheduler::Stats & stats) override
+    {
+        mDrainedCount++;
+        mDrainedStats = stats;
+    }
+
+    std::vector<NodeId> mSucceeded;
+    std::vector<NodeId> mFailed;
+    unsigned mDrainedCount = 0;
+    CommissioningScheduler::Stats mDrainedStats;
+};
+
+// Records the batches it is asked to issue, and completes each request of a batch.
+class RecordingIssuer : public OperationalCredentialsDelegate
+{
+public:
+    CHIP_ERROR GenerateNOCChain(const ByteSpan & csrElements, const ByteSpan & csrNonce, const ByteSpan & attestationSignature,
+                                const ByteSpan & attestationChallenge, const ByteSpan & DAC, const ByteSpan & PAI,
+                                Callback::Callback<OnNOCChainGeneration> * onCompletion) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    CHIP_ERROR GenerateNOCChains(Span<const NOCChainRequest> requests) override
+    {
+        mBatchSizes.push_back(requests.size());
+        VerifyOrReturnError(mBatchError == CHIP_NO_ERROR, mBatchError);
+        for (const auto & request : requests)
+        {
+            mNodeIds.push_back(request.nodeId.ValueOr(kUndefinedNodeId));
+            request.onCompletion->mCall(request.onCompletion->mContext, CHIP_NO_ERROR, request.csrElements, ByteSpan(), ByteSpan(),
+                                        NullOptional, NullOptional);
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<size_t> mBatchSizes;
+    std::vector<NodeId> mNodeIds;
+    CHIP_ERROR mBatchError = CHIP_NO_ERROR;
+};
+
+// Stands in for the NOC chain callback of a DeviceCommissioner.
+struct NOCChainRequester
+{
+    static void OnNOCChain(void * context, CHIP_ERROR status, const ByteSpan & noc, const ByteSpan & icac, const ByteSpan & rcac,
+                           Optional<Crypto::IdentityProtectionKeySpan> ipk, Optional<NodeId> adminSubject)
+    {
+        auto * self = static_cast<NOCChainRequester *>(context);
+        self->completions++;
+        self->status = status;
+    }
+
+    CHIP_ERROR Request(OperationalCredentialsDelegate & delegate, NodeId nodeId)
+    {
+        delegate.SetNodeIdForNextNOCRequest(nodeId);
+        return delegate.GenerateNOCChain(ByteSpan(kCSRElements), ByteSpan(), ByteSpan(), ByteSpan(), ByteSpan(), ByteSpan(),
+                                         &callback);
+    }
+
+    static constexpr uint8_t kCSRElements[] = { 0x15, 0x18 };
+
+    unsigned completions = 0;
+    CHIP_ERROR status    = CHIP_ERROR_INTERNAL;
+    Callback::Callback<OnNOCChainGeneration> callback{ OnNOCChain, this };
+};
+
+constexpr uint8_t NOCChainRequester::kCSRElements[];
+
+void TestQueuesDevicesOverLanes(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeviceCommissioner commissioners[2];
+    DeviceCommissioner * lanes[] = { &commissioners[0], &commissioners[1] };
+    RecordingCommissioningScheduler scheduler;
+    TestDelegate delegate;
+
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.systemLayer, Span<DeviceCommissioner * const>(lanes), &delegate) == CHIP_NO_ERROR);
+
+    // Only as many devices as there are lanes are commissioned at once, in the order they were queued.
+    for (NodeId nodeId = 1; nodeId <= 5; nodeId++)
+    {
+        NL_TEST_ASSERT(inSuite, scheduler.Enqueue(nodeId, kSetUpCode, CommissioningParameters()) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, scheduler.GetActiveCount() == 2);
+    NL_TEST_ASSERT(inSuite, scheduler.GetPendingCount() == 3);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 2);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts[0].nodeId == 1 && scheduler.mStarts[0].commissioner == &commissioners[0]);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts[1].nodeId == 2 && scheduler.mStarts[1].commissioner == &commissioners[1]);
+
+    // The next device is started on the lane that completed, once the commissioner is done with the completed one.
+    scheduler.Complete(commissioners[1]);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 2);
+    NL_TEST_ASSERT(inSuite, scheduler.GetActiveCount() == 1);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 3);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts[2].nodeId == 3 && scheduler.mStarts[2].commissioner == &commissioners[1]);
+    NL_TEST_ASSERT(inSuite, scheduler.GetActiveCount() == 2);
+
+    while (scheduler.GetActiveCount() > 0)
+    {
+        scheduler.Complete(commissioners[0]);
+        scheduler.Complete(commissioners[1]);
+        ServiceEvents(ctx.systemLayer);
+        NL_TEST_ASSERT(inSuite, scheduler.GetActiveCount() <= 2);
+    }
+
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 5);
+    NL_TEST_ASSERT(inSuite, scheduler.GetPendingCount() == 0);
+    NL_TEST_ASSERT(inSuite, delegate.mSucceeded.size() == 5);
+    NL_TEST_ASSERT(inSuite, delegate.mFailed.empty());
+    NL_TEST_ASSERT(inSuite, delegate.mDrainedCount == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mDrainedStats.succeeded == 5);
+
+    scheduler.Shutdown();
+}
+
+void TestReportsFailures(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeviceCommissioner commissioner;
+    DeviceCommissioner * lanes[] = { &commissioner };
+    RecordingCommissioningScheduler scheduler;
+    TestDelegate delegate;
+
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.systemLayer, Span<DeviceCommissioner * const>(lanes), &delegate) == CHIP_NO_ERROR);
+
+    scheduler.mRejectedNodeId = 2;
+    for (NodeId nodeId = 1; nodeId <= 3; nodeId++)
+    {
+        NL_TEST_ASSERT(inSuite, scheduler.Enqueue(nodeId, kSetUpCode, CommissioningParameters()) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 1 && scheduler.mStarts[0].nodeId == 1);
+
+    // A failed PASE session ends commissioning, a successful one does not.
+    commissioner.GetPairingDelegate()->OnPairingComplete(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, scheduler.GetActiveCount() == 1);
+    commissioner.GetPairingDelegate()->OnPairingComplete(CHIP_ERROR_TIMEOUT);
+    NL_TEST_ASSERT(inSuite, delegate.mFailed.size() == 1 && delegate.mFailed[0] == 1);
+    NL_TEST_ASSERT(inSuite, scheduler.GetActiveCount() == 0);
+
+    // A device that cannot be started fails right away and frees its lane for the next one.
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, delegate.mFailed.size() == 2 && delegate.mFailed[1] == 2);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 2 && scheduler.mStarts[1].nodeId == 3);
+
+    // So does a failure later in the commissioning pipeline.
+    scheduler.Complete(commissioner, CHIP_ERROR_INTERNAL);
+    NL_TEST_ASSERT(inSuite, delegate.mFailed.size() == 3 && delegate.mFailed[2] == 3);
+    ServiceEvents(ctx.systemLayer);
+
+    NL_TEST_ASSERT(inSuite, delegate.mSucceeded.empty());
+    NL_TEST_ASSERT(inSuite, delegate.mDrainedCount == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mDrainedStats.failed == 3);
+    NL_TEST_ASSERT(inSuite, delegate.mDrainedStats.DevicesPerMinute() == 0);
+
+    scheduler.Shutdown();
+}
+
+void TestShutdownCancelsPendingDevices(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    DeviceCommissioner commissioner;
+    DeviceCommissioner * lanes[] = { &commissioner };
+    RecordingCommissioningScheduler scheduler;
+    TestDelegate delegate;
+
+    NL_TEST_ASSERT(inSuite, scheduler.Enqueue(1, kSetUpCode, CommissioningParameters()) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.systemLayer, Span<DeviceCommissioner * const>(lanes), &delegate) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, commissioner.GetPairingDelegate() != nullptr);
+
+    for (NodeId nodeId = 1; nodeId <= 3; nodeId++)
+    {
+        NL_TEST_ASSERT(inSuite, scheduler.Enqueue(nodeId, kSetUpCode, CommissioningParameters()) == CHIP_NO_ERROR);
+    }
+    scheduler.Complete(commissioner);
+
+    // Shutting down drops the queued devices, cancels the pending dispatch and restores the pairing delegate.
+    scheduler.Shutdown();
+    NL_TEST_ASSERT(inSuite, scheduler.GetPendingCount() == 0);
+    NL_TEST_ASSERT(inSuite, commissioner.GetPairingDelegate() == nullptr);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, scheduler.mStarts.size() == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mSucceeded.size() == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mDrainedCount == 0);
+    NL_TEST_ASSERT(inSuite, scheduler.Enqueue(4, kSetUpCode, CommissioningParameters()) == CHIP_ERROR_INCORRECT_STATE);
+
+    // The queue is bounded, the device being commissioned aside.
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.systemLayer, Span<DeviceCommissioner * const>(lanes), &delegate) == CHIP_NO_ERROR);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (NodeId nodeId = 1; nodeId <= CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES + 2 && err == CHIP_NO_ERROR; nodeId++)
+    {
+        err = scheduler.Enqueue(nodeId, kSetUpCode, CommissioningParameters());
+    }
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, scheduler.GetPendingCount() == CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES);
+    scheduler.Shutdown();
+}
+
+// Commissions `deviceCount` devices that each take kCommissioningDuration over `laneCount` lanes, and returns the
+// devices per minute the scheduler measured.
+uint32_t MeasureDevicesPerMinute(nlTestSuite * inSuite, TestContext & ctx, size_t laneCount, NodeId deviceCount)
+{
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::MockClock mockClock;
+    System::Clock::Internal::SetSystemClockForTesting(&mockClock);
+
+    DeviceCommissioner commissioners[4];
+    DeviceCommissioner * lanes[] = { &commissioners[0], &commissioners[1], &commissioners[2], &commissioners[3] };
+    RecordingCommissioningScheduler scheduler;
+    TestDelegate delegate;
+
+    NL_TEST_ASSERT(inSuite, scheduler.Init(&ctx.systemLayer, Span<DeviceCommissioner * const>(lanes, laneCount), &delegate) ==
+                       CHIP_NO_ERROR);
+    for (NodeId nodeId = 1; nodeId <= deviceCount; nodeId++)
+    {
+        NL_TEST_ASSERT(inSuite, scheduler.Enqueue(nodeId, kSetUpCode, CommissioningParameters()) == CHIP_NO_ERROR);
+    }
+
+    while (delegate.mDrainedCount == 0)
+    {
+        mockClock.AdvanceMonotonic(kCommissioningDuration);
+        for (size_t i = 0; i < laneCount; i++)
+        {
+            scheduler.Complete(commissioners[i]);
+        }
+        ServiceEvents(ctx.systemLayer);
+    }
+
+    NL_TEST_ASSERT(inSuite, delegate.mSucceeded.size() == deviceCount);
+    uint32_t devicesPerMinute = delegate.mDrainedStats.DevicesPerMinute();
+    ChipLogProgress(Controller, "%u devices over %u lanes: %u devices/minute", static_cast<unsigned>(deviceCount),
+                    static_cast<unsigned>(laneCount), static_cast<unsigned>(devicesPerMinute));
+
+    scheduler.Shutdown();
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+    return devicesPerMinute;
+}
+
+void TestBatchesNOCChainRequests(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    RecordingIssuer issuer;
+    BatchingOperationalCredentialsDelegate batching;
+    NOCChainRequester requesters[3];
+
+    NL_TEST_ASSERT(inSuite, requesters[0].Request(batching, 1) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, batching.Init(&ctx.systemLayer, &issuer) == CHIP_NO_ERROR);
+
+    // The requests made by the lanes while handling the same event are issued together once the event is handled.
+    for (NodeId nodeId = 1; nodeId <= 3; nodeId++)
+    {
+        NL_TEST_ASSERT(inSuite, requesters[nodeId - 1].Request(batching, nodeId) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, batching.GetPendingCount() == 3);
+    NL_TEST_ASSERT(inSuite, issuer.mBatchSizes.empty());
+    NL_TEST_ASSERT(inSuite, requesters[0].completions == 0);
+
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, batching.GetPendingCount() == 0);
+    NL_TEST_ASSERT(inSuite, issuer.mBatchSizes == std::vector<size_t>({ 3 }));
+    NL_TEST_ASSERT(inSuite, issuer.mNodeIds == std::vector<NodeId>({ 1, 2, 3 }));
+    for (auto & requester : requesters)
+    {
+        NL_TEST_ASSERT(inSuite, requester.completions == 1 && requester.status == CHIP_NO_ERROR);
+    }
+
+    // A batch the issuer rejects fails each of its requests.
+    issuer.mBatchError = CHIP_ERROR_NO_MEMORY;
+    NL_TEST_ASSERT(inSuite, requesters[0].Request(batching, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, requesters[1].Request(batching, 5) == CHIP_NO_ERROR);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, issuer.mBatchSizes.size() == 2 && issuer.mBatchSizes[1] == 2);
+    NL_TEST_ASSERT(inSuite, requesters[0].completions == 2 && requesters[0].status == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, requesters[1].completions == 2 && requesters[1].status == CHIP_ERROR_NO_MEMORY);
+
+    // Shutting down cancels the requests that were not issued yet.
+    NL_TEST_ASSERT(inSuite, requesters[2].Request(batching, 6) == CHIP_NO_ERROR);
+    batching.Shutdown();
+    NL_TEST_ASSERT(inSuite, requesters[2].completions == 2 && requesters[2].status == CHIP_ERROR_CANCELLED);
+    ServiceEvents(ctx.systemLayer);
+    NL_TEST_ASSERT(inSuite, issuer.mBatchSizes.size() == 2);
+    NL_TEST_ASSERT(inSuite, requesters[2].completions == 2);
+}
+
+void TestDevicesPerMinute(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    // Devices that each take 30 seconds are commissioned at 2 per minute and per lane.
+    NL_TEST_ASSERT(inSuite, MeasureDevicesPerMinute(inSuite, ctx, 1, 8) == 2);
+    NL_TEST_ASSERT(inSuite, MeasureDevicesPerMinute(inSuite, ctx, 4, 8) == 8);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestQueuesDevicesOverLanes", TestQueuesDevicesOverLanes),
+    NL_TEST_DEF("TestReportsFailures", TestReportsFailures),
+    NL_TEST_DEF("TestShutdownCancelsPendingDevices", TestShutdownCancelsPendingDevices),
+    NL_TEST_DEF("TestBatchesNOCChainRequests", TestBatchesNOCChainRequests),
+    NL_TEST_DEF("TestDevicesPerMinute", TestDevicesPerMinute),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestCommissioningScheduler_Setup(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    VerifyOrReturnError(CHIP_NO_ERROR == Platform::MemoryInit(), FAILURE);
+    VerifyOrReturnError(CHIP_NO_ERROR == ctx.systemLayer.Init(), FAILURE);
+    return SUCCESS;
+}
+
+int TestCommissioningScheduler_Teardown(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    ctx.systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestCommissioningScheduler()
+{
+    TestContext context;
+    nlTestSuite theSuite = { "CommissioningScheduler", &sTests[0], TestCommissioningScheduler_Setup,
+                             TestCommissioningScheduler_Teardown };
+    nlTestRunner(&theSuite, &context);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCommissioningScheduler)
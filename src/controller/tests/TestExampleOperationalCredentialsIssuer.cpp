@@ -0,0 +1,271 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/ExampleOperationalCredentialsIssuer.h>
+#include <credentials/CHIPCert.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Controller;
+using namespace chip::Credentials;
+using namespace chip::Crypto;
+
+namespace {
+
+using NOCChainRequest = OperationalCredentialsDelegate::NOCChainRequest;
+
+constexpr size_t kBatchSize = 16;
+
+void OnChainGenerated(void * context, CHIP_ERROR status, const ByteSpan & noc, const ByteSpan & icac, const ByteSpan & rcac,
+                      Optional<IdentityProtectionKeySpan> ipk, Optional<NodeId> adminSubject);
+
+struct IssuedChain
+{
+    IssuedChain() : callback(OnChainGenerated, this) {}
+
+    void Reset()
+    {
+        status = CHIP_ERROR_INTERNAL;
+        called = false;
+    }
+
+    Callback::Callback<OnNOCChainGeneration> callback;
+    CHIP_ERROR status = CHIP_ERROR_INTERNAL;
+    bool called       = false;
+    uint8_t noc[kMaxDERCertLength];
+    size_t nocLen = 0;
+    uint8_t icac[kMaxDERCertLength];
+    size_t icacLen = 0;
+    uint8_t rcac[kMaxDERCertLength];
+    size_t rcacLen = 0;
+};
+
+void OnChainGenerated(void * context, CHIP_ERROR status, const ByteSpan & noc, const ByteSpan & icac, const ByteSpan & rcac,
+                      Optional<IdentityProtectionKeySpan> ipk, Optional<NodeId> adminSubject)
+{
+    auto * chain   = static_cast<IssuedChain *>(context);
+    chain->called  = true;
+    chain->status  = status;
+    chain->nocLen  = noc.size();
+    chain->icacLen = icac.size();
+    chain->rcacLen = rcac.size();
+    memcpy(chain->noc, noc.data(), noc.size());
+    memcpy(chain->icac, icac.data(), icac.size());
+    memcpy(chain->rcac, rcac.data(), rcac.size());
+}
+
+// Wraps a CSR into NOCSR elements as the commissionee would return them in CSRResponse.
+CHIP_ERROR EncodeNOCSRElements(const P256Keypair & keypair, MutableByteSpan & out)
+{
+    uint8_t csr[kMAX_CSR_Length];
+    size_t csrLength = sizeof(csr);
+    ReturnErrorOnFailure(keypair.NewCertificateSigningRequest(csr, csrLength));
+
+    TLV::TLVWriter writer;
+    writer.Init(out);
+    TLV::TLVType containerType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType));
+    ReturnErrorOnFailure(writer.Put(TLV::ContextTag(1), ByteSpan(csr, csrLength)));
+    ReturnErrorOnFailure(writer.EndContainer(containerType));
+    ReturnErrorOnFailure(writer.Finalize());
+    out.reduce_size(writer.GetLengthWritten());
+    return CHIP_NO_ERROR;
+}
+
+struct BatchFixture
+{
+    P256Keypair keypairs[kBatchSize];
+    uint8_t csrElements[kBatchSize][kMAX_CSR_Length + 16];
+    IssuedChain chains[kBatchSize];
+    NOCChainRequest requests[kBatchSize];
+
+    CHIP_ERROR Init()
+    {
+        for (size_t i = 0; i < kBatchSize; i++)
+        {
+            ReturnErrorOnFailure(keypairs[i].Initialize(ECPKeyTarget::ECDSA));
+
+            MutableByteSpan elements(csrElements[i]);
+            ReturnErrorOnFailure(EncodeNOCSRElements(keypairs[i], elements));
+
+            requests[i].csrElements  = elements;
+            requests[i].nodeId       = MakeOptional(static_cast<NodeId>(0x1000 + i));
+            requests[i].onCompletion = &chains[i].callback;
+        }
+        return CHIP_NO_ERROR;
+    }
+};
+
+void TestBatchIssuesChainsSharingCACerts(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    ExampleOperationalCredentialsIssuer issuer;
+    NL_TEST_ASSERT(inSuite, issuer.Initialize(storage) == CHIP_NO_ERROR);
+
+    auto fixture = Platform::MakeUnique<BatchFixture>();
+    NL_TEST_ASSERT(inSuite, fixture && fixture->Init() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, issuer.GenerateNOCChains(Span<const NOCChainRequest>(fixture->requests)) ==
+                       CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        IssuedChain & chain = fixture->chains[i];
+        NL_TEST_ASSERT(inSuite, chain.called);
+        NL_TEST_ASSERT(inSuite, chain.status == CHIP_NO_ERROR);
+
+        // Every chain shares the same RCAC and ICAC encodings.
+        NL_TEST_ASSERT(inSuite, ByteSpan(chain.rcac, chain.rcacLen).data_equal(
+                                    ByteSpan(fixture->chains[0].rcac, fixture->chains[0].rcacLen)));
+        NL_TEST_ASSERT(inSuite, ByteSpan(chain.icac, chain.icacLen).data_equal(
+                                    ByteSpan(fixture->chains[0].icac, fixture->chains[0].icacLen)));
+
+        // The NOC certifies the key of the CSR it was issued for.
+        P256PublicKey nocPubkey;
+        NL_TEST_ASSERT(inSuite, ExtractPubkeyFromX509Cert(ByteSpan(chain.noc, chain.nocLen), nocPubkey) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, nocPubkey.Matches(fixture->keypairs[i].Pubkey()));
+
+        // And chains up to the shared ICAC and RCAC.
+        uint8_t chipNoc[kMaxCHIPCertLength];
+        MutableByteSpan chipNocSpan(chipNoc);
+        NL_TEST_ASSERT(inSuite, ConvertX509CertToChipCert(ByteSpan(chain.noc, chain.nocLen), chipNocSpan) == CHIP_NO_ERROR);
+        NodeId nodeId     = kUndefinedNodeId;
+        FabricId fabricId = kUndefinedFabricId;
+        NL_TEST_ASSERT(inSuite, ExtractNodeIdFabricIdFromOpCert(chipNocSpan, &nodeId, &fabricId) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, nodeId == 0x1000 + i);
+    }
+}
+
+void TestBatchReportsPerRequestFailures(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    ExampleOperationalCredentialsIssuer issuer;
+    NL_TEST_ASSERT(inSuite, issuer.Initialize(storage) == CHIP_NO_ERROR);
+
+    auto fixture = Platform::MakeUnique<BatchFixture>();
+    NL_TEST_ASSERT(inSuite, fixture && fixture->Init() == CHIP_NO_ERROR);
+
+    // Corrupt one CSR: only that request may fail.
+    const uint8_t garbage[] = { 0x15, 0x30, 0x01, 0x02, 0xAA, 0xBB, 0x18 };
+    fixture->requests[3].csrElements = ByteSpan(garbage);
+
+    NL_TEST_ASSERT(inSuite, issuer.GenerateNOCChains(Span<const NOCChainRequest>(fixture->requests)) ==
+                       CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, fixture->chains[i].called);
+        NL_TEST_ASSERT(inSuite, (fixture->chains[i].status == CHIP_NO_ERROR) == (i != 3));
+    }
+
+    // A request without a callback rejects the whole batch without calling anyone.
+    fixture = Platform::MakeUnique<BatchFixture>();
+    NL_TEST_ASSERT(inSuite, fixture && fixture->Init() == CHIP_NO_ERROR);
+    fixture->requests[kBatchSize - 1].onCompletion = nullptr;
+    NL_TEST_ASSERT(inSuite, issuer.GenerateNOCChains(Span<const NOCChainRequest>(fixture->requests)) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, !fixture->chains[i].called);
+    }
+}
+
+void TestCACertsServedFromCache(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    ExampleOperationalCredentialsIssuer issuer;
+    NL_TEST_ASSERT(inSuite, issuer.Initialize(storage) == CHIP_NO_ERROR);
+
+    auto fixture = Platform::MakeUnique<BatchFixture>();
+    NL_TEST_ASSERT(inSuite, fixture && fixture->Init() == CHIP_NO_ERROR);
+
+    Span<const NOCChainRequest> requests(fixture->requests);
+    NL_TEST_ASSERT(inSuite, issuer.GenerateNOCChains(requests.SubSpan(0, 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, fixture->chains[0].status == CHIP_NO_ERROR);
+
+    // Once loaded, the RCAC and ICAC are no longer read back from storage for each chain.
+    storage.AddPoisonKey("ExampleCARootCert0");
+    storage.AddPoisonKey("ExampleCAIntermediateCert0");
+
+    System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    NL_TEST_ASSERT(inSuite, issuer.GenerateNOCChains(requests.SubSpan(1)) == CHIP_NO_ERROR);
+    System::Clock::Milliseconds64 elapsed = std::chrono::duration_cast<System::Clock::Milliseconds64>(
+        System::SystemClock().GetMonotonicTimestamp() - start);
+
+    for (size_t i = 1; i < kBatchSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, fixture->chains[i].status == CHIP_NO_ERROR);
+    }
+
+    ChipLogProgress(Controller, "Issued %u NOC chains in %u ms", static_cast<unsigned>(kBatchSize - 1),
+                    static_cast<unsigned>(elapsed.count()));
+
+    // Changing the issuer parameters drops the cache, which now requires the (poisoned) storage.
+    issuer.SetCurrentEpoch(0);
+    fixture->chains[0].Reset();
+    NL_TEST_ASSERT(inSuite, issuer.GenerateNOCChains(requests.SubSpan(0, 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, fixture->chains[0].called);
+    NL_TEST_ASSERT(inSuite, fixture->chains[0].status != CHIP_NO_ERROR);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestBatchIssuesChainsSharingCACerts", TestBatchIssuesChainsSharingCACerts),
+    NL_TEST_DEF("TestBatchReportsPerRequestFailures", TestBatchReportsPerRequestFailures),
+    NL_TEST_DEF("TestCACertsServedFromCache", TestCACertsServedFromCache),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestExampleOperationalCredentialsIssuer_Setup(void * inContext)
+{
+    if (CHIP_NO_ERROR != chip::Platform::MemoryInit())
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+int TestExampleOperationalCredentialsIssuer_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestExampleOperationalCredentialsIssuer()
+{
+    nlTestSuite theSuite = { "ExampleOperationalCredentialsIssuer", &sTests[0], TestExampleOperationalCredentialsIssuer_Setup,
+                             TestExampleOperationalCredentialsIssuer_Teardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestExampleOperationalCredentialsIssuer)
@@ -33,6 +33,7 @@
 
 #include <credentials/CHIPCert.h>
 #include <credentials/CHIPCertificateSet.h>
+#include <credentials/ValidatedCertLinkCache.h>
 #include <lib/asn1/ASN1.h>
 #include <lib/asn1/ASN1Macros.h>
 #include <lib/core/CHIPCore.h>
@@ -469,11 +470,23 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
         ExitNow(err = CHIP_ERROR_CA_CERT_NOT_FOUND);
     }
 
+    // Signatures of CA certificates (e.g. an ICAC signed by the RCAC) are shared by every chain issued under them,
+    // so skip verifying one that was already verified.  All the checks above still applied to this validation.
+    if (depth > 0 && context.mValidatedLinkCache != nullptr && context.mValidatedLinkCache->Contains(*cert, *caCert))
+    {
+        ExitNow(err = CHIP_NO_ERROR);
+    }
+
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
     // succeeds, the current certificate is valid.
     err = VerifySignature(cert, caCert);
     SuccessOrExit(err);
 
+    if (depth > 0 && context.mValidatedLinkCache != nullptr)
+    {
+        context.mValidatedLinkCache->Add(*cert, *caCert);
+    }
+
 exit:
     return err;
 }
@@ -564,9 +577,10 @@ bool ChipCertificateData::IsEqual(const ChipCertificateData & other) const
 
 void ValidationContext::Reset()
 {
-    mEffectiveTime  = EffectiveTime{};
-    mTrustAnchor    = nullptr;
-    mValidityPolicy = nullptr;
+    mEffectiveTime      = EffectiveTime{};
+    mTrustAnchor        = nullptr;
+    mValidityPolicy     = nullptr;
+    mValidatedLinkCache = nullptr;
     mRequiredKeyUsages.ClearAll();
     mRequiredKeyPurposes.ClearAll();
     mRequiredCertType = kCertType_NotSpecified;
@@ -53,6 +53,8 @@ struct LastKnownGoodChipEpochTime : chip::System::Clock::Seconds32
 
 using EffectiveTime = Variant<CurrentChipEpochTime, LastKnownGoodChipEpochTime>;
 
+class ValidatedCertLinkCache;
+
 /**
  *  @struct ValidationContext
  *
@@ -75,6 +77,9 @@ struct ValidationContext
     CertificateValidityPolicy * mValidityPolicy =
         nullptr; /**< Optional application policy to apply for certificate validity period evaluation. */
 
+    ValidatedCertLinkCache * mValidatedLinkCache =
+        nullptr; /**< Optional cache of CA certificate signatures that were already verified. */
+
     void Reset();
 
     template <typename T>
@@ -347,6 +347,10 @@ CHIP_ERROR FabricTable::VerifyCredentials(FabricIndex fabricIndex, const ByteSpa
     uint8_t rootCertBuf[kMaxCHIPCertLength];
     MutableByteSpan rootCertSpan{ rootCertBuf };
     ReturnErrorOnFailure(FetchRootCert(fabricIndex, rootCertSpan));
+    if (context.mValidatedLinkCache == nullptr)
+    {
+        context.mValidatedLinkCache = &mValidatedCertLinkCache;
+    }
     return VerifyCredentials(noc, icac, rootCertSpan, context, outCompressedFabricId, outFabricId, outNodeId, outNocPubkey,
                              outRootPublicKey);
 }
@@ -1056,6 +1060,8 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
     // this condition and can act appropriately.
     mLastKnownGoodTime.Init(mStorage);
 
+    ReturnErrorOnFailure(mValidatedCertLinkCache.Init());
+
     uint8_t buf[IndexInfoTLVMaxSize()];
     uint16_t size  = sizeof(buf);
     CHIP_ERROR err = mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::FabricIndexInfo().KeyName(), buf, size);
@@ -29,6 +29,7 @@
 #include <credentials/CertificateValidityPolicy.h>
 #include <credentials/LastKnownGoodTime.h>
 #include <credentials/OperationalCertificateStore.h>
+#include <credentials/ValidatedCertLinkCache.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <crypto/OperationalKeystore.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
@@ -515,6 +516,14 @@ public:
         return mLastKnownGoodTime.GetLastKnownGoodChipEpochTime(lastKnownGoodChipEpochTime);
     }
 
+    /**
+     * Cache of CA certificate signatures verified while validating operational certificate chains.
+     *
+     * VerifyCredentials(FabricIndex, ...) uses it automatically.  Callers of the static VerifyCredentials
+     * (e.g. CASE validating a peer chain off the stack thread) may set it in their ValidationContext.
+     */
+    Credentials::ValidatedCertLinkCache & GetValidatedCertLinkCache() const { return mValidatedCertLinkCache; }
+
     /**
      * Validate that the passed Last Known Good Time is within bounds and then
      * store this and write back to storage.  Legal values are those which are
@@ -1148,6 +1157,10 @@ private:
 
     LastKnownGoodTime mLastKnownGoodTime;
 
+    // Only remembers signature checks, which are immutable facts, so it never needs to be invalidated
+    // when fabrics are updated or removed.
+    mutable Credentials::ValidatedCertLinkCache mValidatedCertLinkCache;
+
     // We may not have an mNextAvailableFabricIndex if our table is as large as
     // it can go and is full.
     Optional<FabricIndex> mNextAvailableFabricIndex;
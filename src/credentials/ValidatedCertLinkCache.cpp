@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <credentials/ValidatedCertLinkCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <mutex>
+#include <string.h>
+
+namespace chip {
+namespace Credentials {
+
+CHIP_ERROR ValidatedCertLinkCache::Init()
+{
+    VerifyOrReturnError(!mInitialized, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(System::Mutex::Init(mMutex));
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ValidatedCertLinkCache::ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & caCert,
+                                                 uint8_t (&digest)[Crypto::kSHA256_Hash_Length])
+{
+    VerifyOrReturnError(cert.mCertFlags.Has(CertFlags::kTBSHashPresent), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Crypto::Hash_SHA256_stream hash;
+    ReturnErrorOnFailure(hash.Begin());
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(cert.mTBSHash)));
+    ReturnErrorOnFailure(hash.AddData(cert.mSignature));
+    ReturnErrorOnFailure(hash.AddData(caCert.mPublicKey));
+
+    MutableByteSpan digestSpan(digest);
+    return hash.Finish(digestSpan);
+}
+
+ValidatedCertLinkCache::Entry * ValidatedCertLinkCache::Find(const uint8_t (&digest)[Crypto::kSHA256_Hash_Length])
+{
+    for (size_t i = 0; i < kCapacity; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.lastUse != 0 && memcmp(entry.digest, digest, sizeof(digest)) == 0)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool ValidatedCertLinkCache::Contains(const ChipCertificateData & cert, const ChipCertificateData & caCert)
+{
+    VerifyOrReturnValue(kCapacity > 0 && mInitialized, false);
+
+    uint8_t digest[Crypto::kSHA256_Hash_Length];
+    VerifyOrReturnValue(ComputeDigest(cert, caCert, digest) == CHIP_NO_ERROR, false);
+
+    std::lock_guard<System::Mutex> lock(mMutex);
+
+    Entry * entry = Find(digest);
+    if (entry == nullptr)
+    {
+        mMissCount++;
+        return false;
+    }
+
+    mHitCount++;
+    entry->lastUse = ++mUseCounter;
+    return true;
+}
+
+void ValidatedCertLinkCache::Add(const ChipCertificateData & cert, const ChipCertificateData & caCert)
+{
+    VerifyOrReturn(kCapacity > 0 && mInitialized);
+
+    uint8_t digest[Crypto::kSHA256_Hash_Length];
+    VerifyOrReturn(ComputeDigest(cert, caCert, digest) == CHIP_NO_ERROR);
+
+    std::lock_guard<System::Mutex> lock(mMutex);
+
+    Entry * entry = Find(digest);
+    if (entry == nullptr)
+    {
+        // Pick an empty slot, or else the least recently used one.
+        entry = &mEntries[0];
+        for (size_t i = 1; i < kCapacity && entry->lastUse != 0; i++)
+        {
+            if (mEntries[i].lastUse < entry->lastUse)
+            {
+                entry = &mEntries[i];
+            }
+        }
+        memcpy(entry->digest, digest, sizeof(digest));
+    }
+
+    entry->lastUse = ++mUseCounter;
+}
+
+void ValidatedCertLinkCache::Clear()
+{
+    VerifyOrReturn(mInitialized);
+
+    std::lock_guard<System::Mutex> lock(mMutex);
+    for (Entry & entry : mEntries)
+    {
+        entry.lastUse = 0;
+    }
+    mUseCounter = 0;
+    mHitCount   = 0;
+    mMissCount  = 0;
+}
+
+} // namespace Credentials
+} // namespace chip
@@ -0,0 +1,93 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <credentials/CHIPCert.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemMutex.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Credentials {
+
+/**
+ * Bounded, least-recently-used record of CA certificate signatures that have already been verified.
+ *
+ * During CASE, every peer of a fabric typically presents the same ICAC, so verifying the ICAC -> RCAC
+ * signature again on each session establishment is redundant.  ChipCertificateSet::ValidateCert consults
+ * this cache (when one is provided in the ValidationContext) before verifying the signature of a CA
+ * certificate and records successful verifications in it.
+ *
+ * Only the outcome of the signature verification is remembered.  An entry is keyed on a digest of the
+ * certificate TBS hash, the certificate signature and the issuer public key, so a hit is equivalent to
+ * a successful signature check.  Every other check performed by ValidateCert (certificate type, key
+ * usage, path length, validity period and the CertificateValidityPolicy) still runs on each validation.
+ *
+ * The cache is safe to use from the CHIP stack thread and from background work items concurrently.
+ */
+class ValidatedCertLinkCache
+{
+public:
+    static constexpr size_t kCapacity = CHIP_CONFIG_VALIDATED_CERT_LINK_CACHE_SIZE;
+
+    CHIP_ERROR Init();
+
+    /**
+     * Returns true if the signature of `cert` was previously verified against the public key of `caCert`.
+     */
+    bool Contains(const ChipCertificateData & cert, const ChipCertificateData & caCert);
+
+    /**
+     * Record that the signature of `cert` was verified against the public key of `caCert`, evicting the
+     * least recently used entry if the cache is full.
+     */
+    void Add(const ChipCertificateData & cert, const ChipCertificateData & caCert);
+
+    void Clear();
+
+    size_t GetHitCount() const { return mHitCount; }
+    size_t GetMissCount() const { return mMissCount; }
+
+private:
+    struct Entry
+    {
+        uint8_t digest[Crypto::kSHA256_Hash_Length];
+        uint64_t lastUse; // 0 when the entry is empty
+    };
+
+    static CHIP_ERROR ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & caCert,
+                                    uint8_t (&digest)[Crypto::kSHA256_Hash_Length]);
+    Entry * Find(const uint8_t (&digest)[Crypto::kSHA256_Hash_Length]);
+
+    // Keep a valid array type when the cache is disabled.
+    Entry mEntries[kCapacity > 0 ? kCapacity : 1] = {};
+    // 64 bits so that the counter does not wrap around, which would break the recency order.
+    uint64_t mUseCounter                          = 0;
+    size_t mHitCount                              = 0;
+    size_t mMissCount                             = 0;
+    bool mInitialized                             = false;
+    System::Mutex mMutex;
+};
+
+} // namespace Credentials
+} // namespace chip
@@ -25,6 +25,7 @@
  */
 
 #include <credentials/CHIPCert.h>
+#include <credentials/ValidatedCertLinkCache.h>
 #include <credentials/examples/LastKnownGoodTimeCertificateValidityPolicyExample.h>
 #include <credentials/examples/StrictCertificateValidityPolicyExample.h>
 #include <crypto/CHIPCryptoPAL.h>
@@ -34,6 +35,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/ErrorStr.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
 
 #include <nlunit-test.h>
 
@@ -2107,6 +2109,95 @@ static void TestChipCert_ExtractPublicKeyAndSKID(nlTestSuite * inSuite, void * i
     }
 }
 
+static void TestChipCert_ValidatedLinkCache(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+    ValidatedCertLinkCache cache;
+    Credentials::StrictCertificateValidityPolicyExample strictCertificateValidityPolicy;
+
+    NL_TEST_ASSERT(inSuite, cache.Init() == CHIP_NO_ERROR);
+
+    err = certSet.Init(kStandardCertsCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = LoadTestCertSet01(certSet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    const ChipCertificateData & rcac = certSet.GetCertSet()[0];
+    const ChipCertificateData & icac = certSet.GetCertSet()[1];
+    const ChipCertificateData & noc  = certSet.GetCertSet()[2];
+
+    validContext.Reset();
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+    validContext.mValidatedLinkCache = &cache;
+    NL_TEST_ASSERT(inSuite, SetCurrentTime(validContext, 2022, 02, 23) == CHIP_NO_ERROR);
+
+    // The first validation verifies the ICAC signature and records it, the second one reuses it.
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(&noc, validContext) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.GetHitCount() == 0);
+    NL_TEST_ASSERT(inSuite, cache.Contains(icac, rcac));
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(&noc, validContext) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.GetHitCount() == 2);
+
+    // Only the CA link is cached: the NOC signature is always verified.
+    NL_TEST_ASSERT(inSuite, !cache.Contains(noc, icac));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(icac, noc));
+
+    // A cached link does not bypass the validity period or the validity policy.
+    NL_TEST_ASSERT(inSuite, SetCurrentTime(validContext, 2042, 4, 25) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(&noc, validContext) == CHIP_ERROR_CERT_EXPIRED);
+    ClearTimeSource(validContext);
+    validContext.mValidityPolicy = &strictCertificateValidityPolicy;
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(&noc, validContext) == CHIP_ERROR_CERT_EXPIRED);
+    validContext.mValidityPolicy = nullptr;
+
+    // Fill the cache with other links: the least recently used entry is evicted first.
+    uint8_t fakeSignature[kP256_ECDSA_Signature_Length_Raw] = { 0 };
+    ChipCertificateData fakeCerts[ValidatedCertLinkCache::kCapacity];
+    for (size_t i = 0; i < ValidatedCertLinkCache::kCapacity; i++)
+    {
+        fakeCerts[i].mCertFlags.Set(CertFlags::kTBSHashPresent);
+        fakeCerts[i].mTBSHash[0] = static_cast<uint8_t>(i + 1);
+        fakeCerts[i].mSignature  = P256ECDSASignatureSpan(fakeSignature);
+    }
+    for (size_t i = 0; i < ValidatedCertLinkCache::kCapacity - 1; i++)
+    {
+        cache.Add(fakeCerts[i], rcac);
+    }
+    NL_TEST_ASSERT(inSuite, cache.Contains(icac, rcac));
+    cache.Add(fakeCerts[ValidatedCertLinkCache::kCapacity - 1], rcac);
+    NL_TEST_ASSERT(inSuite, cache.Contains(icac, rcac));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(fakeCerts[0], rcac));
+    for (size_t i = 1; i < ValidatedCertLinkCache::kCapacity; i++)
+    {
+        NL_TEST_ASSERT(inSuite, cache.Contains(fakeCerts[i], rcac));
+    }
+
+    // Compare the cost of validating the same chain repeatedly with and without the cache.
+    constexpr uint32_t kIterations = 50;
+    NL_TEST_ASSERT(inSuite, SetCurrentTime(validContext, 2022, 02, 23) == CHIP_NO_ERROR);
+    System::Clock::Milliseconds64 elapsed[2];
+    for (int useCache = 0; useCache < 2; useCache++)
+    {
+        validContext.mValidatedLinkCache    = useCache ? &cache : nullptr;
+        System::Clock::Milliseconds64 start = System::SystemClock().GetMonotonicMilliseconds64();
+        for (uint32_t i = 0; i < kIterations; i++)
+        {
+            NL_TEST_ASSERT(inSuite, certSet.ValidateCert(&noc, validContext) == CHIP_NO_ERROR);
+        }
+        elapsed[useCache] = System::SystemClock().GetMonotonicMilliseconds64() - start;
+    }
+    ChipLogProgress(SecureChannel, "Validated %u NOC chains in %u ms without link cache, %u ms with it",
+                    static_cast<unsigned>(kIterations), static_cast<unsigned>(elapsed[0].count()),
+                    static_cast<unsigned>(elapsed[1].count()));
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, !cache.Contains(icac, rcac));
+}
+
 /**
  *  Set up the test suite.
  */
@@ -2164,6 +2255,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test extracting and validating CASE Authenticated Tags from NOC", TestChipCert_ExtractAndValidateCATsFromOpCert),
     NL_TEST_DEF("Test extracting Subject DN from chip certificate", TestChipCert_ExtractSubjectDNFromChipCert),
     NL_TEST_DEF("Test extracting PublicKey and SKID from chip certificate", TestChipCert_ExtractPublicKeyAndSKID),
+    NL_TEST_DEF("Test CHIP Certificate validated link cache", TestChipCert_ValidatedLinkCache),
     NL_TEST_SENTINEL()
 };
 // clang-format on
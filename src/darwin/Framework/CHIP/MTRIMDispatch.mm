@@ -33,6 +33,7 @@
 #include <app/WriteHandler.h>
 #include <app/att-storage.h>
 #include <app/data-model/Decode.h>
+#include <app/util/af-types.h>
 #include <lib/core/CHIPError.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/core/Optional.h>
@@ -274,6 +275,18 @@ Optional<ClusterId> emberAfGetNthClusterId(EndpointId endpoint, uint8_t n, bool
     return NullOptional;
 }
 
+const EmberAfCluster * emberAfGetNthClusterFromIndex(uint16_t endpointIndex, uint8_t n, bool server)
+{
+    static const EmberAfCluster otaProviderCluster = { OtaSoftwareUpdateProvider::Id, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr,
+        nullptr, nullptr, nullptr, 0 };
+
+    if (endpointIndex == 0 && n == 0 && server) {
+        return &otaProviderCluster;
+    }
+
+    return nullptr;
+}
+
 uint16_t emberAfGetServerAttributeIndexByAttributeId(EndpointId endpoint, ClusterId cluster, AttributeId attributeId)
 {
     return UINT16_MAX;
@@ -290,6 +303,15 @@ uint8_t emberAfClusterCount(EndpointId endpoint, bool server)
     return 0;
 }
 
+uint8_t emberAfClusterCountByIndex(uint16_t endpointIndex, bool server)
+{
+    if (endpointIndex == 0 && server) {
+        return 1;
+    }
+
+    return 0;
+}
+
 Optional<AttributeId> emberAfGetServerAttributeIdByIndex(EndpointId endpoint, ClusterId cluster, uint16_t attributeIndex)
 {
     return NullOptional;
@@ -305,3 +327,5 @@ uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClu
 }
 
 bool emberAfEndpointIndexIsEnabled(uint16_t index) { return index == 0; }
+
+uint32_t emberAfMetadataStructureGeneration() { return 0; }
@@ -30,6 +30,7 @@
 #include <type_traits>
 
 #include <lib/core/CHIPError.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <platform/CHIPDeviceBuildConfig.h>
 
 namespace chip {
@@ -170,10 +171,34 @@ public:
      */
     CHIP_ERROR Delete(const char * key);
 
+    /**
+     * @brief
+     * Enumerates the key-value entries whose key starts with the given prefix,
+     * in a single pass over the KVS. Not every platform supports it.
+     *
+     * @param[in]  prefix   The prefix of the keys to enumerate, this is a
+     *                      null-terminated string.
+     * @param[in]  visitor  Called for each matching entry. It must not access
+     *                      the KVS.
+     *
+     * @return CHIP_NO_ERROR all the matching entries were visited
+     *         CHIP_ERROR_NOT_IMPLEMENTED the platform cannot enumerate entries
+     *         CHIP_ERROR_BUFFER_TOO_SMALL a matching value is too large to be
+     *                                     passed to the visitor
+     *         any error returned by the visitor, which stops the enumeration
+     */
+    CHIP_ERROR ForEachKeyValueWithPrefix(const char * prefix, PersistentStorageDelegate::KeyValueVisitor & visitor);
+
 private:
     using ImplClass = ::chip::DeviceLayer::PersistedStorage::KeyValueStoreManagerImpl;
 
 protected:
+    // Default for the platforms that cannot enumerate their entries.
+    CHIP_ERROR _ForEachKeyValueWithPrefix(const char * prefix, PersistentStorageDelegate::KeyValueVisitor & visitor)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
     // Construction/destruction limited to subclasses.
     KeyValueStoreManager()  = default;
     ~KeyValueStoreManager() = default;
@@ -233,6 +258,12 @@ inline CHIP_ERROR KeyValueStoreManager::Delete(const char * key)
     return static_cast<ImplClass *>(this)->_Delete(key);
 }
 
+inline CHIP_ERROR KeyValueStoreManager::ForEachKeyValueWithPrefix(const char * prefix,
+                                                                  PersistentStorageDelegate::KeyValueVisitor & visitor)
+{
+    return static_cast<ImplClass *>(this)->_ForEachKeyValueWithPrefix(prefix, visitor);
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
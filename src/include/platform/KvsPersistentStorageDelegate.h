@@ -103,6 +103,12 @@ public:
         return mKvsManager->Delete(key);
     }
 
+    CHIP_ERROR SyncForEachKeyValueWithPrefix(const char * prefix, KeyValueVisitor & visitor) override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->ForEachKeyValueWithPrefix(prefix, visitor);
+    }
+
 protected:
     DeviceLayer::PersistedStorage::KeyValueStoreManager * mKvsManager = nullptr;
 };
@@ -326,6 +326,20 @@
 #define CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES 5
 #endif // CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES
 
+/**
+ *  @def CHIP_CONFIG_VALIDATED_CERT_LINK_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of CA certificate signature checks (e.g. ICAC signed by RCAC)
+ *    remembered by the FabricTable, so that repeated CASE establishments with
+ *    peers sharing an issuer only verify the NOC signature.  Each entry costs
+ *    36 bytes of RAM.  Set to 0 to disable the cache.
+ *
+ */
+#ifndef CHIP_CONFIG_VALIDATED_CERT_LINK_CACHE_SIZE
+#define CHIP_CONFIG_VALIDATED_CERT_LINK_CACHE_SIZE 8
+#endif // CHIP_CONFIG_VALIDATED_CERT_LINK_CACHE_SIZE
+
 /**
  *  @def CHIP_ERROR_LOGGING
  *
@@ -971,6 +985,15 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES
+ *
+ * @brief Number of devices that can be queued for commissioning in a controller CommissioningScheduler.
+ */
+#ifndef CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES
+#define CHIP_CONFIG_COMMISSIONING_SCHEDULER_MAX_PENDING_DEVICES 64
+#endif
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -1155,6 +1178,19 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE (3 * CHIP_CONFIG_MAX_FABRICS)
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY
+ *
+ * @brief
+ *   Make SimpleSessionResumptionStorage keep the index of the CASE sessions that can be resumed in memory, with a hash
+ *   table over each of its keys, instead of reading it from storage for every lookup. This costs about 40 bytes of RAM per
+ *   entry of CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE, and is worth it for controllers that resume sessions with many
+ *   nodes.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY
+#define CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY 0
+#endif
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
@@ -1298,6 +1334,65 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+ *
+ * @brief Size, in bytes, of the minmdns cache of serialized TXT, A and AAAA
+ *        records, which saves re-generating them (and enumerating interface
+ *        addresses) for every query. Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 1024
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_ENTRIES
+ *
+ * @brief Number of responder and interface pairs whose records the minmdns
+ *        response cache can hold.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_ENTRIES
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_ENTRIES 16
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_ENTRIES
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_OPERATIONAL_INDEX_SIZE
+ *
+ * @brief Number of buckets of the minmdns advertiser index that maps
+ *        operational instance names (peer ids) to their records.
+ *
+ *        Devices advertising many operational identities (e.g. bridges and
+ *        proxies using CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST)
+ *        should size this in the order of the number of identities.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_OPERATIONAL_INDEX_SIZE
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
+#define CHIP_CONFIG_MINMDNS_OPERATIONAL_INDEX_SIZE 64
+#else
+#define CHIP_CONFIG_MINMDNS_OPERATIONAL_INDEX_SIZE 4
+#endif // CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
+#endif // CHIP_CONFIG_MINMDNS_OPERATIONAL_INDEX_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_ANNOUNCEMENT_INTERVAL_MS
+ *
+ * @brief Minimum interval, in milliseconds, between two batches of
+ *        announcements of newly advertised operational records.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_ANNOUNCEMENT_INTERVAL_MS
+#define CHIP_CONFIG_MINMDNS_ANNOUNCEMENT_INTERVAL_MS 100
+#endif // CHIP_CONFIG_MINMDNS_ANNOUNCEMENT_INTERVAL_MS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_ANNOUNCEMENTS_PER_INTERVAL
+ *
+ * @brief Maximum number of operational instances whose records are announced
+ *        in a single batch.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_ANNOUNCEMENTS_PER_INTERVAL
+#define CHIP_CONFIG_MINMDNS_MAX_ANNOUNCEMENTS_PER_INTERVAL 8
+#endif // CHIP_CONFIG_MINMDNS_MAX_ANNOUNCEMENTS_PER_INTERVAL
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1366,6 +1461,92 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_SUBSCRIPTION_RESUMPTION_STORAGE_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS
+ *
+ * @brief Defines the number of persisted subscriptions that can be resumed at the same time
+ *
+ * Resuming a subscription starts with establishing a CASE session with the subscriber. Persisted
+ * subscriptions are resumed in parallel, but a new resumption only starts while fewer than this many
+ * are waiting for their session, so that a device with many subscribers does not flood the network
+ * and the reporting engine after a reboot.
+ */
+#ifndef CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS
+#define CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS 4
+#endif
+
+/**
+ * @def CHIP_CONFIG_REPORT_COALESCING_WINDOW_MS
+ *
+ * @brief Defines how early, in milliseconds, the report scheduler may end the max interval of a subscription, so that
+ *        its empty report is sent together with those of the subscriptions whose max interval ends first.
+ *
+ * The max interval of a subscription only ends early once its min interval elapsed.
+ */
+#ifndef CHIP_CONFIG_REPORT_COALESCING_WINDOW_MS
+#define CHIP_CONFIG_REPORT_COALESCING_WINDOW_MS 500
+#endif
+
+/**
+ * @def CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+ *
+ * @brief Enables sharing the encoded reports of a dirty attribute between the subscriptions that read it with the same
+ *        access, so that the attribute is read and encoded once rather than once per subscription.
+ *
+ *        This only pays off on nodes with many identical subscriptions: the reports of an attribute that another
+ *        subscription also reads are encoded into the cache and then copied, and an access check is made before the
+ *        cache lookup.  The cache takes CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRIES entries of
+ *        CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRY_SIZE bytes of RAM.
+ */
+#ifndef CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE
+#define CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRIES
+ *
+ * @brief Defines the number of dirty attributes whose encoded reports the reporting engine keeps when
+ *        CHIP_CONFIG_ENABLE_REPORT_ENCODING_CACHE is enabled.
+ */
+#ifndef CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRIES
+#define CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRIES 8
+#endif
+
+/**
+ * @def CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRY_SIZE
+ *
+ * @brief Defines the size, in bytes, of the encoded reports of an attribute kept by the reporting engine. The reports
+ *        of larger attributes are encoded for each subscription.
+ */
+#ifndef CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRY_SIZE
+#define CHIP_CONFIG_REPORT_ENCODING_CACHE_ENTRY_SIZE 64
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_PATHS_PER_INVOKE
+ *
+ * @brief Defines the maximum number of commands a command handler accepts in a single invoke request. The
+ *        responses to those commands are correlated with their commands through the references the commands carry.
+ *
+ *        Each command handler keeps the path and reference of every command of the request it handles, so this is
+ *        paid for CHIP_IM_MAX_NUM_COMMAND_HANDLER times. Devices only need to handle one command per request; bridges
+ *        and controllers that expect batched commands can raise it.
+ */
+#ifndef CHIP_CONFIG_MAX_PATHS_PER_INVOKE
+#define CHIP_CONFIG_MAX_PATHS_PER_INVOKE 1
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE
+ *
+ * @brief Defines the number of distinct attributes the data model keeps track of as changed while a write request
+ *        message is applied. Their changes are reported once, after the whole message is applied. Changes to further
+ *        attributes are reported as they are applied.
+ */
+#ifndef CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE
+#define CHIP_CONFIG_MAX_CHANGED_ATTRIBUTES_PER_WRITE 4
+#endif
+
 /**
  * @brief The minimum number of scenes to support according to spec
  */
@@ -1413,6 +1594,46 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_SCENES_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE
+ *
+ * @brief Defines the number of scenes the default scene table keeps decoded in memory
+ *
+ * Scenes found in this cache are recalled without reading and decoding them from persistent storage.
+ * Each entry holds a whole scene table entry, extension field sets included, so it costs roughly
+ * CHIP_CONFIG_SCENES_MAX_CLUSTERS_PER_SCENE * CHIP_CONFIG_SCENES_MAX_EXTENSION_FIELDSET_SIZE_PER_CLUSTER
+ * bytes plus some bookkeeping (about 480 bytes with the defaults on a 64-bit host). The cache is shared
+ * by all the endpoints, so devices recalling scenes on many endpoints at once (e.g. group scenes) trade
+ * RAM for recall latency by raising this up to the number of endpoints with a scene table.
+ *
+ * Set to 0 to disable the cache, in which case every scene is read from persistent storage.
+ */
+#ifndef CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE
+#define CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE 4
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_CONCURRENT_TRANSITIONS
+ *
+ * @brief Defines the number of transitions, such as Level Control or Color Control transitions of an endpoint, that the
+ *        shared TransitionScheduler can step at the same time.
+ *
+ * Transitions beyond that number fall back to a System Layer timer of their own.
+ */
+#ifndef CHIP_CONFIG_MAX_CONCURRENT_TRANSITIONS
+#define CHIP_CONFIG_MAX_CONCURRENT_TRANSITIONS 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_TRANSITION_COALESCING_WINDOW_MS
+ *
+ * @brief Defines how early, in milliseconds, the TransitionScheduler may run a transition step so that it runs in the
+ *        same pass as the step that armed its timer.
+ */
+#ifndef CHIP_CONFIG_TRANSITION_COALESCING_WINDOW_MS
+#define CHIP_CONFIG_TRANSITION_COALESCING_WINDOW_MS 5
+#endif
+
 /**
  * @def CHIP_CONFIG_SKIP_APP_SPECIFIC_GENERATED_HEADER_INCLUDES
  *
@@ -110,6 +110,44 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * Receives the entries enumerated by SyncForEachKeyValueWithPrefix.
+     */
+    class KeyValueVisitor
+    {
+    public:
+        virtual ~KeyValueVisitor() {}
+
+        /**
+         * Called once for each entry.  `key` and `value` are only valid for the duration of the call, and the
+         * storage must not be accessed from within the call.
+         *
+         * @return CHIP_NO_ERROR to continue the enumeration.  Any other value stops the enumeration and is
+         *         returned by SyncForEachKeyValueWithPrefix.
+         */
+        virtual CHIP_ERROR OnKeyValue(const char * key, const void * value, uint16_t size) = 0;
+    };
+
+    /**
+     * @brief
+     *   Enumerate all the entries whose key starts with `prefix`, in a single pass over the storage.
+     *
+     *   This allows restoring a group of related values (for example all the persisted attributes of an
+     *   endpoint) without a separate lookup per key.  Implementations are not required to support it;
+     *   callers must fall back to SyncGetKeyValue when CHIP_ERROR_NOT_IMPLEMENTED is returned.
+     *
+     * @param[in] prefix Prefix of the keys to enumerate.
+     * @param[in] visitor Visitor called for each matching entry, in no particular order.
+     *
+     * @return CHIP_NO_ERROR once all the matching entries were visited, CHIP_ERROR_NOT_IMPLEMENTED if the
+     *         storage cannot enumerate its entries, the error returned by `visitor`, or another CHIP_ERROR
+     *         value from implementation on failure.
+     */
+    virtual CHIP_ERROR SyncForEachKeyValueWithPrefix(const char * prefix, KeyValueVisitor & visitor)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
 };
 
 } // namespace chip
@@ -716,12 +716,108 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
         if (err != CHIP_NO_ERROR)
             return err;
 
+        SkipElementsInBuffer(nestLevel, outerContainerType);
+
         err = ReadElement();
         if (err != CHIP_NO_ERROR)
             return err;
     }
 }
 
+/**
+ * Skip over the elements that lie entirely within the current input buffer, on behalf of SkipToEndOfContainer().
+ *
+ * Only the control byte and length of each element are decoded, which is much cheaper than reading every element with
+ * ReadElement(). Scanning stops before the end of the container being skipped, before any element that ReadElement()
+ * would reject, and before any element that is not entirely within the current buffer: these are left for ReadElement()
+ * to process, so that errors are reported exactly as when reading elements one by one.
+ */
+void TLVReader::SkipElementsInBuffer(uint32_t & nestLevel, TLVType outerContainerType)
+{
+    const uint8_t * p     = mReadPoint;
+    TLVType containerType = mContainerType;
+
+    while (p < mBufEnd)
+    {
+        const uint8_t controlByte      = *p;
+        const TLVElementType elemType  = static_cast<TLVElementType>(controlByte & kTLVTypeMask);
+        const TLVTagControl tagControl = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+
+        if (!IsValidTLVType(elemType))
+            break;
+
+        // Apply the same tag rules as VerifyElement().
+        if (elemType == TLVElementType::EndOfContainer)
+        {
+            if (nestLevel == 0 || tagControl != TLVTagControl::Anonymous)
+                break;
+        }
+        else
+        {
+            if ((tagControl == TLVTagControl::ImplicitProfile_2Bytes || tagControl == TLVTagControl::ImplicitProfile_4Bytes) &&
+                ImplicitProfileId == kProfileIdNotSpecified)
+                break;
+            if (containerType == kTLVType_Structure && tagControl == TLVTagControl::Anonymous)
+                break;
+            if (containerType == kTLVType_Array && tagControl != TLVTagControl::Anonymous)
+                break;
+            if (containerType != kTLVType_Structure && containerType != kTLVType_Array && containerType != kTLVType_List &&
+                containerType != kTLVType_UnknownContainer)
+                break;
+        }
+
+        const TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
+        const uint8_t valOrLenBytes          = TLVFieldSizeToBytes(lenOrValFieldSize);
+        const size_t elemHeadBytes           = 1u + sTagSizes[tagControl >> kTLVTagControlShift] + valOrLenBytes;
+        const size_t bytesAvailable          = static_cast<size_t>(mBufEnd - p);
+        if (elemHeadBytes > bytesAvailable)
+            break;
+
+        uint64_t dataLen = 0;
+        if (TLVTypeHasLength(elemType))
+        {
+            const uint8_t * lenPoint = p + elemHeadBytes - valOrLenBytes;
+            switch (lenOrValFieldSize)
+            {
+            case kTLVFieldSize_1Byte:
+                dataLen = Read8(lenPoint);
+                break;
+            case kTLVFieldSize_2Byte:
+                dataLen = LittleEndian::Read16(lenPoint);
+                break;
+            case kTLVFieldSize_4Byte:
+                dataLen = LittleEndian::Read32(lenPoint);
+                break;
+            case kTLVFieldSize_8Byte:
+                dataLen = LittleEndian::Read64(lenPoint);
+                break;
+            default:
+                break;
+            }
+            if (dataLen > bytesAvailable - elemHeadBytes)
+                break;
+        }
+
+        if (elemType == TLVElementType::EndOfContainer)
+        {
+            nestLevel--;
+            containerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+        }
+        else if (TLVTypeIsContainer(elemType))
+        {
+            nestLevel++;
+            containerType = static_cast<TLVType>(elemType);
+        }
+
+        p += elemHeadBytes + dataLen;
+    }
+
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+
+    mReadPoint     = p;
+    mContainerType = containerType;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
@@ -956,9 +1052,6 @@ CHIP_ERROR TLVReader::EnsureData(CHIP_ERROR noDataErr)
     return CHIP_NO_ERROR;
 }
 
-/**
- * This is a private method used to compute the length of a TLV element head.
- */
 CHIP_ERROR TLVReader::GetElementHeadLength(uint8_t & elemHeadBytes) const
 {
     uint8_t tagBytes;
@@ -871,6 +871,18 @@ public:
      */
     const uint8_t * GetReadPoint() const { return mReadPoint; }
 
+    /**
+     * Gets the length of the head of the current element: its control byte, its tag and its length field, or
+     * its value for elements that have no length.
+     *
+     * @note Until the value of the current element is read, the element starts elemHeadBytes bytes before
+     * the pointer returned by GetReadPoint(), provided its head was not split across input buffers.
+     *
+     * @retval #CHIP_NO_ERROR                   If the reader is positioned on an element.
+     * @retval #CHIP_ERROR_INVALID_TLV_ELEMENT  If the reader is not positioned on an element.
+     */
+    CHIP_ERROR GetElementHeadLength(uint8_t & elemHeadBytes) const;
+
     /**
      * Advances the TLVReader object to immediately after the current TLV element.
      *
@@ -957,11 +969,11 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+    void SkipElementsInBuffer(uint32_t & nestLevel, TLVType outerContainerType);
     CHIP_ERROR VerifyElement();
     Tag ReadTag(TLVTagControl tagControl, const uint8_t *& p) const;
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
     CHIP_ERROR ReadData(uint8_t * buf, uint32_t len);
-    CHIP_ERROR GetElementHeadLength(uint8_t & elemHeadBytes) const;
     TLVElementType ElementType() const;
 };
 
@@ -42,8 +42,10 @@
 #include <lib/support/UnitTestUtils.h>
 #include <lib/support/logging/Constants.h>
 
+#include <system/SystemClock.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
 
@@ -2981,6 +2983,223 @@ void CheckTLVSkipCircular(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+/**
+ * Backing store that hands out an encoding a few bytes at a time, so that elements straddle buffers.
+ */
+class ChunkedBackingStore : public TLVBackingStore
+{
+public:
+    ChunkedBackingStore(const uint8_t * data, uint32_t dataLen, uint32_t chunkLen) :
+        mData(data), mDataLen(dataLen), mChunkLen(chunkLen)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        mOffset = 0;
+        return GetNextBuffer(reader, bufStart, bufLen);
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mData + mOffset;
+        bufLen   = std::min(mChunkLen, mDataLen - mOffset);
+        mOffset += bufLen;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mData;
+    uint32_t mDataLen;
+    uint32_t mChunkLen;
+    uint32_t mOffset = 0;
+};
+
+/**
+ * Writes a structure resembling an attribute report: a list of attribute data entries, each holding a list of
+ * structures with nested containers, strings and integers.
+ */
+void WriteNestedReport(nlTestSuite * inSuite, TLVWriter & writer, size_t numAttributes, size_t numEntries)
+{
+    TLVType outer, reports, report, data, entry, inner;
+
+    writer.ImplicitProfileId = TestProfile_1;
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(AnonymousTag(), kTLVType_Structure, outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(ContextTag(1), kTLVType_Array, reports));
+    for (size_t i = 0; i < numAttributes; i++)
+    {
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(AnonymousTag(), kTLVType_Structure, report));
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ContextTag(0), static_cast<uint32_t>(i)));
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(ContextTag(2), kTLVType_Array, data));
+        for (size_t j = 0; j < numEntries; j++)
+        {
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(AnonymousTag(), kTLVType_Structure, entry));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ContextTag(0), static_cast<uint64_t>(j) << 40));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.PutString(ContextTag(1), "a label of moderate length"));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.StartContainer(ContextTag(2), kTLVType_List, inner));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ContextTag(0), true));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.PutNull(AnonymousTag()));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ProfileTag(TestProfile_1, 2), static_cast<int16_t>(-1)));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(inner));
+            NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(entry));
+        }
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(data));
+        NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(report));
+    }
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(reports));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.Put(ContextTag(2), static_cast<uint8_t>(42)));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.EndContainer(outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, writer.Finalize());
+}
+
+/**
+ * Skips the attribute data of every report written by WriteNestedReport, checking the elements around it.
+ */
+void SkipNestedReport(nlTestSuite * inSuite, TLVReader & reader, size_t numAttributes)
+{
+    TLVType outer, reports, report;
+
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(kTLVType_Structure, AnonymousTag()));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(kTLVType_Array, ContextTag(1)));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(reports));
+    for (size_t i = 0; i < numAttributes; i++)
+    {
+        uint32_t value = 0;
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(kTLVType_Structure, AnonymousTag()));
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(report));
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(ContextTag(0)));
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Get(value));
+        NL_TEST_ASSERT(inSuite, value == i);
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(kTLVType_Array, ContextTag(2)));
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Skip());
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.ExitContainer(report));
+    }
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.ExitContainer(reports));
+
+    uint8_t value = 0;
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next(ContextTag(2)));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Get(value));
+    NL_TEST_ASSERT(inSuite, value == 42);
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.ExitContainer(outer));
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+}
+
+void CheckTLVSkipNestedContainers(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kNumAttributes = 4;
+    constexpr size_t kNumEntries    = 5;
+    uint8_t buf[2048];
+    TLVWriter writer;
+    TLVReader reader;
+
+    writer.Init(buf);
+    WriteNestedReport(inSuite, writer, kNumAttributes, kNumEntries);
+    const uint32_t encodingLen = writer.GetLengthWritten();
+
+    reader.Init(buf, encodingLen);
+    reader.ImplicitProfileId = TestProfile_1;
+    SkipNestedReport(inSuite, reader, kNumAttributes);
+
+    // Elements straddling buffers are skipped the same way, whatever the buffer boundaries.
+    for (uint32_t chunkLen = 1; chunkLen < 24; chunkLen++)
+    {
+        ChunkedBackingStore backingStore(buf, encodingLen, chunkLen);
+        NL_TEST_ASSERT_SUCCESS(inSuite, reader.Init(backingStore, encodingLen));
+        reader.ImplicitProfileId = TestProfile_1;
+        SkipNestedReport(inSuite, reader, kNumAttributes);
+    }
+
+    // Without the implicit profile, the tag within the skipped containers cannot be decoded.
+    reader.Init(buf, encodingLen);
+    TLVType outer, reports, report;
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(reports));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(report));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_ERROR_UNKNOWN_IMPLICIT_TLV_TAG);
+}
+
+void CheckTLVSkipMalformedContainers(nlTestSuite * inSuite, void * inContext)
+{
+    // Structure holding an array holding an anonymous element, then a context tagged one.
+    const uint8_t badArrayTag[] = { 0x15, 0x36, 0x01, 0x04, 0x01, 0x24, 0x02, 0x02, 0x18, 0x18 };
+    // Structure holding a string longer than the encoding.
+    const uint8_t badLength[] = { 0x15, 0x35, 0x01, 0x2C, 0x02, 0x20, 0x61, 0x62, 0x18, 0x18 };
+    // Structure holding an element of invalid type.
+    const uint8_t badType[] = { 0x15, 0x35, 0x01, 0x3F, 0x18, 0x18 };
+    // Structure holding an end of container with a tag.
+    const uint8_t badEndTag[] = { 0x15, 0x35, 0x01, 0x24, 0x02, 0x02, 0x38, 0x01, 0x18 };
+
+    TLVReader reader;
+    TLVType outer;
+
+    reader.Init(badArrayTag);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.EnterContainer(outer));
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_ERROR_INVALID_TLV_TAG);
+
+    reader.Init(badLength);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_ERROR_TLV_UNDERRUN);
+
+    reader.Init(badType);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+    reader.Init(badEndTag);
+    NL_TEST_ASSERT_SUCCESS(inSuite, reader.Next());
+    NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_ERROR_INVALID_TLV_TAG);
+}
+
+/**
+ * Measures how long skipping the attribute data of a large report takes.
+ */
+void CheckTLVSkipBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kNumAttributes = 16;
+    constexpr size_t kNumEntries    = 32;
+    constexpr size_t kIterations    = 200;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> buf;
+    NL_TEST_ASSERT(inSuite, buf.Calloc(64 * 1024));
+    TLVWriter writer;
+    TLVReader reader;
+
+    writer.Init(buf.Get(), 64 * 1024);
+    WriteNestedReport(inSuite, writer, kNumAttributes, kNumEntries);
+    const uint32_t encodingLen = writer.GetLengthWritten();
+
+    const uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        reader.Init(buf.Get(), encodingLen);
+        reader.ImplicitProfileId = TestProfile_1;
+        SkipNestedReport(inSuite, reader, kNumAttributes);
+    }
+    const uint64_t elapsed = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    ChipLogProgress(Support, "Skipped %u bytes of nested containers %u times in %u us", static_cast<unsigned>(encodingLen),
+                    static_cast<unsigned>(kIterations), static_cast<unsigned>(elapsed));
+}
+
 /**
  *  Test Buffer Overflow
  */
@@ -4620,6 +4839,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV String Span",                CheckTLVPutStringSpan),
     NL_TEST_DEF("CHIP TLV Printf, Circular TLV buf",   CheckTLVPutStringFCircular),
     NL_TEST_DEF("CHIP TLV Skip non-contiguous",        CheckTLVSkipCircular),
+    NL_TEST_DEF("CHIP TLV Skip nested containers",     CheckTLVSkipNestedContainers),
+    NL_TEST_DEF("CHIP TLV Skip malformed containers",  CheckTLVSkipMalformedContainers),
+    NL_TEST_DEF("CHIP TLV Skip benchmark",             CheckTLVSkipBenchmark),
     NL_TEST_DEF("CHIP TLV ByteSpan",                   CheckTLVByteSpan),
     NL_TEST_DEF("CHIP TLV CharSpan",                   CheckTLVCharSpan),
     NL_TEST_DEF("CHIP TLV Get LocalizedStringIdentifier", CheckTLVGetLocalizedStringIdentifier),
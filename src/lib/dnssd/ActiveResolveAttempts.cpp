@@ -277,5 +277,18 @@ bool ActiveResolveAttempts::IsWaitingForIpResolutionFor(SerializedQNameIterator
     return false;
 }
 
+bool ActiveResolveAttempts::IsWaitingForIpResolution() const
+{
+    for (auto & entry : mRetryQueue)
+    {
+        if (!entry.attempt.IsEmpty() && entry.attempt.IsIpResolve())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 } // namespace Minimal
 } // namespace mdns
@@ -289,6 +289,10 @@ public:
     /// IP resolution.
     bool IsWaitingForIpResolutionFor(SerializedQNameIterator hostName) const;
 
+    /// Check if any of the pending queries is for IP resolution, whose
+    /// replies name hosts rather than services.
+    bool IsWaitingForIpResolution() const;
+
 private:
     struct RetryEntry
     {
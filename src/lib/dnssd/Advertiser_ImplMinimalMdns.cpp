@@ -19,6 +19,7 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "MinimalMdnsServer.h"
 #include "ServiceNaming.h"
@@ -26,6 +27,7 @@
 #include <crypto/RandUtils.h>
 #include <lib/dnssd/Advertiser_ImplMinimalMdnsAllocator.h>
 #include <lib/dnssd/minimal_mdns/AddressPolicy.h>
+#include <lib/dnssd/minimal_mdns/PacketPrefilter.h>
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 #include <lib/dnssd/minimal_mdns/Server.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
@@ -36,8 +38,11 @@
 #include <lib/dnssd/minimal_mdns/responders/Txt.h>
 #include <lib/support/BytesToHex.h>
 #include <lib/support/CHIPMem.h>
+#include <lib/support/CHIPMemString.h>
 #include <lib/support/IntrusiveList.h>
 #include <lib/support/StringBuilder.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
 
 // Enable detailed mDNS logging for received queries
 #undef DETAIL_LOGGING
@@ -104,6 +109,16 @@ void LogQuery(const QueryData & data) {}
 // Max number of records for operational = PTR, SRV, TXT, A, AAAA, I subtype.
 constexpr size_t kMaxOperationalRecords = 6;
 
+// "_matter._tcp.local", shared by the records of all operational advertisements.
+const QNamePart kOperationalServiceQNameParts[] = { kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+
+// First label of "_services._dns-sd._udp.local", the DNS-SD service enumeration query.
+constexpr char kDnsSdServicesLabel[] = "_services";
+
+// Number of distinct host names the query prefilter can match; advertisements
+// normally share a single host name.
+constexpr size_t kMaxPrefilterHostNames = 2;
+
 /// Represents an allocated operational responder.
 ///
 /// Wraps a QueryResponderAllocator.
@@ -123,6 +138,29 @@ public:
     Allocator * GetAllocator() { return mAllocator; }
     const Allocator * GetAllocator() const { return mAllocator; }
 
+    /// Peer id (and thus instance name) this allocator advertises.
+    const PeerId & GetPeerId() const { return mPeerId; }
+    void SetPeerId(const PeerId & peerId) { mPeerId = peerId; }
+
+    /// Instance name of the advertised records. Empty until the records are added.
+    const FullQName & GetInstanceName() const { return mInstanceName; }
+    void SetInstanceName(const FullQName & instanceName) { mInstanceName = instanceName; }
+
+    /// Free the advertised records, keeping the allocator for new ones.
+    void ClearRecords()
+    {
+        mAllocator->Clear();
+        mInstanceName = FullQName();
+    }
+
+    /// Whether the records still need to be announced.
+    bool IsAnnouncementPending() const { return mAnnouncementPending; }
+    void SetAnnouncementPending(bool pending) { mAnnouncementPending = pending; }
+
+    /// Next allocator within the same OperationalAllocatorIndex bucket.
+    OperationalQueryAllocator * GetNextInBucket() const { return mNextInBucket; }
+    void SetNextInBucket(OperationalQueryAllocator * next) { mNextInBucket = next; }
+
     /// Allocate a new entry for this type.
     ///
     /// May return null on allocation failures.
@@ -147,6 +185,59 @@ public:
 
 private:
     Allocator * mAllocator = nullptr;
+    PeerId mPeerId;
+    FullQName mInstanceName;
+    OperationalQueryAllocator * mNextInBucket = nullptr;
+    bool mAnnouncementPending                 = false;
+};
+
+/// Hash index of operational allocators by peer id.
+///
+/// Operational instance names are derived from the peer id, so this finds the
+/// records of an instance without comparing names against every allocator,
+/// which matters when advertising many operational identities.
+class OperationalAllocatorIndex
+{
+public:
+    OperationalQueryAllocator * Find(const PeerId & peerId) const
+    {
+        for (OperationalQueryAllocator * it = mBuckets[BucketFor(peerId)]; it != nullptr; it = it->GetNextInBucket())
+        {
+            if (it->GetPeerId() == peerId)
+            {
+                return it;
+            }
+        }
+        return nullptr;
+    }
+
+    void Insert(OperationalQueryAllocator * allocator)
+    {
+        OperationalQueryAllocator *& bucket = mBuckets[BucketFor(allocator->GetPeerId())];
+        allocator->SetNextInBucket(bucket);
+        bucket = allocator;
+    }
+
+    void Clear()
+    {
+        for (auto & bucket : mBuckets)
+        {
+            bucket = nullptr;
+        }
+    }
+
+private:
+    static constexpr size_t kBucketCount = CHIP_CONFIG_MINMDNS_OPERATIONAL_INDEX_SIZE;
+    static_assert(kBucketCount > 0, "The operational index needs at least one bucket");
+
+    static size_t BucketFor(const PeerId & peerId)
+    {
+        uint64_t hash = (peerId.GetCompressedFabricId() * 0x9E3779B97F4A7C15ull) ^ peerId.GetNodeId();
+        hash ^= hash >> 32;
+        return static_cast<size_t>(hash % kBucketCount);
+    }
+
+    OperationalQueryAllocator * mBuckets[kBucketCount] = {};
 };
 
 enum BroadcastAdvertiseType
@@ -163,6 +254,7 @@ public:
     AdvertiserMinMdns() : mResponseSender(&GlobalMinimalMdnsServer::Server())
     {
         GlobalMinimalMdnsServer::Instance().SetQueryDelegate(this);
+        ResetQueryPrefilter();
 
         CHIP_ERROR err = mResponseSender.AddQueryResponder(mQueryResponderAllocatorCommissionable.GetQueryResponder());
 
@@ -206,6 +298,31 @@ private:
     /// removes all records by advertising a 0 TTL)
     void AdvertiseRecords(BroadcastAdvertiseType type);
 
+    /// Advertise the records of the given query responders only, such as the
+    /// records that were just added.
+    void AdvertiseRecords(BroadcastAdvertiseType type, Span<QueryResponderBase * const> responders);
+
+    /// Calls `sendFunction(packetInfo)` for every interface and address the
+    /// records are to be advertised on.
+    template <typename SendFunction>
+    void ForEachAdvertisingSource(SendFunction && sendFunction);
+
+    /// Queue the records of `allocator` for announcement. Announcements are
+    /// sent in batches of at most CHIP_CONFIG_MINMDNS_MAX_ANNOUNCEMENTS_PER_INTERVAL
+    /// instances, at most every CHIP_CONFIG_MINMDNS_ANNOUNCEMENT_INTERVAL_MS,
+    /// so that advertising many instances does not flood the network.
+    void ScheduleAnnouncement(OperationalQueryAllocator * allocator);
+    void ScheduleAnnouncementTimer();
+    void CancelAnnouncements();
+    static void OnAnnouncementTimer(System::Layer * layer, void * context);
+
+    /// Announce the next batch of pending records. Returns whether more records remain pending.
+    bool AnnounceNextBatch();
+
+    /// Find the operational allocator owning the records of the queried name,
+    /// if it is the instance name of an operational advertisement.
+    OperationalQueryAllocator * FindOperationalAllocator(SerializedQNameIterator name);
+
     /// Determine if advertisement on the specified interface/address is ok given the
     /// interfaces on which the mDNS server is listening
     bool ShouldAdvertiseOn(const chip::Inet::InterfaceId id, const chip::Inet::IPAddress & addr);
@@ -275,22 +392,38 @@ private:
     }
 
     IntrusiveList<OperationalQueryAllocator> mOperationalResponders;
+    OperationalAllocatorIndex mOperationalIndex;
 
     // Max number of records for commissionable = 7 x PTR (base + 6 sub types - _S, _L, _D, _T, _C, _A), SRV, TXT, A, AAAA
     static constexpr size_t kMaxCommissionRecords = 11;
     QueryResponderAllocator<kMaxCommissionRecords> mQueryResponderAllocatorCommissionable;
     QueryResponderAllocator<kMaxCommissionRecords> mQueryResponderAllocatorCommissioner;
 
-    OperationalQueryAllocator::Allocator * FindOperationalAllocator(const FullQName & qname);
-    OperationalQueryAllocator::Allocator * FindEmptyOperationalAllocator();
+    OperationalQueryAllocator * NewOperationalAllocator(const PeerId & peerId);
 
     void ClearServices();
 
+    /// Set up the query prefilter to accept the queries any advertisement may reply to.
+    void ResetQueryPrefilter();
+
+    /// Have the query prefilter accept queries about the given host name.
+    void AddPrefilterHostName(const char * hostName);
+
     ResponseSender mResponseSender;
     uint8_t mCommissionableInstanceName[sizeof(uint64_t)];
 
     bool mIsInitialized = false;
 
+    // announcements of operational records
+    System::Layer * mSystemLayer                    = nullptr;
+    System::Clock::Timestamp mLastAnnouncementTime = System::Clock::kZero;
+    bool mAnnouncementScheduled                     = false;
+
+    // drops the queries no advertisement can reply to without parsing them
+    PacketPrefilter mQueryPrefilter;
+    char mPrefilterHostNames[kMaxPrefilterHostNames][kHostNameMaxLength + 1];
+    size_t mPrefilterHostNameCount = 0;
+
     // current request handling
     const chip::Inet::IPPacketInfo * mCurrentSource = nullptr;
     uint16_t mMessageId                             = 0;
@@ -308,6 +441,9 @@ void AdvertiserMinMdns::OnMdnsPacketData(const BytesRange & data, const chip::In
     ChipLogDetail(Discovery, "Received an mDNS query from %s", srcAddressString);
 #endif
 
+    // Most mDNS traffic is about other services: skip parsing it.
+    VerifyOrReturn(mQueryPrefilter.Accept(data));
+
     mCurrentSource = info;
     if (!ParsePacket(data, this))
     {
@@ -327,7 +463,21 @@ void AdvertiserMinMdns::OnQuery(const QueryData & data)
     LogQuery(data);
 
     const ResponseConfiguration defaultResponseConfiguration;
-    CHIP_ERROR err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration);
+    CHIP_ERROR err;
+
+    OperationalQueryAllocator * operationalAllocator = FindOperationalAllocator(data.GetName());
+    if (operationalAllocator != nullptr)
+    {
+        // Only the responder of an operational instance has records named after it: skip all the others.
+        QueryResponderBase * responders[] = { operationalAllocator->GetAllocator()->GetQueryResponder() };
+
+        err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration,
+                                      Span<QueryResponderBase * const>(responders));
+    }
+    else
+    {
+        err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration);
+    }
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Discovery, "Failed to reply to query: %" CHIP_ERROR_FORMAT, err.Format());
@@ -347,9 +497,13 @@ CHIP_ERROR AdvertiserMinMdns::Init(chip::Inet::EndPointManager<chip::Inet::UDPEn
         UpdateCommissionableInstanceName();
     }
 
+    mSystemLayer = &udpEndPointManager->SystemLayer();
+
     // Re-set the server in the response sender in case this has been swapped in the
     // GlobalMinimalMdnsServer (used for testing).
     mResponseSender.SetServer(&GlobalMinimalMdnsServer::Server());
+    // The interfaces and their addresses may have changed since the records were cached.
+    mResponseSender.InvalidateResponseCache();
 
     ReturnErrorOnFailure(GlobalMinimalMdnsServer::Instance().StartServer(udpEndPointManager, kMdnsPort));
 
@@ -366,6 +520,7 @@ void AdvertiserMinMdns::Shutdown()
 {
     VerifyOrReturn(mIsInitialized);
 
+    CancelAnnouncements();
     AdvertiseRecords(BroadcastAdvertiseType::kRemovingAll);
 
     GlobalMinimalMdnsServer::Server().Shutdown();
@@ -380,6 +535,7 @@ CHIP_ERROR AdvertiserMinMdns::RemoveServices()
     // This allows mDNS clients to remove stale cached records which may not be re-added with
     // subsequent Advertise() calls. In the case the same records are re-added, this extra
     // is not harmful though suboptimal, so this is a subject to improvement in the future.
+    CancelAnnouncements();
     AdvertiseRecords(BroadcastAdvertiseType::kRemovingAll);
     ClearServices();
 
@@ -409,25 +565,60 @@ void AdvertiserMinMdns::ClearServices()
         // Finally release the memory
         chip::Platform::Delete(ptr);
     }
+    mOperationalIndex.Clear();
 
     mQueryResponderAllocatorCommissionable.Clear();
     mQueryResponderAllocatorCommissioner.Clear();
+    mResponseSender.InvalidateResponseCache();
+    ResetQueryPrefilter();
 }
 
-OperationalQueryAllocator::Allocator * AdvertiserMinMdns::FindOperationalAllocator(const FullQName & qname)
+void AdvertiserMinMdns::ResetQueryPrefilter()
 {
-    for (auto & it : mOperationalResponders)
+    mQueryPrefilter.Clear();
+    mPrefilterHostNameCount = 0;
+
+    // Every other name advertised, including instance names and subtypes, ends with one of the service labels.
+    mQueryPrefilter.AddLabel(kOperationalServiceName);
+    mQueryPrefilter.AddLabel(kCommissionableServiceName);
+    mQueryPrefilter.AddLabel(kCommissionerServiceName);
+    mQueryPrefilter.AddLabel(kDnsSdServicesLabel);
+}
+
+void AdvertiserMinMdns::AddPrefilterHostName(const char * hostName)
+{
+    for (size_t i = 0; i < mPrefilterHostNameCount; i++)
     {
-        if (it.GetAllocator()->GetResponder(QType::SRV, qname) != nullptr)
-        {
-            return it.GetAllocator();
-        }
+        VerifyOrReturn(strcmp(mPrefilterHostNames[i], hostName) != 0);
+    }
+
+    if (mPrefilterHostNameCount == kMaxPrefilterHostNames)
+    {
+        mQueryPrefilter.AcceptAll();
+        return;
     }
 
-    return nullptr;
+    Platform::CopyString(mPrefilterHostNames[mPrefilterHostNameCount], hostName);
+    mQueryPrefilter.AddLabel(mPrefilterHostNames[mPrefilterHostNameCount++]);
 }
 
-OperationalQueryAllocator::Allocator * AdvertiserMinMdns::FindEmptyOperationalAllocator()
+OperationalQueryAllocator * AdvertiserMinMdns::FindOperationalAllocator(SerializedQNameIterator name)
+{
+    SerializedQNameIterator instanceName = name;
+    VerifyOrReturnValue(instanceName.Next(), nullptr);
+
+    PeerId peerId;
+    VerifyOrReturnValue(ExtractIdFromInstanceName(instanceName.Value(), &peerId) == CHIP_NO_ERROR, nullptr);
+
+    OperationalQueryAllocator * allocator = mOperationalIndex.Find(peerId);
+    VerifyOrReturnValue(allocator != nullptr && allocator->GetInstanceName().nameCount != 0, nullptr);
+
+    // The first label matches, but the name may still be in another domain or service.
+    VerifyOrReturnValue(name == allocator->GetInstanceName(), nullptr);
+    return allocator;
+}
+
+OperationalQueryAllocator * AdvertiserMinMdns::NewOperationalAllocator(const PeerId & peerId)
 {
     OperationalQueryAllocator * result = OperationalQueryAllocator::New();
 
@@ -445,8 +636,10 @@ OperationalQueryAllocator::Allocator * AdvertiserMinMdns::FindEmptyOperationalAl
         return nullptr;
     }
 
+    result->SetPeerId(peerId);
     mOperationalResponders.PushBack(result);
-    return result->GetAllocator();
+    mOperationalIndex.Insert(result);
+    return result;
 }
 
 CHIP_ERROR AdvertiserMinMdns::Advertise(const OperationalAdvertisingParameters & params)
@@ -458,31 +651,32 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const OperationalAdvertisingParameters &
     // need to set server name
     ReturnErrorOnFailure(MakeInstanceName(nameBuffer, sizeof(nameBuffer), params.GetPeerId()));
 
-    QNamePart nameCheckParts[]  = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
-    FullQName nameCheck         = FullQName(nameCheckParts);
-    auto * operationalAllocator = FindOperationalAllocator(nameCheck);
-    if (operationalAllocator != nullptr)
+    OperationalQueryAllocator * operationalInstance = mOperationalIndex.Find(params.GetPeerId());
+    if (operationalInstance != nullptr)
     {
-        operationalAllocator->Clear();
+        operationalInstance->ClearRecords();
+        mResponseSender.InvalidateResponseCache();
     }
     else
     {
-        operationalAllocator = FindEmptyOperationalAllocator();
-        if (operationalAllocator == nullptr)
+        operationalInstance = NewOperationalAllocator(params.GetPeerId());
+        if (operationalInstance == nullptr)
         {
             ChipLogError(Discovery, "Failed to find an open operational allocator");
             return CHIP_ERROR_NO_MEMORY;
         }
     }
+    auto * operationalAllocator = operationalInstance->GetAllocator();
 
-    FullQName serviceName = operationalAllocator->AllocateQName(kOperationalServiceName, kOperationalProtocol, kLocalDomain);
+    FullQName serviceName = FullQName(kOperationalServiceQNameParts);
     FullQName instanceName =
         operationalAllocator->AllocateQName(nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain);
 
     ReturnErrorOnFailure(MakeHostName(nameBuffer, sizeof(nameBuffer), params.GetMac()));
     FullQName hostName = operationalAllocator->AllocateQName(nameBuffer, kLocalDomain);
+    AddPrefilterHostName(nameBuffer);
 
-    if ((serviceName.nameCount == 0) || (instanceName.nameCount == 0) || (hostName.nameCount == 0))
+    if ((instanceName.nameCount == 0) || (hostName.nameCount == 0))
     {
         ChipLogError(Discovery, "Failed to allocate QNames.");
         return CHIP_ERROR_NO_MEMORY;
@@ -544,9 +738,11 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const OperationalAdvertisingParameters &
         return CHIP_ERROR_NO_MEMORY;
     }
 
+    operationalInstance->SetInstanceName(instanceName);
+
     ChipLogProgress(Discovery, "CHIP minimal mDNS configured as 'Operational device'; instance name: %s.", instanceName.names[0]);
 
-    AdvertiseRecords(BroadcastAdvertiseType::kStarted);
+    ScheduleAnnouncement(operationalInstance);
 
     ChipLogProgress(Discovery, "mDNS service published: %s.%s", StringOrNullMarker(instanceName.names[1]),
                     StringOrNullMarker(instanceName.names[2]));
@@ -557,6 +753,7 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const OperationalAdvertisingParameters &
 CHIP_ERROR AdvertiserMinMdns::FinalizeServiceUpdate()
 {
     VerifyOrReturnError(mIsInitialized, CHIP_ERROR_INCORRECT_STATE);
+    mResponseSender.InvalidateResponseCache();
     return CHIP_NO_ERROR;
 }
 
@@ -591,6 +788,7 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const CommissionAdvertisingParameters &
     {
         mQueryResponderAllocatorCommissioner.Clear();
     }
+    mResponseSender.InvalidateResponseCache();
 
     // TODO: need to detect colisions here
     char nameBuffer[64] = "";
@@ -608,6 +806,7 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const CommissionAdvertisingParameters &
 
     ReturnErrorOnFailure(MakeHostName(nameBuffer, sizeof(nameBuffer), params.GetMac()));
     FullQName hostName = allocator->AllocateQName(nameBuffer, kLocalDomain);
+    AddPrefilterHostName(nameBuffer);
 
     if ((serviceName.nameCount == 0) || (instanceName.nameCount == 0) || (hostName.nameCount == 0))
     {
@@ -754,7 +953,8 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const CommissionAdvertisingParameters &
                         StringOrNullMarker(instanceName.names[0]));
     }
 
-    AdvertiseRecords(BroadcastAdvertiseType::kStarted);
+    QueryResponderBase * responders[] = { allocator->GetQueryResponder() };
+    AdvertiseRecords(BroadcastAdvertiseType::kStarted, Span<QueryResponderBase * const>(responders));
 
     ChipLogProgress(Discovery, "mDNS service published: %s.%s", StringOrNullMarker(instanceName.names[1]),
                     StringOrNullMarker(instanceName.names[2]));
@@ -885,15 +1085,9 @@ bool AdvertiserMinMdns::ShouldAdvertiseOn(const chip::Inet::InterfaceId id, cons
     return result;
 }
 
-void AdvertiserMinMdns::AdvertiseRecords(BroadcastAdvertiseType type)
+template <typename SendFunction>
+void AdvertiserMinMdns::ForEachAdvertisingSource(SendFunction && sendFunction)
 {
-    ResponseConfiguration responseConfiguration;
-    if (type == BroadcastAdvertiseType::kRemovingAll)
-    {
-        // make a "remove all records now" broadcast
-        responseConfiguration.SetTtlSecondsOverride(0);
-    }
-
     UniquePtr<ListenIterator> allInterfaces = GetAddressPolicy()->GetListenEndpoints();
     VerifyOrDieWithMsg(allInterfaces != nullptr, Discovery, "Failed to allocate memory for endpoints.");
 
@@ -929,38 +1123,52 @@ void AdvertiserMinMdns::AdvertiseRecords(BroadcastAdvertiseType type)
             packetInfo.DestPort  = kMdnsPort;
             packetInfo.Interface = interfaceId;
 
-            // Advertise all records
-            //
-            // TODO: Consider advertising delta changes.
-            //
-            // Current advertisement does not have a concept of "delta" to only
-            // advertise changes. Current implementation is to always
-            //    1. advertise TTL=0 (clear all caches)
-            //    2. advertise available records (with longer TTL)
-            //
-            // It would be nice if we could selectively advertise what changes, like
-            // send TTL=0 for anything removed/about to be removed (and only those),
-            // then only advertise new items added.
-            //
-            // This optimization likely will take more logic and state storage, so
-            // for now it is not done.
-            QueryData queryData(QType::PTR, QClass::IN, false /* unicast */);
-            queryData.SetIsInternalBroadcast(true);
-
-            for (auto & it : mOperationalResponders)
-            {
-                it.GetAllocator()->GetQueryResponder()->ClearBroadcastThrottle();
-            }
-            mQueryResponderAllocatorCommissionable.GetQueryResponder()->ClearBroadcastThrottle();
-            mQueryResponderAllocatorCommissioner.GetQueryResponder()->ClearBroadcastThrottle();
-
-            CHIP_ERROR err = mResponseSender.Respond(0, queryData, &packetInfo, responseConfiguration);
-            if (err != CHIP_NO_ERROR)
-            {
-                ChipLogError(Discovery, "Failed to advertise records: %" CHIP_ERROR_FORMAT, err.Format());
-            }
+            sendFunction(packetInfo);
         }
     }
+}
+
+void AdvertiserMinMdns::AdvertiseRecords(BroadcastAdvertiseType type)
+{
+    ResponseConfiguration responseConfiguration;
+    if (type == BroadcastAdvertiseType::kRemovingAll)
+    {
+        // make a "remove all records now" broadcast
+        responseConfiguration.SetTtlSecondsOverride(0);
+    }
+
+    ForEachAdvertisingSource([&](const chip::Inet::IPPacketInfo & packetInfo) {
+        // Advertise all records
+        //
+        // TODO: Consider advertising delta changes.
+        //
+        // Current advertisement does not have a concept of "delta" to only
+        // advertise changes. Current implementation is to always
+        //    1. advertise TTL=0 (clear all caches)
+        //    2. advertise available records (with longer TTL)
+        //
+        // It would be nice if we could selectively advertise what changes, like
+        // send TTL=0 for anything removed/about to be removed (and only those),
+        // then only advertise new items added.
+        //
+        // This optimization likely will take more logic and state storage, so
+        // for now it is not done.
+        QueryData queryData(QType::PTR, QClass::IN, false /* unicast */);
+        queryData.SetIsInternalBroadcast(true);
+
+        for (auto & it : mOperationalResponders)
+        {
+            it.GetAllocator()->GetQueryResponder()->ClearBroadcastThrottle();
+        }
+        mQueryResponderAllocatorCommissionable.GetQueryResponder()->ClearBroadcastThrottle();
+        mQueryResponderAllocatorCommissioner.GetQueryResponder()->ClearBroadcastThrottle();
+
+        CHIP_ERROR err = mResponseSender.Respond(0, queryData, &packetInfo, responseConfiguration);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Discovery, "Failed to advertise records: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    });
 
     // Once all automatic broadcasts are done, allow immediate replies once.
     for (auto & it : mOperationalResponders)
@@ -971,6 +1179,118 @@ void AdvertiserMinMdns::AdvertiseRecords(BroadcastAdvertiseType type)
     mQueryResponderAllocatorCommissioner.GetQueryResponder()->ClearBroadcastThrottle();
 }
 
+void AdvertiserMinMdns::AdvertiseRecords(BroadcastAdvertiseType type, Span<QueryResponderBase * const> responders)
+{
+    ResponseConfiguration responseConfiguration;
+    if (type == BroadcastAdvertiseType::kRemovingAll)
+    {
+        responseConfiguration.SetTtlSecondsOverride(0);
+    }
+
+    ForEachAdvertisingSource([&](const chip::Inet::IPPacketInfo & packetInfo) {
+        QueryData queryData(QType::PTR, QClass::IN, false /* unicast */);
+        queryData.SetIsInternalBroadcast(true);
+
+        for (auto * responder : responders)
+        {
+            responder->ClearBroadcastThrottle();
+        }
+
+        CHIP_ERROR err = mResponseSender.Respond(0, queryData, &packetInfo, responseConfiguration, responders);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Discovery, "Failed to advertise records: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    });
+
+    for (auto * responder : responders)
+    {
+        responder->ClearBroadcastThrottle();
+    }
+}
+
+void AdvertiserMinMdns::ScheduleAnnouncement(OperationalQueryAllocator * allocator)
+{
+    allocator->SetAnnouncementPending(true);
+    ScheduleAnnouncementTimer();
+}
+
+void AdvertiserMinMdns::ScheduleAnnouncementTimer()
+{
+    VerifyOrReturn(!mAnnouncementScheduled);
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timestamp next =
+        mLastAnnouncementTime + System::Clock::Milliseconds32(CHIP_CONFIG_MINMDNS_ANNOUNCEMENT_INTERVAL_MS);
+    const System::Clock::Timeout delay =
+        (next > now) ? std::chrono::duration_cast<System::Clock::Timeout>(next - now) : System::Clock::kZero;
+
+    if ((mSystemLayer != nullptr) && (mSystemLayer->StartTimer(delay, OnAnnouncementTimer, this) == CHIP_NO_ERROR))
+    {
+        mAnnouncementScheduled = true;
+        return;
+    }
+
+    ChipLogError(Discovery, "Failed to schedule mDNS announcements, sending them right away");
+    while (AnnounceNextBatch())
+    {
+    }
+}
+
+void AdvertiserMinMdns::CancelAnnouncements()
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(OnAnnouncementTimer, this);
+    }
+    mAnnouncementScheduled = false;
+
+    for (auto & it : mOperationalResponders)
+    {
+        it.SetAnnouncementPending(false);
+    }
+}
+
+void AdvertiserMinMdns::OnAnnouncementTimer(System::Layer * layer, void * context)
+{
+    auto * advertiser = static_cast<AdvertiserMinMdns *>(context);
+
+    advertiser->mAnnouncementScheduled = false;
+    if (advertiser->AnnounceNextBatch())
+    {
+        advertiser->ScheduleAnnouncementTimer();
+    }
+}
+
+bool AdvertiserMinMdns::AnnounceNextBatch()
+{
+    QueryResponderBase * responders[CHIP_CONFIG_MINMDNS_MAX_ANNOUNCEMENTS_PER_INTERVAL];
+    size_t count = 0;
+    bool pending = false;
+
+    for (auto & it : mOperationalResponders)
+    {
+        if (!it.IsAnnouncementPending())
+        {
+            continue;
+        }
+        if (count == ArraySize(responders))
+        {
+            pending = true;
+            break;
+        }
+        it.SetAnnouncementPending(false);
+        responders[count++] = it.GetAllocator()->GetQueryResponder();
+    }
+
+    mLastAnnouncementTime = System::SystemClock().GetMonotonicTimestamp();
+    if (count > 0)
+    {
+        AdvertiseRecords(BroadcastAdvertiseType::kStarted, Span<QueryResponderBase * const>(responders, count));
+    }
+    return pending;
+}
+
 AdvertiserMinMdns gAdvertiser;
 } // namespace
 
@@ -26,6 +26,7 @@
 #include <lib/dnssd/ResolverProxy.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
+#include <lib/dnssd/minimal_mdns/PacketPrefilter.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
@@ -70,6 +71,10 @@ public:
     IncrementalResolver * ResolverBegin() { return mResolvers; }
     IncrementalResolver * ResolverEnd() { return mResolvers + kMinMdnsNumParallelResolvers; }
 
+    /// Whether any resolver is waiting for more records of an SRV record
+    /// received earlier.
+    bool HasActiveResolvers() const;
+
 private:
     // ParserDelegate implementation
     void OnHeader(ConstHeaderRef & header) override;
@@ -107,6 +112,18 @@ private:
     IncrementalResolver mResolvers[kMinMdnsNumParallelResolvers];
 };
 
+bool PacketParser::HasActiveResolvers() const
+{
+    for (auto & resolver : mResolvers)
+    {
+        if (resolver.IsActive())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void PacketParser::OnHeader(ConstHeaderRef & header)
 {
     mIsResponse = header.GetFlags().IsResponse();
@@ -268,6 +285,10 @@ public:
     MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
+
+        mServicePrefilter.AddLabel(kOperationalServiceName);
+        mServicePrefilter.AddLabel(kCommissionableServiceName);
+        mServicePrefilter.AddLabel(kCommissionerServiceName);
     }
 
     //// MdnsPacketDelegate implementation
@@ -292,6 +313,7 @@ private:
     System::Layer * mSystemLayer                          = nullptr;
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
+    PacketPrefilter mServicePrefilter;
 
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
 
@@ -418,6 +440,13 @@ void MinMdnsResolver::AdvancePendingResolverStates()
 
 void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info)
 {
+    // Packets naming no Matter service are only of interest for the host
+    // names of nodes being resolved: skip parsing them otherwise.
+    if (!mServicePrefilter.Accept(data) && !mPacketParser.HasActiveResolvers() && !mActiveResolves.IsWaitingForIpResolution())
+    {
+        return;
+    }
+
     // Fill up any relevant data
     mPacketParser.ParseSrvRecords(data);
     mPacketParser.ParseNonSrvRecords(info->Interface, data);
@@ -0,0 +1,117 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "PacketPrefilter.h"
+
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+// Names start after the fixed size header of the packet.
+constexpr size_t kHeaderSize = 12;
+
+// Labels are at most 63 bytes long: longer strings cannot appear as a label.
+constexpr size_t kMaxLabelLength = 63;
+
+inline uint8_t ToLower(uint8_t c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? static_cast<uint8_t>(c - 'A' + 'a') : c;
+}
+
+} // namespace
+
+void PacketPrefilter::AddLabel(const char * label)
+{
+    const size_t length = strlen(label);
+    if ((length == 0) || (length > kMaxLabelLength) || (mLabelCount == kMaxLabels))
+    {
+        // Cannot be described by the filter: never reject a packet that may contain it.
+        mAcceptAll = true;
+        return;
+    }
+
+    mLabels[mLabelCount]       = label;
+    mLabelLengths[mLabelCount] = static_cast<uint8_t>(length);
+    mLabelCount++;
+}
+
+void PacketPrefilter::Clear()
+{
+    mLabelCount = 0;
+    mAcceptAll  = false;
+}
+
+bool PacketPrefilter::Accept(const BytesRange & packet) const
+{
+    if (mAcceptAll)
+    {
+        return true;
+    }
+
+    if (packet.Size() <= kHeaderSize)
+    {
+        return false;
+    }
+
+    const uint8_t * data = packet.Start() + kHeaderSize;
+    const size_t size    = packet.Size() - kHeaderSize;
+
+    for (size_t i = 0; i < mLabelCount; i++)
+    {
+        if (ContainsLabel(data, size, mLabels[i], mLabelLengths[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PacketPrefilter::ContainsLabel(const uint8_t * data, size_t size, const char * label, uint8_t length)
+{
+    const uint8_t * p   = data;
+    const uint8_t * end = data + size;
+
+    // memchr is vectorized by most C libraries: use it to find candidate length
+    // bytes, then compare the few bytes that follow them.
+    while (static_cast<size_t>(end - p) > length)
+    {
+        const uint8_t * candidate = static_cast<const uint8_t *>(memchr(p, length, static_cast<size_t>(end - p) - length));
+        if (candidate == nullptr)
+        {
+            return false;
+        }
+
+        size_t matched = 0;
+        while ((matched < length) && (ToLower(candidate[1 + matched]) == ToLower(static_cast<uint8_t>(label[matched]))))
+        {
+            matched++;
+        }
+        if (matched == length)
+        {
+            return true;
+        }
+
+        p = candidate + 1;
+    }
+    return false;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,72 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mdns {
+namespace Minimal {
+
+/// Quickly determines whether an mDNS packet may contain names of interest,
+/// without parsing it.
+///
+/// Names are sequences of length-prefixed labels, and name compression only
+/// points back to labels spelled out earlier in the same packet: a packet
+/// containing a name with a given label contains that label, preceded by its
+/// length, as raw bytes. Looking for these bytes is much cheaper than parsing
+/// the packet, so that packets about other services, which make up most of the
+/// mDNS traffic of a busy network, can be dropped early.
+///
+/// The filter may accept packets that contain no name of interest (for
+/// instance when the bytes of a label appear within record data), but never
+/// rejects a packet that does.
+class PacketPrefilter
+{
+public:
+    static constexpr size_t kMaxLabels = 8;
+
+    /// Accept packets containing `label`, compared case-insensitively.
+    ///
+    /// The string must remain valid while the filter uses it. If the filter
+    /// cannot hold more labels, it accepts every packet from then on.
+    void AddLabel(const char * label);
+
+    /// Accept every packet, for instance when the names of interest cannot be
+    /// described by the filter.
+    void AcceptAll() { mAcceptAll = true; }
+
+    /// Remove all labels: no packet is accepted until labels are added again.
+    void Clear();
+
+    /// Whether the packet contains any of the labels of interest.
+    bool Accept(const BytesRange & packet) const;
+
+private:
+    static bool ContainsLabel(const uint8_t * data, size_t size, const char * label, uint8_t length);
+
+    const char * mLabels[kMaxLabels];
+    uint8_t mLabelLengths[kMaxLabels];
+    size_t mLabelCount = 0;
+    bool mAcceptAll    = false;
+};
+
+} // namespace Minimal
+} // namespace mdns
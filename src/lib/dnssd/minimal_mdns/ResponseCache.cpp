@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ResponseCache.h"
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/BufferWriter.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+// Size of the type, class, TTL and data length that start a serialized record body.
+constexpr size_t kRecordBodyHeaderSize = 10;
+
+/// Record whose body was serialized earlier.
+class CachedResourceRecord : public ResourceRecord
+{
+public:
+    CachedResourceRecord(QType type, const FullQName & name, const BytesRange & data) : ResourceRecord(type, name), mData(data) {}
+
+protected:
+    bool WriteData(RecordWriter & out) const override { return out.Put(mData).Fit(); }
+
+private:
+    const BytesRange mData;
+};
+
+/// Forwards the records reported by a responder and serializes the ones that can be cached.
+class RecordingDelegate : public ResponderDelegate
+{
+public:
+    RecordingDelegate(ResponderDelegate * delegate, const FullQName & name, uint8_t * buffer, size_t size) :
+        mDelegate(delegate), mName(name), mOutput(buffer, size), mWriter(&mOutput)
+    {}
+
+    void AddResponse(const ResourceRecord & record) override
+    {
+        mDelegate->AddResponse(record);
+
+        const QType type = record.GetType();
+        if ((type != QType::TXT && type != QType::A && type != QType::AAAA) || !(record.GetName() == mName))
+        {
+            mCacheable = false;
+        }
+
+        if (mCacheable)
+        {
+            record.WriteBody(mWriter);
+        }
+    }
+
+    /// Whether all the records reported fit in the buffer and can be cached.
+    bool IsCacheable() const { return mCacheable && mOutput.Fit(); }
+    size_t GetLength() const { return mOutput.Needed(); }
+
+private:
+    ResponderDelegate * mDelegate;
+    const FullQName mName;
+    chip::Encoding::BigEndian::BufferWriter mOutput;
+    RecordWriter mWriter;
+    bool mCacheable = true;
+};
+
+} // namespace
+
+void ResponseCache::AddAllResponses(Responder * responder, const chip::Inet::IPPacketInfo * source, ResponderDelegate * delegate,
+                                    const ResponseConfiguration & configuration)
+{
+    if (configuration.GetTtlSecondsOverride().HasValue())
+    {
+        responder->AddAllResponses(source, delegate, configuration);
+        return;
+    }
+
+    const Entry * entry = FindEntry(responder, source->Interface);
+    if (entry != nullptr)
+    {
+        if (entry->cacheable)
+        {
+            AddCachedResponses(*entry, responder->GetQName(), delegate);
+        }
+        else
+        {
+            responder->AddAllResponses(source, delegate, configuration);
+        }
+        return;
+    }
+
+    RecordingDelegate recorder(delegate, responder->GetQName(), mData + mDataUsed, kDataSize - mDataUsed);
+    responder->AddAllResponses(source, &recorder, configuration);
+
+    if (mEntryCount == kMaxEntries)
+    {
+        return;
+    }
+
+    Entry & newEntry   = mEntries[mEntryCount++];
+    newEntry.responder = responder;
+    newEntry.interface = source->Interface;
+    newEntry.cacheable = recorder.IsCacheable();
+    newEntry.offset    = static_cast<uint16_t>(mDataUsed);
+    newEntry.length    = newEntry.cacheable ? static_cast<uint16_t>(recorder.GetLength()) : 0;
+
+    mDataUsed += newEntry.length;
+}
+
+void ResponseCache::Invalidate()
+{
+    mEntryCount = 0;
+    mDataUsed   = 0;
+}
+
+const ResponseCache::Entry * ResponseCache::FindEntry(const Responder * responder, chip::Inet::InterfaceId interface) const
+{
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        if (mEntries[i].responder == responder && mEntries[i].interface == interface)
+        {
+            return &mEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+void ResponseCache::AddCachedResponses(const Entry & entry, const FullQName & name, ResponderDelegate * delegate) const
+{
+    const uint8_t * p   = mData + entry.offset;
+    const uint8_t * end = p + entry.length;
+
+    while (p + kRecordBodyHeaderSize <= end)
+    {
+        const QType type     = static_cast<QType>(chip::Encoding::BigEndian::Get16(p));
+        const uint16_t klass = chip::Encoding::BigEndian::Get16(p + 2);
+        const uint32_t ttl   = chip::Encoding::BigEndian::Get32(p + 4);
+        const uint16_t size  = chip::Encoding::BigEndian::Get16(p + 8);
+        p += kRecordBodyHeaderSize;
+
+        CachedResourceRecord record(type, name, BytesRange(p, p + size));
+        record.SetCacheFlush((klass & kQClassResponseFlushBit) != 0).SetTtl(ttl);
+        delegate->AddResponse(record);
+
+        p += size;
+    }
+}
+
+} // namespace Minimal
+} // namespace mdns
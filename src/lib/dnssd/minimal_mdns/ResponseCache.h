@@ -0,0 +1,78 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/minimal_mdns/responders/Responder.h>
+
+#include <inet/IPPacketInfo.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Caches the serialized records reported by responders, so that replying to
+/// a query does not generate them again.
+///
+/// Only the records whose data contains no name (TXT, A and AAAA) are cached,
+/// as their serialized body can be copied as is into any reply; the owner name
+/// still goes through name compression. Records are cached per responder and
+/// interface, since IP responders report the addresses of the interface the
+/// query was received on.
+///
+/// The cache refers to responders by pointer: it must be invalidated whenever
+/// responders are added, removed or updated, and when interface addresses
+/// change.
+class ResponseCache
+{
+public:
+    /// Report the responses of the given responder to `delegate`, from the
+    /// cache if they are in it, and caching them otherwise.
+    ///
+    /// The cache is bypassed when `configuration` alters the records.
+    void AddAllResponses(Responder * responder, const chip::Inet::IPPacketInfo * source, ResponderDelegate * delegate,
+                         const ResponseConfiguration & configuration);
+
+    /// Drop all the cached records.
+    void Invalidate();
+
+private:
+    struct Entry
+    {
+        const Responder * responder;
+        chip::Inet::InterfaceId interface;
+        uint16_t offset;
+        uint16_t length;
+        bool cacheable; // false if the responder reports records that cannot be cached
+    };
+
+    static constexpr size_t kDataSize   = CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE;
+    static constexpr size_t kMaxEntries = CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_ENTRIES;
+
+    static_assert(kDataSize > 0 && kDataSize <= UINT16_MAX, "Response cache size must fit 16-bit offsets");
+
+    const Entry * FindEntry(const Responder * responder, chip::Inet::InterfaceId interface) const;
+    void AddCachedResponses(const Entry & entry, const FullQName & name, ResponderDelegate * delegate) const;
+
+    Entry mEntries[kMaxEntries];
+    size_t mEntryCount = 0;
+    uint8_t mData[kDataSize];
+    size_t mDataUsed = 0;
+};
+
+} // namespace Minimal
+} // namespace mdns
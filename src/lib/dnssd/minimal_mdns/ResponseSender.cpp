@@ -60,12 +60,14 @@ CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder
         if (responder == nullptr || responder == queryResponder)
         {
             responder = queryResponder;
+            mResponseCache.Invalidate();
             return CHIP_NO_ERROR;
         }
     }
 
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
     mResponders.push_back(queryResponder);
+    mResponseCache.Invalidate();
     return CHIP_NO_ERROR;
 #else
     return CHIP_ERROR_NO_MEMORY;
@@ -79,6 +81,7 @@ CHIP_ERROR ResponseSender::RemoveQueryResponder(QueryResponderBase * queryRespon
         if (*it == queryResponder)
         {
             *it = nullptr;
+            mResponseCache.Invalidate();
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
             mResponders.erase(it);
 #endif
@@ -102,13 +105,26 @@ bool ResponseSender::HasQueryResponders() const
 
 CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
                                    const ResponseConfiguration & configuration)
+{
+    return RespondWith(mResponders, messageId, query, querySource, configuration);
+}
+
+CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
+                                   const ResponseConfiguration & configuration, chip::Span<QueryResponderBase * const> responders)
+{
+    return RespondWith(responders, messageId, query, querySource, configuration);
+}
+
+template <typename Responders>
+CHIP_ERROR ResponseSender::RespondWith(Responders & responders, uint16_t messageId, const QueryData & query,
+                                       const chip::Inet::IPPacketInfo * querySource, const ResponseConfiguration & configuration)
 {
     mSendState.Reset(messageId, query, querySource);
 
     // Responder has a stateful 'additional replies required' that is used within the response
     // loop. 'no additionals required' is set at the start and additionals are marked as the query
     // reply is built.
-    for (auto & responder : mResponders)
+    for (auto & responder : responders)
     {
         {
             if (responder != nullptr)
@@ -135,7 +151,7 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             //       broadcasts on one interface to throttle broadcasts on another interface.
             responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1));
         }
-        for (auto & responder : mResponders)
+        for (auto & responder : responders)
         {
             if (responder == nullptr)
             {
@@ -143,7 +159,7 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             }
             for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
             {
-                it->responder->AddAllResponses(querySource, this, configuration);
+                mResponseCache.AddAllResponses(it->responder, querySource, this, configuration);
                 ReturnErrorOnFailure(mSendState.GetError());
 
                 responder->MarkAdditionalRepliesFor(it);
@@ -168,7 +184,7 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         responseFilter
             .SetReplyFilter(&queryReplyFilter) //
             .SetIncludeAdditionalRepliesOnly(true);
-        for (auto & responder : mResponders)
+        for (auto & responder : responders)
         {
             if (responder == nullptr)
             {
@@ -176,7 +192,7 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             }
             for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
             {
-                it->responder->AddAllResponses(querySource, this, configuration);
+                mResponseCache.AddAllResponses(it->responder, querySource, this, configuration);
                 ReturnErrorOnFailure(mSendState.GetError());
             }
         }
@@ -19,9 +19,11 @@
 
 #include "Parser.h"
 #include "ResponseBuilder.h"
+#include "ResponseCache.h"
 #include "Server.h"
 
 #include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
+#include <lib/support/Span.h>
 
 #include <system/SystemPacketBuffer.h>
 
@@ -111,21 +113,39 @@ public:
     CHIP_ERROR RemoveQueryResponder(QueryResponderBase * queryResponder);
     bool HasQueryResponders() const;
 
+    /// Drop the records cached by earlier responses. Must be called whenever
+    /// the records of the query responders change, and when interface
+    /// addresses change.
+    void InvalidateResponseCache() { mResponseCache.Invalidate(); }
+
     /// Send back the response to a particular query
     CHIP_ERROR Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
                        const ResponseConfiguration & configuration);
 
+    /// Send back the response to a particular query, only considering the
+    /// records of the given query responders.
+    ///
+    /// Useful when the caller knows which responders own the queried records,
+    /// to avoid going through every registered responder.
+    CHIP_ERROR Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
+                       const ResponseConfiguration & configuration, chip::Span<QueryResponderBase * const> responders);
+
     // Implementation of ResponderDelegate
     void AddResponse(const ResourceRecord & record) override;
 
     void SetServer(ServerBase * server) { mServer = server; }
 
 private:
+    template <typename Responders>
+    CHIP_ERROR RespondWith(Responders & responders, uint16_t messageId, const QueryData & query,
+                           const chip::Inet::IPPacketInfo * querySource, const ResponseConfiguration & configuration);
+
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
 
     ServerBase * mServer;
     QueryResponderPtrPool mResponders = {};
+    ResponseCache mResponseCache;
 
     /// Current send state
     ResponseBuilder mResponseBuilder;          // packet being built
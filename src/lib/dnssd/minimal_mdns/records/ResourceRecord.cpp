@@ -35,20 +35,10 @@ bool ResourceRecord::Append(HeaderRef & hdr, ResourceType asType, RecordWriter &
 
     out.WriteQName(mQName);
 
-    out.Writer()                                  //
-        .Put16(static_cast<uint16_t>(GetType()))  //
-        .Put16(static_cast<uint16_t>(GetClass())) //
-        .Put32(static_cast<uint32_t>(GetTtl()))   //
-        ;
-
-    chip::Encoding::BigEndian::BufferWriter sizeOutput(out.Writer()); // copy to re-output size
-    out.Put16(0);                                                     // dummy, will be replaced later
-
-    if (!WriteData(out))
+    if (!WriteBody(out))
     {
         return false;
     }
-    sizeOutput.Put16(static_cast<uint16_t>(out.Writer().Needed() - sizeOutput.Needed() - 2));
 
     // This MUST be final and separated out: record count is only updated on success.
     if (out.Fit())
@@ -70,5 +60,24 @@ bool ResourceRecord::Append(HeaderRef & hdr, ResourceType asType, RecordWriter &
     return out.Fit();
 }
 
+bool ResourceRecord::WriteBody(RecordWriter & out) const
+{
+    out.Writer()                                  //
+        .Put16(static_cast<uint16_t>(GetType()))  //
+        .Put16(static_cast<uint16_t>(GetClass())) //
+        .Put32(static_cast<uint32_t>(GetTtl()))   //
+        ;
+
+    chip::Encoding::BigEndian::BufferWriter sizeOutput(out.Writer()); // copy to re-output size
+    out.Put16(0);                                                     // dummy, will be replaced later
+
+    if (!WriteData(out))
+    {
+        return false;
+    }
+    sizeOutput.Put16(static_cast<uint16_t>(out.Writer().Needed() - sizeOutput.Needed() - 2));
+    return out.Fit();
+}
+
 } // namespace Minimal
 } // namespace mdns
@@ -60,6 +60,10 @@ public:
     /// Updates header item count on success, does NOT update header on failure.
     bool Append(HeaderRef & hdr, ResourceType asType, RecordWriter & out) const;
 
+    /// Output the part of the record following its name: type, class, TTL and
+    /// length-prefixed data.
+    bool WriteBody(RecordWriter & out) const;
+
 protected:
     /// Output the data portion of the resource record.
     virtual bool WriteData(RecordWriter & out) const = 0;
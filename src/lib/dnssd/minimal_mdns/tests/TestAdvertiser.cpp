@@ -21,6 +21,7 @@
 
 #include <lib/dnssd/Advertiser.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
 #include <lib/dnssd/minimal_mdns/core/QName.h>
@@ -30,6 +31,7 @@
 #include <lib/dnssd/minimal_mdns/tests/CheckOnlyServer.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
 #include <system/SystemPacketBuffer.h>
 #include <transport/raw/tests/NetworkTestHelpers.h>
 
@@ -537,10 +539,80 @@ void CommissionableAndOperationalAdverts(nlTestSuite * inSuite, void * inContext
     NL_TEST_ASSERT(inSuite, server.GetHeaderFound());
 }
 
+// Proxies and bridges advertise many operational identities. Without a dynamic responder list, the advertiser is
+// limited to the fabrics of the device.
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
+constexpr size_t kManyOperationalInstances = 500;
+#else
+constexpr size_t kManyOperationalInstances = CHIP_CONFIG_MAX_FABRICS;
+#endif
+
+PeerId ManyOperationalPeerId(size_t index)
+{
+    // A few nodes on each of many fabrics.
+    return PeerId().SetCompressedFabricId(0xABCD000000000000 + index / 4).SetNodeId(0x1000 + index);
+}
+
+void ManyOperationalAdverts(nlTestSuite * inSuite, void * inContext)
+{
+    auto & mdnsAdvertiser = chip::Dnssd::ServiceAdvertiser::Instance();
+    NL_TEST_ASSERT(inSuite, mdnsAdvertiser.RemoveServices() == CHIP_NO_ERROR);
+
+    auto & server = static_cast<CheckOnlyServer &>(GlobalMinimalMdnsServer::Server());
+    server.SetTestSuite(inSuite);
+    server.Reset();
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t i = 0; i < kManyOperationalInstances; i++)
+    {
+        OperationalAdvertisingParameters params =
+            OperationalAdvertisingParameters().SetPeerId(ManyOperationalPeerId(i)).SetMac(ByteSpan(kMac)).SetPort(CHIP_PORT);
+        NL_TEST_ASSERT(inSuite, mdnsAdvertiser.Advertise(params) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, mdnsAdvertiser.FinalizeServiceUpdate() == CHIP_NO_ERROR);
+    System::Clock::Microseconds64 advertiseTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    // Advertising an instance again updates its records rather than adding new ones.
+    OperationalAdvertisingParameters updatedParams =
+        OperationalAdvertisingParameters().SetPeerId(ManyOperationalPeerId(0)).SetMac(ByteSpan(kMac)).SetPort(CHIP_PORT + 1);
+    NL_TEST_ASSERT(inSuite, mdnsAdvertiser.Advertise(updatedParams) == CHIP_NO_ERROR);
+
+    // Queries for instance names get the records of that instance only.
+    constexpr size_t kQueryCount = 1000;
+    start                        = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t q = 0; q < kQueryCount; q++)
+    {
+        size_t index = (q * 7919) % kManyOperationalInstances;
+
+        char name[Operational::kInstanceNameMaxLength + 1];
+        NL_TEST_ASSERT(inSuite, MakeInstanceName(name, sizeof(name), ManyOperationalPeerId(index)) == CHIP_NO_ERROR);
+        QNamePart queryInstanceNameParts[] = { name, "_matter", "_tcp", "local" };
+        FullQName queryInstanceName        = FullQName(queryInstanceNameParts);
+
+        SrvResourceRecord srv(queryInstanceName, kHostnameName, static_cast<uint16_t>((index == 0) ? CHIP_PORT + 1 : CHIP_PORT));
+        TxtResourceRecord txt(queryInstanceName, kTxtRecordEmptyName);
+        server.Reset();
+        server.AddExpectedRecord(&srv);
+        server.AddExpectedRecord(&txt);
+        NL_TEST_ASSERT(inSuite, SendQuery(queryInstanceName) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, server.GetSendCalled());
+        NL_TEST_ASSERT(inSuite, server.GetHeaderFound());
+    }
+    System::Clock::Microseconds64 queryTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    // The timings depend on the host and are only logged.
+    ChipLogProgress(Discovery, "%u operational instances: advertised in %u us, %u us per instance name query",
+                    static_cast<unsigned>(kManyOperationalInstances), static_cast<unsigned>(advertiseTime.count()),
+                    static_cast<unsigned>(queryTime.count() / kQueryCount));
+
+    NL_TEST_ASSERT(inSuite, mdnsAdvertiser.RemoveServices() == CHIP_NO_ERROR);
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("OperationalAdverts", OperationalAdverts),                                   //
     NL_TEST_DEF("CommissionableNodeAdverts", CommissionableAdverts),                         //
     NL_TEST_DEF("CommissionableAndOperationalAdverts", CommissionableAndOperationalAdverts), //
+    NL_TEST_DEF("ManyOperationalAdverts", ManyOperationalAdverts),                           //
     NL_TEST_SENTINEL()                                                                       //
 };
 
@@ -0,0 +1,302 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/PacketPrefilter.h>
+
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/Query.h>
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/ResponseBuilder.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr uint16_t kMdnsMaxPacketSize = 1024;
+
+const char * const kMatterLabels[] = { "_matter", "_matterc", "_matterd" };
+
+const QNamePart kMatterServiceName[]      = { "_matter", "_tcp", "local" };
+const QNamePart kMatterInstanceName[]     = { "BEEFBEEFF00DF00D-1111222233334444", "_matter", "_tcp", "local" };
+const QNamePart kCommissionableName[]     = { "_matterc", "_udp", "local" };
+const QNamePart kCommissionableSubtype[]  = { "_L3840", "_sub", "_matterc", "_udp", "local" };
+const QNamePart kCommissionableInstance[] = { "5A7C3E91D20B4F66", "_matterc", "_udp", "local" };
+const QNamePart kMatterHostName[]         = { "AABBCCDDEEFF0011", "local" };
+
+struct OtherService
+{
+    const char * service;
+    const char * protocol;
+    const char * instance;
+    const char * host;
+};
+
+// A sample of the services announced on a busy home network.
+const OtherService kOtherServices[] = {
+    { "_googlecast", "_tcp", "Chromecast-Ultra-6e7f0c2b9d4a1e3f5c8b7a6d", "6e7f0c2b-9d4a-1e3f" },
+    { "_airplay", "_tcp", "Living Room TV", "Living-Room-TV" },
+    { "_raop", "_tcp", "A1B2C3D4E5F6@Living Room TV", "Living-Room-TV" },
+    { "_spotify-connect", "_tcp", "Kitchen Speaker", "kitchen-speaker" },
+    { "_hap", "_tcp", "Hallway Bridge 4F2A", "Hallway-Bridge" },
+    { "_companion-link", "_tcp", "Office iMac", "Office-iMac" },
+    { "_ipp", "_tcp", "Brother HL-L2350DW series", "BRW105BAD5E1234" },
+    { "_sonos", "_tcp", "Sonos-949F3E6C2A10", "Sonos-949F3E6C2A10" },
+};
+
+/// Parser delegate ignoring everything: measures the cost of parsing alone.
+class IgnoreAllDelegate : public ParserDelegate
+{
+public:
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override {}
+};
+
+BytesRange PacketRange(const System::PacketBufferHandle & packet)
+{
+    return BytesRange(packet->Start(), packet->Start() + packet->DataLength());
+}
+
+System::PacketBufferHandle BuildQuery(const FullQName & name, QType type)
+{
+    QueryBuilder builder(System::PacketBufferHandle::New(kMdnsMaxPacketSize));
+    builder.AddQuery(Query(name).SetType(type));
+    return builder.Ok() ? builder.ReleasePacket() : System::PacketBufferHandle();
+}
+
+/// Builds a DNS-SD announcement of a service instance: PTR, SRV and TXT records.
+System::PacketBufferHandle BuildAnnouncement(const FullQName & service, const FullQName & instance, const FullQName & host)
+{
+    const char * txtEntries[] = { "VP=65521+32769", "SII=5000", "SAI=300", "T=1" };
+
+    ResponseBuilder builder(System::PacketBufferHandle::New(kMdnsMaxPacketSize));
+    builder.AddRecord(ResourceType::kAnswer, PtrResourceRecord(service, instance));
+    builder.AddRecord(ResourceType::kAdditional, SrvResourceRecord(instance, host, 5540));
+    builder.AddRecord(ResourceType::kAdditional, TxtResourceRecord(instance, txtEntries));
+    return builder.Ok() ? builder.ReleasePacket() : System::PacketBufferHandle();
+}
+
+void SetupMatterFilter(PacketPrefilter & filter)
+{
+    for (auto label : kMatterLabels)
+    {
+        filter.AddLabel(label);
+    }
+}
+
+void TestAcceptsMatterPackets(nlTestSuite * inSuite, void * inContext)
+{
+    PacketPrefilter filter;
+    SetupMatterFilter(filter);
+
+    System::PacketBufferHandle packet = BuildQuery(FullQName(kMatterServiceName), QType::PTR);
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, filter.Accept(PacketRange(packet)));
+
+    packet = BuildQuery(FullQName(kCommissionableSubtype), QType::PTR);
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, filter.Accept(PacketRange(packet)));
+
+    // The instance and host names of the SRV record refer back to the service name.
+    packet = BuildAnnouncement(FullQName(kMatterServiceName), FullQName(kMatterInstanceName), FullQName(kMatterHostName));
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, filter.Accept(PacketRange(packet)));
+
+    packet = BuildAnnouncement(FullQName(kCommissionableName), FullQName(kCommissionableInstance), FullQName(kMatterHostName));
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, filter.Accept(PacketRange(packet)));
+}
+
+void TestCaseInsensitive(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t query[] = {
+        0x12, 0x34, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // header: 1 query
+        7,    '_',  'M',  'A',  'T',  'T',  'E',  'R',                          //
+        4,    '_',  'T',  'C',  'P',                                            //
+        5,    'L',  'O',  'C',  'A',  'L',                                      //
+        0,    0x00, 0x0C, 0x00, 0x01,                                           // PTR/IN
+    };
+
+    PacketPrefilter filter;
+    SetupMatterFilter(filter);
+    NL_TEST_ASSERT(inSuite, filter.Accept(BytesRange(query, query + sizeof(query))));
+}
+
+void TestRejectsOtherPackets(nlTestSuite * inSuite, void * inContext)
+{
+    PacketPrefilter filter;
+    SetupMatterFilter(filter);
+
+    for (auto & other : kOtherServices)
+    {
+        const QNamePart serviceParts[]  = { other.service, other.protocol, "local" };
+        const QNamePart instanceParts[] = { other.instance, other.service, other.protocol, "local" };
+        const QNamePart hostParts[]     = { other.host, "local" };
+
+        System::PacketBufferHandle packet = BuildQuery(FullQName(serviceParts), QType::PTR);
+        NL_TEST_ASSERT(inSuite, !packet.IsNull());
+        NL_TEST_ASSERT(inSuite, !filter.Accept(PacketRange(packet)));
+
+        packet = BuildAnnouncement(FullQName(serviceParts), FullQName(instanceParts), FullQName(hostParts));
+        NL_TEST_ASSERT(inSuite, !packet.IsNull());
+        NL_TEST_ASSERT(inSuite, !filter.Accept(PacketRange(packet)));
+    }
+
+    // Labels merely containing "_matter" are not Matter names.
+    const QNamePart lookalike[]       = { "_matterthing", "_tcp", "local" };
+    System::PacketBufferHandle packet = BuildQuery(FullQName(lookalike), QType::PTR);
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, !filter.Accept(PacketRange(packet)));
+
+    // Too short to contain anything past the header.
+    const uint8_t truncated[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 };
+    NL_TEST_ASSERT(inSuite, !filter.Accept(BytesRange(truncated, truncated + sizeof(truncated))));
+}
+
+void TestHostNamesAndAcceptAll(nlTestSuite * inSuite, void * inContext)
+{
+    PacketPrefilter filter;
+    SetupMatterFilter(filter);
+
+    System::PacketBufferHandle packet = BuildQuery(FullQName(kMatterHostName), QType::AAAA);
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, !filter.Accept(PacketRange(packet)));
+
+    filter.AddLabel(kMatterHostName[0]);
+    NL_TEST_ASSERT(inSuite, filter.Accept(PacketRange(packet)));
+
+    // Once full, the filter lets everything through rather than dropping packets it may need.
+    const QNamePart otherParts[] = { kOtherServices[0].service, kOtherServices[0].protocol, "local" };
+    packet                       = BuildQuery(FullQName(otherParts), QType::PTR);
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, !filter.Accept(PacketRange(packet)));
+
+    for (size_t i = 0; i <= PacketPrefilter::kMaxLabels; i++)
+    {
+        filter.AddLabel("_other");
+    }
+    NL_TEST_ASSERT(inSuite, filter.Accept(PacketRange(packet)));
+
+    filter.Clear();
+    NL_TEST_ASSERT(inSuite, !filter.Accept(PacketRange(packet)));
+}
+
+/// Compares the cost of parsing packets to the cost of prefiltering them, on a
+/// corpus where, as on a typical network, most packets are about other services.
+void TestParseBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMaxCorpusSize = 2 * ArraySize(kOtherServices) + 2;
+    System::PacketBufferHandle corpus[kMaxCorpusSize];
+    size_t corpusSize = 0;
+
+    for (auto & other : kOtherServices)
+    {
+        const QNamePart serviceParts[]  = { other.service, other.protocol, "local" };
+        const QNamePart instanceParts[] = { other.instance, other.service, other.protocol, "local" };
+        const QNamePart hostParts[]     = { other.host, "local" };
+
+        corpus[corpusSize++] = BuildQuery(FullQName(serviceParts), QType::PTR);
+        corpus[corpusSize++] = BuildAnnouncement(FullQName(serviceParts), FullQName(instanceParts), FullQName(hostParts));
+    }
+    corpus[corpusSize++] = BuildQuery(FullQName(kMatterServiceName), QType::PTR);
+    corpus[corpusSize++] =
+        BuildAnnouncement(FullQName(kMatterServiceName), FullQName(kMatterInstanceName), FullQName(kMatterHostName));
+
+    size_t corpusBytes = 0;
+    for (size_t i = 0; i < corpusSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, !corpus[i].IsNull());
+        VerifyOrReturn(!corpus[i].IsNull());
+        corpusBytes += corpus[i]->DataLength();
+    }
+
+    PacketPrefilter filter;
+    SetupMatterFilter(filter);
+    IgnoreAllDelegate delegate;
+
+    constexpr size_t kRounds = 2000;
+    size_t parsed            = 0;
+    size_t accepted          = 0;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        for (size_t i = 0; i < corpusSize; i++)
+        {
+            parsed += ParsePacket(PacketRange(corpus[i]), &delegate) ? 1 : 0;
+        }
+    }
+    System::Clock::Microseconds64 parseTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        for (size_t i = 0; i < corpusSize; i++)
+        {
+            accepted += filter.Accept(PacketRange(corpus[i])) ? 1 : 0;
+        }
+    }
+    System::Clock::Microseconds64 filterTime = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    NL_TEST_ASSERT(inSuite, parsed == kRounds * corpusSize);
+    NL_TEST_ASSERT(inSuite, accepted == kRounds * 2);
+
+    ChipLogProgress(Discovery, "%u packets (%u bytes) x %u: parsed in %u us, prefiltered in %u us",
+                    static_cast<unsigned>(corpusSize), static_cast<unsigned>(corpusBytes), static_cast<unsigned>(kRounds),
+                    static_cast<unsigned>(parseTime.count()), static_cast<unsigned>(filterTime.count()));
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestAcceptsMatterPackets", TestAcceptsMatterPackets),   //
+    NL_TEST_DEF("TestCaseInsensitive", TestCaseInsensitive),             //
+    NL_TEST_DEF("TestRejectsOtherPackets", TestRejectsOtherPackets),     //
+    NL_TEST_DEF("TestHostNamesAndAcceptAll", TestHostNamesAndAcceptAll), //
+    NL_TEST_DEF("TestParseBenchmark", TestParseBenchmark),               //
+    NL_TEST_SENTINEL()                                                   //
+};
+
+int TestSetup(void * inContext)
+{
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestPacketPrefilter()
+{
+    nlTestSuite theSuite = { "PacketPrefilter", sTests, &TestSetup, &TestTeardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPacketPrefilter)
@@ -19,9 +19,12 @@
 #include <string>
 #include <vector>
 
+#include <inet/InetInterface.h>
+#include <lib/dnssd/minimal_mdns/AddressPolicy.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
+#include <lib/dnssd/minimal_mdns/responders/IP.h>
 #include <lib/dnssd/minimal_mdns/responders/Ptr.h>
 #include <lib/dnssd/minimal_mdns/responders/Srv.h>
 #include <lib/dnssd/minimal_mdns/responders/Txt.h>
@@ -29,6 +32,8 @@
 
 #include <lib/support/CHIPMem.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
 
 #include <nlunit-test.h>
 
@@ -344,6 +349,176 @@ void PtrSrvTxtMultipleRespondersToServiceListing(nlTestSuite * inSuite, void * i
     NL_TEST_ASSERT(inSuite, common1.server.GetHeaderFound());
 }
 
+// Address policy reporting fixed IPv6 addresses, and counting how many times they are enumerated. The
+// interface addresses are walked as a real policy would, so that benchmarks account for their cost.
+class FixedAddressPolicy : public AddressPolicy
+{
+public:
+    class Iterator : public IpAddressIterator
+    {
+    public:
+        Iterator(const vector<Inet::IPAddress> & addresses) : mAddresses(addresses) {}
+
+        bool Next(Inet::IPAddress & dest) override
+        {
+            if (mIndex == mAddresses.size())
+            {
+                return false;
+            }
+            dest = mAddresses[mIndex++];
+            return true;
+        }
+
+    private:
+        const vector<Inet::IPAddress> & mAddresses;
+        size_t mIndex = 0;
+    };
+
+    Platform::UniquePtr<ListenIterator> GetListenEndpoints() override { return nullptr; }
+
+    Platform::UniquePtr<IpAddressIterator> GetIpAddressesForEndpoint(Inet::InterfaceId interfaceId,
+                                                                     Inet::IPAddressType type) override
+    {
+        enumerations++;
+        for (Inet::InterfaceAddressIterator it; it.HasCurrent(); it.Next())
+        {
+        }
+        return Platform::UniquePtr<IpAddressIterator>(Platform::New<Iterator>(addresses));
+    }
+
+    vector<Inet::IPAddress> addresses;
+    size_t enumerations = 0;
+};
+
+FixedAddressPolicy gFixedAddressPolicy;
+
+// Server keeping a copy of the last packet sent.
+class RecordingServer : private PoolImpl<ServerBase::EndpointInfo, 0, ObjectPoolMem::kInline,
+                                         ServerBase::EndpointInfoPoolType::Interface>,
+                        public ServerBase
+{
+public:
+    RecordingServer() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    CHIP_ERROR DirectSend(System::PacketBufferHandle && data, const Inet::IPAddress & addr, uint16_t port,
+                          Inet::InterfaceId interface) override
+    {
+        lastPacket.assign(data->Start(), data->Start() + data->DataLength());
+        sendCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    vector<uint8_t> lastPacket;
+    size_t sendCount = 0;
+};
+
+// Records of a commissionable node with three IPv6 addresses, browsed for with a PTR query on its service name.
+struct BrowseTestElements : public CommonTestElements
+{
+    BrowseTestElements(nlTestSuite * inSuite) : CommonTestElements(inSuite, "test")
+    {
+        Inet::IPAddress address;
+        for (const char * text : { "fe80::1234:5678:9abc:def0", "fd00::1234:5678:9abc:def0", "2001:db8::1234:5678:9abc:def0" })
+        {
+            Inet::IPAddress::FromString(text, address);
+            gFixedAddressPolicy.addresses.push_back(address);
+        }
+        SetAddressPolicy(&gFixedAddressPolicy);
+
+        queryResponder.AddResponder(&ptrResponder).SetReportAdditional(instance).SetReportInServiceListing(true);
+        queryResponder.AddResponder(&srvResponder).SetReportAdditional(host);
+        queryResponder.AddResponder(&txtResponder);
+        queryResponder.AddResponder(&ipResponder);
+
+        recordWriter.WriteQName(service);
+    }
+
+    ~BrowseTestElements()
+    {
+        gFixedAddressPolicy.addresses.clear();
+        gFixedAddressPolicy.enumerations = 0;
+    }
+
+    QueryData BrowseQuery() { return QueryData(QType::PTR, QClass::IN, false, requestNameStart, requestBytesRange); }
+
+    IPv6Responder ipResponder = IPv6Responder(host);
+    RecordingServer recordingServer;
+};
+
+void CachedResponsesMatchGeneratedOnes(nlTestSuite * inSuite, void * inContext)
+{
+    BrowseTestElements common(inSuite);
+    ResponseSender responseSender(&common.recordingServer);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+
+    // The first reply is generated from the responders, and fills the cache.
+    responseSender.Respond(1, common.BrowseQuery(), &common.packetInfo, ResponseConfiguration());
+    NL_TEST_ASSERT(inSuite, common.recordingServer.sendCount == 1);
+    NL_TEST_ASSERT(inSuite, gFixedAddressPolicy.enumerations == 1);
+    vector<uint8_t> generated = common.recordingServer.lastPacket;
+
+    // The next ones are identical, but do not enumerate the addresses again.
+    for (int i = 0; i < 3; i++)
+    {
+        common.recordingServer.lastPacket.clear();
+        responseSender.Respond(1, common.BrowseQuery(), &common.packetInfo, ResponseConfiguration());
+        NL_TEST_ASSERT(inSuite, common.recordingServer.lastPacket == generated);
+    }
+    NL_TEST_ASSERT(inSuite, gFixedAddressPolicy.enumerations == 1);
+
+    // A TTL override bypasses the cache.
+    ResponseConfiguration goodbye;
+    goodbye.SetTtlSecondsOverride(0);
+    responseSender.Respond(1, common.BrowseQuery(), &common.packetInfo, goodbye);
+    NL_TEST_ASSERT(inSuite, common.recordingServer.lastPacket != generated);
+    NL_TEST_ASSERT(inSuite, gFixedAddressPolicy.enumerations == 2);
+
+    // Address changes are only picked up once the cache is invalidated.
+    Inet::IPAddress::FromString("fd00::1", gFixedAddressPolicy.addresses[1]);
+    responseSender.Respond(1, common.BrowseQuery(), &common.packetInfo, ResponseConfiguration());
+    NL_TEST_ASSERT(inSuite, common.recordingServer.lastPacket == generated);
+
+    responseSender.InvalidateResponseCache();
+    responseSender.Respond(1, common.BrowseQuery(), &common.packetInfo, ResponseConfiguration());
+    NL_TEST_ASSERT(inSuite, common.recordingServer.lastPacket != generated);
+    NL_TEST_ASSERT(inSuite, gFixedAddressPolicy.enumerations == 3);
+}
+
+// Replies to `count` browse queries and returns the number of queries answered per second.
+uint32_t RunBrowseQueries(ResponseSender & responseSender, BrowseTestElements & common, const ResponseConfiguration & configuration,
+                          uint32_t count)
+{
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        responseSender.Respond(1, common.BrowseQuery(), &common.packetInfo, configuration);
+    }
+    System::Clock::Microseconds64 elapsed = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    return static_cast<uint32_t>(uint64_t{ count } * 1000000u / (elapsed.count() == 0 ? 1 : elapsed.count()));
+}
+
+void BrowseQueryBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kQueryCount = 20000;
+
+    BrowseTestElements common(inSuite);
+    ResponseSender responseSender(&common.recordingServer);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+
+    // A TTL override bypasses the cache, so replies are generated from the responders every time.
+    ResponseConfiguration uncached;
+    uncached.SetTtlSecondsOverride(ResourceRecord::kDefaultTtl);
+
+    uint32_t uncachedRate = RunBrowseQueries(responseSender, common, uncached, kQueryCount);
+    uint32_t cachedRate   = RunBrowseQueries(responseSender, common, ResponseConfiguration(), kQueryCount);
+
+    // The rates depend on the host and are only logged.
+    NL_TEST_ASSERT(inSuite, common.recordingServer.sendCount == 2 * kQueryCount);
+    ChipLogProgress(Discovery, "Browse query replies: %u/s generated, %u/s cached (%u address enumerations)",
+                    static_cast<unsigned>(uncachedRate), static_cast<unsigned>(cachedRate),
+                    static_cast<unsigned>(gFixedAddressPolicy.enumerations));
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("SrvAnyResponseToInstance", SrvAnyResponseToInstance),                                       //
     NL_TEST_DEF("SrvTxtAnyResponseToInstance", SrvTxtAnyResponseToInstance),                                 //
@@ -355,6 +530,8 @@ const nlTest sTests[] = {
     NL_TEST_DEF("AddManyQueryResponders", AddManyQueryResponders),                                           //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToInstance", PtrSrvTxtMultipleRespondersToInstance),             //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToServiceListing", PtrSrvTxtMultipleRespondersToServiceListing), //
+    NL_TEST_DEF("CachedResponsesMatchGeneratedOnes", CachedResponsesMatchGeneratedOnes),                     //
+    NL_TEST_DEF("BrowseQueryBenchmark", BrowseQueryBenchmark),                                               //
 
     NL_TEST_SENTINEL() //
 };
@@ -170,6 +170,9 @@ public:
         return StorageKeyName::Formatted("g/a/%x/%" PRIx32 "/%" PRIx32, endpointId, clusterId, attributeId);
     }
 
+    // Prefix of the AttributeValue keys of all the attributes of an endpoint.
+    static StorageKeyName AttributeValuePrefix(EndpointId endpointId) { return StorageKeyName::Formatted("g/a/%x/", endpointId); }
+
     // TODO: Should store fabric-specific parts of the binding list under keys
     // starting with "f/%x/".
     static StorageKeyName BindingTable() { return StorageKeyName::FromConst("g/bt"); }
@@ -197,6 +200,7 @@ public:
         return StorageKeyName::Formatted("g/su/%x", static_cast<unsigned>(index));
     }
     static StorageKeyName SubscriptionResumptionMaxCount() { return StorageKeyName::Formatted("g/sum"); }
+    static StorageKeyName SubscriptionResumptionIndex() { return StorageKeyName::FromConst("g/sui"); }
 
     // Number of scenes stored in a given endpoint's scene table, across all fabrics.
     static StorageKeyName EndpointSceneCountKey(EndpointId endpoint) { return StorageKeyName::Formatted("g/scc/e/%x", endpoint); }
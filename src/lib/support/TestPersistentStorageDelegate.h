@@ -126,6 +126,16 @@ public:
         return err;
     }
 
+    CHIP_ERROR SyncForEachKeyValueWithPrefix(const char * prefix, KeyValueVisitor & visitor) override
+    {
+        if (mLoggingLevel >= LoggingLevel::kLogMutationAndReads)
+        {
+            ChipLogDetail(Test, "TestPersistentStorageDelegate::SyncForEachKeyValueWithPrefix: Prefix '%s'", prefix);
+        }
+
+        return SyncForEachKeyValueWithPrefixInternal(prefix, visitor);
+    }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -231,6 +241,30 @@ protected:
         return size < valueSizeUint16 ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
     }
 
+    virtual CHIP_ERROR SyncForEachKeyValueWithPrefixInternal(const char * prefix, KeyValueVisitor & visitor)
+    {
+        // Keys are sorted, so the matching entries are contiguous.
+        std::string prefixString(prefix);
+        for (auto it = mStorage.lower_bound(prefixString);
+             it != mStorage.end() && it->first.compare(0, prefixString.size(), prefixString) == 0; ++it)
+        {
+            // Making sure poison keys are not accessed
+            if (mPoisonKeys.find(it->first) != mPoisonKeys.end())
+            {
+                return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+            }
+
+            if (!CanCastTo<uint16_t>(it->second.size()))
+            {
+                return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+            }
+
+            ReturnErrorOnFailure(
+                visitor.OnKeyValue(it->first.c_str(), it->second.data(), static_cast<uint16_t>(it->second.size())));
+        }
+        return CHIP_NO_ERROR;
+    }
+
     virtual CHIP_ERROR SyncSetKeyValueInternal(const char * key, const void * value, uint16_t size)
     {
         // Make sure poison keys are not accessed
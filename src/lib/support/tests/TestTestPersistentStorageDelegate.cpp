@@ -341,8 +341,74 @@ void TestClearStorage(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, size == sizeof(buf));
 }
 
+class KeyCollector : public PersistentStorageDelegate::KeyValueVisitor
+{
+public:
+    CHIP_ERROR OnKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        keys.insert(std::string(key));
+        totalSize += size;
+        return (stopAfter != 0 && keys.size() == stopAfter) ? CHIP_ERROR_CANCELLED : CHIP_NO_ERROR;
+    }
+
+    std::set<std::string> keys;
+    size_t totalSize = 0;
+    size_t stopAfter = 0;
+};
+
+void TestForEachKeyValueWithPrefix(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/1/6/0", "\x01", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/1/8/0", "\x01\x02", 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/10/6/0", "\x01", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/2/6/0", "\x01", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("g/a/1", nullptr, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("f/1/n", "\x01", 1) == CHIP_NO_ERROR);
+
+    // Only the keys with the prefix are visited, not the ones that merely share its first characters.
+    {
+        KeyCollector collector;
+        NL_TEST_ASSERT(inSuite, storage.SyncForEachKeyValueWithPrefix("g/a/1/", collector) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, SetMatches(collector.keys, std::array<std::string, 2>{ { "g/a/1/6/0", "g/a/1/8/0" } }));
+        NL_TEST_ASSERT(inSuite, collector.totalSize == 3);
+    }
+
+    // An empty prefix visits everything, including empty values.
+    {
+        KeyCollector collector;
+        NL_TEST_ASSERT(inSuite, storage.SyncForEachKeyValueWithPrefix("", collector) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, collector.keys.size() == storage.GetNumKeys());
+    }
+
+    // No match is not an error.
+    {
+        KeyCollector collector;
+        NL_TEST_ASSERT(inSuite, storage.SyncForEachKeyValueWithPrefix("g/a/3/", collector) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, collector.keys.empty());
+    }
+
+    // The visitor can stop the enumeration.
+    {
+        KeyCollector collector;
+        collector.stopAfter = 1;
+        NL_TEST_ASSERT(inSuite, storage.SyncForEachKeyValueWithPrefix("g/a/", collector) == CHIP_ERROR_CANCELLED);
+        NL_TEST_ASSERT(inSuite, collector.keys.size() == 1);
+    }
+
+    // Poison keys fail the enumeration.
+    {
+        KeyCollector collector;
+        storage.AddPoisonKey("g/a/1/8/0");
+        NL_TEST_ASSERT(inSuite, storage.SyncForEachKeyValueWithPrefix("g/a/1/", collector) == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        storage.ClearPoisonKeys();
+    }
+}
+
 const nlTest sTests[] = { NL_TEST_DEF("Test basic API", TestBasicApi),
                           NL_TEST_DEF("Test ClearStorage method of TestPersistentStorageDelegate", TestClearStorage),
+                          NL_TEST_DEF("Test prefix enumeration", TestForEachKeyValueWithPrefix),
                           NL_TEST_SENTINEL() };
 
 } // namespace
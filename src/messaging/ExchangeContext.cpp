@@ -337,6 +337,7 @@ ExchangeContext::ExchangeContext(ExchangeManager * em, uint16_t ExchangeId, cons
 
     mExchangeMgr = em;
     mExchangeId  = ExchangeId;
+    mExchangeMgr->AddToExchangeIndex(this);
     mSession.Grab(session);
     mFlags.Set(Flags::kFlagInitiator, Initiator);
     mFlags.Set(Flags::kFlagEphemeralExchange, isEphemeralExchange);
@@ -385,6 +386,7 @@ ExchangeContext::~ExchangeContext()
     // the boolean parameter passed to DoClose() should not matter.
 
     DoClose(false);
+    mExchangeMgr->RemoveFromExchangeIndex(this);
     mExchangeMgr = nullptr;
 
 #if defined(CHIP_EXCHANGE_CONTEXT_DETAIL_LOGGING)
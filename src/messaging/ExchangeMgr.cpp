@@ -82,6 +82,7 @@ CHIP_ERROR ExchangeManager::Init(SessionManager * sessionManager)
         // then re-initializes without removing registered handlers.
         handler.Reset();
     }
+    memset(mUMHIndex, 0, sizeof(mUMHIndex));
 
     sessionManager->SetMessageDelegate(this);
 
@@ -140,42 +141,68 @@ CHIP_ERROR ExchangeManager::UnregisterUnsolicitedMessageHandlerForType(Protocols
     return UnregisterUMH(protocolId, static_cast<int16_t>(msgType));
 }
 
-CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler)
+size_t ExchangeManager::UMHIndexBucket(Protocols::Id protocolId, int16_t msgType)
 {
-    UnsolicitedMessageHandlerSlot * selected = nullptr;
+    uint32_t key = protocolId.ToFullyQualifiedSpecForm() ^ (static_cast<uint32_t>(static_cast<uint16_t>(msgType)) << 8);
+    // Fibonacci hashing spreads the few standard protocol ids and message types over the buckets.
+    return static_cast<size_t>((key * 2654435761u) >> 16) & (kUMHIndexBucketCount - 1);
+}
 
-    for (auto & umh : UMHandlerPool)
+ExchangeManager::UnsolicitedMessageHandlerSlot * ExchangeManager::FindUMH(Protocols::Id protocolId, int16_t msgType)
+{
+    for (uint8_t slot = mUMHIndex[UMHIndexBucket(protocolId, msgType)]; slot != 0; slot = UMHandlerPool[slot - 1].NextInBucket)
     {
-        if (!umh.IsInUse())
+        UnsolicitedMessageHandlerSlot & umh = UMHandlerPool[slot - 1];
+        if (umh.Matches(protocolId, msgType))
         {
-            if (selected == nullptr)
-                selected = &umh;
+            return &umh;
         }
-        else if (umh.Matches(protocolId, msgType))
+    }
+    return nullptr;
+}
+
+CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler)
+{
+    UnsolicitedMessageHandlerSlot * existing = FindUMH(protocolId, msgType);
+    if (existing != nullptr)
+    {
+        existing->Handler = handler;
+        return CHIP_NO_ERROR;
+    }
+
+    for (uint8_t i = 0; i < CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++)
+    {
+        UnsolicitedMessageHandlerSlot & selected = UMHandlerPool[i];
+        if (selected.IsInUse())
         {
-            umh.Handler = handler;
-            return CHIP_NO_ERROR;
+            continue;
         }
-    }
 
-    if (selected == nullptr)
-        return CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
+        uint8_t & bucket = mUMHIndex[UMHIndexBucket(protocolId, msgType)];
 
-    selected->Handler     = handler;
-    selected->ProtocolId  = protocolId;
-    selected->MessageType = msgType;
+        selected.Handler      = handler;
+        selected.ProtocolId   = protocolId;
+        selected.MessageType  = msgType;
+        selected.NextInBucket = bucket;
+        bucket                = static_cast<uint8_t>(i + 1);
 
-    SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+        SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
-    return CHIP_NO_ERROR;
+        return CHIP_NO_ERROR;
+    }
+
+    return CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
 }
 
 CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgType)
 {
-    for (auto & umh : UMHandlerPool)
+    uint8_t * link = &mUMHIndex[UMHIndexBucket(protocolId, msgType)];
+    for (; *link != 0; link = &UMHandlerPool[*link - 1].NextInBucket)
     {
-        if (umh.IsInUse() && umh.Matches(protocolId, msgType))
+        UnsolicitedMessageHandlerSlot & umh = UMHandlerPool[*link - 1];
+        if (umh.Matches(protocolId, msgType))
         {
+            *link = umh.NextInBucket;
             umh.Reset();
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
             return CHIP_NO_ERROR;
@@ -185,6 +212,42 @@ CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgT
     return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
 }
 
+void ExchangeManager::AddToExchangeIndex(ExchangeContext * ec)
+{
+    ExchangeContext *& bucket = mExchangeIndex[ec->GetExchangeId() & (kExchangeIndexBucketCount - 1)];
+
+    ec->mNextInExchangeIndex = bucket;
+    bucket                   = ec;
+}
+
+void ExchangeManager::RemoveFromExchangeIndex(ExchangeContext * ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[ec->GetExchangeId() & (kExchangeIndexBucketCount - 1)];
+    for (; *link != nullptr; link = &(*link)->mNextInExchangeIndex)
+    {
+        if (*link == ec)
+        {
+            *link                    = ec->mNextInExchangeIndex;
+            ec->mNextInExchangeIndex = nullptr;
+            return;
+        }
+    }
+}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    ExchangeContext * ec = mExchangeIndex[payloadHeader.GetExchangeID() & (kExchangeIndexBucketCount - 1)];
+    for (; ec != nullptr; ec = ec->mNextInExchangeIndex)
+    {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            return ec;
+        }
+    }
+    return nullptr;
+}
+
 void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
                                         const SessionHandle & session, DuplicateMessage isDuplicate,
                                         System::PacketBufferHandle && msgBuf)
@@ -238,23 +301,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -279,21 +333,10 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
         // handle the message type over handlers that handle all messages for a profile.
-        matchingUMH = nullptr;
-
-        for (auto & umh : UMHandlerPool)
+        matchingUMH = FindUMH(payloadHeader.GetProtocolID(), payloadHeader.GetMessageType());
+        if (matchingUMH == nullptr)
         {
-            if (umh.IsInUse() && payloadHeader.HasProtocol(umh.ProtocolId))
-            {
-                if (umh.MessageType == payloadHeader.GetMessageType())
-                {
-                    matchingUMH = &umh;
-                    break;
-                }
-
-                if (umh.MessageType == kAnyMessageType)
-                    matchingUMH = &umh;
-            }
+            matchingUMH = FindUMH(payloadHeader.GetProtocolID(), kAnyMessageType);
         }
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message does not need to send
@@ -42,6 +42,13 @@ class ExchangeDelegate;
 
 static constexpr int16_t kAnyMessageType = -1;
 
+namespace detail {
+constexpr size_t RoundUpToPowerOfTwo(size_t value, size_t powerOfTwo = 1)
+{
+    return powerOfTwo >= value ? powerOfTwo : RoundUpToPowerOfTwo(value, powerOfTwo * 2);
+}
+} // namespace detail
+
 /**
  *  @brief
  *    This class is used to manage ExchangeContexts with other CHIP nodes.
@@ -204,7 +211,11 @@ private:
     {
         UnsolicitedMessageHandlerSlot() : ProtocolId(Protocols::NotSpecified) {}
 
-        constexpr void Reset() { Handler = nullptr; }
+        constexpr void Reset()
+        {
+            Handler      = nullptr;
+            NextInBucket = 0;
+        }
         constexpr bool IsInUse() const { return Handler != nullptr; }
         // Matches() only returns a sensible value if IsInUse() is true.
         constexpr bool Matches(Protocols::Id aProtocolId, int16_t aMessageType) const
@@ -220,8 +231,18 @@ private:
         int16_t MessageType;
 
         UnsolicitedMessageHandler * Handler;
+
+        // 1-based index in UMHandlerPool of the next slot in the same mUMHIndex bucket, 0 if none.
+        uint8_t NextInBucket = 0;
     };
 
+    // Number of buckets of the exchange index.  Sized to the exchange pool so that chains stay short.
+    static constexpr size_t kExchangeIndexBucketCount = detail::RoundUpToPowerOfTwo(CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS);
+
+    // Number of buckets of the unsolicited message handler index.
+    static constexpr size_t kUMHIndexBucketCount = detail::RoundUpToPowerOfTwo(2 * CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS);
+    static_assert(CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS < UINT8_MAX, "Handler slots are indexed with uint8_t");
+
     uint16_t mNextExchangeId;
     uint16_t mNextKeyId;
     State mState;
@@ -233,8 +254,23 @@ private:
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
+    // Active exchanges hashed on their exchange id, chained through ExchangeContext::mNextInExchangeIndex, so
+    // that an incoming message is matched to its exchange without scanning the whole context pool.
+    ExchangeContext * mExchangeIndex[kExchangeIndexBucketCount] = {};
+
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
 
+    // Registered UMHandlerPool slots hashed on their protocol id and message type: 1-based index of the first
+    // slot of each bucket, 0 if the bucket is empty.
+    uint8_t mUMHIndex[kUMHIndexBucketCount] = {};
+
+    void AddToExchangeIndex(ExchangeContext * ec);
+    void RemoveFromExchangeIndex(ExchangeContext * ec);
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
+
+    static size_t UMHIndexBucket(Protocols::Id protocolId, int16_t msgType);
+    UnsolicitedMessageHandlerSlot * FindUMH(Protocols::Id protocolId, int16_t msgType);
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
 
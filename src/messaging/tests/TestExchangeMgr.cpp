@@ -31,6 +31,7 @@
 #include <messaging/Flags.h>
 #include <messaging/tests/MessagingContext.h>
 #include <protocols/Protocols.h>
+#include <system/SystemClock.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 
@@ -90,6 +91,40 @@ public:
     bool IsOnResponseTimeoutCalled = false;
 };
 
+class RespondingAppDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        return ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
+class CountingDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ReceivedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    uint32_t ReceivedCount = 0;
+};
+
 class ExpireSessionFromTimeoutDelegate : public WaitForTimeoutDelegate
 {
     void OnResponseTimeout(ExchangeContext * ec) override
@@ -259,6 +294,133 @@ void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+void CheckUmhDispatchPrecedence(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err;
+    MockAppDelegate protocolDelegate;
+    MockAppDelegate typeDelegate;
+    MockAppDelegate otherDelegates[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
+    MockAppDelegate sendDelegate;
+
+    // Fill every remaining handler slot so that handlers share index buckets.
+    size_t registered = 0;
+    for (auto & delegate : otherDelegates)
+    {
+        uint8_t msgType = static_cast<uint8_t>(0x10 + registered);
+        if (ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, msgType, &delegate) !=
+            CHIP_NO_ERROR)
+        {
+            break;
+        }
+        registered++;
+    }
+    NL_TEST_ASSERT(inSuite, registered >= 2);
+
+    // Make room for the handlers under test.
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, 0x10);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, 0x11);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &protocolDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &typeDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST2, &typeDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS);
+
+    // A handler for the exact message type wins over the protocol handler.
+    ExchangeContext * ec = ctx.NewExchangeToAlice(&sendDelegate);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+    ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                    SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, typeDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, !protocolDelegate.IsOnMessageReceivedCalled);
+
+    // Other message types of the protocol go to the protocol handler.
+    typeDelegate.IsOnMessageReceivedCalled = false;
+    ec                                     = ctx.NewExchangeToAlice(&sendDelegate);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+    ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                    SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, !typeDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, protocolDelegate.IsOnMessageReceivedCalled);
+
+    // Re-registering an existing handler replaces it in place.
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &typeDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    for (size_t i = 2; i < registered; i++)
+    {
+        uint8_t msgType = static_cast<uint8_t>(0x10 + i);
+        err             = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, msgType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, 0x10);
+    NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+}
+
+void CheckDispatchWithManyExchanges(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Keep most of the exchange pool busy with idle exchanges, leaving room for one request/response pair.
+    constexpr size_t kIdleExchangeCount = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS - 4;
+    constexpr uint32_t kRoundTrips      = 100;
+
+    CountingDelegate idleDelegate;
+    ExchangeContext * idleExchanges[kIdleExchangeCount];
+    for (auto & idle : idleExchanges)
+    {
+        idle = ctx.NewExchangeToAlice(&idleDelegate);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, idle != nullptr);
+    }
+
+    RespondingAppDelegate responder;
+    CHIP_ERROR err =
+        ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &responder);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    CountingDelegate requester;
+    System::Clock::Milliseconds64 start = System::SystemClock().GetMonotonicMilliseconds64();
+    for (uint32_t i = 0; i < kRoundTrips; i++)
+    {
+        ExchangeContext * ec = ctx.NewExchangeToBob(&requester);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+        err = ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                              SendFlags(Messaging::SendMessageFlags::kExpectResponse)
+                                  .Set(Messaging::SendMessageFlags::kNoAutoRequestAck));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+    }
+    System::Clock::Milliseconds64 elapsed = System::SystemClock().GetMonotonicMilliseconds64() - start;
+
+    // Every response was matched to its requesting exchange, none to the idle ones.
+    NL_TEST_ASSERT(inSuite, requester.ReceivedCount == kRoundTrips);
+    NL_TEST_ASSERT(inSuite, idleDelegate.ReceivedCount == 0);
+    NL_TEST_ASSERT(inSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == kIdleExchangeCount);
+
+    ChipLogProgress(ExchangeManager, "%u round trips with %u idle exchanges took %u ms", static_cast<unsigned>(kRoundTrips),
+                    static_cast<unsigned>(kIdleExchangeCount), static_cast<unsigned>(elapsed.count()));
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (auto & idle : idleExchanges)
+    {
+        idle->Close();
+    }
+    NL_TEST_ASSERT(inSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 // Test Suite
 
 /**
@@ -270,6 +432,8 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test ExchangeMgr::NewContext",               CheckNewContextTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckUmhRegistrationTest", CheckUmhRegistrationTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
+    NL_TEST_DEF("Test unsolicited handler dispatch",          CheckUmhDispatchPrecedence),
+    NL_TEST_DEF("Test dispatch with many exchanges",          CheckDispatchWithManyExchanges),
     NL_TEST_DEF("Test OnConnectionExpired basics",            CheckSessionExpirationBasics),
     NL_TEST_DEF("Test OnConnectionExpired timeout handling",  CheckSessionExpirationTimeout),
     NL_TEST_DEF("Test session eviction in timeout handling",  CheckSessionExpirationDuringTimeout),
@@ -270,6 +270,19 @@ CHIP_ERROR ChipLinuxStorage::WriteValueBin(const char * key, const uint8_t * dat
     return retval;
 }
 
+CHIP_ERROR ChipLinuxStorage::ForEachValueBinWithPrefix(const char * prefix, PersistentStorageDelegate::KeyValueVisitor & visitor)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    mLock.lock();
+
+    retval = ChipLinuxStorageIni::ForEachBinaryBlobWithPrefix(prefix, visitor);
+
+    mLock.unlock();
+
+    return retval;
+}
+
 CHIP_ERROR ChipLinuxStorage::ClearValue(const char * key)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
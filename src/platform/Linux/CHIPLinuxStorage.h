@@ -82,6 +82,7 @@ public:
     CHIP_ERROR WriteValueStr(const char * key, const char * val);
     CHIP_ERROR WriteValueBin(const char * key, const uint8_t * data, size_t dataLen);
     CHIP_ERROR ClearValue(const char * key);
+    CHIP_ERROR ForEachValueBinWithPrefix(const char * prefix, PersistentStorageDelegate::KeyValueVisitor & visitor);
     CHIP_ERROR ClearAll();
     CHIP_ERROR Commit();
     bool HasValue(const char * key);
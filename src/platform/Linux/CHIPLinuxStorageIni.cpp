@@ -339,6 +339,44 @@ CHIP_ERROR ChipLinuxStorageIni::GetBinaryBlobValue(const char * key, uint8_t * d
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ChipLinuxStorageIni::ForEachBinaryBlobWithPrefix(const char * prefix,
+                                                            PersistentStorageDelegate::KeyValueVisitor & visitor)
+{
+    auto sectionIt = mConfigStore.sections.find("DEFAULT");
+    VerifyOrReturnError(sectionIt != mConfigStore.sections.end(), CHIP_NO_ERROR);
+
+    // Keys are escaped character by character, so the escaped keys with the escaped prefix are the keys with the prefix,
+    // and they are adjacent in the section.
+    const std::map<std::string, std::string> & section = sectionIt->second;
+    std::string escapedPrefix                           = EscapeKey(prefix);
+    chip::Platform::ScopedMemoryBuffer<uint8_t> decodedData;
+    size_t decodedDataSize = 0;
+
+    for (auto it = section.lower_bound(escapedPrefix);
+         it != section.end() && it->first.compare(0, escapedPrefix.size(), escapedPrefix) == 0; ++it)
+    {
+        std::string value;
+        VerifyOrReturnError(inipp::extract(it->second, value), CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(value.size() <= UINT16_MAX, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        uint16_t encodedDataLen = static_cast<uint16_t>(value.size());
+        size_t maxDecodedLen    = BASE64_MAX_DECODED_LEN(encodedDataLen);
+        if (decodedDataSize < maxDecodedLen)
+        {
+            VerifyOrReturnError(decodedData.Alloc(maxDecodedLen), CHIP_ERROR_NO_MEMORY);
+            decodedDataSize = maxDecodedLen;
+        }
+
+        uint16_t decodedDataLen = Base64Decode(value.data(), encodedDataLen, decodedData.Get());
+        VerifyOrReturnError(decodedDataLen != UINT16_MAX, CHIP_ERROR_DECODE_FAILED);
+
+        std::string key = UnescapeKey(it->first);
+        ReturnErrorOnFailure(visitor.OnKeyValue(key.c_str(), decodedData.Get(), decodedDataLen));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 bool ChipLinuxStorageIni::HasValue(const char * key)
 {
     std::map<std::string, std::string> section;
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <inipp/inipp.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/support/ScopedBuffer.h>
 #include <platform/PersistedStorage.h>
 
@@ -44,6 +45,7 @@ public:
     CHIP_ERROR GetUInt64Value(const char * key, uint64_t & val);
     CHIP_ERROR GetStringValue(const char * key, char * buf, size_t bufSize, size_t & outLen);
     CHIP_ERROR GetBinaryBlobValue(const char * key, uint8_t * decodedData, size_t bufSize, size_t & decodedDataLen);
+    CHIP_ERROR ForEachBinaryBlobWithPrefix(const char * prefix, PersistentStorageDelegate::KeyValueVisitor & visitor);
     bool HasValue(const char * key);
 
 protected:
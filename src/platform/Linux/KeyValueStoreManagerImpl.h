@@ -41,6 +41,10 @@ public:
     CHIP_ERROR _Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
+    CHIP_ERROR _ForEachKeyValueWithPrefix(const char * prefix, PersistentStorageDelegate::KeyValueVisitor & visitor)
+    {
+        return mStorage.ForEachValueBinWithPrefix(prefix, visitor);
+    }
 
 private:
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
@@ -24,7 +24,10 @@
 
 #include <nlunit-test.h>
 
+#include <string.h>
+
 #include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestRegistration.h>
 
 #include <platform/CHIPDeviceLayer.h>
@@ -286,6 +289,54 @@ static void TestKeyValueStoreMgr_MultiRead(nlTestSuite * inSuite, void * inConte
 }
 #endif
 
+namespace {
+
+class CollectingVisitor : public PersistentStorageDelegate::KeyValueVisitor
+{
+public:
+    CHIP_ERROR OnKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        if (size == sizeof(uint32_t))
+        {
+            uint32_t entryValue;
+            memcpy(&entryValue, value, sizeof(entryValue));
+            mValueSum += entryValue;
+        }
+        mCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t mCount      = 0;
+    uint32_t mValueSum = 0;
+};
+
+} // namespace
+
+static void TestKeyValueStoreMgr_ForEachKeyValueWithPrefix(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr const char * kTestKeys[] = { "g/a/1/6/0", "g/a/1/8/0", "g/a/1/8/4000", "g/a/10/6/0", "g/b/1" };
+
+    for (uint32_t i = 0; i < ArraySize(kTestKeys); i++)
+    {
+        NL_TEST_ASSERT(inSuite, KeyValueStoreMgr().Put(kTestKeys[i], uint32_t(1) << i) == CHIP_NO_ERROR);
+    }
+
+    CollectingVisitor visitor;
+    CHIP_ERROR err = KeyValueStoreMgr().ForEachKeyValueWithPrefix("g/a/1/", visitor);
+    if (err != CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        // Only the entries of the first three keys match.
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, visitor.mCount == 3);
+        NL_TEST_ASSERT(inSuite, visitor.mValueSum == 0x7);
+    }
+
+    for (const char * key : kTestKeys)
+    {
+        NL_TEST_ASSERT(inSuite, KeyValueStoreMgr().Delete(key) == CHIP_NO_ERROR);
+    }
+}
+
 #ifdef __ZEPHYR__
 static void TestKeyValueStoreMgr_DoFactoryReset(nlTestSuite * inSuite, void * inContext)
 {
@@ -319,6 +370,8 @@ static const nlTest sTests[] = { NL_TEST_DEF("Test KeyValueStoreMgr_EmptyString"
                                  NL_TEST_DEF("Test KeyValueStoreMgr_TooSmallBufferRead", TestKeyValueStoreMgr_TooSmallBufferRead),
                                  NL_TEST_DEF("Test KeyValueStoreMgr_AllCharactersKey", TestKeyValueStoreMgr_AllCharactersKey),
                                  NL_TEST_DEF("Test KeyValueStoreMgr_NonExistentDelete", TestKeyValueStoreMgr_NonExistentDelete),
+                                 NL_TEST_DEF("Test KeyValueStoreMgr_ForEachKeyValueWithPrefix",
+                                             TestKeyValueStoreMgr_ForEachKeyValueWithPrefix),
 #if !defined(__ZEPHYR__) && !defined(__MBED__)
                                  // Zephyr and Mbed platforms do not support partial or offset reads yet.
                                  NL_TEST_DEF("Test KeyValueStoreMgr_MultiRead", TestKeyValueStoreMgr_MultiRead),
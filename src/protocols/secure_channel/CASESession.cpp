@@ -1632,7 +1632,8 @@ CHIP_ERROR CASESession::HandleSigma3a(System::PacketBufferHandle && msg)
 
         // Copy remaining needed data into work structure
         {
-            data.validContext = mValidContext;
+            data.validContext                     = mValidContext;
+            data.validContext.mValidatedLinkCache = &mFabricsTable->GetValidatedCertLinkCache();
 
             // initiatorNOC and initiatorICAC are spans into msg_R3_Encrypted
             // which is going away, so to save memory, redirect them to their
@@ -20,11 +20,28 @@
 #include <lib/support/Base64.h>
 #include <lib/support/SafeInt.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace chip {
 
+namespace {
+
+// 2^64 divided by the golden ratio, for Fibonacci hashing.
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15;
+
+} // namespace
+
 CHIP_ERROR DefaultSessionResumptionStorage::FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
                                                                Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
 {
+    if (mInMemoryIndex != nullptr)
+    {
+        // Fail as LoadState would for a node that is not stored.
+        ReturnErrorOnFailure(LoadInMemoryIndexIfNeeded());
+        size_t position;
+        VerifyOrReturnError(mInMemoryIndex->FindPosition(node, position), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    }
     ReturnErrorOnFailure(LoadState(node, resumptionId, sharedSecret, peerCATs));
     return CHIP_NO_ERROR;
 }
@@ -42,6 +59,15 @@ CHIP_ERROR DefaultSessionResumptionStorage::FindByResumptionId(ConstResumptionId
 
 CHIP_ERROR DefaultSessionResumptionStorage::FindNodeByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node)
 {
+    if (mInMemoryIndex != nullptr)
+    {
+        // Fail as LoadLink would for a resumption ID that is not stored.
+        ReturnErrorOnFailure(LoadInMemoryIndexIfNeeded());
+        size_t position;
+        VerifyOrReturnError(mInMemoryIndex->FindPosition(resumptionId, position), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        node = mInMemoryIndex->mIndex.mNodes[position];
+        return CHIP_NO_ERROR;
+    }
     ReturnErrorOnFailure(LoadLink(resumptionId, node));
     return CHIP_NO_ERROR;
 }
@@ -49,158 +75,131 @@ CHIP_ERROR DefaultSessionResumptionStorage::FindNodeByResumptionId(ConstResumpti
 CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
                                                  const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
 {
-    SessionIndex index;
-    ReturnErrorOnFailure(LoadIndex(index));
+    SessionIndex scratch;
+    SessionIndex * index;
+    ReturnErrorOnFailure(AccessIndex(scratch, index));
 
-    for (size_t i = 0; i < index.mSize; ++i)
+    size_t position;
+    if (FindPosition(*index, node, position))
     {
-        if (index.mNodes[i] == node)
+        // Node already exists in the index.  Save in place.
+        //
+        // Removal of the old resumption-id-keyed link is best effort.  If we
+        // cannot load state to lookup the resumption ID for the key, the
+        // entry in the link table will be leaked.
+        ResumptionIdStorage oldResumptionId;
+        const ResumptionIdStorage * knownResumptionId = GetKnownResumptionId(position);
+        CHIP_ERROR err                                = CHIP_NO_ERROR;
+        if (knownResumptionId != nullptr)
+        {
+            oldResumptionId = *knownResumptionId;
+        }
+        else
         {
-            // Node already exists in the index.  Save in place.
-            CHIP_ERROR err = CHIP_NO_ERROR;
-            ResumptionIdStorage oldResumptionId;
             Crypto::P256ECDHDerivedSecret oldSharedSecret;
             CATValues oldPeerCATs;
-            // This follows the approach in Delete.  Removal of the old
-            // resumption-id-keyed link is best effort.  If we cannot load
-            // state to lookup the resumption ID for the key, the entry in
-            // the link table will be leaked.
             err = LoadState(node, oldResumptionId, oldSharedSecret, oldPeerCATs);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(SecureChannel,
+                         "LoadState failed; unable to fully delete session resumption record for node " ChipLogFormatX64
+                         ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueX64(node.GetNodeId()), err.Format());
+        }
+        else
+        {
+            err = DeleteLink(oldResumptionId);
             if (err != CHIP_NO_ERROR)
             {
                 ChipLogError(SecureChannel,
-                             "LoadState failed; unable to fully delete session resumption record for node " ChipLogFormatX64
+                             "DeleteLink failed; unable to fully delete session resumption record for node " ChipLogFormatX64
                              ": %" CHIP_ERROR_FORMAT,
                              ChipLogValueX64(node.GetNodeId()), err.Format());
             }
-            else
-            {
-                err = DeleteLink(oldResumptionId);
-                if (err != CHIP_NO_ERROR)
-                {
-                    ChipLogError(SecureChannel,
-                                 "DeleteLink failed; unable to fully delete session resumption record for node " ChipLogFormatX64
-                                 ": %" CHIP_ERROR_FORMAT,
-                                 ChipLogValueX64(node.GetNodeId()), err.Format());
-                }
-            }
-            ReturnErrorOnFailure(SaveState(node, resumptionId, sharedSecret, peerCATs));
-            ReturnErrorOnFailure(SaveLink(resumptionId, node));
-            return CHIP_NO_ERROR;
         }
+
+        // Until the new state is saved, the node cannot be found by resumption ID.
+        if (mInMemoryIndex != nullptr)
+        {
+            mInMemoryIndex->mHasResumptionId[position] = false;
+        }
+        ReturnErrorOnFailure(SaveState(node, resumptionId, sharedSecret, peerCATs));
+        ReturnErrorOnFailure(SaveLink(resumptionId, node));
+        SetKnownResumptionId(position, resumptionId);
+        return CHIP_NO_ERROR;
     }
 
-    if (index.mSize == CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE)
+    if (index->mSize == CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE)
     {
         // TODO: implement LRU for resumption
-        ReturnErrorOnFailure(Delete(index.mNodes[0]));
-        ReturnErrorOnFailure(LoadIndex(index));
+        RemoveNode(*index, 0);
     }
 
     ReturnErrorOnFailure(SaveState(node, resumptionId, sharedSecret, peerCATs));
     ReturnErrorOnFailure(SaveLink(resumptionId, node));
 
-    index.mNodes[index.mSize++] = node;
-    ReturnErrorOnFailure(SaveIndex(index));
+    position                = index->mSize++;
+    index->mNodes[position] = node;
+    CHIP_ERROR err          = SaveIndex(*index);
+    if (err != CHIP_NO_ERROR)
+    {
+        index->mSize = position;
+        return err;
+    }
+    SetKnownResumptionId(position, resumptionId);
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DefaultSessionResumptionStorage::Delete(const ScopedNodeId & node)
 {
-    SessionIndex index;
-    ReturnErrorOnFailure(LoadIndex(index));
-
-    ResumptionIdStorage resumptionId;
-    Crypto::P256ECDHDerivedSecret sharedSecret;
-    CATValues peerCATs;
-    CHIP_ERROR err = LoadState(node, resumptionId, sharedSecret, peerCATs);
-    if (err == CHIP_NO_ERROR)
-    {
-        err = DeleteLink(resumptionId);
-        if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
-        {
-            ChipLogError(SecureChannel,
-                         "Unable to delete session resumption link for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
-                         ChipLogValueX64(node.GetNodeId()), err.Format());
-        }
-    }
-    else if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
-    {
-        ChipLogError(SecureChannel,
-                     "Unable to load session resumption state during session deletion for node " ChipLogFormatX64
-                     ": %" CHIP_ERROR_FORMAT,
-                     ChipLogValueX64(node.GetNodeId()), err.Format());
-    }
-
-    err = DeleteState(node);
-    if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
-    {
-        ChipLogError(SecureChannel, "Unable to delete session resumption state for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
-                     ChipLogValueX64(node.GetNodeId()), err.Format());
-    }
+    SessionIndex scratch;
+    SessionIndex * index;
+    ReturnErrorOnFailure(AccessIndex(scratch, index));
 
-    bool found = false;
-    for (size_t i = 0; i < index.mSize; ++i)
+    size_t position;
+    if (!FindPosition(*index, node, position))
     {
-        if (found)
-        {
-            // index.mSize was decreased by 1 when found was set to true.
-            // So the (i+1)th element isn't out of bounds.
-            index.mNodes[i] = index.mNodes[i + 1];
-        }
-        else
-        {
-            if (index.mNodes[i] == node)
-            {
-                found = true;
-                if (i + 1 < index.mSize)
-                {
-                    index.mNodes[i] = index.mNodes[i + 1];
-                }
-                index.mSize -= 1;
-            }
-        }
-    }
-
-    if (found)
-    {
-        err = SaveIndex(index);
-        if (err != CHIP_NO_ERROR)
-        {
-            ChipLogError(SecureChannel, "Unable to save session resumption index: %" CHIP_ERROR_FORMAT, err.Format());
-        }
-    }
-    else
-    {
-        ChipLogError(SecureChannel,
-                     "Unable to find session resumption state for node in index" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
-                     ChipLogValueX64(node.GetNodeId()), err.Format());
+        DeleteStorage(node, nullptr);
+        ChipLogError(SecureChannel, "Unable to find session resumption state for node in index" ChipLogFormatX64,
+                     ChipLogValueX64(node.GetNodeId()));
+        return CHIP_NO_ERROR;
     }
 
+    RemoveNode(*index, position);
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
 {
     CHIP_ERROR stickyErr = CHIP_NO_ERROR;
-    size_t found         = 0;
-    SessionIndex index;
-    ReturnErrorOnFailure(LoadIndex(index));
-    size_t initialSize = index.mSize;
-    for (size_t i = 0; i < initialSize; ++i)
+    bool found           = false;
+    SessionIndex scratch;
+    SessionIndex * index;
+    ReturnErrorOnFailure(AccessIndex(scratch, index));
+
+    for (size_t cur = 0; cur < index->mSize;)
     {
         CHIP_ERROR err = CHIP_NO_ERROR;
-        size_t cur     = i - found;
-        size_t remain  = initialSize - i;
         ResumptionIdStorage resumptionId;
-        Crypto::P256ECDHDerivedSecret sharedSecret;
-        CATValues peerCATs;
-        if (index.mNodes[cur].GetFabricIndex() != fabricIndex)
+        const ScopedNodeId & node = index->mNodes[cur];
+        if (node.GetFabricIndex() != fabricIndex)
         {
+            ++cur;
             continue;
         }
-        err       = LoadState(index.mNodes[cur], resumptionId, sharedSecret, peerCATs);
+        const ResumptionIdStorage * knownResumptionId = GetKnownResumptionId(cur);
+        if (knownResumptionId != nullptr)
+        {
+            resumptionId = *knownResumptionId;
+        }
+        else
+        {
+            Crypto::P256ECDHDerivedSecret sharedSecret;
+            CATValues peerCATs;
+            err = LoadState(node, resumptionId, sharedSecret, peerCATs);
+        }
         stickyErr = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
         if (err != CHIP_NO_ERROR)
         {
@@ -208,6 +207,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
                          "Session resumption cache deletion partially failed for fabric index %u, "
                          "unable to load node state: %" CHIP_ERROR_FORMAT,
                          fabricIndex, err.Format());
+            ++cur;
             continue;
         }
         err       = DeleteLink(resumptionId);
@@ -218,9 +218,10 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
                          "Session resumption cache deletion partially failed for fabric index %u, "
                          "unable to delete node link: %" CHIP_ERROR_FORMAT,
                          fabricIndex, err.Format());
+            ++cur;
             continue;
         }
-        err       = DeleteState(index.mNodes[cur]);
+        err       = DeleteState(node);
         stickyErr = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
         if (err != CHIP_NO_ERROR)
         {
@@ -228,19 +229,15 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
                          "Session resumption cache is in an inconsistent state!  "
                          "Unable to delete node state during attempted deletion of fabric index %u: %" CHIP_ERROR_FORMAT,
                          fabricIndex, err.Format());
+            ++cur;
             continue;
         }
-        ++found;
-        --remain;
-        if (remain)
-        {
-            memmove(&index.mNodes[cur], &index.mNodes[cur + 1], remain * sizeof(index.mNodes[0]));
-        }
+        RemoveFromIndex(*index, cur);
+        found = true;
     }
     if (found)
     {
-        index.mSize -= found;
-        CHIP_ERROR err = SaveIndex(index);
+        CHIP_ERROR err = SaveIndex(*index);
         stickyErr      = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
         if (err != CHIP_NO_ERROR)
         {
@@ -254,4 +251,218 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
     return stickyErr;
 }
 
+CHIP_ERROR DefaultSessionResumptionStorage::AccessIndex(SessionIndex & scratch, SessionIndex *& index)
+{
+    if (mInMemoryIndex != nullptr)
+    {
+        ReturnErrorOnFailure(LoadInMemoryIndexIfNeeded());
+        index = &mInMemoryIndex->mIndex;
+        return CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(LoadIndex(scratch));
+    index = &scratch;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DefaultSessionResumptionStorage::LoadInMemoryIndexIfNeeded()
+{
+    VerifyOrReturnError(!mInMemoryIndex->mLoaded, CHIP_NO_ERROR);
+    SessionIndex & index = mInMemoryIndex->mIndex;
+    ReturnErrorOnFailure(LoadIndex(index));
+
+    // The index only holds the nodes, so their resumption IDs come from their state.
+    for (size_t i = 0; i < index.mSize; ++i)
+    {
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+        CHIP_ERROR err = LoadState(index.mNodes[i], mInMemoryIndex->mResumptionIds[i], sharedSecret, peerCATs);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(SecureChannel,
+                         "Unable to load session resumption state for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueX64(index.mNodes[i].GetNodeId()), err.Format());
+        }
+        mInMemoryIndex->mHasResumptionId[i] = (err == CHIP_NO_ERROR);
+    }
+
+    mInMemoryIndex->RebuildHashTables();
+    mInMemoryIndex->mLoaded = true;
+    return CHIP_NO_ERROR;
+}
+
+bool DefaultSessionResumptionStorage::FindPosition(const SessionIndex & index, const ScopedNodeId & node, size_t & position) const
+{
+    if (mInMemoryIndex != nullptr)
+    {
+        return mInMemoryIndex->FindPosition(node, position);
+    }
+    for (size_t i = 0; i < index.mSize; ++i)
+    {
+        if (index.mNodes[i] == node)
+        {
+            position = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+DefaultSessionResumptionStorage::ResumptionIdStorage * DefaultSessionResumptionStorage::GetKnownResumptionId(size_t position)
+{
+    if (mInMemoryIndex == nullptr || !mInMemoryIndex->mHasResumptionId[position])
+    {
+        return nullptr;
+    }
+    return &mInMemoryIndex->mResumptionIds[position];
+}
+
+void DefaultSessionResumptionStorage::SetKnownResumptionId(size_t position, ConstResumptionIdView resumptionId)
+{
+    VerifyOrReturn(mInMemoryIndex != nullptr);
+    std::copy(resumptionId.begin(), resumptionId.end(), mInMemoryIndex->mResumptionIds[position].begin());
+    mInMemoryIndex->mHasResumptionId[position] = true;
+    mInMemoryIndex->RebuildHashTables();
+}
+
+void DefaultSessionResumptionStorage::RemoveNode(SessionIndex & index, size_t position)
+{
+    DeleteStorage(index.mNodes[position], GetKnownResumptionId(position));
+    RemoveFromIndex(index, position);
+
+    CHIP_ERROR err = SaveIndex(index);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to save session resumption index: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void DefaultSessionResumptionStorage::RemoveFromIndex(SessionIndex & index, size_t position)
+{
+    size_t remain = index.mSize - position - 1;
+    memmove(&index.mNodes[position], &index.mNodes[position + 1], remain * sizeof(index.mNodes[0]));
+    index.mSize -= 1;
+
+    VerifyOrReturn(mInMemoryIndex != nullptr);
+    memmove(&mInMemoryIndex->mResumptionIds[position], &mInMemoryIndex->mResumptionIds[position + 1],
+            remain * sizeof(mInMemoryIndex->mResumptionIds[0]));
+    memmove(&mInMemoryIndex->mHasResumptionId[position], &mInMemoryIndex->mHasResumptionId[position + 1],
+            remain * sizeof(mInMemoryIndex->mHasResumptionId[0]));
+    mInMemoryIndex->RebuildHashTables();
+}
+
+void DefaultSessionResumptionStorage::DeleteStorage(const ScopedNodeId & node, ResumptionIdStorage * resumptionId)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    ResumptionIdStorage storedResumptionId;
+    if (resumptionId == nullptr)
+    {
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+        err          = LoadState(node, storedResumptionId, sharedSecret, peerCATs);
+        resumptionId = &storedResumptionId;
+    }
+
+    if (err == CHIP_NO_ERROR)
+    {
+        err = DeleteLink(*resumptionId);
+        if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            ChipLogError(SecureChannel,
+                         "Unable to delete session resumption link for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueX64(node.GetNodeId()), err.Format());
+        }
+    }
+    else if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        ChipLogError(SecureChannel,
+                     "Unable to load session resumption state during session deletion for node " ChipLogFormatX64
+                     ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueX64(node.GetNodeId()), err.Format());
+    }
+
+    err = DeleteState(node);
+    if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        ChipLogError(SecureChannel, "Unable to delete session resumption state for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueX64(node.GetNodeId()), err.Format());
+    }
+}
+
+size_t DefaultSessionResumptionStorage::InMemoryIndex::Hash(const ScopedNodeId & node)
+{
+    uint64_t key = node.GetNodeId() ^ (static_cast<uint64_t>(node.GetFabricIndex()) << 56);
+    return static_cast<size_t>((key * kHashMultiplier) >> 32);
+}
+
+size_t DefaultSessionResumptionStorage::InMemoryIndex::Hash(ConstResumptionIdView resumptionId)
+{
+    // Resumption IDs are random, so folding them into 64 bits keeps them well distributed.
+    static_assert(kResumptionIdSize == 2 * sizeof(uint64_t), "Resumption IDs are folded from two 64-bit halves");
+    uint64_t low;
+    uint64_t high;
+    memcpy(&low, resumptionId.data(), sizeof(low));
+    memcpy(&high, resumptionId.data() + sizeof(low), sizeof(high));
+    return static_cast<size_t>(((low ^ high) * kHashMultiplier) >> 32);
+}
+
+void DefaultSessionResumptionStorage::InMemoryIndex::AddToHashTables(size_t position)
+{
+    size_t bucket = Hash(mIndex.mNodes[position]) % kHashTableSize;
+    while (mNodeHashTable[bucket] != kEmptyBucket)
+    {
+        bucket = (bucket + 1) % kHashTableSize;
+    }
+    mNodeHashTable[bucket] = static_cast<uint16_t>(position + 1);
+
+    VerifyOrReturn(mHasResumptionId[position]);
+    bucket = Hash(mResumptionIds[position]) % kHashTableSize;
+    while (mResumptionIdHashTable[bucket] != kEmptyBucket)
+    {
+        bucket = (bucket + 1) % kHashTableSize;
+    }
+    mResumptionIdHashTable[bucket] = static_cast<uint16_t>(position + 1);
+}
+
+void DefaultSessionResumptionStorage::InMemoryIndex::RebuildHashTables()
+{
+    std::fill(std::begin(mNodeHashTable), std::end(mNodeHashTable), kEmptyBucket);
+    std::fill(std::begin(mResumptionIdHashTable), std::end(mResumptionIdHashTable), kEmptyBucket);
+    for (size_t i = 0; i < mIndex.mSize; ++i)
+    {
+        AddToHashTables(i);
+    }
+}
+
+bool DefaultSessionResumptionStorage::InMemoryIndex::FindPosition(const ScopedNodeId & node, size_t & position) const
+{
+    for (size_t bucket = Hash(node) % kHashTableSize; mNodeHashTable[bucket] != kEmptyBucket;
+         bucket        = (bucket + 1) % kHashTableSize)
+    {
+        size_t candidate = mNodeHashTable[bucket] - 1u;
+        if (mIndex.mNodes[candidate] == node)
+        {
+            position = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DefaultSessionResumptionStorage::InMemoryIndex::FindPosition(ConstResumptionIdView resumptionId, size_t & position) const
+{
+    for (size_t bucket = Hash(resumptionId) % kHashTableSize; mResumptionIdHashTable[bucket] != kEmptyBucket;
+         bucket        = (bucket + 1) % kHashTableSize)
+    {
+        size_t candidate = mResumptionIdHashTable[bucket] - 1u;
+        const ResumptionIdStorage & candidateResumptionId = mResumptionIds[candidate];
+        if (mHasResumptionId[candidate] &&
+            std::equal(resumptionId.begin(), resumptionId.end(), candidateResumptionId.begin(), candidateResumptionId.end()))
+        {
+            position = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace chip
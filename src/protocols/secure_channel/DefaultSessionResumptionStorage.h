@@ -29,6 +29,11 @@ namespace chip {
  *   The implementation saves 2 maps:
  *     * <FabricIndex, PeerNodeId>   => <ResumptionId, ShareSecret, PeerCATs>
  *     * <ResumptionId>              => <FabricIndex, PeerNodeId>
+ *
+ *   The index of stored nodes is a single storage entry, which is written whenever nodes are added or removed.  Updating the
+ *   state of a node already in the index does not write it.
+ *
+ *   An implementation may also keep a copy of the index in memory, see InMemoryIndex.
  */
 class DefaultSessionResumptionStorage : public SessionResumptionStorage
 {
@@ -41,6 +46,40 @@ public:
         ScopedNodeId mNodes[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
     };
 
+    /**
+     * A copy of the index kept in memory, along with the ResumptionId of each node and a hash table over each of the 2 keys.
+     * It is loaded from storage on first use, and then lets lookups by either key read the storage only for an entry that
+     * exists.  It costs about 40 bytes of RAM per entry of CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE.
+     */
+    class InMemoryIndex
+    {
+    private:
+        friend class DefaultSessionResumptionStorage;
+
+        static_assert(CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE < UINT16_MAX, "Index positions must fit in the hash tables");
+
+        // Keep the hash tables at most half full, so that probe sequences stay short.
+        static constexpr size_t kHashTableSize = 2 * CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE;
+        // Hash table buckets hold an index position plus one, so that zero marks an empty bucket.
+        static constexpr uint16_t kEmptyBucket = 0;
+
+        static size_t Hash(const ScopedNodeId & node);
+        static size_t Hash(ConstResumptionIdView resumptionId);
+
+        void AddToHashTables(size_t position);
+        void RebuildHashTables();
+        bool FindPosition(const ScopedNodeId & node, size_t & position) const;
+        bool FindPosition(ConstResumptionIdView resumptionId, size_t & position) const;
+
+        bool mLoaded = false;
+        SessionIndex mIndex;
+        // ResumptionId of each node in mIndex, if its state could be loaded.
+        ResumptionIdStorage mResumptionIds[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+        bool mHasResumptionId[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+        uint16_t mNodeHashTable[kHashTableSize];
+        uint16_t mResumptionIdHashTable[kHashTableSize];
+    };
+
     virtual ~DefaultSessionResumptionStorage() {}
 
     CHIP_ERROR FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
@@ -66,6 +105,39 @@ protected:
     CHIP_ERROR virtual LoadState(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)             = 0;
     CHIP_ERROR virtual DeleteState(const ScopedNodeId & node)                                                    = 0;
+
+    /**
+     * Keep a copy of the index in `index`, or stop keeping one if it is null.  The index is loaded from storage on next use.
+     */
+    void UseInMemoryIndex(InMemoryIndex * index)
+    {
+        mInMemoryIndex = index;
+        InvalidateIndex();
+    }
+
+    /**
+     * Drop the index kept in memory, so that it is loaded again from storage on next use.  Needs to be called when the
+     * storage backing this object changes.
+     */
+    void InvalidateIndex()
+    {
+        if (mInMemoryIndex != nullptr)
+        {
+            mInMemoryIndex->mLoaded = false;
+        }
+    }
+
+private:
+    CHIP_ERROR AccessIndex(SessionIndex & scratch, SessionIndex *& index);
+    CHIP_ERROR LoadInMemoryIndexIfNeeded();
+    bool FindPosition(const SessionIndex & index, const ScopedNodeId & node, size_t & position) const;
+    ResumptionIdStorage * GetKnownResumptionId(size_t position);
+    void SetKnownResumptionId(size_t position, ConstResumptionIdView resumptionId);
+    void RemoveNode(SessionIndex & index, size_t position);
+    void RemoveFromIndex(SessionIndex & index, size_t position);
+    void DeleteStorage(const ScopedNodeId & node, ResumptionIdStorage * resumptionId);
+
+    InMemoryIndex * mInMemoryIndex = nullptr;
 };
 
 } // namespace chip
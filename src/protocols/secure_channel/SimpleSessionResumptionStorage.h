@@ -36,10 +36,15 @@ namespace chip {
 class SimpleSessionResumptionStorage : public DefaultSessionResumptionStorage
 {
 public:
+#if CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY
+    SimpleSessionResumptionStorage() { UseInMemoryIndex(&mInMemoryIndexStorage); }
+#endif
+
     CHIP_ERROR Init(PersistentStorageDelegate * storage)
     {
         VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
         mStorage = storage;
+        InvalidateIndex();
         return CHIP_NO_ERROR;
     }
 
@@ -81,6 +86,9 @@ private:
     static constexpr TLV::Tag kCATTag          = TLV::ContextTag(5);
 
     PersistentStorageDelegate * mStorage;
+#if CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY
+    InMemoryIndex mInMemoryIndexStorage;
+#endif
 };
 
 } // namespace chip
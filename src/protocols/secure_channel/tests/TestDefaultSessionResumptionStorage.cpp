@@ -19,14 +19,28 @@
 #include <lib/support/TestPersistentStorageDelegate.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
+#include <system/SystemClock.h>
 
 // DefaultSessionResumptionStorage is a partial implementation.
 // Use SimpleSessionResumptionStorage, which extends it, to test.
 #include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
 
+namespace {
+
+// SimpleSessionResumptionStorage keeps its index in memory when CHIP_CONFIG_CASE_SESSION_RESUME_INDEX_IN_MEMORY is
+// enabled.  The tests also run against this one, which reads it from storage on every use, so that both ways are covered.
+class IndexInStorageSessionResumptionStorage : public chip::SimpleSessionResumptionStorage
+{
+public:
+    IndexInStorageSessionResumptionStorage() { UseInMemoryIndex(nullptr); }
+};
+
+} // namespace
+
+template <typename StorageType>
 void TestSave(nlTestSuite * inSuite, void * inContext)
 {
-    chip::SimpleSessionResumptionStorage sessionStorage;
+    StorageType sessionStorage;
     chip::TestPersistentStorageDelegate storage;
     sessionStorage.Init(&storage);
     struct
@@ -110,9 +124,10 @@ void TestSave(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+template <typename StorageType>
 void TestInPlaceSave(nlTestSuite * inSuite, void * inContext)
 {
-    chip::SimpleSessionResumptionStorage sessionStorage;
+    StorageType sessionStorage;
     chip::TestPersistentStorageDelegate storage;
     sessionStorage.Init(&storage);
     struct
@@ -279,9 +294,10 @@ void TestInPlaceSave(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+template <typename StorageType>
 void TestDelete(nlTestSuite * inSuite, void * inContext)
 {
-    chip::SimpleSessionResumptionStorage sessionStorage;
+    StorageType sessionStorage;
     chip::TestPersistentStorageDelegate storage;
     sessionStorage.Init(&storage);
     chip::Crypto::P256ECDHDerivedSecret sharedSecret;
@@ -343,9 +359,10 @@ void TestDelete(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+template <typename StorageType>
 void TestDeleteAll(nlTestSuite * inSuite, void * inContext)
 {
-    chip::SimpleSessionResumptionStorage sessionStorage;
+    StorageType sessionStorage;
     chip::TestPersistentStorageDelegate storage;
     sessionStorage.Init(&storage);
     chip::Crypto::P256ECDHDerivedSecret sharedSecret;
@@ -429,6 +446,187 @@ void TestDeleteAll(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+template <typename StorageType>
+void TestReload(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    struct
+    {
+        chip::SessionResumptionStorage::ResumptionIdStorage resumptionId;
+        chip::ScopedNodeId node;
+    } vectors[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+
+    // Create a shared secret.  We can use the same one for all entries.
+    sharedSecret.SetLength(sharedSecret.Capacity());
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length()));
+
+    // Populate test vectors.
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        NL_TEST_ASSERT(
+            inSuite, CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(vectors[i].resumptionId.data(), vectors[i].resumptionId.size()));
+        *vectors[i].resumptionId.data() = static_cast<uint8_t>(i);
+        vectors[i].node = chip::ScopedNodeId(static_cast<chip::NodeId>(i + 1), static_cast<chip::FabricIndex>(i + 1));
+    }
+
+    // Fill storage, then delete the first entry.
+    {
+        StorageType sessionStorage;
+        sessionStorage.Init(&storage);
+        for (auto & vector : vectors)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           sessionStorage.Save(vector.node, vector.resumptionId, sharedSecret, chip::CATValues{}) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, sessionStorage.Delete(vectors[0].node) == CHIP_NO_ERROR);
+    }
+
+    // The index of the first instance must have been persisted.
+    StorageType sessionStorage;
+    sessionStorage.Init(&storage);
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        chip::ScopedNodeId outNode;
+        chip::SessionResumptionStorage::ResumptionIdStorage outResumptionId;
+        chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+        chip::CATValues outCats;
+        bool expectFound = i != 0;
+        NL_TEST_ASSERT(inSuite,
+                       (sessionStorage.FindByScopedNodeId(vectors[i].node, outResumptionId, outSharedSecret, outCats) ==
+                        CHIP_NO_ERROR) == expectFound);
+        NL_TEST_ASSERT(inSuite,
+                       (sessionStorage.FindByResumptionId(vectors[i].resumptionId, outNode, outSharedSecret, outCats) ==
+                        CHIP_NO_ERROR) == expectFound);
+        NL_TEST_ASSERT(inSuite, i == 0 || outNode == vectors[i].node);
+    }
+
+    // Saving a new entry must not evict any of the reloaded ones.
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.Save(vectors[0].node, vectors[0].resumptionId, sharedSecret, chip::CATValues{}) == CHIP_NO_ERROR);
+    for (auto & vector : vectors)
+    {
+        chip::SessionResumptionStorage::ResumptionIdStorage outResumptionId;
+        chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+        chip::CATValues outCats;
+        NL_TEST_ASSERT(inSuite,
+                       sessionStorage.FindByScopedNodeId(vector.node, outResumptionId, outSharedSecret, outCats) == CHIP_NO_ERROR);
+    }
+}
+
+template <typename StorageType>
+void TestNotFound(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    StorageType sessionStorage;
+    sessionStorage.Init(&storage);
+
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    sharedSecret.SetLength(sharedSecret.Capacity());
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length()));
+    chip::SessionResumptionStorage::ResumptionIdStorage resumptionId;
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(resumptionId.data(), resumptionId.size()));
+    chip::SessionResumptionStorage::ResumptionIdStorage unknownResumptionId = resumptionId;
+    unknownResumptionId[0] ^= 0xff;
+
+    chip::ScopedNodeId node(1, 1);
+    chip::ScopedNodeId unknownNode(2, 1);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Save(node, resumptionId, sharedSecret, chip::CATValues{}) == CHIP_NO_ERROR);
+
+    // Entries that are not stored are reported with the error of the storage, whether the index is kept in memory or not.
+    chip::ScopedNodeId outNode;
+    chip::SessionResumptionStorage::ResumptionIdStorage outResumptionId;
+    chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+    chip::CATValues outCats;
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.FindByScopedNodeId(unknownNode, outResumptionId, outSharedSecret, outCats) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.FindByResumptionId(unknownResumptionId, outNode, outSharedSecret, outCats) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, sessionStorage.Delete(node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.FindByScopedNodeId(node, outResumptionId, outSharedSecret, outCats) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.FindByResumptionId(resumptionId, outNode, outSharedSecret, outCats) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+template <typename StorageType>
+void TestLookupBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kEntryCounts[] = { 10, CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE };
+    constexpr size_t kIterations    = 1000;
+
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    sharedSecret.SetLength(sharedSecret.Capacity());
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length()));
+
+    for (size_t entryCount : kEntryCounts)
+    {
+        StorageType sessionStorage;
+        chip::TestPersistentStorageDelegate storage;
+        sessionStorage.Init(&storage);
+
+        chip::SessionResumptionStorage::ResumptionIdStorage resumptionIds[CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE];
+        for (size_t i = 0; i < entryCount; ++i)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(resumptionIds[i].data(), resumptionIds[i].size()));
+            chip::ScopedNodeId node(static_cast<chip::NodeId>(i + 1), static_cast<chip::FabricIndex>(i % 16 + 1));
+            NL_TEST_ASSERT(inSuite, sessionStorage.Save(node, resumptionIds[i], sharedSecret, chip::CATValues{}) == CHIP_NO_ERROR);
+        }
+
+        chip::SessionResumptionStorage::ResumptionIdStorage unknownResumptionId;
+        NL_TEST_ASSERT(inSuite,
+                       CHIP_NO_ERROR == chip::Crypto::DRBG_get_bytes(unknownResumptionId.data(), unknownResumptionId.size()));
+
+        chip::ScopedNodeId outNode;
+        chip::SessionResumptionStorage::ResumptionIdStorage outResumptionId;
+        chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+        chip::CATValues outCats;
+
+        // Sigma1 with a resumption ID that is known, then one that is not.
+        uint64_t start = chip::System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (size_t i = 0; i < kIterations; ++i)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           sessionStorage.FindByResumptionId(resumptionIds[i % entryCount], outNode, outSharedSecret, outCats) ==
+                               CHIP_NO_ERROR);
+        }
+        uint64_t hitDuration = chip::System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+        start = chip::System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (size_t i = 0; i < kIterations; ++i)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           sessionStorage.FindByResumptionId(unknownResumptionId, outNode, outSharedSecret, outCats) !=
+                               CHIP_NO_ERROR);
+        }
+        uint64_t missDuration = chip::System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+        // Sessions re-established with known peers replace their entry in place.
+        start = chip::System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (size_t i = 0; i < kIterations; ++i)
+        {
+            size_t entry = i % entryCount;
+            chip::ScopedNodeId node(static_cast<chip::NodeId>(entry + 1), static_cast<chip::FabricIndex>(entry % 16 + 1));
+            NL_TEST_ASSERT(inSuite,
+                           sessionStorage.FindByScopedNodeId(node, outResumptionId, outSharedSecret, outCats) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, sessionStorage.Save(node, resumptionIds[entry], sharedSecret, outCats) == CHIP_NO_ERROR);
+        }
+        uint64_t updateDuration = chip::System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+        ChipLogProgress(SecureChannel,
+                        "%u entries: %u lookups by resumption id in %u us, %u misses in %u us, %u in-place updates in %u us",
+                        static_cast<unsigned>(entryCount), static_cast<unsigned>(kIterations), static_cast<unsigned>(hitDuration),
+                        static_cast<unsigned>(kIterations), static_cast<unsigned>(missDuration),
+                        static_cast<unsigned>(kIterations), static_cast<unsigned>(updateDuration));
+    }
+}
+
 // Test Suite
 
 /**
@@ -437,10 +635,20 @@ void TestDeleteAll(nlTestSuite * inSuite, void * inContext)
 // clang-format off
 static const nlTest sTests[] =
 {
-    NL_TEST_DEF("TestSave", TestSave),
-    NL_TEST_DEF("TestInPlaceSave", TestInPlaceSave),
-    NL_TEST_DEF("TestDelete", TestDelete),
-    NL_TEST_DEF("TestDeleteAll", TestDeleteAll),
+    NL_TEST_DEF("TestSave", TestSave<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestSaveIndexInStorage", TestSave<IndexInStorageSessionResumptionStorage>),
+    NL_TEST_DEF("TestInPlaceSave", TestInPlaceSave<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestInPlaceSaveIndexInStorage", TestInPlaceSave<IndexInStorageSessionResumptionStorage>),
+    NL_TEST_DEF("TestDelete", TestDelete<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestDeleteIndexInStorage", TestDelete<IndexInStorageSessionResumptionStorage>),
+    NL_TEST_DEF("TestDeleteAll", TestDeleteAll<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestDeleteAllIndexInStorage", TestDeleteAll<IndexInStorageSessionResumptionStorage>),
+    NL_TEST_DEF("TestReload", TestReload<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestReloadIndexInStorage", TestReload<IndexInStorageSessionResumptionStorage>),
+    NL_TEST_DEF("TestNotFound", TestNotFound<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestNotFoundIndexInStorage", TestNotFound<IndexInStorageSessionResumptionStorage>),
+    NL_TEST_DEF("TestLookupBenchmark", TestLookupBenchmark<chip::SimpleSessionResumptionStorage>),
+    NL_TEST_DEF("TestLookupBenchmarkIndexInStorage", TestLookupBenchmark<IndexInStorageSessionResumptionStorage>),
 
     NL_TEST_SENTINEL()
 };